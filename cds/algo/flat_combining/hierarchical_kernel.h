@@ -0,0 +1,711 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSLIB_ALGO_FLAT_COMBINING_HIERARCHICAL_KERNEL_H
+#define CDSLIB_ALGO_FLAT_COMBINING_HIERARCHICAL_KERNEL_H
+
+#include <cds/algo/flat_combining/kernel.h>
+
+namespace cds { namespace algo { namespace flat_combining {
+
+    /// NUMA-aware hierarchical kernel of flat combining
+    /**
+        The kernel has the same interface as \p kernel and can be used instead of it
+        in any FC-based container by \p opt::fc_kernel< numa_kernel > option.
+
+        The plain \p kernel has one publication list and one combiner, so on a multi-socket system
+        the combiner reads the publication records of all nodes, and the container data moves
+        between the nodes with every combining pass.
+        \p %hierarchical_kernel splits the publication list by NUMA node: each node has its own
+        publication list and its own node lock. A thread publishes its requests in the list of its node
+        and competes for the node lock only. The node combiner collects the requests of its node and acquires
+        the global lock only to apply them to the container. Thus, the publication records are accessed
+        within their node, and the container is handed over between the nodes once per node combining pass
+        instead of once per operation.
+
+        The NUMA node of a thread is determined by \p Traits::numa_topology policy (see \p numa namespace)
+        when the thread allocates its publication record. The default policy \p numa::os_topology
+        uses the NUMA topology reported by the OS. If the system has one node, the kernel behaves
+        like \p kernel with additional node lock.
+
+        Template parameters:
+        - \p PublicationRecord - a type derived from \ref publication_record
+        - \p Traits - a type traits of flat combining, default is \p flat_combining::traits.
+            \p Traits::lock_type is used both for the global lock and for the node locks.
+
+        The iterators passed to \p owner.fc_prepare() and \p owner.fc_process() in \p batch_combine() mode enumerate
+        the publication records of the combiner's node only. \p owner.fc_prepare() is called
+        while the node combiner holds the node lock but not the global lock, so the node combiners
+        preprocess their batches in parallel.
+    */
+    template <
+        typename PublicationRecord
+        ,typename Traits = traits
+    >
+    class hierarchical_kernel
+    {
+    public:
+        typedef Traits   traits;                               ///< Type traits
+        typedef typename traits::lock_type global_lock_type;   ///< Global lock type, also used for node locks
+        typedef typename traits::wait_strategy wait_strategy;  ///< Wait strategy type
+        typedef typename traits::allocator allocator;          ///< Allocator type (used for allocating publication_record_type data)
+        typedef typename traits::stat      stat;               ///< Internal statistics
+        typedef typename traits::memory_model memory_model;    ///< C++ memory model
+        typedef typename traits::numa_topology numa_topology;  ///< NUMA topology policy
+
+        /// Publication record type
+        struct publication_record_type: public wait_strategy::template make_publication_record<PublicationRecord>::type
+        {
+            unsigned int nNode;     ///< NUMA node of the record
+        };
+
+    protected:
+        //@cond
+        typedef cds::details::Allocator< publication_record_type, allocator >   cxx11_allocator;
+        typedef std::lock_guard<global_lock_type> lock_guard;
+
+        struct node_type
+        {
+            publication_record_type *       pHead;  // dummy head of the node publication list and of the node allocated list
+            atomics::atomic<unsigned int>   nCount; // total count of combining passes of the node, used as an age
+            global_lock_type                Lock;   // node combiner lock
+            char pad_[cds::c_nCacheLineSize];
+
+            node_type()
+                : pHead( nullptr )
+                , nCount( 0 )
+            {}
+        };
+        typedef cds::details::Allocator< node_type, allocator > node_allocator;
+        //@endcond
+
+    protected:
+        //@cond
+        unsigned int const          m_nNodeCount;   ///< NUMA node count
+        node_type *                 m_arrNode;      ///< Per-node publication lists
+        boost::thread_specific_ptr< publication_record_type > m_pThreadRec;   ///< Thread-local publication record
+        mutable global_lock_type    m_Mutex;        ///< Global mutex
+        mutable stat                m_Stat;         ///< Internal statistics
+        unsigned int const          m_nCompactFactor;    ///< Publication list compacting factor (each node list is compacted through \p %m_nCompactFactor combining passes of the node)
+        unsigned int const          m_nCombinePassCount; ///< Number of combining passes
+        wait_strategy               m_waitStrategy;      ///< Wait strategy
+        //@endcond
+
+    public:
+        /// Initializes the object
+        /**
+            Compact factor = 1024
+
+            Combiner pass count = 8
+        */
+        hierarchical_kernel()
+            : hierarchical_kernel( 1024, 8 )
+        {}
+
+        /// Initializes the object
+        hierarchical_kernel(
+            unsigned int nCompactFactor  ///< Publication list compacting factor (each node list will be compacted through \p nCompactFactor combining passes of the node)
+            ,unsigned int nCombinePassCount ///< Number of combining passes for combiner thread
+            )
+            : m_nNodeCount( numa_topology::node_count() > 0 ? numa_topology::node_count() : 1 )
+            , m_arrNode( node_allocator().NewArray( m_nNodeCount ))
+            , m_pThreadRec( tls_cleanup )
+            , m_nCompactFactor( static_cast<unsigned>( cds::beans::ceil2( static_cast<size_t>( nCompactFactor )) - 1 ))   // binary mask
+            , m_nCombinePassCount( nCombinePassCount )
+        {
+            for ( unsigned int i = 0; i < m_nNodeCount; ++i ) {
+                publication_record_type * pHead = cxx11_allocator().New();
+                pHead->nNode = i;
+                m_arrNode[i].pHead = pHead;
+            }
+        }
+
+        /// Destroys the object and all publication records
+        ~hierarchical_kernel()
+        {
+            m_pThreadRec.reset();   // calls tls_cleanup()
+
+            // delete all publication records
+            for ( unsigned int i = 0; i < m_nNodeCount; ++i ) {
+                for ( publication_record* p = m_arrNode[i].pHead; p; ) {
+                    publication_record * pRec = p;
+                    p = p->pNextAllocated.load( memory_model::memory_order_relaxed );
+                    cxx11_allocator().Delete( static_cast<publication_record_type *>( pRec ));
+                }
+            }
+            node_allocator().Delete( m_arrNode, m_nNodeCount );
+        }
+
+        /// Gets publication list record for the current thread
+        /**
+            If there is no publication record for the current thread
+            the function allocates it in the publication list of the current NUMA node.
+        */
+        publication_record_type * acquire_record()
+        {
+            publication_record_type * pRec = m_pThreadRec.get();
+            if ( !pRec ) {
+                // Allocate new publication record
+                pRec = cxx11_allocator().New();
+                pRec->nNode = numa_topology::current_node() % m_nNodeCount;
+                m_pThreadRec.reset( pRec );
+                m_Stat.onCreatePubRecord();
+
+                // Insert in allocated list of the node
+                publication_record_type * pHead = m_arrNode[pRec->nNode].pHead;
+                publication_record* p = pHead->pNextAllocated.load( memory_model::memory_order_relaxed );
+                do {
+                    pRec->pNextAllocated.store( p, memory_model::memory_order_release );
+                } while ( !pHead->pNextAllocated.compare_exchange_weak( p, pRec, memory_model::memory_order_release, atomics::memory_order_acquire ));
+
+                publish( pRec );
+            }
+            else if ( pRec->nState.load( memory_model::memory_order_acquire ) != active )
+                publish( pRec );
+
+            assert( pRec->op() == req_EmptyRecord );
+
+            return pRec;
+        }
+
+        /// Marks publication record for the current thread as empty
+        void release_record( publication_record_type * pRec )
+        {
+            assert( pRec->is_done());
+            pRec->nRequest.store( req_EmptyRecord, memory_model::memory_order_release );
+        }
+
+        /// Trying to execute operation \p nOpId
+        /**
+            The function is similar to \p kernel::combine(). If the thread becomes the combiner of its node,
+            it acquires the global lock and calls \p owner.fc_apply() for each active non-empty
+            publication record of the node.
+        */
+        template <class Container>
+        void combine( unsigned int nOpId, publication_record_type * pRec, Container& owner )
+        {
+            assert( nOpId >= req_Operation );
+            assert( pRec );
+
+            pRec->nRequest.store( nOpId, memory_model::memory_order_release );
+            m_Stat.onOperation();
+
+            try_combining( owner, pRec );
+        }
+
+        /// Trying to execute operation \p nOpId in batch-combine mode
+        /**
+            The function is similar to \p kernel::batch_combine(). If the thread becomes the combiner of its node,
+            it acquires the global lock and calls \p owner.fc_process() with the iterators over the publication
+            records of the node.
+        */
+        template <class Container>
+        void batch_combine( unsigned int nOpId, publication_record_type* pRec, Container& owner )
+        {
+            assert( nOpId >= req_Operation );
+            assert( pRec );
+
+            pRec->nRequest.store( nOpId, memory_model::memory_order_release );
+            m_Stat.onOperation();
+
+            try_batch_combining( owner, pRec );
+        }
+
+        /// Invokes \p Func in exclusive mode
+        /**
+            The function acquires the global lock only, see \p kernel::invoke_exclusive().
+        */
+        template <typename Func>
+        void invoke_exclusive( Func f )
+        {
+            {
+                lock_guard l( m_Mutex );
+                f();
+            }
+            m_waitStrategy.wakeup( *this );
+            m_Stat.onInvokeExclusive();
+        }
+
+        /// Marks \p rec as executed
+        /**
+            This function should be called by container if \p batch_combine() mode is used.
+            For usual combining (see \p combine()) this function is excess.
+        */
+        void operation_done( publication_record& rec )
+        {
+            rec.nRequest.store( req_Response, memory_model::memory_order_release );
+            m_waitStrategy.notify( *this, static_cast<publication_record_type&>( rec ));
+        }
+
+        /// Internal statistics
+        stat const& statistics() const
+        {
+            return m_Stat;
+        }
+
+        //@cond
+        // For container classes based on flat combining
+        stat& internal_statistics() const
+        {
+            return m_Stat;
+        }
+        //@endcond
+
+        /// Returns the compact factor
+        unsigned int compact_factor() const
+        {
+            return m_nCompactFactor + 1;
+        }
+
+        /// Returns number of combining passes for combiner thread
+        unsigned int combine_pass_count() const
+        {
+            return m_nCombinePassCount;
+        }
+
+        /// Returns NUMA node count
+        unsigned int node_count() const
+        {
+            return m_nNodeCount;
+        }
+
+    public:
+        /// Publication list iterator
+        /**
+            The iterator enumerates active publication records of a range of nodes.
+            \p begin() iterates over all nodes; the iterators passed to \p owner.fc_process()
+            iterate over the node of the combiner.
+        */
+        class iterator
+        {
+            //@cond
+            friend class hierarchical_kernel;
+            publication_record_type *   m_pRec;
+            node_type *                 m_pNode;
+            node_type *                 m_pNodeEnd;
+            //@endcond
+
+        protected:
+            //@cond
+            iterator( node_type * pNode, node_type * pNodeEnd )
+                : m_pRec( pNode->pHead )
+                , m_pNode( pNode )
+                , m_pNodeEnd( pNodeEnd )
+            {
+                skip_inactive();
+            }
+
+            void skip_inactive()
+            {
+                for ( ;; ) {
+                    while ( m_pRec && ( m_pRec->nState.load( memory_model::memory_order_acquire ) != active
+                                     || m_pRec->op( memory_model::memory_order_relaxed ) < req_Operation ))
+                    {
+                        m_pRec = static_cast<publication_record_type*>( m_pRec->pNext.load( memory_model::memory_order_acquire ));
+                    }
+
+                    if ( m_pRec || ++m_pNode >= m_pNodeEnd )
+                        break;
+                    m_pRec = m_pNode->pHead;
+                }
+            }
+            //@endcond
+
+        public:
+            /// Initializes an empty iterator object
+            iterator()
+                : m_pRec( nullptr )
+                , m_pNode( nullptr )
+                , m_pNodeEnd( nullptr )
+            {}
+
+            /// Copy ctor
+            iterator( iterator const& src )
+                : m_pRec( src.m_pRec )
+                , m_pNode( src.m_pNode )
+                , m_pNodeEnd( src.m_pNodeEnd )
+            {}
+
+            /// Pre-increment
+            iterator& operator++()
+            {
+                assert( m_pRec );
+                m_pRec = static_cast<publication_record_type *>( m_pRec->pNext.load( memory_model::memory_order_acquire ));
+                skip_inactive();
+                return *this;
+            }
+
+            /// Post-increment
+            iterator operator++(int)
+            {
+                assert( m_pRec );
+                iterator it(*this);
+                ++(*this);
+                return it;
+            }
+
+            /// Dereference operator, can return \p nullptr
+            publication_record_type* operator ->()
+            {
+                return m_pRec;
+            }
+
+            /// Dereference operator, the iterator should not be an end iterator
+            publication_record_type& operator*()
+            {
+                assert( m_pRec );
+                return *m_pRec;
+            }
+
+            /// Iterator equality
+            friend bool operator==( iterator it1, iterator it2 )
+            {
+                return it1.m_pRec == it2.m_pRec;
+            }
+
+            /// Iterator inequality
+            friend bool operator!=( iterator it1, iterator it2 )
+            {
+                return !( it1 == it2 );
+            }
+        };
+
+        /// Returns an iterator to the first active publication record of all nodes
+        iterator begin()    { return iterator( m_arrNode, m_arrNode + m_nNodeCount ); }
+
+        /// Returns an iterator to the end of publication list. Should not be dereferenced.
+        iterator end()      { return iterator(); }
+
+    public:
+        /// Gets current value of \p rec.nRequest
+        /**
+            This function is intended for invoking from a wait strategy
+        */
+        int get_operation( publication_record& rec )
+        {
+            return rec.op( memory_model::memory_order_acquire );
+        }
+
+        /// Wakes up any waiting thread
+        /**
+            This function is intended for invoking from a wait strategy
+        */
+        void wakeup_any()
+        {
+            for ( unsigned int i = 0; i < m_nNodeCount; ++i ) {
+                for ( publication_record* pRec = m_arrNode[i].pHead; pRec; pRec = pRec->pNext.load( memory_model::memory_order_acquire )) {
+                    if ( pRec->nState.load( memory_model::memory_order_acquire ) == active
+                      && pRec->op( memory_model::memory_order_acquire ) >= req_Operation )
+                    {
+                        m_waitStrategy.notify( *this, static_cast<publication_record_type&>( *pRec ));
+                        return;
+                    }
+                }
+            }
+        }
+
+    private:
+        //@cond
+        static void tls_cleanup( publication_record_type* pRec )
+        {
+            // Thread done
+            // pRec that is TLS data should be excluded from publication list
+            pRec->nState.store( removed, memory_model::memory_order_release );
+        }
+
+        void free_publication_record( publication_record_type* pRec )
+        {
+            cxx11_allocator().Delete( pRec );
+            m_Stat.onDeletePubRecord();
+        }
+
+        void publish( publication_record_type* pRec )
+        {
+            assert( pRec->nState.load( memory_model::memory_order_relaxed ) == inactive );
+
+            node_type& node = m_arrNode[pRec->nNode];
+            pRec->nAge.store( node.nCount.load( memory_model::memory_order_relaxed ), memory_model::memory_order_relaxed );
+            pRec->nState.store( active, memory_model::memory_order_relaxed );
+
+            // Insert record to publication list of the node. The head is a dummy record that is never published
+            publication_record * p = node.pHead->pNext.load( memory_model::memory_order_relaxed );
+            if ( p != static_cast<publication_record *>( pRec )) {
+                do {
+                    pRec->pNext.store( p, memory_model::memory_order_release );
+                    // Failed CAS changes p
+                } while ( !node.pHead->pNext.compare_exchange_weak( p, static_cast<publication_record *>( pRec ),
+                    memory_model::memory_order_release, atomics::memory_order_acquire ));
+                m_Stat.onActivatePubRecord();
+            }
+        }
+
+        void republish( publication_record_type* pRec )
+        {
+            if ( pRec->nState.load( memory_model::memory_order_relaxed ) != active ) {
+                // The record has been excluded from publication list. Reinsert it
+                publish( pRec );
+            }
+        }
+
+        template <class Container>
+        void try_combining( Container& owner, publication_record_type* pRec )
+        {
+            node_type& node = m_arrNode[pRec->nNode];
+            if ( node.Lock.try_lock() || !wait_for_combining( node, pRec )) {
+                // The thread becomes the combiner of the node
+                lock_guard l( node.Lock, std::adopt_lock_t());
+
+                // The record pRec can be excluded from publication list. Re-publish it
+                republish( pRec );
+
+                combining( node, owner );
+                assert( pRec->op( memory_model::memory_order_relaxed ) == req_Response );
+            }
+        }
+
+        template <class Container>
+        void try_batch_combining( Container& owner, publication_record_type * pRec )
+        {
+            node_type& node = m_arrNode[pRec->nNode];
+            if ( node.Lock.try_lock() || !wait_for_combining( node, pRec )) {
+                // The thread becomes the combiner of the node
+                lock_guard l( node.Lock, std::adopt_lock_t());
+
+                // The record pRec can be excluded from publication list. Re-publish it
+                republish( pRec );
+
+                batch_combining( node, owner );
+                assert( pRec->op( memory_model::memory_order_relaxed ) == req_Response );
+            }
+        }
+
+        template <class Container>
+        void combining( node_type& node, Container& owner )
+        {
+            // The thread is the node combiner
+            unsigned int const nCurAge = node.nCount.fetch_add( 1, memory_model::memory_order_relaxed ) + 1;
+
+            {
+                // The node combiners compete for the container
+                lock_guard l( m_Mutex );
+
+                unsigned int nEmptyPassCount = 0;
+                unsigned int nUsefulPassCount = 0;
+                for ( unsigned int nPass = 0; nPass < m_nCombinePassCount; ++nPass ) {
+                    if ( combining_pass( node, owner, nCurAge ))
+                        ++nUsefulPassCount;
+                    else if ( ++nEmptyPassCount > nUsefulPassCount )
+                        break;
+                }
+                m_waitStrategy.flush( *this );
+            }
+
+            m_Stat.onCombining();
+            if ( ( nCurAge & m_nCompactFactor ) == 0 )
+                compact_list( node, nCurAge );
+        }
+
+        template <class Container>
+        bool combining_pass( node_type& node, Container& owner, unsigned int nCurAge )
+        {
+            bool bOpDone = false;
+            for ( publication_record* p = node.pHead->pNext.load( memory_model::memory_order_acquire ); p; p = p->pNext.load( memory_model::memory_order_acquire )) {
+                if ( p->nState.load( memory_model::memory_order_acquire ) == active
+                  && p->op( memory_model::memory_order_acquire ) >= req_Operation )
+                {
+                    p->nAge.store( nCurAge, memory_model::memory_order_relaxed );
+                    owner.fc_apply( static_cast<publication_record_type*>( p ));
+                    operation_done( *p );
+                    bOpDone = true;
+                }
+                // removed records are excluded on compacting phase
+            }
+            return bOpDone;
+        }
+
+        template <class Container>
+        void batch_combining( node_type& node, Container& owner )
+        {
+            // The thread is the node combiner
+            unsigned int const nCurAge = node.nCount.fetch_add( 1, memory_model::memory_order_relaxed ) + 1;
+
+            // The node combiners preprocess their batches in parallel
+            owner.fc_prepare( iterator( &node, &node + 1 ), end());
+
+            {
+                // The node combiners compete for the container
+                lock_guard l( m_Mutex );
+
+                for ( unsigned int nPass = 0; nPass < m_nCombinePassCount; ++nPass )
+                    owner.fc_process( iterator( &node, &node + 1 ), end());
+
+                combining_pass( node, owner, nCurAge );
+                m_waitStrategy.flush( *this );
+            }
+
+            m_Stat.onCombining();
+            if ( ( nCurAge & m_nCompactFactor ) == 0 )
+                compact_list( node, nCurAge );
+        }
+
+        bool wait_for_combining( node_type& node, publication_record_type* pRec )
+        {
+            m_waitStrategy.prepare( *pRec );
+            m_Stat.onPassiveWait();
+
+            while ( pRec->op( memory_model::memory_order_acquire ) != req_Response ) {
+                // The record can be excluded from publication list. Reinsert it
+                republish( pRec );
+
+                m_Stat.onPassiveWaitIteration();
+
+                // Wait while operation processing
+                if ( m_waitStrategy.wait( *this, *pRec ))
+                    m_Stat.onWakeupByNotifying();
+
+                if ( node.Lock.try_lock()) {
+                    if ( pRec->op( memory_model::memory_order_acquire ) == req_Response ) {
+                        // Operation is done
+                        node.Lock.unlock();
+
+                        // Wake up a pending threads
+                        m_waitStrategy.wakeup( *this );
+                        m_Stat.onPassiveWaitWakeup();
+
+                        break;
+                    }
+                    // The thread becomes the node combiner
+                    m_Stat.onPassiveToCombiner();
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        void compact_list( node_type& node, unsigned int nCurAge )
+        {
+            // Compacts the publication list of the node
+            // This function is called only by the node combiner
+
+        try_again:
+            publication_record * pPrev = node.pHead;
+            for ( publication_record * p = pPrev->pNext.load( memory_model::memory_order_acquire ); p; ) {
+                switch ( p->nState.load( memory_model::memory_order_relaxed )) {
+                case active:
+                    if ( p->nAge.load( memory_model::memory_order_relaxed ) + m_nCompactFactor < nCurAge )
+                    {
+                        publication_record * pNext = p->pNext.load( memory_model::memory_order_relaxed );
+                        if ( pPrev->pNext.compare_exchange_strong( p, pNext,
+                            memory_model::memory_order_acquire, atomics::memory_order_relaxed ))
+                        {
+                            p->nState.store( inactive, memory_model::memory_order_release );
+                            p = pNext;
+                            m_Stat.onDeactivatePubRecord();
+                            continue;
+                        }
+                    }
+                    break;
+
+                case removed:
+                    publication_record * pNext = p->pNext.load( memory_model::memory_order_acquire );
+                    if ( cds_likely( pPrev->pNext.compare_exchange_strong( p, pNext, memory_model::memory_order_acquire, atomics::memory_order_relaxed ))) {
+                        p = pNext;
+                        continue;
+                    }
+                    else {
+                        // CAS can be failed only in beginning of list
+                        assert( pPrev == node.pHead );
+                        goto try_again;
+                    }
+                }
+                pPrev = p;
+                p = p->pNext.load( memory_model::memory_order_acquire );
+            }
+
+            // Iterate over allocated list of the node to find removed records
+            pPrev = node.pHead;
+            for ( publication_record * p = pPrev->pNextAllocated.load( memory_model::memory_order_acquire ); p; ) {
+                if ( p->nState.load( memory_model::memory_order_relaxed ) == removed ) {
+                    publication_record * pNext = p->pNextAllocated.load( memory_model::memory_order_relaxed );
+                    if ( pPrev->pNextAllocated.compare_exchange_strong( p, pNext, memory_model::memory_order_acquire, atomics::memory_order_relaxed )) {
+                        free_publication_record( static_cast<publication_record_type *>( p ));
+                        p = pNext;
+                        continue;
+                    }
+                }
+
+                pPrev = p;
+                p = p->pNextAllocated.load( memory_model::memory_order_relaxed );
+            }
+
+            m_Stat.onCompactPublicationList();
+        }
+        //@endcond
+    };
+
+    /// Selects \p hierarchical_kernel for FC-based containers, see \p opt::fc_kernel option
+    struct numa_kernel
+    {
+        /// Metafunction returning the kernel type
+        template <typename PublicationRecord, typename Traits>
+        struct make_kernel {
+            typedef hierarchical_kernel< PublicationRecord, Traits > type;    ///< Metafunction result
+        };
+    };
+
+    /// Selects \p hierarchical_kernel with \p GroupCount combining groups for FC-based containers
+    /**
+        Parallel combining mode: the threads are distributed among \p GroupCount groups in round-robin order
+        (see \p numa::round_robin) independently of \p Traits::numa_topology.
+        Each group has its own combiner. In \p batch_combine() mode the group combiners preprocess
+        their batches by \p owner.fc_prepare() in parallel, and only the prepared result is applied
+        to the container under the global lock. The containers that benefit from this mode are
+        \p FCPriorityQueue and \p FCDeque with elimination enabled.
+    */
+    template <unsigned int GroupCount = 4>
+    struct parallel_kernel
+    {
+        /// Metafunction returning the kernel type
+        template <typename PublicationRecord, typename Traits>
+        struct make_kernel {
+            //@cond
+            struct group_traits: public Traits
+            {
+                typedef numa::round_robin< GroupCount > numa_topology;
+            };
+            //@endcond
+
+            typedef hierarchical_kernel< PublicationRecord, group_traits > type;    ///< Metafunction result
+        };
+    };
+
+}}} // namespace cds::algo::flat_combining
+
+#endif // #ifndef CDSLIB_ALGO_FLAT_COMBINING_HIERARCHICAL_KERNEL_H
@@ -38,6 +38,41 @@
 #include <cds/details/allocator.h>
 #include <cds/opt/options.h>
 #include <cds/algo/int_algo.h>
+#include <cds/os/topology.h>
+
+namespace cds { namespace opt {
+
+    /// Flat combining kernel option for FC-based containers
+    /**
+        \p Selector is a metafunction class that makes the kernel type,
+        \p cds::algo::flat_combining::plain_kernel (the default), \p cds::algo::flat_combining::numa_kernel,
+        \p cds::algo::flat_combining::slot_kernel or \p cds::algo::flat_combining::parallel_kernel.
+    */
+    template <typename Selector>
+    struct fc_kernel {
+        //@cond
+        template <typename Base> struct pack: public Base
+        {
+            typedef Selector fc_kernel;
+        };
+        //@endcond
+    };
+
+    /// NUMA topology option for \p flat_combining::hierarchical_kernel
+    /**
+        See \p cds::algo::flat_combining::numa namespace for available policies.
+    */
+    template <typename Topology>
+    struct numa_topology {
+        //@cond
+        template <typename Base> struct pack: public Base
+        {
+            typedef Topology numa_topology;
+        };
+        //@endcond
+    };
+
+}} // namespace cds::opt
 
 namespace cds { namespace algo {
 
@@ -167,6 +202,78 @@ namespace cds { namespace algo {
             //@endcond
         };
 
+        /// NUMA topology policies for \p hierarchical_kernel
+        /**
+            The policy maps a thread to a NUMA node. The node of the thread is determined once,
+            when the thread allocates its publication record. The policy interface:
+            \code
+            struct topology {
+                // Returns the count of nodes, at least 1
+                static unsigned int node_count();
+                // Returns the node of the current thread, the result is taken modulo node_count()
+                static unsigned int current_node();
+            };
+            \endcode
+        */
+        namespace numa {
+
+            /// NUMA topology reported by the OS
+            /**
+                On Linux the policy uses \p cds::OS::topology::numa_node_count() and \p current_numa_node().
+                On other systems the policy reports one node.
+            */
+            struct os_topology
+            {
+                /// Returns the count of NUMA nodes
+                static unsigned int node_count()
+                {
+#           if CDS_OS_TYPE == CDS_OS_LINUX
+                    return cds::OS::topology::numa_node_count();
+#           else
+                    return 1;
+#           endif
+                }
+
+                /// Returns the NUMA node of the current thread
+                static unsigned int current_node()
+                {
+#           if CDS_OS_TYPE == CDS_OS_LINUX
+                    return cds::OS::topology::current_numa_node();
+#           else
+                    return 0;
+#           endif
+                }
+            };
+
+            /// Virtual topology of \p NodeCount nodes, the threads are distributed among the nodes in round-robin order
+            /**
+                The policy is intended for partitioning the threads when the OS gives no NUMA information,
+                and for testing the hierarchical kernel on a non-NUMA system.
+            */
+            template <unsigned int NodeCount>
+            struct round_robin
+            {
+                static_assert( NodeCount > 0, "NodeCount must be positive" );
+
+                /// Returns \p NodeCount
+                static unsigned int node_count()
+                {
+                    return NodeCount;
+                }
+
+                /// Returns the next node
+                static unsigned int current_node()
+                {
+                    static atomics::atomic<unsigned int> s_nNext( 0 );
+                    return s_nNext.fetch_add( 1, atomics::memory_order_relaxed ) % NodeCount;
+                }
+            };
+        } // namespace numa
+
+        //@cond
+        struct plain_kernel;
+        //@endcond
+
         /// Type traits of \ref kernel class
         /**
             You can define different type traits for \ref kernel
@@ -180,6 +287,8 @@ namespace cds { namespace algo {
             typedef CDS_DEFAULT_ALLOCATOR       allocator;  ///< Allocator used for TLS data (allocating \p publication_record derivatives)
             typedef empty_stat                  stat;       ///< Internal statistics
             typedef opt::v::relaxed_ordering  memory_model; ///< /// C++ memory ordering model
+            typedef plain_kernel                fc_kernel;  ///< Kernel selector for FC-based containers: \p plain_kernel, \p numa_kernel, \p slot_kernel or \p parallel_kernel
+            typedef numa::os_topology           numa_topology; ///< NUMA topology, used by \p hierarchical_kernel only
         };
 
         /// Metafunction converting option list to traits
@@ -192,6 +301,11 @@ namespace cds { namespace algo {
             - \p opt::memory_model - C++ memory ordering model.
                 List of all available memory ordering see \p opt::memory_model.
                 Default is \p cds::opt::v::relaxed_ordering
+            - \p opt::fc_kernel - the kernel used by FC-based containers: \p plain_kernel (the default)
+                \p numa_kernel (see \p hierarchical_kernel), \p slot_kernel (see \p slot_array_kernel)
+                or \p parallel_kernel
+            - \p opt::numa_topology - NUMA topology policy for \p hierarchical_kernel, see \p numa namespace.
+                Default is \p numa::os_topology
         */
         template <typename... Options>
         struct make_traits {
@@ -230,6 +344,11 @@ namespace cds { namespace algo {
               multiple pass through active records of publication list. For each processed record the container
               should call \p operation_done() function. On the end, the container should release
               its record by \p release_record().
+              Before \p fc_process() the combiner calls \p owner.fc_prepare() with the same iterators.
+              The container may preprocess the batch there (sort, match requests and so on) but it must not access
+              the underlying sequential container and must not call \p operation_done(): \p hierarchical_kernel
+              calls \p fc_prepare() outside of the global lock, see \p parallel_kernel.
+              \p flat_combining::container provides empty \p fc_prepare().
         */
         template <
             typename PublicationRecord
@@ -694,6 +813,7 @@ namespace cds { namespace algo {
                     else if ( ++nEmptyPassCount > nUsefulPassCount )
                         break;
                 }
+                m_waitStrategy.flush( *this );
 
                 m_Stat.onCombining();
                 if ( ( nCurAge & m_nCompactFactor ) == 0 )
@@ -739,10 +859,12 @@ namespace cds { namespace algo {
 
                 unsigned int const nCurAge = m_nCount.fetch_add( 1, memory_model::memory_order_relaxed ) + 1;
 
+                owner.fc_prepare( begin(), end());
                 for ( unsigned int nPass = 0; nPass < m_nCombinePassCount; ++nPass )
                     owner.fc_process( begin(), end());
 
                 combining_pass( owner, nCurAge );
+                m_waitStrategy.flush( *this );
                 m_Stat.onCombining();
                 if ( ( nCurAge & m_nCompactFactor ) == 0 )
                     compact_list( nCurAge );
@@ -843,6 +965,16 @@ namespace cds { namespace algo {
             //@endcond
         };
 
+        /// Selects \p kernel for FC-based containers, see \p opt::fc_kernel option
+        struct plain_kernel
+        {
+            /// Metafunction returning the kernel type
+            template <typename PublicationRecord, typename Traits>
+            struct make_kernel {
+                typedef kernel< PublicationRecord, Traits > type;    ///< Metafunction result
+            };
+        };
+
         //@cond
         class container
         {
@@ -858,6 +990,11 @@ namespace cds { namespace algo {
             {
                 assert( false );
             }
+
+            // Default: no preprocessing of the batch
+            template <typename Iterator>
+            void fc_prepare( Iterator, Iterator )
+            {}
         };
         //@endcond
 
@@ -0,0 +1,618 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSLIB_ALGO_FLAT_COMBINING_SLOT_KERNEL_H
+#define CDSLIB_ALGO_FLAT_COMBINING_SLOT_KERNEL_H
+
+#include <cds/algo/flat_combining/kernel.h>
+#include <cds/algo/bitop.h>
+#include <cds/os/alloc_aligned.h>
+
+namespace cds { namespace algo { namespace flat_combining {
+
+    /// Flat combining kernel with array-based publication slots
+    /**
+        The kernel has the same interface as \p kernel and can be used instead of it
+        in any FC-based container by \p opt::fc_kernel< slot_kernel<SlotCount> > option.
+
+        The plain \p kernel keeps the publication records in a linked list. The combiner walks the list
+        chasing the pointers, and the list is periodically pruned by age.
+        \p %slot_array_kernel stores the publication records in a fixed array of \p SlotCount cache-line padded slots.
+        A thread claims a free slot on its first operation and keeps it until the thread terminates;
+        the slot of a terminated thread is reused by the next new thread. Each claimed slot is marked
+        in the occupancy bitmap, so the combiner scans the bitmap and visits the occupied slots in address order.
+        Since a slot is never unlinked, there is no compacting pass, and the compact factor is ignored.
+
+        If all slots are claimed, the thread gets an overflow publication record allocated by \p Traits::allocator.
+        The overflow records are kept in a list that the combiner walks after the slots;
+        an overflow record of a terminated thread is reused by another thread and freed in the kernel destructor only.
+
+        Template parameters:
+        - \p PublicationRecord - a type derived from \ref publication_record
+        - \p Traits - a type traits of flat combining, default is \p flat_combining::traits.
+        - \p SlotCount - the number of publication slots, should be close to the maximum number of threads
+            accessing the container.
+    */
+    template <
+        typename PublicationRecord
+        ,typename Traits = traits
+        ,unsigned int SlotCount = 64
+    >
+    class slot_array_kernel
+    {
+    public:
+        typedef Traits   traits;                               ///< Type traits
+        typedef typename traits::lock_type global_lock_type;   ///< Global lock type
+        typedef typename traits::wait_strategy wait_strategy;  ///< Wait strategy type
+        typedef typename traits::allocator allocator;          ///< Allocator type (used for allocating overflow publication records)
+        typedef typename traits::stat      stat;               ///< Internal statistics
+        typedef typename traits::memory_model memory_model;    ///< C++ memory model
+
+        typedef typename wait_strategy::template make_publication_record<PublicationRecord>::type publication_record_type; ///< Publication record type
+
+        static constexpr unsigned int const c_nSlotCount = SlotCount;   ///< Number of publication slots
+        static_assert( c_nSlotCount > 0, "SlotCount must be positive" );
+
+    protected:
+        //@cond
+        typedef cds::details::Allocator< publication_record_type, allocator >   cxx11_allocator;
+        typedef std::lock_guard<global_lock_type> lock_guard;
+
+        typedef typename cds::opt::details::apply_padding< publication_record_type, cds::opt::cache_line_padding >::type slot_type;
+
+        typedef atomics::atomic<uint64_t> bitmap_word;
+        static constexpr unsigned int const c_nBitmapWordBits = 64;
+        static constexpr unsigned int const c_nBitmapSize = ( c_nSlotCount + c_nBitmapWordBits - 1 ) / c_nBitmapWordBits;
+        //@endcond
+
+    protected:
+        //@cond
+        slot_type *                 m_arrSlot;      ///< Publication slots, aligned on cache line
+        bitmap_word                 m_arrBitmap[c_nBitmapSize]; ///< Occupancy bitmap: bit \p i is set if the slot \p i has ever been claimed
+        atomics::atomic< publication_record_type *> m_pOverflowHead;    ///< List of overflow records linked by \p pNextAllocated
+        atomics::atomic<unsigned int>  m_nCount;    ///< Total count of combining passes. Used as an age.
+        boost::thread_specific_ptr< publication_record_type > m_pThreadRec;   ///< Thread-local publication record
+        mutable global_lock_type    m_Mutex;        ///< Global mutex
+        mutable stat                m_Stat;         ///< Internal statistics
+        unsigned int const          m_nCompactFactor;    ///< Not used, for interface compatibility with \p kernel
+        unsigned int const          m_nCombinePassCount; ///< Number of combining passes
+        wait_strategy               m_waitStrategy;      ///< Wait strategy
+        //@endcond
+
+    public:
+        /// Initializes the object
+        /**
+            Combiner pass count = 8
+        */
+        slot_array_kernel()
+            : slot_array_kernel( 1024, 8 )
+        {}
+
+        /// Initializes the object
+        slot_array_kernel(
+            unsigned int nCompactFactor  ///< Not used, the slot array is never compacted
+            ,unsigned int nCombinePassCount ///< Number of combining passes for combiner thread
+            )
+            : m_arrSlot( alloc_slots())
+            , m_pOverflowHead( nullptr )
+            , m_nCount( 0 )
+            , m_pThreadRec( tls_cleanup )
+            , m_nCompactFactor( nCompactFactor )
+            , m_nCombinePassCount( nCombinePassCount )
+        {
+            for ( unsigned int i = 0; i < c_nBitmapSize; ++i )
+                m_arrBitmap[i].store( 0, memory_model::memory_order_relaxed );
+        }
+
+        /// Destroys the object, all slots and overflow records
+        ~slot_array_kernel()
+        {
+            m_pThreadRec.reset();   // calls tls_cleanup()
+
+            for ( publication_record* p = m_pOverflowHead.load( memory_model::memory_order_relaxed ); p; ) {
+                publication_record * pRec = p;
+                p = p->pNextAllocated.load( memory_model::memory_order_relaxed );
+                cxx11_allocator().Delete( static_cast<publication_record_type *>( pRec ));
+                m_Stat.onDeletePubRecord();
+            }
+
+            for ( unsigned int i = 0; i < c_nSlotCount; ++i )
+                m_arrSlot[i].~slot_type();
+            cds::OS::aligned_free( m_arrSlot );
+        }
+
+        /// Gets publication record for the current thread
+        /**
+            If the current thread has no publication record the function claims a free slot.
+            If there is no free slot, an overflow record is used.
+        */
+        publication_record_type * acquire_record()
+        {
+            publication_record_type * pRec = m_pThreadRec.get();
+            if ( !pRec ) {
+                pRec = claim_slot();
+                if ( !pRec )
+                    pRec = claim_overflow_record();
+                m_pThreadRec.reset( pRec );
+            }
+
+            assert( pRec->nState.load( memory_model::memory_order_relaxed ) == active );
+            assert( pRec->op() == req_EmptyRecord );
+
+            return pRec;
+        }
+
+        /// Marks publication record for the current thread as empty
+        void release_record( publication_record_type * pRec )
+        {
+            assert( pRec->is_done());
+            pRec->nRequest.store( req_EmptyRecord, memory_model::memory_order_release );
+        }
+
+        /// Trying to execute operation \p nOpId
+        /**
+            See \p kernel::combine()
+        */
+        template <class Container>
+        void combine( unsigned int nOpId, publication_record_type * pRec, Container& owner )
+        {
+            assert( nOpId >= req_Operation );
+            assert( pRec );
+
+            pRec->nRequest.store( nOpId, memory_model::memory_order_release );
+            m_Stat.onOperation();
+
+            try_combining( owner, pRec );
+        }
+
+        /// Trying to execute operation \p nOpId in batch-combine mode
+        /**
+            See \p kernel::batch_combine()
+        */
+        template <class Container>
+        void batch_combine( unsigned int nOpId, publication_record_type* pRec, Container& owner )
+        {
+            assert( nOpId >= req_Operation );
+            assert( pRec );
+
+            pRec->nRequest.store( nOpId, memory_model::memory_order_release );
+            m_Stat.onOperation();
+
+            try_batch_combining( owner, pRec );
+        }
+
+        /// Invokes \p Func in exclusive mode
+        /**
+            See \p kernel::invoke_exclusive()
+        */
+        template <typename Func>
+        void invoke_exclusive( Func f )
+        {
+            {
+                lock_guard l( m_Mutex );
+                f();
+            }
+            m_waitStrategy.wakeup( *this );
+            m_Stat.onInvokeExclusive();
+        }
+
+        /// Marks \p rec as executed
+        /**
+            This function should be called by container if \p batch_combine() mode is used.
+            For usual combining (see \p combine()) this function is excess.
+        */
+        void operation_done( publication_record& rec )
+        {
+            rec.nRequest.store( req_Response, memory_model::memory_order_release );
+            m_waitStrategy.notify( *this, static_cast<publication_record_type&>( rec ));
+        }
+
+        /// Internal statistics
+        stat const& statistics() const
+        {
+            return m_Stat;
+        }
+
+        //@cond
+        // For container classes based on flat combining
+        stat& internal_statistics() const
+        {
+            return m_Stat;
+        }
+        //@endcond
+
+        /// Returns the compact factor passed to the constructor; the kernel does not use it
+        unsigned int compact_factor() const
+        {
+            return m_nCompactFactor;
+        }
+
+        /// Returns number of combining passes for combiner thread
+        unsigned int combine_pass_count() const
+        {
+            return m_nCombinePassCount;
+        }
+
+        /// Returns the number of publication slots
+        static constexpr unsigned int slot_count()
+        {
+            return c_nSlotCount;
+        }
+
+    public:
+        /// Publication record iterator
+        /**
+            The iterator enumerates active non-empty publication records: the occupied slots in slot order,
+            then the overflow records.
+        */
+        class iterator
+        {
+            //@cond
+            friend class slot_array_kernel;
+            publication_record_type *   m_pRec;
+            slot_array_kernel *         m_pKernel;
+            unsigned int                m_nWord;    // current bitmap word, c_nBitmapSize means the overflow list
+            uint64_t                    m_nBits;    // not yet visited bits of the current bitmap word
+            //@endcond
+
+        protected:
+            //@cond
+            explicit iterator( slot_array_kernel& k )
+                : m_pRec( nullptr )
+                , m_pKernel( &k )
+                , m_nWord( 0 )
+                , m_nBits( k.m_arrBitmap[0].load( memory_model::memory_order_acquire ))
+            {
+                next_record();
+                skip_inactive();
+            }
+
+            void next_record()
+            {
+                while ( m_nWord < c_nBitmapSize ) {
+                    if ( m_nBits ) {
+                        unsigned int const nSlot = m_nWord * c_nBitmapWordBits + static_cast<unsigned int>( cds::bitop::LSBnz( m_nBits ));
+                        m_nBits &= m_nBits - 1;
+                        m_pRec = &m_pKernel->m_arrSlot[nSlot].data;
+                        return;
+                    }
+                    if ( ++m_nWord < c_nBitmapSize )
+                        m_nBits = m_pKernel->m_arrBitmap[m_nWord].load( memory_model::memory_order_acquire );
+                    else {
+                        m_pRec = m_pKernel->m_pOverflowHead.load( memory_model::memory_order_acquire );
+                        return;
+                    }
+                }
+
+                assert( m_pRec );
+                m_pRec = static_cast<publication_record_type *>( m_pRec->pNextAllocated.load( memory_model::memory_order_acquire ));
+            }
+
+            void skip_inactive()
+            {
+                while ( m_pRec && ( m_pRec->nState.load( memory_model::memory_order_acquire ) != active
+                                 || m_pRec->op( memory_model::memory_order_relaxed ) < req_Operation ))
+                {
+                    next_record();
+                }
+            }
+            //@endcond
+
+        public:
+            /// Initializes an empty iterator object
+            iterator()
+                : m_pRec( nullptr )
+                , m_pKernel( nullptr )
+                , m_nWord( c_nBitmapSize )
+                , m_nBits( 0 )
+            {}
+
+            /// Copy ctor
+            iterator( iterator const& src )
+                : m_pRec( src.m_pRec )
+                , m_pKernel( src.m_pKernel )
+                , m_nWord( src.m_nWord )
+                , m_nBits( src.m_nBits )
+            {}
+
+            /// Pre-increment
+            iterator& operator++()
+            {
+                assert( m_pRec );
+                next_record();
+                skip_inactive();
+                return *this;
+            }
+
+            /// Post-increment
+            iterator operator++(int)
+            {
+                assert( m_pRec );
+                iterator it(*this);
+                ++(*this);
+                return it;
+            }
+
+            /// Dereference operator, can return \p nullptr
+            publication_record_type* operator ->()
+            {
+                return m_pRec;
+            }
+
+            /// Dereference operator, the iterator should not be an end iterator
+            publication_record_type& operator*()
+            {
+                assert( m_pRec );
+                return *m_pRec;
+            }
+
+            /// Iterator equality
+            friend bool operator==( iterator it1, iterator it2 )
+            {
+                return it1.m_pRec == it2.m_pRec;
+            }
+
+            /// Iterator inequality
+            friend bool operator!=( iterator it1, iterator it2 )
+            {
+                return !( it1 == it2 );
+            }
+        };
+
+        /// Returns an iterator to the first active publication record
+        iterator begin()    { return iterator( *this ); }
+
+        /// Returns an iterator to the end of publication records. Should not be dereferenced.
+        iterator end()      { return iterator(); }
+
+    public:
+        /// Gets current value of \p rec.nRequest
+        /**
+            This function is intended for invoking from a wait strategy
+        */
+        int get_operation( publication_record& rec )
+        {
+            return rec.op( memory_model::memory_order_acquire );
+        }
+
+        /// Wakes up any waiting thread
+        /**
+            This function is intended for invoking from a wait strategy
+        */
+        void wakeup_any()
+        {
+            iterator it = begin();
+            if ( it != end())
+                m_waitStrategy.notify( *this, *it );
+        }
+
+    private:
+        //@cond
+        static slot_type * alloc_slots()
+        {
+            slot_type * pSlots = reinterpret_cast<slot_type *>( cds::OS::aligned_malloc( sizeof( slot_type ) * c_nSlotCount, cds::c_nCacheLineSize ));
+            if ( !pSlots )
+                CDS_THROW_EXCEPTION( std::bad_alloc());
+            for ( unsigned int i = 0; i < c_nSlotCount; ++i )
+                new ( pSlots + i ) slot_type;
+            return pSlots;
+        }
+
+        static void tls_cleanup( publication_record_type* pRec )
+        {
+            // Thread done
+            // The slot (or the overflow record) of the thread can be reused by another thread
+            pRec->nState.store( removed, memory_model::memory_order_release );
+        }
+
+        publication_record_type * claim_slot()
+        {
+            // First fit keeps the occupied slots dense at the start of the array
+            for ( unsigned int i = 0; i < c_nSlotCount; ++i ) {
+                publication_record_type& rec = m_arrSlot[i].data;
+                unsigned int nState = rec.nState.load( memory_model::memory_order_acquire );
+                if ( nState != active
+                  && rec.nState.compare_exchange_strong( nState, active, memory_model::memory_order_acquire, atomics::memory_order_relaxed ))
+                {
+                    rec.nAge.store( m_nCount.load( memory_model::memory_order_relaxed ), memory_model::memory_order_relaxed );
+                    if ( nState == inactive ) {
+                        // The slot is used for the first time
+                        m_arrBitmap[i / c_nBitmapWordBits].fetch_or( uint64_t( 1 ) << ( i % c_nBitmapWordBits ), memory_model::memory_order_release );
+                    }
+                    m_Stat.onActivatePubRecord();
+                    return &rec;
+                }
+            }
+            return nullptr;
+        }
+
+        publication_record_type * claim_overflow_record()
+        {
+            // Try to reuse an overflow record of a terminated thread
+            for ( publication_record* p = m_pOverflowHead.load( memory_model::memory_order_acquire ); p; p = p->pNextAllocated.load( memory_model::memory_order_acquire )) {
+                unsigned int nState = removed;
+                if ( p->nState.compare_exchange_strong( nState, active, memory_model::memory_order_acquire, atomics::memory_order_relaxed )) {
+                    m_Stat.onActivatePubRecord();
+                    return static_cast<publication_record_type *>( p );
+                }
+            }
+
+            publication_record_type * pRec = cxx11_allocator().New();
+            pRec->nState.store( active, memory_model::memory_order_relaxed );
+            m_Stat.onCreatePubRecord();
+
+            publication_record_type * pHead = m_pOverflowHead.load( memory_model::memory_order_relaxed );
+            do {
+                pRec->pNextAllocated.store( pHead, memory_model::memory_order_relaxed );
+            } while ( !m_pOverflowHead.compare_exchange_weak( pHead, pRec, memory_model::memory_order_release, atomics::memory_order_relaxed ));
+
+            return pRec;
+        }
+
+        template <class Container>
+        void try_combining( Container& owner, publication_record_type* pRec )
+        {
+            if ( m_Mutex.try_lock() || !wait_for_combining( pRec )) {
+                // The thread becomes a combiner
+                lock_guard l( m_Mutex, std::adopt_lock_t());
+                combining( owner );
+                assert( pRec->op( memory_model::memory_order_relaxed ) == req_Response );
+            }
+        }
+
+        template <class Container>
+        void try_batch_combining( Container& owner, publication_record_type * pRec )
+        {
+            if ( m_Mutex.try_lock() || !wait_for_combining( pRec )) {
+                // The thread becomes a combiner
+                lock_guard l( m_Mutex, std::adopt_lock_t());
+                batch_combining( owner );
+                assert( pRec->op( memory_model::memory_order_relaxed ) == req_Response );
+            }
+        }
+
+        template <class Container>
+        void combining( Container& owner )
+        {
+            // The thread is a combiner
+            assert( !m_Mutex.try_lock());
+
+            unsigned int const nCurAge = m_nCount.fetch_add( 1, memory_model::memory_order_relaxed ) + 1;
+
+            unsigned int nEmptyPassCount = 0;
+            unsigned int nUsefulPassCount = 0;
+            for ( unsigned int nPass = 0; nPass < m_nCombinePassCount; ++nPass ) {
+                if ( combining_pass( owner, nCurAge ))
+                    ++nUsefulPassCount;
+                else if ( ++nEmptyPassCount > nUsefulPassCount )
+                    break;
+            }
+            m_waitStrategy.flush( *this );
+
+            m_Stat.onCombining();
+        }
+
+        template <class Container>
+        bool combining_pass( Container& owner, unsigned int nCurAge )
+        {
+            bool bOpDone = false;
+            for ( unsigned int nWord = 0; nWord < c_nBitmapSize; ++nWord ) {
+                uint64_t nBits = m_arrBitmap[nWord].load( memory_model::memory_order_acquire );
+                while ( nBits ) {
+                    unsigned int const nSlot = nWord * c_nBitmapWordBits + static_cast<unsigned int>( cds::bitop::LSBnz( nBits ));
+                    nBits &= nBits - 1;
+                    bOpDone |= apply_record( owner, m_arrSlot[nSlot].data, nCurAge );
+                }
+            }
+
+            for ( publication_record* p = m_pOverflowHead.load( memory_model::memory_order_acquire ); p; p = p->pNextAllocated.load( memory_model::memory_order_acquire ))
+                bOpDone |= apply_record( owner, *static_cast<publication_record_type *>( p ), nCurAge );
+
+            return bOpDone;
+        }
+
+        template <class Container>
+        bool apply_record( Container& owner, publication_record_type& rec, unsigned int nCurAge )
+        {
+            if ( rec.nState.load( memory_model::memory_order_acquire ) == active
+              && rec.op( memory_model::memory_order_acquire ) >= req_Operation )
+            {
+                rec.nAge.store( nCurAge, memory_model::memory_order_relaxed );
+                owner.fc_apply( &rec );
+                operation_done( rec );
+                return true;
+            }
+            return false;
+        }
+
+        template <class Container>
+        void batch_combining( Container& owner )
+        {
+            // The thread is a combiner
+            assert( !m_Mutex.try_lock());
+
+            unsigned int const nCurAge = m_nCount.fetch_add( 1, memory_model::memory_order_relaxed ) + 1;
+
+            owner.fc_prepare( begin(), end());
+            for ( unsigned int nPass = 0; nPass < m_nCombinePassCount; ++nPass )
+                owner.fc_process( begin(), end());
+
+            combining_pass( owner, nCurAge );
+            m_waitStrategy.flush( *this );
+            m_Stat.onCombining();
+        }
+
+        bool wait_for_combining( publication_record_type* pRec )
+        {
+            m_waitStrategy.prepare( *pRec );
+            m_Stat.onPassiveWait();
+
+            while ( pRec->op( memory_model::memory_order_acquire ) != req_Response ) {
+                m_Stat.onPassiveWaitIteration();
+
+                // Wait while operation processing
+                if ( m_waitStrategy.wait( *this, *pRec ))
+                    m_Stat.onWakeupByNotifying();
+
+                if ( m_Mutex.try_lock()) {
+                    if ( pRec->op( memory_model::memory_order_acquire ) == req_Response ) {
+                        // Operation is done
+                        m_Mutex.unlock();
+
+                        // Wake up a pending threads
+                        m_waitStrategy.wakeup( *this );
+                        m_Stat.onPassiveWaitWakeup();
+
+                        break;
+                    }
+                    // The thread becomes a combiner
+                    m_Stat.onPassiveToCombiner();
+                    return false;
+                }
+            }
+            return true;
+        }
+        //@endcond
+    };
+
+    /// Selects \p slot_array_kernel with \p SlotCount slots for FC-based containers, see \p opt::fc_kernel option
+    template <unsigned int SlotCount = 64>
+    struct slot_kernel
+    {
+        /// Metafunction returning the kernel type
+        template <typename PublicationRecord, typename Traits>
+        struct make_kernel {
+            typedef slot_array_kernel< PublicationRecord, Traits, SlotCount > type;    ///< Metafunction result
+        };
+    };
+
+}}} // namespace cds::algo::flat_combining
+
+#endif // #ifndef CDSLIB_ALGO_FLAT_COMBINING_SLOT_KERNEL_H
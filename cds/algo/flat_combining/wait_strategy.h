@@ -33,6 +33,7 @@
 
 #include <cds/algo/flat_combining/defs.h>
 #include <cds/algo/backoff_strategy.h>
+#include <cds/os/futex.h>
 #include <mutex>
 #include <condition_variable>
 #include <boost/thread/tss.hpp>  // thread_specific_ptr
@@ -152,6 +153,20 @@ namespace cds { namespace algo { namespace flat_combining {
             {
                 CDS_UNUSED( fc );
             }
+
+            /// Completes the notifications of the combining
+            /**
+                The combiner calls \p %flush() at the end of combining while it holds the lock,
+                after all \p notify() calls of the combining.
+                The strategy may defer the notifications and perform them in \p %flush() by batch.
+
+                \p FCKernel is a \p flat_combining::kernel object,
+            */
+            template <typename FCKernel>
+            void flush( FCKernel& fc )
+            {
+                CDS_UNUSED( fc );
+            }
         };
 
         /// Back-off wait strategy
@@ -199,6 +214,11 @@ namespace cds { namespace algo { namespace flat_combining {
             template <typename FCKernel>
             void wakeup( FCKernel& )
             {}
+
+            /// Does nothing
+            template <typename FCKernel>
+            void flush( FCKernel& )
+            {}
         };
 
         /// Wait strategy based on the single mutex and the condition variable
@@ -275,6 +295,11 @@ namespace cds { namespace algo { namespace flat_combining {
                 m_wakeup = true;
                 m_condvar.notify_all();
             }
+
+            /// Does nothing
+            template <typename FCKernel>
+            void flush( FCKernel& /*fc*/ )
+            {}
         };
 
         /// Wait strategy based on the single mutex and thread-local condition variables
@@ -357,6 +382,11 @@ namespace cds { namespace algo { namespace flat_combining {
             {
                 fc.wakeup_any();
             }
+
+            /// Does nothing
+            template <typename FCKernel>
+            void flush( FCKernel& /*fc*/ )
+            {}
         };
 
         /// Wait strategy where each thread has a mutex and a condition variable
@@ -434,6 +464,130 @@ namespace cds { namespace algo { namespace flat_combining {
             {
                 fc.wakeup_any();
             }
+
+            /// Does nothing
+            template <typename FCKernel>
+            void flush( FCKernel& /*fc*/ )
+            {}
+        };
+
+        /// Wait strategy based on futex
+        /**
+            The passive thread parks on the \p nRequest field of its own publication record
+            by \p cds::OS::futex::wait(), so no mutex is acquired on the waiting path.
+            The combiner wakes only the threads that are parked on the records it has processed.
+            The wake-ups are deferred to the end of the combining and issued by batch:
+            the combiner does not make system calls while it applies the requests.
+            The strategy is intended for the systems with more threads than processors.
+
+            Template parameters:
+            - \p Milliseconds - the maximal duration of parking; the minimal value is 1.
+              The parked thread wakes up after the timeout to check if it can become the combiner.
+            - \p BatchSize - maximal number of deferred wake-ups. If the batch is full the combiner flushes it.
+
+            On systems other than Linux the parking degrades to yielding the processor, see \p cds::OS::futex.
+        */
+        template <int Milliseconds = 2, unsigned int BatchSize = 16>
+        class futex
+        {
+        public:
+            enum {
+                c_nWaitMilliseconds = Milliseconds < 1 ? 1 : Milliseconds,  ///< Parking duration
+                c_nBatchSize = BatchSize < 1 ? 1 : BatchSize                ///< Wake-up batch size
+            };
+
+            /// Incorporates a parking flag into \p PublicationRecord
+            template <typename PublicationRecord>
+            struct make_publication_record {
+                /// Metafunction result
+                struct type: public PublicationRecord
+                {
+                    //@cond
+                    atomics::atomic<unsigned int> m_nParked;
+
+                    type()
+                        : m_nParked( 0 )
+                    {}
+                    //@endcond
+                };
+            };
+
+        private:
+            //@cond
+            atomics::atomic<unsigned int> * m_arrWake[c_nBatchSize];   // futex words of parked threads to wake up
+            unsigned int    m_nWakeCount;
+            //@endcond
+
+        public:
+            /// Default ctor
+            futex()
+                : m_nWakeCount( 0 )
+            {}
+
+            /// Does nothing
+            template <typename PublicationRecord>
+            void prepare( PublicationRecord& /*rec*/ )
+            {}
+
+            /// Parks the thread on \p rec.nRequest waiting for notification from combiner
+            template <typename FCKernel, typename PublicationRecord>
+            bool wait( FCKernel& fc, PublicationRecord& rec )
+            {
+                unsigned int const nOp = static_cast<unsigned int>( fc.get_operation( rec ));
+                if ( nOp >= req_Operation ) {
+                    rec.m_nParked.store( 1, atomics::memory_order_relaxed );
+                    // Pairs with the fence in notify(): either the combiner sees the flag or we see the response
+                    atomics::atomic_thread_fence( atomics::memory_order_seq_cst );
+
+                    bool bWoken = false;
+                    if ( static_cast<unsigned int>( fc.get_operation( rec )) == nOp )
+                        bWoken = cds::OS::futex::wait( rec.nRequest, nOp, c_nWaitMilliseconds );
+
+                    rec.m_nParked.store( 0, atomics::memory_order_relaxed );
+                    return bWoken;
+                }
+                return false;
+            }
+
+            /// Puts \p rec into the wake-up batch if its thread is parked
+            /**
+                The function is called by the combiner only.
+            */
+            template <typename FCKernel, typename PublicationRecord>
+            void notify( FCKernel& fc, PublicationRecord& rec )
+            {
+                atomics::atomic_thread_fence( atomics::memory_order_seq_cst );
+                if ( rec.m_nParked.load( atomics::memory_order_relaxed )) {
+                    m_arrWake[m_nWakeCount++] = &rec.nRequest;
+                    if ( m_nWakeCount == c_nBatchSize )
+                        flush( fc );
+                }
+            }
+
+            /// Wakes up the first parked thread having a pending request
+            /**
+                Unlike the condition variable strategies the function does not call \p fc.wakeup_any()
+                since \p notify() is reserved for the combiner.
+            */
+            template <typename FCKernel>
+            void wakeup( FCKernel& fc )
+            {
+                for ( auto it = fc.begin(), itEnd = fc.end(); it != itEnd; ++it ) {
+                    if ( it->m_nParked.load( atomics::memory_order_relaxed )) {
+                        cds::OS::futex::wake( it->nRequest );
+                        break;
+                    }
+                }
+            }
+
+            /// Wakes up the parked threads collected by \p notify()
+            template <typename FCKernel>
+            void flush( FCKernel& /*fc*/ )
+            {
+                for ( unsigned int i = 0; i < m_nWakeCount; ++i )
+                    cds::OS::futex::wake( *m_arrWake[i] );
+                m_nWakeCount = 0;
+            }
         };
 
     } // namespace wait_strategy
@@ -57,7 +57,8 @@ namespace cds { namespace container {
             counter_type    m_nFailedPopFront;  ///< Count of failed pop_front operations (pop from empty deque)
             counter_type    m_nPopBack       ;  ///< Count of success pop_back operations
             counter_type    m_nFailedPopBack ;  ///< Count of failed pop_back operations (pop from empty deque)
-            counter_type    m_nCollided      ;  ///< How many pairs of push/pop were collided, if elimination is enabled
+            counter_type    m_nCollided      ;  ///< How many pairs of push/pop were eliminated, if elimination is enabled
+            counter_type    m_nEliminationPass;  ///< How many batch passes eliminated at least one pair
 
             //@cond
             void    onPushFront()             { ++m_nPushFront; }
@@ -67,6 +68,7 @@ namespace cds { namespace container {
             void    onPopFront( bool bFailed ) { if ( bFailed ) ++m_nFailedPopFront; else ++m_nPopFront;  }
             void    onPopBack( bool bFailed ) { if ( bFailed ) ++m_nFailedPopBack; else ++m_nPopBack;  }
             void    onCollide()               { ++m_nCollided; }
+            void    onEliminationPass()       { ++m_nEliminationPass; }
             //@endcond
         };
 
@@ -81,6 +83,7 @@ namespace cds { namespace container {
             void    onPopFront(bool)    {}
             void    onPopBack(bool)     {}
             void    onCollide()         {}
+            void    onEliminationPass() {}
             //@endcond
         };
 
@@ -97,8 +100,10 @@ namespace cds { namespace container {
             - any \p cds::algo::flat_combining::make_traits options
             - \p opt::stat - internal statistics, possible type: \ref stat, \ref empty_stat (the default)
             - \p opt::enable_elimination - enable/disable operation \ref cds_elimination_description "elimination"
-                By default, the elimination is disabled. For queue, the elimination is possible if the queue
-                is empty.
+                By default, the elimination is disabled. In batch mode the combiner matches push and pop requests
+                of the same end in pairs; if the deque is empty, push and pop of opposite ends are matched too.
+                The same-end pairs are matched by \p FCDeque::fc_prepare() that does not need the deque,
+                so with \p cds::algo::flat_combining::parallel_kernel the combining groups eliminate them in parallel.
         */
         template <typename... Options>
         struct make_traits {
@@ -159,6 +164,9 @@ namespace cds { namespace container {
             op_clear                ///< Clear
         };
 
+        /// Maximal number of unmatched records for each end kept by one elimination pass
+        static constexpr const unsigned int c_nEliminationBatchSize = 64;
+
         /// Flat combining publication list record
         struct fc_record: public cds::algo::flat_combining::publication_record
         {
@@ -167,11 +175,12 @@ namespace cds { namespace container {
                 value_type *        pValPop;  ///< Pop destination
             };
             bool            bEmpty; ///< \p true if the deque is empty
+            bool            bPrepared = false; ///< \p true if the record has been eliminated by \p fc_prepare()
         };
         //@endcond
 
         /// Flat combining kernel
-        typedef cds::algo::flat_combining::kernel< fc_record, traits > fc_kernel;
+        typedef typename traits::fc_kernel::template make_kernel< fc_record, traits >::type fc_kernel;
 
     protected:
         //@cond
@@ -413,6 +422,12 @@ namespace cds { namespace container {
         {
             assert( pRec );
 
+            if ( pRec->bPrepared ) {
+                // The record has been eliminated by fc_prepare()
+                clear_prepared( *pRec );
+                return;
+            }
+
             switch ( pRec->op()) {
             case op_push_front:
                 assert( pRec->pValPush );
@@ -456,149 +471,156 @@ namespace cds { namespace container {
             }
         }
 
+        /// Batch preparation: eliminates push/pop pairs of the same end
+        /**
+            The function is called by the combiner before it locks the deque.
+            A push and a pop at the same end can be eliminated regardless of the deque state,
+            so the function transfers the values without access to the deque.
+            The eliminated records are completed by \p fc_process() under the lock.
+        */
+        void fc_prepare( typename fc_kernel::iterator itBegin, typename fc_kernel::iterator itEnd )
+        {
+            typedef typename fc_kernel::iterator fc_iterator;
+
+            // Unmatched records for each end: either all are pushes or all are pops
+            fc_record * arrPending[2][c_nEliminationBatchSize];
+            unsigned int nPending[2] = { 0, 0 };
+            bool bPendingPop[2] = { false, false };
+
+            for ( fc_iterator it = itBegin; it != itEnd; ++it ) {
+                unsigned int nEnd;
+                bool bPop;
+                if ( it->bPrepared || !classify( it->op( atomics::memory_order_acquire ), nEnd, bPop ))
+                    continue;
+
+                if ( nPending[nEnd] && bPendingPop[nEnd] != bPop ) {
+                    fc_record& rec = *arrPending[nEnd][--nPending[nEnd]];
+                    if ( bPop )
+                        transfer( rec, *it );
+                    else
+                        transfer( *it, rec );
+                    rec.bPrepared = true;
+                    it->bPrepared = true;
+                }
+                else if ( nPending[nEnd] < c_nEliminationBatchSize ) {
+                    arrPending[nEnd][nPending[nEnd]++] = &*it;
+                    bPendingPop[nEnd] = bPop;
+                }
+            }
+        }
+
         /// Batch-processing flat combining
         void fc_process( typename fc_kernel::iterator itBegin, typename fc_kernel::iterator itEnd )
         {
             typedef typename fc_kernel::iterator fc_iterator;
 
-            for ( fc_iterator it = itBegin, itPrev = itEnd; it != itEnd; ++it ) {
-                switch ( it->op( atomics::memory_order_acquire )) {
-                case op_push_front:
-                    if ( itPrev != itEnd
-                        && (itPrev->op() == op_pop_front || (m_Deque.empty() && itPrev->op() == op_pop_back)))
-                    {
-                        collide( *it, *itPrev );
-                        itPrev = itEnd;
-                    }
-                    else
-                        itPrev = it;
-                    break;
-                case op_push_front_move:
-                    if ( itPrev != itEnd
-                      && (itPrev->op() == op_pop_front || ( m_Deque.empty() && itPrev->op() == op_pop_back )))
-                    {
-                        collide_move( *it, *itPrev );
-                        itPrev = itEnd;
-                    }
-                    else
-                        itPrev = it;
-                    break;
-                case op_push_back:
-                    if ( itPrev != itEnd
-                        && (itPrev->op() == op_pop_back || (m_Deque.empty() && itPrev->op() == op_pop_front)))
-                    {
-                        collide( *it, *itPrev );
-                        itPrev = itEnd;
-                    }
-                    else
-                        itPrev = it;
-                    break;
-                case op_push_back_move:
-                    if ( itPrev != itEnd
-                        && (itPrev->op() == op_pop_back || ( m_Deque.empty() && itPrev->op() == op_pop_front )))
-                    {
-                        collide_move( *it, *itPrev );
-                        itPrev = itEnd;
-                    }
-                    else
-                        itPrev = it;
-                    break;
-                case op_pop_front:
-                    if ( itPrev != itEnd ) {
-                        if ( m_Deque.empty()) {
-                            switch ( itPrev->op()) {
-                            case op_push_back:
-                                collide( *itPrev, *it );
-                                itPrev = itEnd;
-                                break;
-                            case op_push_back_move:
-                                collide_move( *itPrev, *it );
-                                itPrev = itEnd;
-                                break;
-                            default:
-                                itPrev = it;
-                                break;
-                            }
-                        }
-                        else {
-                            switch ( itPrev->op()) {
-                            case op_push_front:
-                                collide( *itPrev, *it );
-                                itPrev = itEnd;
-                                break;
-                            case op_push_front_move:
-                                collide_move( *itPrev, *it );
-                                itPrev = itEnd;
-                                break;
-                            default:
-                                itPrev = it;
-                                break;
-                            }
-                        }
-                    }
-                    else
-                        itPrev = it;
-                    break;
-                case op_pop_back:
-                    if ( itPrev != itEnd ) {
-                        if ( m_Deque.empty()) {
-                            switch ( itPrev->op()) {
-                            case op_push_front:
-                                collide( *itPrev, *it );
-                                itPrev = itEnd;
-                                break;
-                            case op_push_front_move:
-                                collide_move( *itPrev, *it );
-                                itPrev = itEnd;
-                                break;
-                            default:
-                                itPrev = it;
-                                break;
-                            }
-                        }
-                        else {
-                            switch ( itPrev->op()) {
-                            case op_push_back:
-                                collide( *itPrev, *it );
-                                itPrev = itEnd;
-                                break;
-                            case op_push_back_move:
-                                collide_move( *itPrev, *it );
-                                itPrev = itEnd;
-                                break;
-                            default:
-                                itPrev = it;
-                                break;
-                            }
+            // A push and a pop at the same end can always be eliminated.
+            // A push and a pop at opposite ends can be eliminated if the deque is empty.
+            // The deque is not changed inside fc_process(), so the emptiness is checked once per pass
+            bool const bEmpty = m_Deque.empty();
+
+            // Unmatched records of the pass for each end: either all are pushes or all are pops
+            fc_record * arrPending[2][c_nEliminationBatchSize];
+            unsigned int nPending[2] = { 0, 0 };
+            bool bPendingPop[2] = { false, false };
+            bool bCollided = false;
+
+            for ( fc_iterator it = itBegin; it != itEnd; ++it ) {
+                unsigned int nEnd;
+                bool bPop;
+                if ( !classify( it->op( atomics::memory_order_acquire ), nEnd, bPop ))
+                    continue;
+
+                if ( it->bPrepared ) {
+                    clear_prepared( *it );
+                    m_FlatCombining.operation_done( *it );
+                    bCollided = true;
+                    continue;
+                }
+
+                unsigned int nMatchEnd = nEnd;
+                if ( !nPending[nEnd] || bPendingPop[nEnd] == bPop ) {
+                    nMatchEnd = 1 - nEnd;
+                    if ( !bEmpty || !nPending[nMatchEnd] || bPendingPop[nMatchEnd] == bPop ) {
+                        // No pair for the record
+                        if ( nPending[nEnd] < c_nEliminationBatchSize ) {
+                            arrPending[nEnd][nPending[nEnd]++] = &*it;
+                            bPendingPop[nEnd] = bPop;
                         }
+                        continue;
                     }
-                    else
-                        itPrev = it;
-                    break;
                 }
+
+                fc_record& rec = *arrPending[nMatchEnd][--nPending[nMatchEnd]];
+                if ( bPop )
+                    collide( rec, *it );
+                else
+                    collide( *it, rec );
+                bCollided = true;
             }
+
+            if ( bCollided )
+                m_FlatCombining.internal_statistics().onEliminationPass();
         }
         //@endcond
 
     private:
         //@cond
-        void collide( fc_record& recPush, fc_record& recPop )
+        // Returns the end (0 - front, 1 - back) and the kind of push/pop operation
+        static bool classify( unsigned int nOp, unsigned int& nEnd, bool& bPop )
         {
-            *(recPop.pValPop) = *(recPush.pValPush);
-            recPop.bEmpty = false;
-            m_FlatCombining.operation_done( recPush );
-            m_FlatCombining.operation_done( recPop );
-            m_FlatCombining.internal_statistics().onCollide();
+            switch ( nOp ) {
+            case op_push_front:
+            case op_push_front_move:
+                nEnd = 0;
+                bPop = false;
+                return true;
+            case op_push_back:
+            case op_push_back_move:
+                nEnd = 1;
+                bPop = false;
+                return true;
+            case op_pop_front:
+                nEnd = 0;
+                bPop = true;
+                return true;
+            case op_pop_back:
+                nEnd = 1;
+                bPop = true;
+                return true;
+            default:
+                return false;
+            }
         }
 
-        void collide_move( fc_record& recPush, fc_record& recPop )
+        void transfer( fc_record& recPush, fc_record& recPop )
         {
-            *(recPop.pValPop) = std::move( *(recPush.pValPush));
+            switch ( recPush.op()) {
+            case op_push_front_move:
+            case op_push_back_move:
+                *(recPop.pValPop) = std::move( *(recPush.pValPush));
+                break;
+            default:
+                *(recPop.pValPop) = *(recPush.pValPush);
+                break;
+            }
             recPop.bEmpty = false;
+        }
+
+        void collide( fc_record& recPush, fc_record& recPop )
+        {
+            transfer( recPush, recPop );
             m_FlatCombining.operation_done( recPush );
             m_FlatCombining.operation_done( recPop );
             m_FlatCombining.internal_statistics().onCollide();
         }
+
+        void clear_prepared( fc_record& rec )
+        {
+            rec.bPrepared = false;
+            if ( rec.op() == op_pop_front || rec.op() == op_pop_back )
+                m_FlatCombining.internal_statistics().onCollide();
+        }
         //@endcond
     };
 
@@ -34,6 +34,7 @@
 #include <cds/algo/flat_combining.h>
 #include <cds/algo/elimination_opt.h>
 #include <queue>
+#include <algorithm>    // std::sort
 
 namespace cds { namespace container {
 
@@ -53,11 +54,13 @@ namespace cds { namespace container {
             counter_type    m_nPushMove ;  ///< Count of push operations with move semantics
             counter_type    m_nPop      ;  ///< Count of success pop operations
             counter_type    m_nFailedPop;  ///< Count of failed pop operations (pop from empty queue)
+            counter_type    m_nCollided ;  ///< How many pops received the value of a pending push directly, if elimination is enabled
 
             //@cond
             void    onPush()             { ++m_nPush; }
             void    onPushMove()         { ++m_nPushMove; }
             void    onPop( bool bFailed ) { if ( bFailed ) ++m_nFailedPop; else ++m_nPop;  }
+            void    onCollide()          { ++m_nCollided; }
             //@endcond
         };
 
@@ -68,6 +71,7 @@ namespace cds { namespace container {
             void    onPush()       {}
             void    onPushMove()   {}
             void    onPop(bool)    {}
+            void    onCollide()    {}
             //@endcond
         };
 
@@ -75,6 +79,7 @@ namespace cds { namespace container {
         struct traits: public cds::algo::flat_combining::traits
         {
             typedef empty_stat      stat;   ///< Internal statistics
+            static constexpr const bool enable_elimination = false; ///< Enable \ref cds_elimination_description "elimination"
         };
 
         /// Metafunction converting option list to traits
@@ -82,6 +87,13 @@ namespace cds { namespace container {
             \p Options are:
             - any \p cds::algo::flat_combining::make_traits options
             - \p opt::stat - internal statistics, possible type: \p fcpqueue::stat, \p fcpqueue::empty_stat (the default)
+            - \p opt::enable_elimination - enable/disable operation \ref cds_elimination_description "elimination"
+                By default, the elimination is disabled. If enabled, the combiner sorts the pending pushes of its batch
+                by priority and hands a pushed value directly to a pending pop when the value is not less
+                than the top of the queue. \p PriorityQueue should define \p value_compare type
+                as \p std::priority_queue does. The combiner cannot get the comparator of the queue object
+                (\p std::priority_queue keeps it protected), so it default-constructs \p value_compare:
+                the comparator must be default-constructible and must not have a state.
         */
         template <typename... Options>
         struct make_traits {
@@ -110,6 +122,13 @@ namespace cds { namespace container {
         - \p PriorityQueue - sequential priority queue implementation, default is \p std::priority_queue<T>
         - \p Traits - type traits of flat combining, default is \p fcpqueue::traits.
             \p fcpqueue::make_traits metafunction can be used to construct specialized \p %fcpqueue::traits
+
+        With \p fcpqueue::traits::enable_elimination the queue works in batch mode. The batch is prepared
+        by \p fc_prepare() before the combiner locks the queue: the pushes are sorted by priority
+        and linked to a run after the pops of the batch. Under the lock the run is merged with the heap:
+        each pop takes either the head of the run or the top of the heap, and the rest of the run is pushed.
+        The preparation is done outside of the global lock if the kernel is \p cds::algo::flat_combining::parallel_kernel,
+        so several combining groups sort their batches in parallel.
     */
     template <typename T,
         class PriorityQueue = std::priority_queue<T>,
@@ -126,6 +145,7 @@ namespace cds { namespace container {
         typedef Traits          traits;              ///< Priority queue type traits
 
         typedef typename traits::stat  stat;    ///< Internal statistics type
+        static constexpr const bool c_bEliminationEnabled = traits::enable_elimination; ///< \p true if elimination is enabled
 
     protected:
         //@cond
@@ -145,11 +165,16 @@ namespace cds { namespace container {
                 value_type *        pValPop;  // Pop destination
             };
             bool            bEmpty; // true if the queue is empty
+            bool            bBatchHead = false; // the record is the head of the prepared batch
+            fc_record *     pNextBatch;         // next record of the prepared batch
         };
+
+        // Maximal number of pushes sorted by one fc_prepare() call
+        static constexpr const unsigned int c_nBatchSize = 64;
         //@endcond
 
         /// Flat combining kernel
-        typedef cds::algo::flat_combining::kernel< fc_record, traits > fc_kernel;
+        typedef typename traits::fc_kernel::template make_kernel< fc_record, traits >::type fc_kernel;
 
     protected:
         //@cond
@@ -181,7 +206,10 @@ namespace cds { namespace container {
             auto pRec = m_FlatCombining.acquire_record();
             pRec->pValPush = &val;
 
-            m_FlatCombining.combine( op_push, pRec, *this );
+            constexpr_if ( c_bEliminationEnabled )
+                m_FlatCombining.batch_combine( op_push, pRec, *this );
+            else
+                m_FlatCombining.combine( op_push, pRec, *this );
 
             assert( pRec->is_done());
             m_FlatCombining.release_record( pRec );
@@ -200,7 +228,10 @@ namespace cds { namespace container {
             auto pRec = m_FlatCombining.acquire_record();
             pRec->pValPush = &val;
 
-            m_FlatCombining.combine( op_push_move, pRec, *this );
+            constexpr_if ( c_bEliminationEnabled )
+                m_FlatCombining.batch_combine( op_push_move, pRec, *this );
+            else
+                m_FlatCombining.combine( op_push_move, pRec, *this );
 
             assert( pRec->is_done());
             m_FlatCombining.release_record( pRec );
@@ -220,7 +251,10 @@ namespace cds { namespace container {
             auto pRec = m_FlatCombining.acquire_record();
             pRec->pValPop = &val;
 
-            m_FlatCombining.combine( op_pop, pRec, *this );
+            constexpr_if ( c_bEliminationEnabled )
+                m_FlatCombining.batch_combine( op_pop, pRec, *this );
+            else
+                m_FlatCombining.combine( op_pop, pRec, *this );
 
             assert( pRec->is_done());
             m_FlatCombining.release_record( pRec );
@@ -265,7 +299,10 @@ namespace cds { namespace container {
         {
             auto pRec = m_FlatCombining.acquire_record();
 
-           m_FlatCombining.combine( op_clear, pRec, *this );
+            constexpr_if ( c_bEliminationEnabled )
+                m_FlatCombining.batch_combine( op_clear, pRec, *this );
+            else
+                m_FlatCombining.combine( op_clear, pRec, *this );
 
             assert( pRec->is_done());
             m_FlatCombining.release_record( pRec );
@@ -311,6 +348,9 @@ namespace cds { namespace container {
         {
             assert( pRec );
 
+            // The prepared batch has not been processed, apply the record alone
+            pRec->bBatchHead = false;
+
             // this function is called under FC mutex, so switch TSan off
             //CDS_TSAN_ANNOTATE_IGNORE_RW_BEGIN;
 
@@ -321,7 +361,7 @@ namespace cds { namespace container {
                 break;
             case op_push_move:
                 assert( pRec->pValPush );
-                m_PQueue.push( std::move( *(pRec->pValPush )));
+                m_PQueue.push( std::move( moved_value( pRec )));
                 break;
             case op_pop:
                 assert( pRec->pValPop );
@@ -342,6 +382,135 @@ namespace cds { namespace container {
 
             //CDS_TSAN_ANNOTATE_IGNORE_RW_END;
         }
+
+        /*
+            Batch preparation, elimination mode only.
+            The function is called by the combiner before it locks the queue.
+            It sorts the pushes by priority and links the batch: the pops first, then the sorted pushes.
+            The queue itself is not accessed.
+        */
+        template <typename Iterator>
+        void fc_prepare( Iterator itBegin, Iterator itEnd )
+        {
+            fc_record * arrPush[c_nBatchSize];
+            unsigned int nPush = 0;
+            fc_record * pPopHead = nullptr;
+            fc_record * pPopTail = nullptr;
+
+            for ( Iterator it = itBegin; it != itEnd; ++it ) {
+                switch ( it->op( atomics::memory_order_acquire )) {
+                case op_push:
+                case op_push_move:
+                    if ( nPush < c_nBatchSize )
+                        arrPush[nPush++] = &*it;
+                    break;
+                case op_pop:
+                    it->pNextBatch = nullptr;
+                    if ( pPopTail )
+                        pPopTail->pNextBatch = &*it;
+                    else
+                        pPopHead = &*it;
+                    pPopTail = &*it;
+                    break;
+                default:
+                    break;
+                }
+            }
+
+            // Highest priority first
+            typedef typename priority_queue_type::value_compare value_compare;
+            static_assert( std::is_default_constructible<value_compare>::value, "FCPriorityQueue with elimination requires default-constructible value_compare" );
+            value_compare cmp;
+            std::sort( arrPush, arrPush + nPush, [&cmp]( fc_record const* p1, fc_record const* p2 ) {
+                return cmp( *p2->pValPush, *p1->pValPush );
+            });
+
+            fc_record * pPushHead = nullptr;
+            for ( unsigned int i = nPush; i > 0; --i ) {
+                arrPush[i - 1]->pNextBatch = pPushHead;
+                pPushHead = arrPush[i - 1];
+            }
+
+            fc_record * pHead = pPushHead;
+            if ( pPopTail ) {
+                pPopTail->pNextBatch = pPushHead;
+                pHead = pPopHead;
+            }
+            if ( pHead )
+                pHead->bBatchHead = true;
+        }
+
+        /*
+            Batch processing, elimination mode only.
+            Merges the prepared run of pushes with the queue.
+        */
+        template <typename Iterator>
+        void fc_process( Iterator itBegin, Iterator itEnd )
+        {
+            for ( Iterator it = itBegin; it != itEnd; ++it ) {
+                if ( it->bBatchHead && it->op( atomics::memory_order_acquire ) >= cds::algo::flat_combining::req_Operation ) {
+                    it->bBatchHead = false;
+                    apply_batch( &*it );
+                }
+            }
+        }
+        //@endcond
+
+    private:
+        //@cond
+        // The value of op_push_move has been passed as rvalue reference by push( value_type&& )
+        static value_type& moved_value( fc_record * pRec )
+        {
+            assert( pRec->op() == op_push_move );
+            return *const_cast<value_type *>( pRec->pValPush );
+        }
+
+        void apply_batch( fc_record * pRec )
+        {
+            // Find the run of pushes
+            fc_record * pRun = pRec;
+            while ( pRun && pRun->op() == op_pop )
+                pRun = pRun->pNextBatch;
+
+            typename priority_queue_type::value_compare cmp;
+            fc_record * pPush = pRun;
+            while ( pRec != pRun ) {
+                fc_record * pNext = pRec->pNextBatch;
+
+                if ( pPush && ( m_PQueue.empty() || !cmp( *(pPush->pValPush), m_PQueue.top()))) {
+                    // The pending push has the highest priority, give the value to the pop directly
+                    fc_record * pNextPush = pPush->pNextBatch;
+                    if ( pPush->op() == op_push_move )
+                        *(pRec->pValPop) = std::move( moved_value( pPush ));
+                    else
+                        *(pRec->pValPop) = *(pPush->pValPush);
+                    pRec->bEmpty = false;
+                    m_FlatCombining.operation_done( *pPush );
+                    m_FlatCombining.internal_statistics().onCollide();
+                    pPush = pNextPush;
+                }
+                else {
+                    pRec->bEmpty = m_PQueue.empty();
+                    if ( !pRec->bEmpty ) {
+                        *(pRec->pValPop) = std::move( m_PQueue.top());
+                        m_PQueue.pop();
+                    }
+                }
+                m_FlatCombining.operation_done( *pRec );
+                pRec = pNext;
+            }
+
+            // The rest of the run
+            while ( pPush ) {
+                fc_record * pNext = pPush->pNextBatch;
+                if ( pPush->op() == op_push_move )
+                    m_PQueue.push( std::move( moved_value( pPush )));
+                else
+                    m_PQueue.push( *(pPush->pValPush));
+                m_FlatCombining.operation_done( *pPush );
+                pPush = pNext;
+            }
+        }
         //@endcond
     };
 
@@ -53,13 +53,21 @@ namespace cds { namespace container {
             counter_type    m_nEnqMove     ;   ///< Count of enqueue operations with move semantics
             counter_type    m_nDequeue     ;   ///< Count of success dequeue operations
             counter_type    m_nFailedDeq   ;   ///< Count of failed dequeue operations (pop from empty queue)
-            counter_type    m_nCollided    ;   ///< How many pairs of enqueue/dequeue were collided, if elimination is enabled
+            counter_type    m_nCollided    ;   ///< How many pairs of enqueue/dequeue were eliminated, if elimination is enabled
+            counter_type    m_nEliminationPass; ///< How many batch passes eliminated at least one pair
+
+            /// Returns average count of pairs eliminated by a batch pass: <tt>m_nCollided / m_nEliminationPass</tt>
+            double elimination_factor() const
+            {
+                return m_nEliminationPass.get() ? double( m_nCollided.get()) / m_nEliminationPass.get() : 0.0;
+            }
 
             //@cond
             void    onEnqueue()               { ++m_nEnqueue; }
             void    onEnqMove()               { ++m_nEnqMove; }
             void    onDequeue( bool bFailed ) { if ( bFailed ) ++m_nFailedDeq; else ++m_nDequeue;  }
             void    onCollide()               { ++m_nCollided; }
+            void    onEliminationPass()       { ++m_nEliminationPass; }
             //@endcond
         };
 
@@ -71,6 +79,7 @@ namespace cds { namespace container {
             void    onEnqMove()     {}
             void    onDequeue(bool) {}
             void    onCollide()     {}
+            void    onEliminationPass() {}
             //@endcond
         };
 
@@ -88,7 +97,8 @@ namespace cds { namespace container {
             - \p opt::stat - internal statistics, possible type: \p fcqueue::stat, \p fcqueue::empty_stat (the default)
             - \p opt::enable_elimination - enable/disable operation \ref cds_elimination_description "elimination"
                 By default, the elimination is disabled. For queue, the elimination is possible if the queue
-                is empty.
+                is empty: in batch mode the combiner matches the enqueue and dequeue requests of the publication list
+                in pairs, each dequeue receives the value of its enqueue without touching the queue.
         */
         template <typename... Options>
         struct make_traits {
@@ -145,6 +155,9 @@ namespace cds { namespace container {
             op_clear        ///< Clear
         };
 
+        /// Maximal number of unmatched records kept by one elimination pass
+        static constexpr const unsigned int c_nEliminationBatchSize = 64;
+
         /// Flat combining publication list record
         struct fc_record: public cds::algo::flat_combining::publication_record
         {
@@ -157,7 +170,7 @@ namespace cds { namespace container {
         //@endcond
 
         /// Flat combining kernel
-        typedef cds::algo::flat_combining::kernel< fc_record, traits > fc_kernel;
+        typedef typename traits::fc_kernel::template make_kernel< fc_record, traits >::type fc_kernel;
 
     protected:
         //@cond
@@ -379,60 +392,66 @@ namespace cds { namespace container {
         {
             typedef typename fc_kernel::iterator fc_iterator;
 
-            for ( fc_iterator it = itBegin, itPrev = itEnd; it != itEnd; ++it ) {
+            // Elimination is possible only if the queue is empty.
+            // The queue is not changed inside fc_process(), so the check is made once per pass
+            if ( !m_Queue.empty())
+                return;
+
+            // Unmatched records of the pass: either all are enqueues or all are dequeues
+            fc_record * arrPending[c_nEliminationBatchSize];
+            unsigned int nPending = 0;
+            bool bPendingDeq = false;
+            bool bCollided = false;
+
+            for ( fc_iterator it = itBegin; it != itEnd; ++it ) {
+                bool bDeq;
                 switch ( it->op( atomics::memory_order_acquire )) {
                 case op_enq:
                 case op_enq_move:
+                    bDeq = false;
+                    break;
                 case op_deq:
-                    if ( m_Queue.empty()) {
-                        if ( itPrev != itEnd && collide( *itPrev, *it ))
-                            itPrev = itEnd;
-                        else
-                            itPrev = it;
-                    }
+                    bDeq = true;
                     break;
+                default:
+                    continue;
+                }
+
+                if ( nPending && bPendingDeq != bDeq ) {
+                    fc_record& rec = *arrPending[--nPending];
+                    if ( bDeq )
+                        collide( rec, *it );
+                    else
+                        collide( *it, rec );
+                    bCollided = true;
+                }
+                else if ( nPending < c_nEliminationBatchSize ) {
+                    arrPending[nPending++] = &*it;
+                    bPendingDeq = bDeq;
                 }
             }
+
+            if ( bCollided )
+                m_FlatCombining.internal_statistics().onEliminationPass();
         }
         //@endcond
 
     private:
         //@cond
-        bool collide( fc_record& rec1, fc_record& rec2 )
+        void collide( fc_record& recEnq, fc_record& recDeq )
         {
-            switch ( rec1.op()) {
-                case op_enq:
-                    if ( rec2.op() == op_deq ) {
-                        assert(rec1.pValEnq);
-                        assert(rec2.pValDeq);
-                        *rec2.pValDeq = *rec1.pValEnq;
-                        rec2.bEmpty = false;
-                        goto collided;
-                    }
-                    break;
-                case op_enq_move:
-                    if ( rec2.op() == op_deq ) {
-                        assert(rec1.pValEnq);
-                        assert(rec2.pValDeq);
-                        *rec2.pValDeq = std::move( *rec1.pValEnq );
-                        rec2.bEmpty = false;
-                        goto collided;
-                    }
-                    break;
-                case op_deq:
-                    switch ( rec2.op()) {
-                    case op_enq:
-                    case op_enq_move:
-                        return collide( rec2, rec1 );
-                    }
-            }
-            return false;
+            assert( recEnq.pValEnq );
+            assert( recDeq.pValDeq );
+
+            if ( recEnq.op() == op_enq_move )
+                *recDeq.pValDeq = std::move( *recEnq.pValEnq );
+            else
+                *recDeq.pValDeq = *recEnq.pValEnq;
+            recDeq.bEmpty = false;
 
-        collided:
-            m_FlatCombining.operation_done( rec1 );
-            m_FlatCombining.operation_done( rec2 );
+            m_FlatCombining.operation_done( recEnq );
+            m_FlatCombining.operation_done( recDeq );
             m_FlatCombining.internal_statistics().onCollide();
-            return true;
         }
         //@endcond
 
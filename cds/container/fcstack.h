@@ -156,7 +156,7 @@ namespace cds { namespace container {
         //@endcond
 
         /// Flat combining kernel
-        typedef cds::algo::flat_combining::kernel< fc_record, traits > fc_kernel;
+        typedef typename traits::fc_kernel::template make_kernel< fc_record, traits >::type fc_kernel;
 
     protected:
         //@cond
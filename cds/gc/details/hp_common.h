@@ -176,6 +176,103 @@ namespace cds { namespace gc { namespace hp { namespace common {
     /// Retired pointer disposer
     typedef void ( *disposer_func )( void* );
 
+    /// Policy applied by \p scan() when the retired budget is exceeded
+    enum retired_budget_policy {
+        budget_help_scan,   ///< the thread scans retired data of the terminated threads and rescans its own retired array
+        budget_throttle,    ///< the retiring thread backs off and rescans until the budget is restored
+        budget_callback     ///< user-provided callback is called
+    };
+
+    /// Callback for \p budget_callback policy
+    /**
+        The first argument is the count of retained retired pointers, the second one is the budget.
+        The callback is called by the scanning thread, it must not retire pointers or call \p scan().
+    */
+    typedef void ( *retired_budget_callback )( size_t nRetained, size_t nBudget );
+
+    /// Global budget of retired pointers
+    /**
+        The budget counts the retired pointers that survived \p scan() because they are guarded
+        (retained pointers). Each thread accounts its retained count after each \p scan() call,
+        so the global counter lags behind the actual value by at most one retired array per thread.
+
+        The limit 0 means "no budget" and it is the default.
+    */
+    class retired_budget
+    {
+    public:
+        retired_budget() noexcept
+            : limit_( 0 )
+            , policy_( budget_help_scan )
+            , callback_( nullptr )
+            , retained_( 0 )
+            , exceeded_count_( 0 )
+        {}
+
+        /// Sets budget parameters
+        /**
+            The function should be called before any thread retires data.
+        */
+        void set( size_t nLimit, retired_budget_policy policy, retired_budget_callback cb ) noexcept
+        {
+            assert( policy != budget_callback || cb != nullptr );
+            policy_ = policy;
+            callback_ = cb;
+            limit_.store( nLimit, atomics::memory_order_release );
+        }
+
+        /// Sets new retained count \p nRetained of a thread; \p thread_retained is the previous value
+        void update( size_t& thread_retained, size_t nRetained ) noexcept
+        {
+            if ( nRetained > thread_retained )
+                retained_.fetch_add( nRetained - thread_retained, atomics::memory_order_relaxed );
+            else if ( nRetained < thread_retained )
+                retained_.fetch_sub( thread_retained - nRetained, atomics::memory_order_relaxed );
+            thread_retained = nRetained;
+        }
+
+        /// Checks if the count of retained pointers is greater than the limit
+        bool exceeded() const noexcept
+        {
+            size_t const nLimit = limit_.load( atomics::memory_order_relaxed );
+            return nLimit != 0 && retained_.load( atomics::memory_order_relaxed ) > nLimit;
+        }
+
+        /// Calls the user callback for \p budget_callback policy and counts the exceeding
+        /**
+            Returns policy to apply.
+        */
+        retired_budget_policy on_exceeded() noexcept
+        {
+            exceeded_count_.fetch_add( 1, atomics::memory_order_relaxed );
+            if ( policy_ == budget_callback )
+                callback_( retained(), limit());
+            return policy_;
+        }
+
+        size_t limit() const noexcept
+        {
+            return limit_.load( atomics::memory_order_relaxed );
+        }
+
+        size_t retained() const noexcept
+        {
+            return retained_.load( atomics::memory_order_relaxed );
+        }
+
+        size_t exceeded_count() const noexcept
+        {
+            return exceeded_count_.load( atomics::memory_order_relaxed );
+        }
+
+    private:
+        atomics::atomic<size_t> limit_;
+        retired_budget_policy   policy_;
+        retired_budget_callback callback_;
+        atomics::atomic<size_t> retained_;
+        atomics::atomic<size_t> exceeded_count_;
+    };
+
 }}}} // namespace cds::gc::hp::common
 //@endcond
 
@@ -0,0 +1,181 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSLIB_GC_DETAILS_HP_HAZARD_SET_H
+#define CDSLIB_GC_DETAILS_HP_HAZARD_SET_H
+
+#include <vector>
+#include <cds/details/defs.h>
+
+#if CDS_BUILD_BITS == 64
+#   if defined( __AVX2__ )
+#       include <immintrin.h>
+#       define CDS_HAZARD_SET_AVX2
+#   elif defined( __SSE2__ ) || defined( _M_X64 )
+#       include <emmintrin.h>
+#       define CDS_HAZARD_SET_SSE2
+#   endif
+#endif
+
+//@cond
+namespace cds { namespace gc { namespace hp { namespace common {
+
+    /// Snapshot of hazard pointers for \p scan()
+    /**
+        Open-addressing hash set of the hazard pointers built once per \p scan() call.
+        The table is split into groups of \p c_group_size slots; a pointer is hashed to a group
+        and placed to the first empty slot of the group or of the next groups (linear probing by groups).
+        Lookup compares all slots of a group at once (SSE2/AVX2 if available), so \p contains()
+        usually costs one cache line access instead of <tt>O(log H)</tt> of binary search over sorted hazards.
+
+        Empty slot is 0, so \p nullptr cannot be inserted.
+
+        Template argument \p Allocator is an allocator of \p uintptr_t for the table.
+    */
+    template <class Allocator>
+    class hazard_set
+    {
+    public:
+        static size_t const c_group_size = 4;   ///< slot count in a group
+
+    public:
+        /// Creates the set that can hold at least \p nCapacity pointers
+        explicit hazard_set( size_t nCapacity )
+            : group_mask_( 0 )
+            , shift_( 0 )
+        {
+            // load factor is not greater than 1/2
+            size_t group_count = 1;
+            unsigned bits = 0;
+            while ( group_count * c_group_size < nCapacity * 2 ) {
+                group_count <<= 1;
+                ++bits;
+            }
+
+            group_mask_ = group_count - 1;
+            shift_ = bits ? static_cast<unsigned>( sizeof( uintptr_t ) * 8 - bits ) : 0;
+            table_.assign( group_count * c_group_size, 0 );
+        }
+
+        /// Inserts hazard pointer \p p, <tt>p != nullptr</tt>
+        void insert( void* p )
+        {
+            assert( p != nullptr );
+            uintptr_t const key = reinterpret_cast<uintptr_t>( p );
+
+            for ( size_t group = hash( key ); ; group = ( group + 1 ) & group_mask_ ) {
+                uintptr_t* slot = table_.data() + group * c_group_size;
+                for ( uintptr_t* end = slot + c_group_size; slot != end; ++slot ) {
+                    if ( *slot == key )
+                        return;
+                    if ( *slot == 0 ) {
+                        *slot = key;
+                        return;
+                    }
+                }
+            }
+        }
+
+        /// Checks whether \p p is in the set
+        bool contains( void const* p ) const
+        {
+            uintptr_t const key = reinterpret_cast<uintptr_t>( p );
+
+            for ( size_t group = hash( key ); ; group = ( group + 1 ) & group_mask_ ) {
+                unsigned match;
+                unsigned empty;
+                probe( table_.data() + group * c_group_size, key, match, empty );
+
+                if ( match )
+                    return true;
+                if ( empty )
+                    return false;
+            }
+        }
+
+    private:
+        size_t hash( uintptr_t key ) const
+        {
+            // Fibonacci hashing: the upper bits of the product are well mixed
+#   if CDS_BUILD_BITS == 64
+            uintptr_t const h = key * static_cast<uintptr_t>( 0x9E3779B97F4A7C15ULL );
+#   else
+            uintptr_t const h = key * static_cast<uintptr_t>( 0x9E3779B9UL );
+#   endif
+            return shift_ ? static_cast<size_t>( h >> shift_ ) : 0;
+        }
+
+        static void probe( uintptr_t const* group, uintptr_t key, unsigned& match, unsigned& empty )
+        {
+#   if defined( CDS_HAZARD_SET_AVX2 )
+            __m256i const slots = _mm256_loadu_si256( reinterpret_cast<__m256i const*>( group ));
+            match = static_cast<unsigned>( _mm256_movemask_epi8( _mm256_cmpeq_epi64( slots, _mm256_set1_epi64x( static_cast<long long>( key )))));
+            empty = static_cast<unsigned>( _mm256_movemask_epi8( _mm256_cmpeq_epi64( slots, _mm256_setzero_si256())));
+#   elif defined( CDS_HAZARD_SET_SSE2 )
+            // SSE2 has no 64bit compare: compare 32bit halves and AND each half with its pair
+            __m128i const k = _mm_set1_epi64x( static_cast<long long>( key ));
+            __m128i const zero = _mm_setzero_si128();
+            __m128i const lo = _mm_loadu_si128( reinterpret_cast<__m128i const*>( group ));
+            __m128i const hi = _mm_loadu_si128( reinterpret_cast<__m128i const*>( group + 2 ));
+
+            __m128i m_lo = _mm_cmpeq_epi32( lo, k );
+            __m128i m_hi = _mm_cmpeq_epi32( hi, k );
+            __m128i e_lo = _mm_cmpeq_epi32( lo, zero );
+            __m128i e_hi = _mm_cmpeq_epi32( hi, zero );
+            m_lo = _mm_and_si128( m_lo, _mm_shuffle_epi32( m_lo, _MM_SHUFFLE( 2, 3, 0, 1 )));
+            m_hi = _mm_and_si128( m_hi, _mm_shuffle_epi32( m_hi, _MM_SHUFFLE( 2, 3, 0, 1 )));
+            e_lo = _mm_and_si128( e_lo, _mm_shuffle_epi32( e_lo, _MM_SHUFFLE( 2, 3, 0, 1 )));
+            e_hi = _mm_and_si128( e_hi, _mm_shuffle_epi32( e_hi, _MM_SHUFFLE( 2, 3, 0, 1 )));
+
+            match = static_cast<unsigned>( _mm_movemask_epi8( _mm_or_si128( m_lo, m_hi )));
+            empty = static_cast<unsigned>( _mm_movemask_epi8( _mm_or_si128( e_lo, e_hi )));
+#   else
+            match = 0;
+            empty = 0;
+            for ( size_t i = 0; i < c_group_size; ++i ) {
+                match |= static_cast<unsigned>( group[i] == key );
+                empty |= static_cast<unsigned>( group[i] == 0 );
+            }
+#   endif
+        }
+
+    private:
+        std::vector< uintptr_t, Allocator > table_;
+        size_t      group_mask_;
+        unsigned    shift_;
+    };
+
+}}}} // namespace cds::gc::hp::common
+//@endcond
+
+#undef CDS_HAZARD_SET_AVX2
+#undef CDS_HAZARD_SET_SSE2
+
+#endif // #ifndef CDSLIB_GC_DETAILS_HP_HAZARD_SET_H
@@ -0,0 +1,195 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSLIB_GC_DETAILS_HP_RECLAIMER_H
+#define CDSLIB_GC_DETAILS_HP_RECLAIMER_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cds/gc/details/hp_common.h>
+
+//@cond
+namespace cds { namespace gc { namespace hp { namespace common {
+
+    /// Background reclamation thread for Hazard Pointer SMR
+    /**
+        The object of this class owns a reclamation thread. A worker thread
+        whose retired array is full hands its content over to the reclamation thread
+        by \p push() call and continues its work with empty retired array.
+        The reclamation thread scans hazard pointers and frees unguarded retired pointers;
+        the guarded ones are kept until the next pass.
+
+        Template arguments:
+        - \p SMR - SMR class. It should provide <tt>size_t reclaim( retired_ptr* first, retired_ptr* last )</tt>
+            member function that frees all unguarded pointers from <tt>[first, last)</tt>,
+            moves the guarded ones to the head of the range and returns their count.
+        - \p Allocator - allocator for internal buffers
+    */
+    template <class SMR, class Allocator>
+    class reclaimer_thread
+    {
+    public:
+        typedef SMR smr_type;   ///< SMR type
+        typedef std::vector< retired_ptr, Allocator > retired_vector; ///< Buffer of retired pointers
+
+    private:
+        typedef std::mutex              mutex_type;
+        typedef std::condition_variable condvar_type;
+        typedef std::unique_lock< mutex_type >  unique_lock;
+
+    public:
+        explicit reclaimer_thread( smr_type& smr )
+            : smr_( smr )
+            , quit_( false )
+            , request_seq_( 0 )
+            , done_seq_( 0 )
+            , pass_count_( 0 )
+            , free_count_( 0 )
+        {
+            thread_ = std::thread( &reclaimer_thread::execute, this );
+        }
+
+        ~reclaimer_thread()
+        {
+            assert( !thread_.joinable());
+        }
+
+        /// Hands retired pointers <tt>[first, last)</tt> over to the reclamation thread
+        void push( retired_ptr const* first, retired_ptr const* last )
+        {
+            {
+                unique_lock lock( mutex_ );
+                incoming_.insert( incoming_.end(), first, last );
+                ++request_seq_;
+            }
+            cv_.notify_one();
+        }
+
+        /// Waits until the reclamation thread makes a pass over all retired pointers handed over before the call
+        void flush()
+        {
+            unique_lock lock( mutex_ );
+            size_t const seq = ++request_seq_;
+            cv_.notify_one();
+
+            while ( done_seq_ < seq )
+                done_cv_.wait( lock );
+        }
+
+        /// Makes the last reclamation pass and terminates the reclamation thread
+        /**
+            After the call \p leftover contains the retired pointers that were guarded in the last pass.
+        */
+        void stop( retired_vector& leftover )
+        {
+            {
+                unique_lock lock( mutex_ );
+                quit_ = true;
+            }
+            cv_.notify_one();
+            thread_.join();
+
+            leftover.swap( pending_ );
+        }
+
+        /// Count of reclamation passes
+        size_t pass_count() const
+        {
+            return pass_count_.load( atomics::memory_order_relaxed );
+        }
+
+        /// Count of retired pointers freed by the reclamation thread
+        size_t free_count() const
+        {
+            return free_count_.load( atomics::memory_order_relaxed );
+        }
+
+    private:
+        void execute()
+        {
+            retired_vector work;
+            bool quit = false;
+
+            while ( !quit ) {
+                size_t seq;
+                {
+                    unique_lock lock( mutex_ );
+                    while ( request_seq_ == done_seq_ && !quit_ )
+                        cv_.wait( lock );
+
+                    work.swap( incoming_ );
+                    seq = request_seq_;
+                    quit = quit_;
+                }
+
+                pending_.insert( pending_.end(), work.begin(), work.end());
+                work.clear();
+
+                if ( !pending_.empty()) {
+                    size_t const nSize = pending_.size();
+                    size_t const nGuarded = smr_.reclaim( pending_.data(), pending_.data() + nSize );
+                    pending_.resize( nGuarded );
+
+                    pass_count_.fetch_add( 1, atomics::memory_order_relaxed );
+                    free_count_.fetch_add( nSize - nGuarded, atomics::memory_order_relaxed );
+                }
+
+                {
+                    unique_lock lock( mutex_ );
+                    done_seq_ = seq;
+                }
+                done_cv_.notify_all();
+            }
+        }
+
+    private:
+        smr_type&       smr_;
+        std::thread     thread_;
+
+        mutex_type      mutex_;
+        condvar_type    cv_;
+        condvar_type    done_cv_;
+        retired_vector  incoming_;  ///< retired pointers handed over by worker threads
+        bool            quit_;
+        size_t          request_seq_;   ///< number of \p push() and \p flush() requests
+        size_t          done_seq_;      ///< number of requests processed by the reclamation thread
+
+        retired_vector  pending_;   ///< retired pointers guarded in the last pass, private to the reclamation thread
+
+        atomics::atomic<size_t> pass_count_;
+        atomics::atomic<size_t> free_count_;
+    };
+
+}}}} // namespace cds::gc::hp::common
+//@endcond
+
+#endif // #ifndef CDSLIB_GC_DETAILS_HP_RECLAIMER_H
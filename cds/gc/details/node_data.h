@@ -0,0 +1,62 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSLIB_GC_DETAILS_NODE_DATA_H
+#define CDSLIB_GC_DETAILS_NODE_DATA_H
+
+//@cond
+namespace cds { namespace gc { namespace details {
+
+    /// GC-specific data of a container node
+    /**
+        The nodes of intrusive containers derive from \p node_data<GC>.
+        For most GCs the data is empty and costs nothing.
+        A GC that needs per-node data specializes the template,
+        for example, \p cds::gc::HE records the birth era of the node.
+
+        The container retires the value \p p owning the node by <tt>pNode->template retire<Disposer>( p )</tt>
+        instead of <tt>gc::template retire<Disposer>( p )</tt>, so the node data is passed to GC
+        both for base and member hooks.
+    */
+    template <typename GC>
+    struct node_data
+    {
+        /// Retires the value \p p that owns the node
+        template <typename Disposer, typename T>
+        void retire( T* p ) const
+        {
+            GC::template retire<Disposer>( p );
+        }
+    };
+
+}}} // namespace cds::gc::details
+//@endcond
+
+#endif // #ifndef CDSLIB_GC_DETAILS_NODE_DATA_H
@@ -31,6 +31,9 @@
 #ifndef CDSLIB_GC_DETAILS_RETIRED_PTR_H
 #define CDSLIB_GC_DETAILS_RETIRED_PTR_H
 
+#include <algorithm>
+#include <functional>
+#include <type_traits>
 #include <cds/details/defs.h>
 #include <cds/details/static_functor.h>
 
@@ -42,6 +45,9 @@ namespace cds { namespace gc {
         /// Pointer to function to free (destruct and deallocate) retired pointer of specific type
         typedef void (* free_retired_ptr_func )( void * );
 
+        /// Pointer to function to free an array of retired pointers of specific type
+        typedef void (* free_retired_batch_func )( void ** arr, size_t count );
+
         /// Retired pointer
         /**
             Pointer to an object that is ready to delete.
@@ -134,12 +140,162 @@ namespace cds { namespace gc {
         {
             return !(p1 == p2);
         }
+
+        /// Registry of batch disposers
+        /**
+            The registry maps the free function of a retired pointer to the batch free function of the same disposer.
+            The entries are added once per disposer type by \p retired_functor, the registry is never cleared.
+            If the registry is full the disposer is used in per-pointer mode.
+        */
+        class batch_disposer_registry
+        {
+        public:
+            /// Adds batch free function \p batch_func for \p func
+            static CDS_EXPORT_API bool add( free_retired_ptr_func func, free_retired_batch_func batch_func );
+
+            /// Returns batch free function for \p func, or \p nullptr
+            static CDS_EXPORT_API free_retired_batch_func find( free_retired_ptr_func func );
+
+            /// Checks if there is no batch disposer registered
+            static CDS_EXPORT_API bool empty();
+        };
+
+        /// Checks if \p Functor has batch <tt>operator()( T** arr, size_t count )</tt>
+        template <class Functor, typename T>
+        struct has_batch_call
+        {
+        private:
+            template <class F>
+            static auto test( int ) -> decltype( std::declval<F&>()( std::declval<T**>(), size_t( 0 )), std::true_type());
+            template <class F>
+            static std::false_type test( ... );
+
+        public:
+            static constexpr bool value = decltype( test<Functor>( 0 ))::value;
+        };
+
+        /// Free function of retired pointer for disposer \p Functor
+        /**
+            If \p Functor has batch <tt>operator()( T** arr, size_t count )</tt> the batch operator
+            is registered in \p batch_disposer_registry, and \p scan() frees the retired pointers
+            of the disposer by the batch call.
+        */
+        template <class Functor, typename T, bool Batch = has_batch_call<Functor, T>::value>
+        struct retired_functor
+        {
+            static free_retired_ptr_func get()
+            {
+                return cds::details::static_functor<Functor, T>::call;
+            }
+        };
+
+        template <class Functor, typename T>
+        struct retired_functor<Functor, T, true>
+        {
+            static void call_batch( void** arr, size_t count )
+            {
+                Functor()( reinterpret_cast<T**>( arr ), count );
+            }
+
+            static free_retired_ptr_func get()
+            {
+                static bool const registered = batch_disposer_registry::add( cds::details::static_functor<Functor, T>::call, call_batch );
+                CDS_UNUSED( registered );
+                return cds::details::static_functor<Functor, T>::call;
+            }
+        };
+
+        /// Frees retired pointers <tt>[first, last)</tt>
+        /**
+            The function groups the retired pointers by free function and calls batch disposer
+            for each group if it is registered in \p batch_disposer_registry.
+            The order of the range may be changed.
+
+            \p RetiredPtr is \p retired_ptr or a class derived from it.
+        */
+        template <typename RetiredPtr>
+        static inline void free_retired( RetiredPtr* first, RetiredPtr* last )
+        {
+            if ( batch_disposer_registry::empty()) {
+                for ( ; first != last; ++first )
+                    first->free();
+                return;
+            }
+
+            auto less_func = []( RetiredPtr const& p1, RetiredPtr const& p2 ) {
+                return std::less<free_retired_ptr_func>()( p1.m_funcFree, p2.m_funcFree );
+            };
+            if ( !std::is_sorted( first, last, less_func ))
+                std::sort( first, last, less_func );
+
+            static size_t const c_nBatchSize = 128;
+            void* batch[c_nBatchSize];
+
+            while ( first != last ) {
+                free_retired_ptr_func const func = first->m_funcFree;
+                RetiredPtr* group_end = first + 1;
+                while ( group_end != last && group_end->m_funcFree == func )
+                    ++group_end;
+
+                free_retired_batch_func const batch_func = batch_disposer_registry::find( func );
+                if ( batch_func ) {
+                    while ( first != group_end ) {
+                        size_t count = 0;
+                        for ( ; first != group_end && count < c_nBatchSize; ++first )
+                            batch[count++] = first->m_p;
+                        batch_func( batch, count );
+                    }
+                }
+                else {
+                    for ( ; first != group_end; ++first )
+                        first->free();
+                }
+            }
+        }
+
+        /// Buffer of retired pointers to be freed by \p free_retired()
+        /**
+            The buffer is used by \p scan() when the retired pointers cannot be freed in place.
+        */
+        template <typename RetiredPtr>
+        class retired_free_buffer
+        {
+        public:
+            retired_free_buffer()
+                : count_( 0 )
+            {}
+
+            ~retired_free_buffer()
+            {
+                flush();
+            }
+
+            /// Adds \p p to the buffer, frees the buffer content if the buffer is full
+            void push( RetiredPtr const& p )
+            {
+                buf_[count_] = p;
+                if ( ++count_ == c_nCapacity )
+                    flush();
+            }
+
+            /// Frees the buffer content
+            void flush()
+            {
+                free_retired( buf_, buf_ + count_ );
+                count_ = 0;
+            }
+
+        private:
+            static size_t const c_nCapacity = 128;
+            RetiredPtr  buf_[c_nCapacity];
+            size_t      count_;
+        };
     }  // namespace details
 
     template <typename Func, typename T>
     static inline cds::gc::details::retired_ptr make_retired_ptr( T * p )
     {
-        return cds::gc::details::retired_ptr( p, cds::details::static_functor<Func, T>::call );
+        return cds::gc::details::retired_ptr( p, cds::gc::details::retired_functor<Func, T>::get());
     }
 
 }}   // namespace cds::gc
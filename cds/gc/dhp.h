@@ -34,12 +34,14 @@
 #include <exception>
 #include <cds/gc/details/hp_common.h>
 #include <cds/details/lib.h>
+#include <cds/sync/spinlock.h>
 #include <cds/threading/model.h>
 #include <cds/intrusive/free_list_selector.h>
 #include <cds/details/throw_exception.h>
 #include <cds/details/static_functor.h>
 #include <cds/details/marked_ptr.h>
 #include <cds/user_setup/cache_line.h>
+#include <cds/os/membarrier.h>
 
 namespace cds { namespace gc {
 
@@ -433,6 +435,7 @@ namespace cds { namespace gc {
             size_t  free_count;         ///< Count of free pointers
             size_t  scan_count;         ///< Count of \p scan() call
             size_t  help_scan_count;    ///< Count of \p help_scan() call
+            size_t  reclaim_count;      ///< Count of reclamation passes of the background reclaimer thread
 
             size_t  thread_rec_count;   ///< Count of thread records
 
@@ -441,6 +444,11 @@ namespace cds { namespace gc {
             size_t  hp_extend_count;        ///< Count of hp array \p extend() call
             size_t  retired_extend_count;   ///< Count of retired array \p extend() call
 
+            size_t  retained_count;         ///< Current count of retired pointers that survived \p scan() (available even if \p CDS_ENABLE_HPSTAT is not defined)
+            size_t  budget_exceeded_count;  ///< Count of retired budget exceeding (available even if \p CDS_ENABLE_HPSTAT is not defined)
+            size_t  thread_list_count;      ///< Current count of records in the thread list scanned by \p scan() (available even if \p CDS_ENABLE_HPSTAT is not defined)
+            size_t  thread_rec_compact_count;   ///< Count of free records unlinked from the thread list (available even if \p CDS_ENABLE_HPSTAT is not defined)
+
                                         /// Default ctor
             stat()
             {
@@ -456,11 +464,16 @@ namespace cds { namespace gc {
                     free_count =
                     scan_count =
                     help_scan_count =
+                    reclaim_count =
                     thread_rec_count =
                     hp_block_count =
                     retired_block_count =
                     hp_extend_count =
-                    retired_extend_count = 0;
+                    retired_extend_count =
+                    retained_count =
+                    budget_exceeded_count =
+                    thread_list_count =
+                    thread_rec_compact_count = 0;
             }
         };
 
@@ -472,8 +485,12 @@ namespace cds { namespace gc {
 
             char pad1_[cds::c_nCacheLineSize];
             atomics::atomic<unsigned int> sync_; ///< dummy var to introduce synchronizes-with relationship between threads
+            bool const asymmetric_fence_;        ///< \p true - \p sync() is a compiler barrier, the scanner issues \p membarrier
             char pad2_[cds::c_nCacheLineSize];
 
+            size_t  retained_count_;    ///< retired pointers survived the last \p scan(), accounted in \p smr::budget_
+            bool    in_budget_policy_;  ///< the thread applies the retired budget policy
+
 #       ifdef CDS_ENABLE_HPSTAT
             size_t              free_call_count_;
             size_t              scan_call_count_;
@@ -482,9 +499,12 @@ namespace cds { namespace gc {
 
             // CppCheck warn: pad1_ and pad2_ is uninitialized in ctor
             // cppcheck-suppress uninitMemberVar
-            thread_data( guard* guards, size_t guard_count )
+            thread_data( guard* guards, size_t guard_count, bool asymmetric_fence )
                 : hazards_( guards, guard_count )
                 , sync_( 0 )
+                , asymmetric_fence_( asymmetric_fence )
+                , retained_count_( 0 )
+                , in_budget_policy_( false )
 #       ifdef CDS_ENABLE_HPSTAT
                 , free_call_count_(0)
                 , scan_call_count_(0)
@@ -498,7 +518,10 @@ namespace cds { namespace gc {
 
             void sync()
             {
-                sync_.fetch_add( 1, atomics::memory_order_acq_rel );
+                if ( asymmetric_fence_ )
+                    cds::OS::membarrier::light();
+                else
+                    sync_.fetch_add( 1, atomics::memory_order_acq_rel );
             }
         };
         //@endcond
@@ -535,17 +558,26 @@ namespace cds { namespace gc {
                 - \p nMaxRetiredPtrCount - capacity of array of retired pointers for each thread. Must be greater than
                 <tt> nHazardPtrCount * nMaxThreadCount </tt>
                 Default is <tt>2 * nHazardPtrCount * nMaxThreadCount</tt>
+                - \p bAsymmetricFence - if \p true, the guards publish hazard pointers with a compiler barrier only,
+                and \p scan() issues process-wide \p membarrier before reading the hazard arrays.
+                If the OS does not support \p membarrier the ordinary fences are used.
+                - \p bBackgroundReclaim - if \p true, \p scan() hands the retired pointers over
+                to the background reclaimer thread that scans hazard pointers and frees retired data.
             */
             static CDS_EXPORT_API void construct(
-                size_t nInitialHazardPtrCount = 16  ///< Initial number of hazard pointer per thread
+                size_t nInitialHazardPtrCount = 16, ///< Initial number of hazard pointer per thread
+                bool bAsymmetricFence = false,      ///< Use asymmetric fence
+                bool bBackgroundReclaim = false     ///< Use background reclaimer thread
             );
 
             // for back-copatibility
             static void Construct(
-                size_t nInitialHazardPtrCount = 16  ///< Initial number of hazard pointer per thread
+                size_t nInitialHazardPtrCount = 16, ///< Initial number of hazard pointer per thread
+                bool bAsymmetricFence = false,      ///< Use asymmetric fence
+                bool bBackgroundReclaim = false     ///< Use background reclaimer thread
             )
             {
-                construct( nInitialHazardPtrCount );
+                construct( nInitialHazardPtrCount, bAsymmetricFence, bBackgroundReclaim );
             }
 
             /// Destroys global instance of \ref smr
@@ -587,7 +619,38 @@ namespace cds { namespace gc {
                 void( *free_func )( void * p )
             );
 
-            /// Returns thread-local data for the current thread
+            /// Checks if asymmetric fence mode is active
+            bool is_asymmetric_fence() const
+            {
+                return asymmetric_fence_;
+            }
+
+            /// Checks if retired data is freed by the background reclaimer thread
+            bool is_background_reclaim() const
+            {
+                return reclaimer_ != nullptr;
+            }
+
+            /// Sets the budget of retired pointers
+            /**
+                \p nMaxRetained is the limit of retired pointers that survived \p scan() in all threads,
+                0 means no limit. When the limit is exceeded \p scan() applies \p policy,
+                see \p hp::common::retired_budget_policy. \p cb is required for \p budget_callback policy.
+
+                The function should be called before any thread retires data.
+            */
+            void set_retired_budget( size_t nMaxRetained, retired_budget_policy policy, retired_budget_callback cb )
+            {
+                budget_.set( nMaxRetained, policy, cb );
+            }
+
+            /// Returns the retired budget
+            retired_budget const& get_retired_budget() const
+            {
+                return budget_;
+            }
+
+            /// Returns thread-local data for the current thread, attaching the thread to the GC on first call
             static CDS_EXPORT_API thread_data* tls();
 
             static CDS_EXPORT_API void attach_thread();
@@ -611,6 +674,19 @@ namespace cds { namespace gc {
             */
             CDS_EXPORT_API void help_scan( thread_data* pThis );
 
+            /// Frees unguarded retired pointers from <tt>[first, last)</tt>
+            /**
+                The function is called by the background reclaimer thread.
+                Guarded retired pointers are moved to the head of the range, the function returns their count.
+            */
+            CDS_EXPORT_API size_t reclaim( retired_ptr* first, retired_ptr* last );
+
+            /// Waits until the background reclaimer thread processes all retired data handed over to it
+            /**
+                If background reclamation mode is off the function does nothing.
+            */
+            CDS_EXPORT_API void wait_reclaim();
+
             hp_allocator& get_hp_allocator()
             {
                 return hp_allocator_;
@@ -622,8 +698,10 @@ namespace cds { namespace gc {
             }
 
         private:
-            CDS_EXPORT_API explicit smr(
-                size_t nInitialHazardPtrCount
+            CDS_EXPORT_API smr(
+                size_t nInitialHazardPtrCount,
+                bool bAsymmetricFence,
+                bool bBackgroundReclaim
             );
 
             CDS_EXPORT_API ~smr();
@@ -640,11 +718,40 @@ namespace cds { namespace gc {
             /// Free HP SMR thread-private data
             CDS_EXPORT_API void free_thread_data( thread_record* pRec );
 
+            /// Unlinks free records without retired pointers from the thread list
+            /**
+                The unlinked records are kept in \p free_records_ and are reused by \p alloc_thread_data().
+                The function is called by the detaching thread when the thread list contains
+                much more free records than attached threads, so after a burst of short-lived threads
+                \p scan() and \p help_scan() walk only the records of live threads.
+            */
+            CDS_EXPORT_API void compact_thread_list();
+
+            /// Scans hazard pointers and frees retired data of \p pRec, without budget check
+            CDS_EXPORT_API void do_scan( thread_record* pRec );
+
+            /// Hands the retired pointers of \p pRec over to the background reclaimer thread
+            CDS_EXPORT_API void background_scan( thread_record* pRec );
+
+            /// Applies the retired budget policy when the budget is exceeded
+            CDS_EXPORT_API void apply_retired_budget( thread_record* pRec );
+
         private:
+            struct reclaimer;
+
             static CDS_EXPORT_API smr* instance_;
 
             atomics::atomic< thread_record*>    thread_list_;   ///< Head of thread list
+            atomics::atomic<size_t>             thread_list_count_; ///< Count of records in \p thread_list_
+            atomics::atomic<size_t>             attached_count_;    ///< Count of attached threads
+            thread_record*                      free_records_;      ///< Records unlinked from \p thread_list_, protected by \p thread_list_lock_
+            size_t                              compact_count_;     ///< Count of unlinked records, protected by \p thread_list_lock_
+            cds::sync::spin                     thread_list_lock_;  ///< Lock for \p compact_thread_list() and \p free_records_
             size_t const        initial_hazard_count_;  ///< initial number of hazard pointers per thread
+            bool const          asymmetric_fence_;      ///< asymmetric fence mode is active
+            reclaimer*          reclaimer_;             ///< background reclaimer thread, \p nullptr if not used
+            size_t              reclaimer_retained_;    ///< retired pointers retained by the reclaimer thread, accounted in \p budget_
+            retired_budget      budget_;                ///< budget of retired pointers
             hp_allocator        hp_allocator_;
             retired_allocator   retired_allocator_;
 
@@ -717,6 +824,16 @@ namespace cds { namespace gc {
         /// Internal statistics
         typedef dhp::stat stat;
 
+        /// Policy applied when the retired budget is exceeded, see \p set_retired_budget()
+        enum class budget_policy {
+            help_scan = hp::common::budget_help_scan,   ///< scan retired data of terminated threads and rescan
+            throttle = hp::common::budget_throttle,     ///< back off the retiring thread and rescan until the budget is restored
+            callback = hp::common::budget_callback      ///< call user-provided callback
+        };
+
+        /// Callback for \p budget_policy::callback: <tt>void cb( size_t nRetained, size_t nBudget )</tt>
+        typedef hp::common::retired_budget_callback budget_callback;
+
         /// Dynamic Hazard Pointer guard
         /**
             A guard is a hazard pointer.
@@ -1332,12 +1449,23 @@ namespace cds { namespace gc {
                 When a thread is initialized the GC allocates local guard pool for the thread from a common guard pool.
                 By perforce the local thread's guard pool is grown automatically from common pool.
                 When the thread terminated its guard pool is backed to common GC's pool.
+
+            \p bAsymmetricFence - asymmetric fence mode. In this mode \p Guard::protect() publishes
+                the hazard pointer without store-load fence, and the rare \p scan() forces the memory barrier
+                on all threads by Linux \p membarrier(2) system call. If \p membarrier is not available,
+                %DHP falls back to ordinary fences; use \p asymmetric_fence() to check the actual mode.
+
+            \p bBackgroundReclaim - background reclamation mode. In this mode \p scan() does not search
+                the hazard pointers in the context of the worker thread; instead, it hands all retired pointers
+                of the thread over to the dedicated reclaimer thread that frees retired data.
         */
         explicit DHP(
-            size_t nInitialHazardPtrCount = 16  ///< Initial number of hazard pointer per thread
+            size_t nInitialHazardPtrCount = 16, ///< Initial number of hazard pointer per thread
+            bool bAsymmetricFence = false,      ///< Use asymmetric fence
+            bool bBackgroundReclaim = false     ///< Use background reclaimer thread
         )
         {
-            dhp::smr::construct( nInitialHazardPtrCount );
+            dhp::smr::construct( nInitialHazardPtrCount, bAsymmetricFence, bBackgroundReclaim );
         }
 
         /// Destroys %DHP memory manager
@@ -1414,6 +1542,11 @@ namespace cds { namespace gc {
             - it should be default-constructible
             - the result of functor call with argument \p p should not depend on where the functor will be called.
 
+            \p Disposer may also provide batch disposing operator <tt>void operator()( T ** arr, size_t count )</tt>.
+            In this case \p scan() groups unguarded retired pointers by disposer and frees each group
+            by one batch call instead of per-pointer calls; it is useful when the disposer returns memory
+            to a pool or an allocator that benefits from bulk deallocation.
+
             \par Examples:
             Operator \p delete functor:
             \code
@@ -1449,8 +1582,8 @@ namespace cds { namespace gc {
         template <class Disposer, typename T>
         static void retire( T* p )
         {
-            if ( !dhp::smr::tls()->retired_.push( dhp::retired_ptr( p, cds::details::static_functor<Disposer, T>::call )))
-                scan();
+            if ( !dhp::smr::tls()->retired_.push( dhp::retired_ptr( p, cds::gc::details::retired_functor<Disposer, T>::get())))
+                dhp::smr::instance().scan( dhp::smr::tls());
         }
 
         /// Checks if Dynamic Hazard Pointer GC is constructed and may be used
@@ -1459,13 +1592,51 @@ namespace cds { namespace gc {
             return dhp::smr::isUsed();
         }
 
+        /// Checks if asymmetric fence mode is active
+        static bool asymmetric_fence()
+        {
+            return dhp::smr::instance().is_asymmetric_fence();
+        }
+
+        /// Checks if retired data is freed by the background reclaimer thread
+        static bool background_reclaim()
+        {
+            return dhp::smr::instance().is_background_reclaim();
+        }
+
+        /// Sets the budget of retired pointers
+        /**
+            A stalled thread that holds a hazard pointer pins the retired data forever, and the retired arrays
+            of the other threads grow without bound. The budget limits the total count of retired pointers
+            that survived \p scan(). When the budget is exceeded, \p scan() applies \p policy:
+            - \p budget_policy::help_scan - the thread frees retired data of the terminated threads
+                and rescans its own retired array
+            - \p budget_policy::throttle - the retiring thread backs off and rescans until
+                the budget is restored or the max back-off count is reached
+            - \p budget_policy::callback - \p cb is called, for example, to log a warning
+
+            \p nMaxRetained = 0 removes the budget. The current count of retained pointers
+            is available in \p stat::retained_count.
+
+            The function should be called before any thread retires data.
+        */
+        static void set_retired_budget( size_t nMaxRetained, budget_policy policy = budget_policy::help_scan, budget_callback cb = nullptr )
+        {
+            dhp::smr::instance().set_retired_budget( nMaxRetained, static_cast<hp::common::retired_budget_policy>( policy ), cb );
+        }
+
         /// Forced GC cycle call for current thread
         /**
             Usually, this function should not be called directly.
+
+            In background reclamation mode the function waits until the reclaimer thread
+            processes the retired data of the current thread.
         */
         static void scan()
         {
-            dhp::smr::instance().scan( dhp::smr::tls());
+            dhp::smr& gc = dhp::smr::instance();
+            gc.scan( dhp::smr::tls());
+            gc.wait_reclaim();
         }
 
         /// Synonym for \p scan()
@@ -1480,6 +1651,8 @@ namespace cds { namespace gc {
 
             @note Internal statistics is available only if you compile
             \p libcds and your program with \p -DCDS_ENABLE_HPSTAT.
+            The retired budget counters \p stat::retained_count and \p stat::budget_exceeded_count
+            are always available.
         */
         static void statistics( stat& st )
         {
@@ -0,0 +1,1571 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSLIB_GC_EBR_SMR_H
+#define CDSLIB_GC_EBR_SMR_H
+
+#include <exception>
+#include <cds/gc/details/retired_ptr.h>
+#include <cds/details/lib.h>
+#include <cds/threading/model.h>
+#include <cds/details/throw_exception.h>
+#include <cds/details/static_functor.h>
+#include <cds/details/marked_ptr.h>
+#include <cds/user_setup/cache_line.h>
+
+#ifdef CDS_ENABLE_HPSTAT
+#   define CDS_EBRSTAT( expr ) expr
+#else
+#   define CDS_EBRSTAT( expr )
+#endif
+
+namespace cds { namespace gc {
+    /// Epoch-based reclamation implementation details
+    namespace ebr {
+
+        /// Guarded pointer type
+        typedef void*   hazard_ptr;
+
+        /// Epoch type
+        typedef uint64_t epoch_t;
+
+        //@cond
+        /// Announced epoch of the thread that is outside of any operation
+        static constexpr epoch_t const c_quiescent = 0;
+
+        /// Count of limbo bags per thread
+        static constexpr size_t const c_nLimboBagCount = 3;
+        //@endcond
+
+        /// Exception "Not enough guards"
+        class not_enought_hazard_ptr: public std::length_error
+        {
+        //@cond
+        public:
+            not_enought_hazard_ptr()
+                : std::length_error( "Not enough EBR guards" )
+            {}
+        //@endcond
+        };
+
+        /// Exception "Epoch-based SMR is not initialized"
+        class not_initialized: public std::runtime_error
+        {
+        //@cond
+        public:
+            not_initialized()
+                : std::runtime_error( "Global epoch-based SMR object is not initialized" )
+            {}
+        //@endcond
+        };
+
+        //@cond
+        /// EBR guard
+        /**
+            Unlike the hazard pointer, the guarded pointer is private to the owner thread:
+            the guard only keeps the owner thread in its announced epoch.
+        */
+        class guard
+        {
+        public:
+            guard() noexcept
+                : ptr_( nullptr )
+                , next_( nullptr )
+            {}
+
+            hazard_ptr get() const noexcept
+            {
+                return ptr_;
+            }
+
+            hazard_ptr get( atomics::memory_order ) const noexcept
+            {
+                return ptr_;
+            }
+
+            template <typename T>
+            T* get_as() const noexcept
+            {
+                return reinterpret_cast<T*>( get());
+            }
+
+            template <typename T>
+            void set( T* ptr ) noexcept
+            {
+                ptr_ = reinterpret_cast<hazard_ptr>( ptr );
+            }
+
+            template <typename T, int BITMASK>
+            void set( cds::details::marked_ptr<T, BITMASK> ptr ) noexcept
+            {
+                set( ptr.ptr());
+            }
+
+            void clear() noexcept
+            {
+                ptr_ = nullptr;
+            }
+
+        private:
+            hazard_ptr  ptr_;   // guarded pointer, private to the owner thread
+
+        public:
+            guard* next_;   // free guard list
+        };
+
+        /// Array of guards
+        template <size_t Capacity>
+        class guard_array
+        {
+        public:
+            static size_t const c_nCapacity = Capacity;
+
+        public:
+            guard_array()
+                : arr_{ nullptr }
+            {}
+
+            static constexpr size_t capacity()
+            {
+                return c_nCapacity;
+            }
+
+            guard* operator[]( size_t idx ) const noexcept
+            {
+                assert( idx < capacity());
+                return arr_[idx];
+            }
+
+            void clear( size_t idx ) noexcept
+            {
+                assert( idx < capacity());
+                assert( arr_[idx] != nullptr );
+
+                arr_[idx]->clear();
+            }
+
+            guard* release( size_t idx ) noexcept
+            {
+                assert( idx < capacity());
+
+                guard* g = arr_[idx];
+                arr_[idx] = nullptr;
+                return g;
+            }
+
+            void reset( size_t idx, guard* g ) noexcept
+            {
+                assert( idx < capacity());
+                assert( arr_[idx] == nullptr );
+
+                arr_[idx] = g;
+            }
+
+        private:
+            guard*  arr_[c_nCapacity];
+        };
+        //@endcond
+
+        //@cond
+        /// Per-thread guard storage
+        /**
+            The storage counts allocated guards: the thread is inside an operation
+            while it owns at least one guard.
+        */
+        class thread_guard_storage {
+        public:
+            thread_guard_storage( guard* arr, size_t nSize ) noexcept
+                : free_head_( arr )
+                , array_( arr )
+                , capacity_( nSize )
+                , active_( 0 )
+#       ifdef CDS_ENABLE_HPSTAT
+                , alloc_guard_count_(0)
+                , free_guard_count_(0)
+#       endif
+            {
+                // Initialize guards
+                new( arr ) guard[nSize];
+
+                for ( guard* pEnd = arr + nSize - 1; arr < pEnd; ++arr )
+                    arr->next_ = arr + 1;
+                arr->next_ = nullptr;
+            }
+
+            thread_guard_storage() = delete;
+            thread_guard_storage( thread_guard_storage const& ) = delete;
+            thread_guard_storage( thread_guard_storage&& ) = delete;
+
+            size_t capacity() const noexcept
+            {
+                return capacity_;
+            }
+
+            bool full() const noexcept
+            {
+                return free_head_ == nullptr;
+            }
+
+            /// Count of allocated guards
+            size_t active() const noexcept
+            {
+                return active_;
+            }
+
+            guard* alloc()
+            {
+#       ifdef CDS_DISABLE_SMR_EXCEPTION
+                assert( !full());
+#       else
+                if ( full())
+                    CDS_THROW_EXCEPTION( not_enought_hazard_ptr());
+#       endif
+                guard* g = free_head_;
+                free_head_ = g->next_;
+                ++active_;
+                CDS_EBRSTAT( ++alloc_guard_count_ );
+                return g;
+            }
+
+            void free( guard* g ) noexcept
+            {
+                assert( g >= array_ && g < array_ + capacity());
+                assert( active_ > 0 );
+
+                g->clear();
+                g->next_ = free_head_;
+                free_head_ = g;
+                --active_;
+                CDS_EBRSTAT( ++free_guard_count_ );
+            }
+
+            template< size_t Capacity>
+            size_t alloc( guard_array<Capacity>& arr )
+            {
+                size_t i;
+                guard* g = free_head_;
+                for ( i = 0; i < Capacity && g; ++i ) {
+                    arr.reset( i, g );
+                    g = g->next_;
+                }
+
+#       ifdef CDS_DISABLE_SMR_EXCEPTION
+                assert( i == Capacity );
+#       else
+                if ( i != Capacity )
+                    CDS_THROW_EXCEPTION( not_enought_hazard_ptr());
+#       endif
+                free_head_ = g;
+                active_ += Capacity;
+                CDS_EBRSTAT( alloc_guard_count_ += Capacity );
+                return i;
+            }
+
+            template <size_t Capacity>
+            void free( guard_array<Capacity>& arr ) noexcept
+            {
+                guard* gList = free_head_;
+                for ( size_t i = 0; i < Capacity; ++i ) {
+                    guard* g = arr[i];
+                    if ( g ) {
+                        g->clear();
+                        g->next_ = gList;
+                        gList = g;
+                        --active_;
+                        CDS_EBRSTAT( ++free_guard_count_ );
+                    }
+                }
+                free_head_ = gList;
+            }
+
+            static size_t calc_array_size( size_t capacity )
+            {
+                return sizeof( guard ) * capacity;
+            }
+
+        private:
+            guard*          free_head_; ///< Head of free guard list
+            guard* const    array_;     ///< Guard array
+            size_t const    capacity_;  ///< Guard array capacity
+            size_t          active_;    ///< Count of allocated guards
+#       ifdef CDS_ENABLE_HPSTAT
+        public:
+            size_t          alloc_guard_count_;
+            size_t          free_guard_count_;
+#       endif
+        };
+        //@endcond
+
+        //@cond
+        /// Limbo bag
+        /**
+            The bag contains the objects retired by the thread in epoch \p epoch().
+            The objects can be freed when the global epoch is at least <tt>epoch() + 2</tt>.
+            The bag is growable: \p smr::scan() extends the bag if it is full.
+        */
+        class limbo_bag
+        {
+            friend class smr;
+            friend struct thread_data;
+        public:
+            limbo_bag() noexcept
+                : current_( nullptr )
+                , last_( nullptr )
+                , retired_( nullptr )
+                , initial_( nullptr )
+                , epoch_( c_quiescent )
+#       ifdef CDS_ENABLE_HPSTAT
+                , retire_call_count_(0)
+                , extend_call_count_(0)
+#       endif
+            {}
+
+            limbo_bag( limbo_bag const& ) = delete;
+            limbo_bag( limbo_bag&& ) = delete;
+
+            size_t capacity() const noexcept
+            {
+                return last_ - retired_;
+            }
+
+            size_t size() const noexcept
+            {
+                return current_ - retired_;
+            }
+
+            bool empty() const noexcept
+            {
+                return current_ == retired_;
+            }
+
+            bool full() const noexcept
+            {
+                return current_ == last_;
+            }
+
+            epoch_t epoch() const noexcept
+            {
+                return epoch_;
+            }
+
+            /// Pushes \p p retired in epoch \p epoch, returns \p false if the bag is full after the push
+            bool push( cds::gc::details::retired_ptr const& p, epoch_t epoch ) noexcept
+            {
+                assert( current_ < last_ );
+                assert( empty() || epoch_ == epoch );
+
+                epoch_ = epoch;
+                *current_ = p;
+                CDS_EBRSTAT( ++retire_call_count_ );
+                return ++current_ < last_;
+            }
+
+            bool repush( cds::gc::details::retired_ptr const& p, epoch_t epoch ) noexcept
+            {
+                bool ret = push( p, epoch );
+                CDS_EBRSTAT( --retire_call_count_ );
+                return ret;
+            }
+
+            cds::gc::details::retired_ptr* first() const noexcept
+            {
+                return retired_;
+            }
+
+            cds::gc::details::retired_ptr* last() const noexcept
+            {
+                return current_;
+            }
+
+            /// Frees all objects of the bag, returns the count of freed objects
+            size_t free_all()
+            {
+                size_t const nCount = size();
+                cds::gc::details::free_retired( first(), last());
+                current_ = retired_;
+                return nCount;
+            }
+
+            static size_t calc_array_size( size_t capacity )
+            {
+                return sizeof( cds::gc::details::retired_ptr ) * capacity;
+            }
+
+        private:
+            void init( cds::gc::details::retired_ptr* arr, size_t capacity ) noexcept
+            {
+                current_ = retired_ = initial_ = arr;
+                last_ = arr + capacity;
+            }
+
+        private:
+            cds::gc::details::retired_ptr*  current_;
+            cds::gc::details::retired_ptr*  last_;
+            cds::gc::details::retired_ptr*  retired_;
+            cds::gc::details::retired_ptr*  initial_;   ///< initial array allocated with thread record
+            epoch_t                         epoch_;     ///< epoch of the objects in the bag
+#       ifdef CDS_ENABLE_HPSTAT
+        public:
+            size_t  retire_call_count_;
+            size_t  extend_call_count_;
+#       endif
+        };
+        //@endcond
+
+        /// Internal statistics
+        struct stat {
+            size_t  guard_allocated;    ///< Count of allocated EBR guards
+            size_t  guard_freed;        ///< Count of freed EBR guards
+            size_t  retired_count;      ///< Count of retired pointers
+            size_t  free_count;         ///< Count of free pointers
+            size_t  scan_count;         ///< Count of \p scan() call
+            size_t  help_scan_count;    ///< Count of \p help_scan() call
+            size_t  announce_count;     ///< Count of epoch announcements, i.e. count of fences on the read side
+            size_t  advance_count;      ///< Count of global epoch advancements
+            size_t  stall_count;        ///< Count of \p scan() calls that cannot advance the epoch due to a lagging thread
+            size_t  bag_extend_count;   ///< Count of limbo bag extensions
+
+            size_t  thread_rec_count;   ///< Count of thread records
+
+            /// Default ctor
+            stat()
+            {
+                clear();
+            }
+
+            /// Clears all counters
+            void clear()
+            {
+                guard_allocated =
+                    guard_freed =
+                    retired_count =
+                    free_count =
+                    scan_count =
+                    help_scan_count =
+                    announce_count =
+                    advance_count =
+                    stall_count =
+                    bag_extend_count =
+                    thread_rec_count = 0;
+            }
+        };
+
+        //@cond
+        /// Per-thread data
+        struct thread_data {
+            thread_guard_storage    guards_;    ///< Guards private to the thread
+            limbo_bag               bags_[c_nLimboBagCount]; ///< Limbo bags indexed by <tt>epoch % c_nLimboBagCount</tt>
+            atomics::atomic<epoch_t>& global_epoch_;    ///< Global epoch
+            size_t const        epoch_freq_;    ///< \p scan() is called after each \p epoch_freq_ retired pointers
+            size_t              retire_count_;  ///< Retired pointers after the last \p scan()
+            epoch_t             epoch_;         ///< The last global epoch seen by \p retire()
+
+            char pad1_[cds::c_nCacheLineSize];
+            atomics::atomic<epoch_t> announce_; ///< Announced epoch or \p c_quiescent
+            char pad2_[cds::c_nCacheLineSize];
+
+#       ifdef CDS_ENABLE_HPSTAT
+            // Internal statistics:
+            size_t              free_count_;
+            size_t              scan_count_;
+            size_t              help_scan_count_;
+            size_t              announce_count_;
+            size_t              advance_count_;
+            size_t              stall_count_;
+#       endif
+
+            // CppCheck warn: pad1_ and pad2_ is uninitialized in ctor
+            // cppcheck-suppress uninitMemberVar
+            thread_data( guard* guards, size_t guard_count, cds::gc::details::retired_ptr* bag_arr, size_t bag_capacity, atomics::atomic<epoch_t>& global_epoch, size_t epoch_freq )
+                : guards_( guards, guard_count )
+                , global_epoch_( global_epoch )
+                , epoch_freq_( epoch_freq )
+                , retire_count_( 0 )
+                , epoch_( c_quiescent )
+                , announce_( c_quiescent )
+#       ifdef CDS_ENABLE_HPSTAT
+                , free_count_(0)
+                , scan_count_(0)
+                , help_scan_count_(0)
+                , announce_count_(0)
+                , advance_count_(0)
+                , stall_count_(0)
+#       endif
+            {
+                for ( limbo_bag& bag : bags_ ) {
+                    bag.init( bag_arr, bag_capacity );
+                    bag_arr += bag_capacity;
+                }
+            }
+
+            thread_data() = delete;
+            thread_data( thread_data const& ) = delete;
+            thread_data( thread_data&& ) = delete;
+
+            epoch_t current_epoch() const noexcept
+            {
+                return global_epoch_.load( atomics::memory_order_acquire );
+            }
+
+            /// Announces the current global epoch: the thread enters an operation
+            void enter()
+            {
+                announce_.store( current_epoch(), atomics::memory_order_relaxed );
+                atomics::atomic_thread_fence( atomics::memory_order_seq_cst );
+                CDS_EBRSTAT( ++announce_count_ );
+            }
+
+            /// Announces quiescent state: the thread leaves the operation
+            void leave()
+            {
+                announce_.store( c_quiescent, atomics::memory_order_release );
+            }
+
+            guard* alloc_guard()
+            {
+                guard* g = guards_.alloc();
+                if ( guards_.active() == 1 )
+                    enter();
+                return g;
+            }
+
+            void free_guard( guard* g ) noexcept
+            {
+                guards_.free( g );
+                if ( guards_.active() == 0 )
+                    leave();
+            }
+
+            template <size_t Capacity>
+            void alloc_guard( guard_array<Capacity>& arr )
+            {
+                bool const bEnter = guards_.active() == 0;
+                guards_.alloc( arr );
+                if ( bEnter )
+                    enter();
+            }
+
+            template <size_t Capacity>
+            void free_guard( guard_array<Capacity>& arr ) noexcept
+            {
+                guards_.free( arr );
+                if ( guards_.active() == 0 )
+                    leave();
+            }
+
+            /// Frees limbo bags that are safe for the global epoch \p epoch
+            void rotate( epoch_t epoch )
+            {
+                for ( limbo_bag& bag : bags_ ) {
+                    if ( !bag.empty() && bag.epoch() + 2 <= epoch ) {
+                        size_t const nFreed = bag.free_all();
+                        CDS_EBRSTAT( free_count_ += nFreed );
+                        CDS_UNUSED( nFreed );
+                    }
+                }
+                epoch_ = epoch;
+            }
+
+            /// Pushes \p p to the limbo bag of the current epoch, returns \p false if \p smr::scan() should be called
+            bool retire( cds::gc::details::retired_ptr const& p )
+            {
+                // The object is unlinked before the call, so the epoch is read after the unlinking
+                epoch_t const epoch = global_epoch_.load( atomics::memory_order_seq_cst );
+                if ( epoch != epoch_ )
+                    rotate( epoch );
+
+                bool const ret = bags_[epoch % c_nLimboBagCount].push( p, epoch );
+                return ++retire_count_ < epoch_freq_ && ret;
+            }
+        };
+        //@endcond
+
+        //@cond
+        /// Epoch-based SMR (Safe Memory Reclamation)
+        class smr
+        {
+            struct thread_record;
+
+        public:
+            /// Returns the instance of epoch-based \ref smr
+            static smr& instance()
+            {
+#       ifdef CDS_DISABLE_SMR_EXCEPTION
+                assert( instance_ != nullptr );
+#       else
+                if ( !instance_ )
+                    CDS_THROW_EXCEPTION( not_initialized());
+#       endif
+                return *instance_;
+            }
+
+            /// Creates epoch-based SMR singleton
+            /**
+                Epoch-based SMR is a singleton. If EBR instance is not initialized then the function creates the instance.
+                Otherwise it does nothing.
+
+                The parameters:
+                - \p nGuardCount - guard count per thread. Default is 72.
+                - \p nBagCapacity - initial capacity of each limbo bag of the thread. Default is 256.
+                - \p nEpochFreq - each thread tries to advance the global epoch after \p nEpochFreq retired pointers.
+                    Default is 64.
+            */
+            static CDS_EXPORT_API void construct(
+                size_t nGuardCount = 0,     ///< Guard count per thread
+                size_t nBagCapacity = 0,    ///< Initial capacity of limbo bag
+                size_t nEpochFreq = 0       ///< Epoch advance frequency
+            );
+
+            /// Destroys global instance of \ref smr
+            /**
+                The parameter \p bDetachAll should be used carefully: if its value is \p true,
+                then the object destroyed automatically detaches all attached threads. This feature
+                can be useful when you have no control over the thread termination, for example,
+                when \p libcds is injected into existing external thread.
+            */
+            static CDS_EXPORT_API void destruct(
+                bool bDetachAll = false     ///< Detach all threads
+            );
+
+            /// Checks if global SMR object is constructed and may be used
+            static bool isUsed() noexcept
+            {
+                return instance_ != nullptr;
+            }
+
+            /// Set memory management functions
+            /**
+                @note This function may be called <b>BEFORE</b> creating an instance
+                of epoch-based SMR
+
+                SMR object allocates some memory for thread-specific data and for
+                creating SMR object.
+                By default, a standard \p new and \p delete operators are used for this.
+            */
+            static CDS_EXPORT_API void set_memory_allocator(
+                void* ( *alloc_func )( size_t size ),
+                void (*free_func )( void * p )
+            );
+
+            /// Returns max guard count per thread
+            size_t get_guard_count() const noexcept
+            {
+                return guard_count_;
+            }
+
+            /// Returns initial capacity of limbo bag
+            size_t get_bag_capacity() const noexcept
+            {
+                return bag_capacity_;
+            }
+
+            /// Returns epoch advance frequency
+            size_t get_epoch_freq() const noexcept
+            {
+                return epoch_freq_;
+            }
+
+            /// Returns current global epoch
+            epoch_t get_epoch() const noexcept
+            {
+                return global_epoch_.load( atomics::memory_order_acquire );
+            }
+
+            /// Checks that required guard count \p nRequiredCount is less or equal then max guard count
+            /**
+                If <tt> nRequiredCount > get_guard_count()</tt> then the exception \p not_enought_hazard_ptr is thrown
+            */
+            static void check_guard_count( size_t nRequiredCount )
+            {
+                if ( instance().get_guard_count() < nRequiredCount ) {
+#       ifdef CDS_DISABLE_SMR_EXCEPTION
+                    assert( false );    // not enough guards
+#       else
+                    CDS_THROW_EXCEPTION( not_enought_hazard_ptr());
+#       endif
+                }
+            }
+
+            /// Returns thread-local data for the current thread, attaching the thread to the GC on first call
+            static CDS_EXPORT_API thread_data* tls();
+
+            static CDS_EXPORT_API void attach_thread();
+            static CDS_EXPORT_API void detach_thread();
+
+            /// Get internal statistics
+            CDS_EXPORT_API void statistics( stat& st );
+
+        public: // for internal use only
+            /// The main garbage collecting function
+            /**
+                The function tries to advance the global epoch: the epoch is advanced if each thread
+                is quiescent or has announced the current epoch. Then the limbo bags of the thread
+                that are two epochs behind the global epoch are freed.
+                If the bag of the current epoch is full, it is extended.
+            */
+            CDS_EXPORT_API void scan( thread_data* pRec );
+
+            /// Forced reclamation
+            /**
+                The function calls \p scan() to advance the global epoch twice, so all objects retired
+                by the thread before the call are freed if no other thread is inside an operation.
+            */
+            CDS_EXPORT_API void force_dispose( thread_data* pRec );
+
+            /// Helper scan routine
+            /**
+                The function moves the limbo bags of inactive thread records
+                to the limbo bags of \p pThis.
+
+                The function is called internally when the thread is detached.
+            */
+            CDS_EXPORT_API void help_scan( thread_data* pThis );
+
+        private:
+            CDS_EXPORT_API smr(
+                size_t nGuardCount,     ///< Guard count per thread
+                size_t nBagCapacity,    ///< Initial capacity of limbo bag
+                size_t nEpochFreq       ///< Epoch advance frequency
+            );
+
+            CDS_EXPORT_API ~smr();
+
+            CDS_EXPORT_API void detach_all_thread();
+
+            /// Advances the global epoch if all threads have observed it, returns the global epoch
+            epoch_t try_advance( thread_data* pRec );
+
+            /// Extends limbo bag of the thread
+            void extend_bag( limbo_bag& bag );
+
+        private:
+            CDS_EXPORT_API thread_record* create_thread_data();
+            static CDS_EXPORT_API void destroy_thread_data( thread_record* pRec );
+
+            /// Allocates epoch-based SMR thread private data
+            CDS_EXPORT_API thread_record* alloc_thread_data();
+
+            /// Free EBR SMR thread-private data
+            CDS_EXPORT_API void free_thread_data( thread_record* pRec );
+
+        private:
+            static CDS_EXPORT_API smr* instance_;
+
+            atomics::atomic< thread_record*>    thread_list_;   ///< Head of thread list
+
+            size_t const    guard_count_;   ///< max count of thread's guards
+            size_t const    bag_capacity_;  ///< initial capacity of limbo bag
+            size_t const    epoch_freq_;    ///< epoch advance frequency
+
+            char pad1_[cds::c_nCacheLineSize];
+            atomics::atomic<epoch_t>    global_epoch_;  ///< Global epoch
+            char pad2_[cds::c_nCacheLineSize];
+        };
+        //@endcond
+
+    } // namespace ebr
+
+    /// Epoch-based SMR (Safe Memory Reclamation)
+    /**  @ingroup cds_garbage_collector
+
+        Implementation of epoch-based reclamation in the style of DEBRA
+
+        Sources:
+            - [2004] Keir Fraser "Practical lock-freedom"
+            - [2015] Trevor Brown "Reclaiming memory for lock-free data structures: there has to be a better way"
+
+        Epoch-based reclamation is an interface-compatible replacement of \p cds::gc::HP
+        for write-heavy workloads. The reader does not publish any pointer: the first guard allocated
+        by the thread announces the current global epoch (one store and one fence per operation),
+        the last freed guard announces the quiescent state. \p Guard::protect() is a plain atomic load.
+
+        Each thread has three limbo bags. An object is retired to the bag of the current global epoch
+        and can be freed when the global epoch has been advanced twice. The global epoch is advanced
+        when each thread is quiescent or has announced the current epoch; the check is amortized:
+        the thread tries to advance the epoch after each \p nEpochFreq retired pointers.
+
+        Like any epoch-based scheme, \p %EBR is not robust: a thread that stays inside an operation
+        (for example, holds a \p guarded_ptr) prevents the epoch advancement, and the limbo bags of all threads grow.
+        The containers of \p libcds have no restart points, so the lagging thread cannot be neutralized
+        as in DEBRA+; such situations are counted in \p stat::stall_count.
+
+        Epoch-based SMR is a singleton. Before use any EBR-related class you must initialize \p %EBR
+        by contructing \p %cds::gc::EBR object in beginning of your \p main().
+        To use the containers with \p %EBR, include the corresponding <tt>*_ebr.h</tt> header, for example,
+        <tt>cds/container/michael_list_ebr.h</tt>.
+    */
+    class EBR
+    {
+    public:
+        /// Native guarded pointer type
+        typedef ebr::hazard_ptr guarded_pointer;
+
+        /// Atomic reference
+        template <typename T> using atomic_ref = atomics::atomic<T *>;
+
+        /// Atomic marked pointer
+        template <typename MarkedPtr> using atomic_marked_ptr = atomics::atomic<MarkedPtr>;
+
+        /// Atomic type
+        template <typename T> using atomic_type = atomics::atomic<T>;
+
+        /// Exception "Not enough guards"
+        typedef ebr::not_enought_hazard_ptr not_enought_hazard_ptr_exception;
+
+        /// Internal statistics
+        typedef ebr::stat stat;
+
+        /// EBR guard
+        /**
+            The guard has the same interface as \p cds::gc::HP::Guard.
+            While the thread owns at least one guard, it stays in the announced epoch,
+            so any pointer read by the thread cannot be freed. The guarded pointer itself
+            is private to the owner thread.
+
+            \p %Guard object is movable but not copyable.
+
+            The guard object can be in two states:
+            - unlinked - the guard is not linked with any internal guard slot.
+              In this state no operation except \p link() and move assignment is supported.
+            - linked (default) - the guard allocates an internal guard slot and completely operable.
+
+            @warning Move assignment transfers the guard in unlinked state, use with care.
+        */
+        class Guard
+        {
+        public:
+            /// Default ctor allocates a guard slot from thread-private storage
+            /**
+                @warning Can throw \p not_enought_hazard_ptr_exception if internal guard slots are exhausted.
+            */
+            Guard()
+                : guard_( ebr::smr::tls()->alloc_guard())
+            {}
+
+            /// Initilalizes an unlinked guard i.e. the guard contains no guard slot. Used for move semantics support
+            explicit Guard( std::nullptr_t ) noexcept
+                : guard_( nullptr )
+            {}
+
+            /// Move ctor - \p src guard becomes unlinked (transfer internal guard ownership)
+            Guard( Guard&& src ) noexcept
+                : guard_( src.guard_ )
+            {
+                src.guard_ = nullptr;
+            }
+
+            /// Move assignment: the internal guards are swapped between \p src and \p this
+            /**
+                @warning \p src will become in unlinked state if \p this was unlinked on entry.
+            */
+            Guard& operator=( Guard&& src ) noexcept
+            {
+                std::swap( guard_, src.guard_ );
+                return *this;
+            }
+
+            /// Copy ctor is prohibited - the guard is not copyable
+            Guard( Guard const& ) = delete;
+
+            /// Copy assignment is prohibited
+            Guard& operator=( Guard const& ) = delete;
+
+            /// Frees the internal guard slot if the guard is in linked state
+            ~Guard()
+            {
+                unlink();
+            }
+
+            /// Checks if the guard object linked with any internal guard slot
+            bool is_linked() const
+            {
+                return guard_ != nullptr;
+            }
+
+            /// Links the guard with internal guard slot if the guard is in unlinked state
+            /**
+                @warning Can throw \p not_enought_hazard_ptr_exception if internal guard array is exhausted.
+            */
+            void link()
+            {
+                if ( !guard_ )
+                    guard_ = ebr::smr::tls()->alloc_guard();
+            }
+
+            /// Unlinks the guard from internal guard slot. The guard becomes in unlinked state
+            void unlink()
+            {
+                if ( guard_ ) {
+                    ebr::smr::tls()->free_guard( guard_ );
+                    guard_ = nullptr;
+                }
+            }
+
+            /// Protects a pointer of type \p atomic<T*>
+            /**
+                Return the value of \p toGuard
+
+                The thread is already inside the announced epoch, so the function is a plain load of \p toGuard.
+
+                @warning The guad object should be in linked state, otherwise the result is undefined
+            */
+            template <typename T>
+            T protect( atomics::atomic<T> const& toGuard )
+            {
+                assert( guard_ != nullptr );
+
+                T pCur = toGuard.load( atomics::memory_order_acquire );
+                guard_->set( pCur );
+                return pCur;
+            }
+
+            /// Protects a converted pointer of type \p atomic<T*>
+            /**
+                Return the value of \p toGuard
+
+                The function is the same as \p protect( toGuard ) but the result of <tt> f( toGuard.load()) </tt>
+                is stored as the guarded pointer.
+
+                The function is useful for intrusive containers when \p toGuard is a node pointer
+                that should be converted to a pointer to the value before protecting.
+                The parameter \p f of type Func is a functor that makes this conversion:
+                \code
+                    struct functor {
+                        value_type * operator()( T * p );
+                    };
+                \endcode
+
+                @warning The guad object should be in linked state, otherwise the result is undefined
+            */
+            template <typename T, class Func>
+            T protect( atomics::atomic<T> const& toGuard, Func f )
+            {
+                assert( guard_ != nullptr );
+
+                T pCur = toGuard.load( atomics::memory_order_acquire );
+                guard_->set( f( pCur ));
+                return pCur;
+            }
+
+            /// Store \p p to the guard
+            /**
+                The function is intended for a pointer that cannot be changed concurrently
+                or if the pointer is already guarded by another guard of the thread.
+
+                @warning The guad object should be in linked state, otherwise the result is undefined
+            */
+            template <typename T>
+            T * assign( T* p )
+            {
+                assert( guard_ != nullptr );
+
+                guard_->set( p );
+                return p;
+            }
+
+            //@cond
+            std::nullptr_t assign( std::nullptr_t )
+            {
+                assert( guard_ != nullptr );
+
+                guard_->clear();
+                return nullptr;
+            }
+            //@endcond
+
+            /// Copy a value guarded from \p src guard to \p this guard (valid only in linked state)
+            void copy( Guard const& src )
+            {
+                assign( src.get_native());
+            }
+
+            /// Store marked pointer \p p to the guard
+            /**
+                The function equals to a simple assignment of <tt>p.ptr()</tt>, no loop is performed.
+                Can be used for a marked pointer that cannot be changed concurrently or if the marked pointer
+                is already guarded by another guard.
+
+                @warning The guard object should be in linked state, otherwise the result is undefined
+            */
+            template <typename T, int BITMASK>
+            T * assign( cds::details::marked_ptr<T, BITMASK> p )
+            {
+                return assign( p.ptr());
+            }
+
+            /// Clear value of the guard (valid only in linked state)
+            void clear()
+            {
+                assign( nullptr );
+            }
+
+            /// Get the value currently protected (valid only in linked state)
+            template <typename T>
+            T * get() const
+            {
+                assert( guard_ != nullptr );
+                return guard_->get_as<T>();
+            }
+
+            /// Get native guarded pointer stored (valid only in linked state)
+            guarded_pointer get_native() const
+            {
+                assert( guard_ != nullptr );
+                return guard_->get();
+            }
+
+            //@cond
+            ebr::guard* release()
+            {
+                ebr::guard* g = guard_;
+                guard_ = nullptr;
+                return g;
+            }
+
+            ebr::guard*& guard_ref()
+            {
+                return guard_;
+            }
+            //@endcond
+
+        private:
+            //@cond
+            ebr::guard* guard_;
+            //@endcond
+        };
+
+        /// Array of EBR guards
+        /**
+            The class is intended for allocating an array of guards.
+            Template parameter \p Count defines the size of the array.
+            The interface is the same as \p cds::gc::HP::GuardArray.
+        */
+        template <size_t Count>
+        class GuardArray
+        {
+        public:
+            /// Rebind array for other size \p Count2
+            template <size_t Count2>
+            struct rebind {
+                typedef GuardArray<Count2>  other;   ///< rebinding result
+            };
+
+            /// Array capacity
+            static constexpr const size_t c_nCapacity = Count;
+
+        public:
+            /// Default ctor allocates \p Count guard slots
+            GuardArray()
+            {
+                ebr::smr::tls()->alloc_guard( guards_ );
+            }
+
+            /// Move ctor is prohibited
+            GuardArray( GuardArray&& ) = delete;
+
+            /// Move assignment is prohibited
+            GuardArray& operator=( GuardArray&& ) = delete;
+
+            /// Copy ctor is prohibited
+            GuardArray( GuardArray const& ) = delete;
+
+            /// Copy assignment is prohibited
+            GuardArray& operator=( GuardArray const& ) = delete;
+
+            /// Frees allocated guard slots
+            ~GuardArray()
+            {
+                ebr::smr::tls()->free_guard( guards_ );
+            }
+
+            /// Protects a pointer of type \p atomic<T*>
+            /**
+                Return the value of \p toGuard
+
+                The function is a plain load of \p toGuard, the result is stored in the slot \p nIndex.
+            */
+            template <typename T>
+            T protect( size_t nIndex, atomics::atomic<T> const& toGuard )
+            {
+                assert( nIndex < capacity());
+
+                T pRet = toGuard.load( atomics::memory_order_acquire );
+                guards_[nIndex]->set( pRet );
+                return pRet;
+            }
+
+            /// Protects a pointer of type \p atomic<T*>
+            /**
+                Return the value of \p toGuard
+
+                The function is the same as \p protect( nIndex, toGuard ) but the result of <tt> f( toGuard.load()) </tt>
+                is stored as the guarded pointer.
+            */
+            template <typename T, class Func>
+            T protect( size_t nIndex, atomics::atomic<T> const& toGuard, Func f )
+            {
+                assert( nIndex < capacity());
+
+                T pRet = toGuard.load( atomics::memory_order_acquire );
+                guards_[nIndex]->set( f( pRet ));
+                return pRet;
+            }
+
+            /// Store \p p to the slot \p nIndex
+            /**
+                The function is intended for a pointer that cannot be changed concurrently
+                or if the pointer is already guarded by another guard of the thread.
+            */
+            template <typename T>
+            T * assign( size_t nIndex, T * p )
+            {
+                assert( nIndex < capacity());
+
+                guards_[nIndex]->set( p );
+                return p;
+            }
+
+            /// Store marked pointer \p p to the guard
+            /**
+                The function equals to a simple assignment of <tt>p.ptr()</tt>, no loop is performed.
+                Can be used for a marked pointer that cannot be changed concurrently.
+            */
+            template <typename T, int BITMASK>
+            T * assign( size_t nIndex, cds::details::marked_ptr<T, BITMASK> p )
+            {
+                return assign( nIndex, p.ptr());
+            }
+
+            /// Copy guarded value from \p src guard to slot at index \p nIndex
+            void copy( size_t nIndex, Guard const& src )
+            {
+                assign( nIndex, src.get_native());
+            }
+
+            /// Copy guarded value from slot \p nSrcIndex to the slot \p nDestIndex
+            void copy( size_t nDestIndex, size_t nSrcIndex )
+            {
+                assign( nDestIndex, get_native( nSrcIndex ));
+            }
+
+            /// Clear value of the slot \p nIndex
+            void clear( size_t nIndex )
+            {
+                guards_.clear( nIndex );
+            }
+
+            /// Get current value of slot \p nIndex
+            template <typename T>
+            T * get( size_t nIndex ) const
+            {
+                assert( nIndex < capacity());
+                return guards_[nIndex]->template get_as<T>();
+            }
+
+            /// Get native guarded pointer stored
+            guarded_pointer get_native( size_t nIndex ) const
+            {
+                assert( nIndex < capacity());
+                return guards_[nIndex]->get();
+            }
+
+            //@cond
+            ebr::guard* release( size_t nIndex ) noexcept
+            {
+                return guards_.release( nIndex );
+            }
+            //@endcond
+
+            /// Capacity of the guard array
+            static constexpr size_t capacity()
+            {
+                return c_nCapacity;
+            }
+
+        private:
+            //@cond
+            ebr::guard_array<c_nCapacity> guards_;
+            //@endcond
+        };
+
+        /// Guarded pointer
+        /**
+            A guarded pointer is a pair of a pointer and GC's guard.
+            Usually, it is used for returning a pointer to an element of a lock-free container.
+            The guard prevents the pointer to be early disposed (freed) by SMR.
+            After destructing \p %guarded_ptr object the pointer can be disposed (freed) automatically at any time.
+
+            The interface is the same as \p cds::gc::HP::guarded_ptr.
+            Note that a live \p %guarded_ptr keeps the owner thread inside its epoch and prevents
+            the epoch advancement, so do not hold it for a long time.
+
+            Template arguments:
+            - \p GuardedType - a type which the guard stores
+            - \p ValueType - a value type
+            - \p Cast - a functor for converting <tt>GuardedType*</tt> to <tt>ValueType*</tt>. Default is \p void (no casting).
+
+            You don't need use this class directly.
+            All set/map container classes from \p libcds declare the typedef for \p %guarded_ptr with appropriate casting functor.
+        */
+        template <typename GuardedType, typename ValueType=GuardedType, typename Cast=void >
+        class guarded_ptr
+        {
+            //@cond
+            struct trivial_cast {
+                ValueType * operator()( GuardedType * p ) const
+                {
+                    return p;
+                }
+            };
+
+            template <typename GT, typename VT, typename C> friend class guarded_ptr;
+            //@endcond
+
+        public:
+            typedef GuardedType guarded_type; ///< Guarded type
+            typedef ValueType   value_type;   ///< Value type
+
+            /// Functor for casting \p guarded_type to \p value_type
+            typedef typename std::conditional< std::is_same<Cast, void>::value, trivial_cast, Cast >::type value_cast;
+
+        public:
+            /// Creates empty guarded pointer
+            guarded_ptr() noexcept
+                : guard_(nullptr)
+            {}
+
+            //@cond
+            explicit guarded_ptr( ebr::guard* g ) noexcept
+                : guard_( g )
+            {}
+
+            /// Initializes guarded pointer with \p p
+            explicit guarded_ptr( guarded_type* p ) noexcept
+                : guard_( nullptr )
+            {
+                reset(p);
+            }
+            explicit guarded_ptr( std::nullptr_t ) noexcept
+                : guard_( nullptr )
+            {}
+            //@endcond
+
+            /// Move ctor
+            guarded_ptr( guarded_ptr&& gp ) noexcept
+                : guard_( gp.guard_ )
+            {
+                gp.guard_ = nullptr;
+            }
+
+            /// Move ctor
+            template <typename GT, typename VT, typename C>
+            guarded_ptr( guarded_ptr<GT, VT, C>&& gp ) noexcept
+                : guard_( gp.guard_ )
+            {
+                gp.guard_ = nullptr;
+            }
+
+            /// Ctor from \p Guard
+            explicit guarded_ptr( Guard&& g ) noexcept
+                : guard_( g.release())
+            {}
+
+            /// The guarded pointer is not copy-constructible
+            guarded_ptr( guarded_ptr const& gp ) = delete;
+
+            /// Clears the guarded pointer
+            /**
+                \ref release() is called if guarded pointer is not \ref empty()
+            */
+            ~guarded_ptr() noexcept
+            {
+                release();
+            }
+
+            /// Move-assignment operator
+            guarded_ptr& operator=( guarded_ptr&& gp ) noexcept
+            {
+                std::swap( guard_, gp.guard_ );
+                return *this;
+            }
+
+            /// Move-assignment from \p Guard
+            guarded_ptr& operator=( Guard&& g ) noexcept
+            {
+                std::swap( guard_, g.guard_ref());
+                return *this;
+            }
+
+            /// The guarded pointer is not copy-assignable
+            guarded_ptr& operator=(guarded_ptr const& gp) = delete;
+
+            /// Returns a pointer to guarded value
+            value_type * operator ->() const noexcept
+            {
+                assert( !empty());
+                return value_cast()( guard_->get_as<guarded_type>());
+            }
+
+            /// Returns a reference to guarded value
+            value_type& operator *() noexcept
+            {
+                assert( !empty());
+                return *value_cast()( guard_->get_as<guarded_type>());
+            }
+
+            /// Returns const reference to guarded value
+            value_type const& operator *() const noexcept
+            {
+                assert( !empty());
+                return *value_cast()( guard_->get_as<guarded_type>());
+            }
+
+            /// Checks if the guarded pointer is \p nullptr
+            bool empty() const noexcept
+            {
+                return !guard_ || guard_->get( atomics::memory_order_relaxed ) == nullptr;
+            }
+
+            /// \p bool operator returns <tt>!empty()</tt>
+            explicit operator bool() const noexcept
+            {
+                return !empty();
+            }
+
+            /// Clears guarded pointer
+            /**
+                If the guarded pointer has been released, the pointer can be disposed (freed) at any time.
+                Dereferncing the guarded pointer after \p release() is dangerous.
+            */
+            void release() noexcept
+            {
+                free_guard();
+            }
+
+            //@cond
+            // For internal use only!!!
+            void reset(guarded_type * p) noexcept
+            {
+                alloc_guard();
+                assert( guard_ );
+                guard_->set( p );
+            }
+            //@endcond
+
+        private:
+            //@cond
+            void alloc_guard()
+            {
+                if ( !guard_ )
+                    guard_ = ebr::smr::tls()->alloc_guard();
+            }
+
+            void free_guard()
+            {
+                if ( guard_ ) {
+                    ebr::smr::tls()->free_guard( guard_ );
+                    guard_ = nullptr;
+                }
+            }
+            //@endcond
+
+        private:
+            //@cond
+            ebr::guard* guard_;
+            //@endcond
+        };
+
+    public:
+        /// Initializes %EBR singleton
+        /**
+            The constructor initializes epoch-based SMR singleton with passed parameters.
+            If the instance does not yet exist then the function creates the instance.
+            Otherwise it does nothing.
+
+            The %EBR reclamation schema depends of three parameters:
+            - \p nGuardCount - guard count per thread. The guards are not published, so the count
+                limits only the guards that can be allocated simultaneously. If \p nGuardCount = 0, the defaul value 72
+                (enough for the skip-list) is used
+            - \p nBagCapacity - initial capacity of each of three limbo bags of the thread. Default is 256.
+                The bag is extended if needed.
+            - \p nEpochFreq - each thread tries to advance the global epoch after \p nEpochFreq retired pointers. Default is 64.
+                Less value means more precise reclamation and more reads of the announced epochs of other threads.
+        */
+        EBR(
+            size_t nGuardCount = 0,     ///< Guard count per thread
+            size_t nBagCapacity = 0,    ///< Initial capacity of limbo bag
+            size_t nEpochFreq = 0       ///< Epoch advance frequency
+        )
+        {
+            ebr::smr::construct(
+                nGuardCount,
+                nBagCapacity,
+                nEpochFreq
+            );
+        }
+
+        /// Terminates GC singleton
+        /**
+            The destructor destroys %EBR global object. After calling of this function you may \b NOT
+            use CDS data structures based on \p %cds::gc::EBR.
+            Usually, %EBR object is destroyed at the end of your \p main().
+        */
+        ~EBR()
+        {
+            ebr::smr::destruct( true );
+        }
+
+        /// Checks that required guard count \p nCountNeeded is less or equal then max guard count
+        /**
+            If <tt> nRequiredCount > max_hazard_count()</tt> then the exception \p not_enought_hazard_ptr is thrown
+        */
+        static void check_available_guards( size_t nCountNeeded )
+        {
+            ebr::smr::check_guard_count( nCountNeeded );
+        }
+
+        /// Set memory management functions
+        /**
+            @note This function may be called <b>BEFORE</b> creating an instance
+            of epoch-based SMR
+
+            SMR object allocates some memory for thread-specific data and for
+            creating SMR object.
+            By default, a standard \p new and \p delete operators are used for this.
+        */
+        static void set_memory_allocator(
+            void* ( *alloc_func )( size_t size ),   ///< \p malloc() function
+            void( *free_func )( void * p )          ///< \p free() function
+        )
+        {
+            ebr::smr::set_memory_allocator( alloc_func, free_func );
+        }
+
+        /// Returns max guard count per thread
+        static size_t max_hazard_count()
+        {
+            return ebr::smr::instance().get_guard_count();
+        }
+
+        /// Returns initial capacity of limbo bag
+        static size_t retired_array_capacity()
+        {
+            return ebr::smr::instance().get_bag_capacity();
+        }
+
+        /// Returns current global epoch
+        static ebr::epoch_t current_epoch()
+        {
+            return ebr::smr::instance().get_epoch();
+        }
+
+        /// Retire pointer \p p with function \p func
+        /**
+            The function places pointer \p p to the limbo bag of the current epoch.
+            The pointer can be safely removed when the global epoch has been advanced twice.
+            \p func is a disposer: when \p p can be safely removed, \p func is called.
+        */
+        template <typename T>
+        static void retire( T * p, void( *func )( void * ))
+        {
+            ebr::thread_data* rec = ebr::smr::tls();
+            if ( !rec->retire( cds::gc::details::retired_ptr( p, func )))
+                ebr::smr::instance().scan( rec );
+        }
+
+        /// Retire pointer \p p with functor of type \p Disposer
+        /**
+            The function places pointer \p p to the limbo bag of the current epoch.
+            The pointer can be safely removed when the global epoch has been advanced twice.
+
+            See \p cds::gc::HP::retire() for \p Disposer requirements.
+        */
+        template <class Disposer, typename T>
+        static void retire( T * p )
+        {
+            ebr::thread_data* rec = ebr::smr::tls();
+            if ( !rec->retire( cds::gc::details::retired_ptr( p, cds::gc::details::retired_functor<Disposer, T>::get())))
+                ebr::smr::instance().scan( rec );
+        }
+
+        /// Checks that %EBR singleton is initialized
+        static bool isUsed()
+        {
+            return ebr::smr::isUsed();
+        }
+
+        /// Forces reclamation
+        /**
+            The function tries to advance the global epoch and frees the limbo bags of the current thread
+            that are two epochs behind.
+            Usually, this function should not be called directly.
+        */
+        static void scan()
+        {
+            ebr::smr::instance().scan( ebr::smr::tls());
+        }
+
+        /// Forces reclamation of all objects retired by the current thread
+        /**
+            Unlike \p scan(), the function advances the global epoch twice, so all objects
+            retired by the current thread are freed if no other thread is inside an operation.
+            The containers call this function in the destructor.
+        */
+        static void force_dispose()
+        {
+            ebr::smr::instance().force_dispose( ebr::smr::tls());
+        }
+
+        /// Returns internal statistics
+        /**
+            The function clears \p st before gathering statistics.
+
+            @note Internal statistics is available only if you compile
+            \p libcds and your program with \p -DCDS_ENABLE_HPSTAT.
+        */
+        static void statistics( stat& st )
+        {
+            ebr::smr::instance().statistics( st );
+        }
+
+        /// Returns post-mortem statistics
+        /**
+            Post-mortem statistics is gathered in the \p %EBR object destructor
+            and can be accessible after destructing the global \p %EBR object.
+
+            @note Internal statistics is available only if you compile
+            \p libcds and your program with \p -DCDS_ENABLE_HPSTAT.
+        */
+        CDS_EXPORT_API static stat const& postmortem_statistics();
+    };
+
+}} // namespace cds::gc
+
+#endif // #ifndef CDSLIB_GC_EBR_SMR_H
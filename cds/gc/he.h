@@ -0,0 +1,1686 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSLIB_GC_HE_SMR_H
+#define CDSLIB_GC_HE_SMR_H
+
+#include <exception>
+#include <cds/gc/details/retired_ptr.h>
+#include <cds/gc/details/node_data.h>
+#include <cds/details/lib.h>
+#include <cds/threading/model.h>
+#include <cds/details/throw_exception.h>
+#include <cds/details/static_functor.h>
+#include <cds/details/marked_ptr.h>
+#include <cds/user_setup/cache_line.h>
+
+#ifdef CDS_ENABLE_HPSTAT
+#   define CDS_HESTAT( expr ) expr
+#else
+#   define CDS_HESTAT( expr )
+#endif
+
+namespace cds { namespace gc {
+    /// Hazard Eras implementation details
+    namespace he {
+
+        /// Hazard pointer type
+        typedef void*   hazard_ptr;
+
+        /// Era type
+        typedef uint64_t era_t;
+
+        //@cond
+        /// Era that marks free (non-published) hazard era slot
+        static constexpr era_t const c_no_era = 0;
+        //@endcond
+
+        /// Retired pointer
+        /**
+            The object born at era \p birth_ and retired at era \p era_ can be freed
+            when no thread publishes an era in the range <tt>[birth_, era_]</tt>.
+            The birth era \p c_no_era means unknown birth era: any era less than or equal to \p era_ protects the object.
+        */
+        struct retired_ptr: public cds::gc::details::retired_ptr
+        {
+            era_t   birth_; ///< The era when the object has been created
+            era_t   era_;   ///< The era when the object has been retired
+
+            //@cond
+            retired_ptr() noexcept
+                : birth_( c_no_era )
+                , era_( c_no_era )
+            {}
+
+            retired_ptr( cds::gc::details::retired_ptr const& rp, era_t birth, era_t era ) noexcept
+                : cds::gc::details::retired_ptr( rp.m_p, rp.m_funcFree )
+                , birth_( birth )
+                , era_( era )
+            {}
+            //@endcond
+        };
+
+        /// Exception "Not enough Hazard Eras"
+        class not_enought_hazard_ptr: public std::length_error
+        {
+        //@cond
+        public:
+            not_enought_hazard_ptr()
+                : std::length_error( "Not enough Hazard Eras" )
+            {}
+        //@endcond
+        };
+
+        /// Exception "Hazard Eras SMR is not initialized"
+        class not_initialized: public std::runtime_error
+        {
+        //@cond
+        public:
+            not_initialized()
+                : std::runtime_error( "Global Hazard Eras SMR object is not initialized" )
+            {}
+        //@endcond
+        };
+
+        //@cond
+        /// Hazard era guard
+        /**
+            The guard consists of the published era that is visible to all threads
+            and of the guarded pointer that is private to the owner thread.
+        */
+        class guard
+        {
+        public:
+            guard() noexcept
+                : era_( c_no_era )
+                , ptr_( nullptr )
+                , next_( nullptr )
+            {}
+
+            era_t era() const noexcept
+            {
+                return era_.load( atomics::memory_order_acquire );
+            }
+
+            era_t era( atomics::memory_order order ) const noexcept
+            {
+                return era_.load( order );
+            }
+
+            void publish( era_t era ) noexcept
+            {
+                era_.store( era, atomics::memory_order_release );
+            }
+
+            hazard_ptr get() const noexcept
+            {
+                return ptr_;
+            }
+
+            hazard_ptr get( atomics::memory_order ) const noexcept
+            {
+                return ptr_;
+            }
+
+            template <typename T>
+            T* get_as() const noexcept
+            {
+                return reinterpret_cast<T*>( get());
+            }
+
+            template <typename T>
+            void set( T* ptr ) noexcept
+            {
+                ptr_ = reinterpret_cast<hazard_ptr>( ptr );
+            }
+
+            template <typename T, int BITMASK>
+            void set( cds::details::marked_ptr<T, BITMASK> ptr ) noexcept
+            {
+                set( ptr.ptr());
+            }
+
+            void clear( atomics::memory_order order ) noexcept
+            {
+                ptr_ = nullptr;
+                era_.store( c_no_era, order );
+            }
+
+            void clear() noexcept
+            {
+                clear( atomics::memory_order_release );
+            }
+
+        private:
+            atomics::atomic<era_t>  era_;   // published era
+            hazard_ptr              ptr_;   // guarded pointer, private to the owner thread
+
+        public:
+            guard* next_;   // free guard list
+        };
+
+        /// Array of guards
+        template <size_t Capacity>
+        class guard_array
+        {
+        public:
+            static size_t const c_nCapacity = Capacity;
+
+        public:
+            guard_array()
+                : arr_{ nullptr }
+            {}
+
+            static constexpr size_t capacity()
+            {
+                return c_nCapacity;
+            }
+
+            guard* operator[]( size_t idx ) const noexcept
+            {
+                assert( idx < capacity());
+                return arr_[idx];
+            }
+
+            void clear( size_t idx ) noexcept
+            {
+                assert( idx < capacity());
+                assert( arr_[idx] != nullptr );
+
+                arr_[idx]->clear();
+            }
+
+            guard* release( size_t idx ) noexcept
+            {
+                assert( idx < capacity());
+
+                guard* g = arr_[idx];
+                arr_[idx] = nullptr;
+                return g;
+            }
+
+            void reset( size_t idx, guard* g ) noexcept
+            {
+                assert( idx < capacity());
+                assert( arr_[idx] == nullptr );
+
+                arr_[idx] = g;
+            }
+
+        private:
+            guard*  arr_[c_nCapacity];
+        };
+        //@endcond
+
+        //@cond
+        /// Per-thread hazard era storage
+        class thread_he_storage {
+        public:
+            thread_he_storage( guard* arr, size_t nSize ) noexcept
+                : free_head_( arr )
+                , array_( arr )
+                , capacity_( nSize )
+#       ifdef CDS_ENABLE_HPSTAT
+                , alloc_guard_count_(0)
+                , free_guard_count_(0)
+#       endif
+            {
+                // Initialize guards
+                new( arr ) guard[nSize];
+
+                for ( guard* pEnd = arr + nSize - 1; arr < pEnd; ++arr )
+                    arr->next_ = arr + 1;
+                arr->next_ = nullptr;
+            }
+
+            thread_he_storage() = delete;
+            thread_he_storage( thread_he_storage const& ) = delete;
+            thread_he_storage( thread_he_storage&& ) = delete;
+
+            size_t capacity() const noexcept
+            {
+                return capacity_;
+            }
+
+            bool full() const noexcept
+            {
+                return free_head_ == nullptr;
+            }
+
+            guard* alloc()
+            {
+#       ifdef CDS_DISABLE_SMR_EXCEPTION
+                assert( !full());
+#       else
+                if ( full())
+                    CDS_THROW_EXCEPTION( not_enought_hazard_ptr());
+#       endif
+                guard* g = free_head_;
+                free_head_ = g->next_;
+                CDS_HESTAT( ++alloc_guard_count_ );
+                return g;
+            }
+
+            void free( guard* g ) noexcept
+            {
+                assert( g >= array_ && g < array_ + capacity());
+
+                if ( g ) {
+                    g->clear();
+                    g->next_ = free_head_;
+                    free_head_ = g;
+                    CDS_HESTAT( ++free_guard_count_ );
+                }
+            }
+
+            template< size_t Capacity>
+            size_t alloc( guard_array<Capacity>& arr )
+            {
+                size_t i;
+                guard* g = free_head_;
+                for ( i = 0; i < Capacity && g; ++i ) {
+                    arr.reset( i, g );
+                    g = g->next_;
+                }
+
+#       ifdef CDS_DISABLE_SMR_EXCEPTION
+                assert( i == Capacity );
+#       else
+                if ( i != Capacity )
+                    CDS_THROW_EXCEPTION( not_enought_hazard_ptr());
+#       endif
+                free_head_ = g;
+                CDS_HESTAT( alloc_guard_count_ += Capacity );
+                return i;
+            }
+
+            template <size_t Capacity>
+            void free( guard_array<Capacity>& arr ) noexcept
+            {
+                guard* gList = free_head_;
+                for ( size_t i = 0; i < Capacity; ++i ) {
+                    guard* g = arr[i];
+                    if ( g ) {
+                        g->clear();
+                        g->next_ = gList;
+                        gList = g;
+                        CDS_HESTAT( ++free_guard_count_ );
+                    }
+                }
+                free_head_ = gList;
+            }
+
+            // cppcheck-suppress functionConst
+            void clear()
+            {
+                for ( guard* cur = array_, *last = array_ + capacity(); cur < last; ++cur )
+                    cur->clear();
+            }
+
+            /// Returns the era published by the guard that holds \p p or \p c_no_era if \p p is not guarded
+            era_t era_of( hazard_ptr p ) const noexcept
+            {
+                for ( guard const* cur = array_, *last = array_ + capacity(); cur < last; ++cur ) {
+                    if ( cur->get() == p )
+                        return cur->era( atomics::memory_order_relaxed );
+                }
+                return c_no_era;
+            }
+
+            guard& operator[]( size_t idx )
+            {
+                assert( idx < capacity());
+
+                return array_[idx];
+            }
+
+            static size_t calc_array_size( size_t capacity )
+            {
+                return sizeof( guard ) * capacity;
+            }
+
+        private:
+            guard*          free_head_; ///< Head of free guard list
+            guard* const    array_;     ///< Hazard era array
+            size_t const    capacity_;  ///< Hazard era array capacity
+#       ifdef CDS_ENABLE_HPSTAT
+        public:
+            size_t          alloc_guard_count_;
+            size_t          free_guard_count_;
+#       endif
+        };
+        //@endcond
+
+        //@cond
+        /// Per-thread retired array
+        /**
+            Unlike \p cds::gc::HP, the retired array of Hazard Eras is growable:
+            an era protects every object that was alive at that era, so the number of objects
+            that cannot be freed is not bounded by the hazard count. \p smr::scan() extends
+            the array when less than half of it has been freed.
+        */
+        class retired_array
+        {
+            friend class smr;
+        public:
+            retired_array( retired_ptr* arr, size_t capacity ) noexcept
+                : current_( arr )
+                , last_( arr + capacity )
+                , retired_( arr )
+                , initial_( arr )
+#       ifdef CDS_ENABLE_HPSTAT
+                , retire_call_count_(0)
+                , extend_call_count_(0)
+#       endif
+            {}
+
+            retired_array() = delete;
+            retired_array( retired_array const& ) = delete;
+            retired_array( retired_array&& ) = delete;
+
+            size_t capacity() const noexcept
+            {
+                return last_ - retired_;
+            }
+
+            size_t size() const noexcept
+            {
+                return current_ - retired_;
+            }
+
+            bool push( retired_ptr const& p ) noexcept
+            {
+                assert( current_ < last_ );
+                *current_ = p;
+                CDS_HESTAT( ++retire_call_count_ );
+                return ++current_ < last_;
+            }
+
+            bool repush( retired_ptr const& p ) noexcept
+            {
+                bool ret = push( p );
+                CDS_HESTAT( --retire_call_count_ );
+                return ret;
+            }
+
+            retired_ptr* first() const noexcept
+            {
+                return retired_;
+            }
+
+            retired_ptr* last() const noexcept
+            {
+                return current_;
+            }
+
+            void reset( size_t nSize ) noexcept
+            {
+                current_ = first() + nSize;
+            }
+
+            bool full() const noexcept
+            {
+                return current_ == last_;
+            }
+
+            static size_t calc_array_size( size_t capacity )
+            {
+                return sizeof( retired_ptr ) * capacity;
+            }
+
+        private:
+            retired_ptr*        current_;
+            retired_ptr*        last_;
+            retired_ptr*        retired_;
+            retired_ptr* const  initial_;   ///< initial array allocated with thread record
+#       ifdef CDS_ENABLE_HPSTAT
+        public:
+            size_t  retire_call_count_;
+            size_t  extend_call_count_;
+#       endif
+        };
+        //@endcond
+
+        /// Internal statistics
+        struct stat {
+            size_t  guard_allocated;    ///< Count of allocated HE guards
+            size_t  guard_freed;        ///< Count of freed HE guards
+            size_t  retired_count;      ///< Count of retired pointers
+            size_t  free_count;         ///< Count of free pointers
+            size_t  scan_count;         ///< Count of \p scan() call
+            size_t  help_scan_count;    ///< Count of \p help_scan() call
+            size_t  era_publish_count;  ///< Count of era publications, i.e. count of fences on the read side
+            size_t  retired_extend_count; ///< Count of retired array \p extend() call
+
+            size_t  thread_rec_count;   ///< Count of thread records
+
+            /// Default ctor
+            stat()
+            {
+                clear();
+            }
+
+            /// Clears all counters
+            void clear()
+            {
+                guard_allocated =
+                    guard_freed =
+                    retired_count =
+                    free_count =
+                    scan_count =
+                    help_scan_count =
+                    era_publish_count =
+                    retired_extend_count =
+                    thread_rec_count = 0;
+            }
+        };
+
+        //@cond
+        /// Per-thread data
+        struct thread_data {
+            thread_he_storage   hazards_;   ///< Hazard eras private to the thread
+            retired_array       retired_;   ///< Retired data private to the thread
+            atomics::atomic<era_t>& global_era_;    ///< Global era clock
+            size_t const        era_freq_;  ///< Global era is advanced after each \p era_freq_ retired pointers
+            size_t              retire_count_;  ///< Retired pointers after the last advance of the global era
+
+            char pad1_[cds::c_nCacheLineSize];
+            atomics::atomic<unsigned int> sync_; ///< dummy var to introduce synchronizes-with relationship between threads
+            char pad2_[cds::c_nCacheLineSize];
+
+#       ifdef CDS_ENABLE_HPSTAT
+            // Internal statistics:
+            size_t              free_count_;
+            size_t              scan_count_;
+            size_t              help_scan_count_;
+            size_t              publish_count_;
+#       endif
+
+            // CppCheck warn: pad1_ and pad2_ is uninitialized in ctor
+            // cppcheck-suppress uninitMemberVar
+            thread_data( guard* guards, size_t guard_count, retired_ptr* retired_arr, size_t retired_capacity, atomics::atomic<era_t>& global_era, size_t era_freq )
+                : hazards_( guards, guard_count )
+                , retired_( retired_arr, retired_capacity )
+                , global_era_( global_era )
+                , era_freq_( era_freq )
+                , retire_count_( 0 )
+                , sync_(0)
+#       ifdef CDS_ENABLE_HPSTAT
+                , free_count_(0)
+                , scan_count_(0)
+                , help_scan_count_(0)
+                , publish_count_(0)
+#       endif
+            {}
+
+            thread_data() = delete;
+            thread_data( thread_data const& ) = delete;
+            thread_data( thread_data&& ) = delete;
+
+            void sync()
+            {
+                sync_.fetch_add( 1, atomics::memory_order_acq_rel );
+            }
+
+            era_t current_era() const noexcept
+            {
+                return global_era_.load( atomics::memory_order_acquire );
+            }
+
+            /// Publishes \p era in the guard \p g
+            void publish( guard* g, era_t era )
+            {
+                g->publish( era );
+                sync();
+                CDS_HESTAT( ++publish_count_ );
+            }
+
+            /// Protects the pointer \p p that is already protected by the thread or cannot be retired concurrently
+            /**
+                If \p p is guarded by another guard of the thread, that guard may hold an era
+                that is older than the current global era and the object may be already retired,
+                so the function publishes the era of that guard.
+                Otherwise, the object is not retired yet and the current era protects it.
+            */
+            template <typename T>
+            void protect_guarded( guard* g, T p )
+            {
+                era_t era = hazards_.era_of( reinterpret_cast<hazard_ptr>( p ));
+                if ( era == c_no_era )
+                    era = current_era();
+                if ( g->era( atomics::memory_order_relaxed ) != era )
+                    publish( g, era );
+                g->set( p );
+            }
+
+            /// Pushes \p p born at era \p birth to the retired array, returns \p false if the array is full
+            bool retire( cds::gc::details::retired_ptr const& p, era_t birth )
+            {
+                bool const ret = retired_.push( retired_ptr( p, birth, current_era()));
+                if ( ++retire_count_ >= era_freq_ ) {
+                    retire_count_ = 0;
+                    global_era_.fetch_add( 1, atomics::memory_order_acq_rel );
+                }
+                return ret;
+            }
+        };
+        //@endcond
+
+        //@cond
+        /// Hazard Eras SMR (Safe Memory Reclamation)
+        class smr
+        {
+            struct thread_record;
+
+        public:
+            /// Returns the instance of Hazard Eras \ref smr
+            static smr& instance()
+            {
+#       ifdef CDS_DISABLE_SMR_EXCEPTION
+                assert( instance_ != nullptr );
+#       else
+                if ( !instance_ )
+                    CDS_THROW_EXCEPTION( not_initialized());
+#       endif
+                return *instance_;
+            }
+
+            /// Creates Hazard Eras SMR singleton
+            /**
+                Hazard Eras SMR is a singleton. If HE instance is not initialized then the function creates the instance.
+                Otherwise it does nothing.
+
+                The parameters:
+                - \p nHazardEraCount - hazard era count per thread. Default is 8.
+                - \p nMaxThreadCount - max count of thread with using HE GC in your application. Default is 100.
+                - \p nMaxRetiredPtrCount - initial capacity of array of retired pointers for each thread.
+                    Default is <tt>2 * nHazardEraCount * nMaxThreadCount</tt>
+                - \p nEraFreq - each thread advances the global era after \p nEraFreq retired pointers.
+                    Default is 64.
+            */
+            static CDS_EXPORT_API void construct(
+                size_t nHazardEraCount = 0,     ///< Hazard era count per thread
+                size_t nMaxThreadCount = 0,     ///< Max count of simultaneous working thread in your application
+                size_t nMaxRetiredPtrCount = 0, ///< Initial capacity of the array of retired objects for the thread
+                size_t nEraFreq = 0             ///< Era advance frequency
+            );
+
+            /// Destroys global instance of \ref smr
+            /**
+                The parameter \p bDetachAll should be used carefully: if its value is \p true,
+                then the object destroyed automatically detaches all attached threads. This feature
+                can be useful when you have no control over the thread termination, for example,
+                when \p libcds is injected into existing external thread.
+            */
+            static CDS_EXPORT_API void destruct(
+                bool bDetachAll = false     ///< Detach all threads
+            );
+
+            /// Checks if global SMR object is constructed and may be used
+            static bool isUsed() noexcept
+            {
+                return instance_ != nullptr;
+            }
+
+            /// Set memory management functions
+            /**
+                @note This function may be called <b>BEFORE</b> creating an instance
+                of Hazard Eras SMR
+
+                SMR object allocates some memory for thread-specific data and for
+                creating SMR object.
+                By default, a standard \p new and \p delete operators are used for this.
+            */
+            static CDS_EXPORT_API void set_memory_allocator(
+                void* ( *alloc_func )( size_t size ),
+                void (*free_func )( void * p )
+            );
+
+            /// Returns max hazard era count per thread
+            size_t get_hazard_ptr_count() const noexcept
+            {
+                return hazard_ptr_count_;
+            }
+
+            /// Returns max thread count
+            size_t get_max_thread_count() const noexcept
+            {
+                return max_thread_count_;
+            }
+
+            /// Returns initial size of retired objects array
+            size_t get_max_retired_ptr_count() const noexcept
+            {
+                return max_retired_ptr_count_;
+            }
+
+            /// Returns era advance frequency
+            size_t get_era_freq() const noexcept
+            {
+                return era_freq_;
+            }
+
+            /// Returns current global era
+            era_t get_era() const noexcept
+            {
+                return global_era_.load( atomics::memory_order_acquire );
+            }
+
+            /// Checks that required hazard era count \p nRequiredCount is less or equal then max hazard era count
+            /**
+                If <tt> nRequiredCount > get_hazard_ptr_count()</tt> then the exception \p not_enought_hazard_ptr is thrown
+            */
+            static void check_hazard_ptr_count( size_t nRequiredCount )
+            {
+                if ( instance().get_hazard_ptr_count() < nRequiredCount ) {
+#       ifdef CDS_DISABLE_SMR_EXCEPTION
+                    assert( false );    // not enough hazard era
+#       else
+                    CDS_THROW_EXCEPTION( not_enought_hazard_ptr());
+#       endif
+                }
+            }
+
+            /// Returns thread-local data for the current thread, attaching the thread to the GC on first call
+            static CDS_EXPORT_API thread_data* tls();
+
+            static CDS_EXPORT_API void attach_thread();
+            static CDS_EXPORT_API void detach_thread();
+
+            /// Get internal statistics
+            CDS_EXPORT_API void statistics( stat& st );
+
+        public: // for internal use only
+            /// The main garbage collecting function
+            /**
+                The function advances the global era and collects the eras published by all threads.
+                Each retired pointer is freed if no published era lies in the range
+                from its birth era to its retire era.
+                If less than half of the retired array has been freed, the array is extended.
+            */
+            CDS_EXPORT_API void scan( thread_data* pRec );
+
+            /// Helper scan routine
+            /**
+                The function moves all retired pointers of inactive thread records
+                to thread's list of retired pointers.
+
+                The function is called internally by \p scan().
+            */
+            CDS_EXPORT_API void help_scan( thread_data* pThis );
+
+        private:
+            CDS_EXPORT_API smr(
+                size_t nHazardEraCount,     ///< Hazard era count per thread
+                size_t nMaxThreadCount,     ///< Max count of simultaneous working thread in your application
+                size_t nMaxRetiredPtrCount, ///< Initial capacity of the array of retired objects for the thread
+                size_t nEraFreq             ///< Era advance frequency
+            );
+
+            CDS_EXPORT_API ~smr();
+
+            CDS_EXPORT_API void detach_all_thread();
+
+            /// Extends retired array of the thread
+            void extend_retired( retired_array& arr );
+
+        private:
+            CDS_EXPORT_API thread_record* create_thread_data();
+            static CDS_EXPORT_API void destroy_thread_data( thread_record* pRec );
+
+            /// Allocates Hazard Eras SMR thread private data
+            CDS_EXPORT_API thread_record* alloc_thread_data();
+
+            /// Free HE SMR thread-private data
+            CDS_EXPORT_API void free_thread_data( thread_record* pRec );
+
+        private:
+            static CDS_EXPORT_API smr* instance_;
+
+            atomics::atomic< thread_record*>    thread_list_;   ///< Head of thread list
+
+            size_t const    hazard_ptr_count_;      ///< max count of thread's hazard eras
+            size_t const    max_thread_count_;      ///< max count of thread
+            size_t const    max_retired_ptr_count_; ///< initial count of retired ptr per thread
+            size_t const    era_freq_;              ///< era advance frequency
+
+            char pad1_[cds::c_nCacheLineSize];
+            atomics::atomic<era_t>  global_era_;    ///< Global era clock
+            char pad2_[cds::c_nCacheLineSize];
+        };
+        //@endcond
+
+    } // namespace he
+
+    class HE;
+
+    namespace details {
+        /// Birth era of the node for \p cds::gc::HE
+        /**
+            The node created before \p %HE is initialized has unknown birth era \p he::c_no_era.
+        */
+        template <>
+        struct node_data<HE>
+        {
+            he::era_t   birth_era_; ///< The global era when the node has been created
+
+            //@cond
+            node_data() noexcept
+                : birth_era_( he::smr::isUsed() ? he::smr::instance().get_era() : he::c_no_era )
+            {}
+            //@endcond
+
+            /// Retires the value \p p that owns the node, see \p cds::gc::HE::retire( T*, he::era_t )
+            template <typename Disposer, typename T>
+            void retire( T* p ) const;
+        };
+    } // namespace details
+
+    /// Hazard Eras SMR (Safe Memory Reclamation)
+    /**  @ingroup cds_garbage_collector
+
+        Implementation of Hazard Eras SMR
+
+        Sources:
+            - [2017] Pedro Ramalhete, Andreia Correia "Brief Announcement: Hazard Eras - Non-Blocking Memory
+                Reclamation"
+
+        Hazard Eras is an interface-compatible replacement of \p cds::gc::HP. The global era clock
+        is advanced periodically by \p retire(). Instead of the pointer, the guard publishes
+        the era when the pointer has been read. Since the era changes rarely, \p Guard::protect()
+        publishes the era (and, therefore, issues the store-load fence) only when the global era
+        differs from the era already published by the guard. So, the traversal of a list or a skip-list
+        costs just one fence per era change instead of one fence per hop.
+
+        The node of a container records the global era when it has been created (the birth era)
+        in its \p cds::gc::details::node_data<HE> base, and the object is retired with the current global era.
+        The object can be freed when no thread publishes an era between its birth era and its retire era.
+        So, a stalled reader delays freeing only of the objects that were alive at the era it published,
+        the objects created after that era are freed as usual.
+        The birth era of an object that is not a node of an intrusive container with base hook
+        (for example, a member-hooked item or an internal object of a queue) is unknown,
+        any era published before the object has been retired protects it.
+
+        Hazard Eras SMR is a singleton. Before use any HE-related class you must initialize \p %HE
+        by contructing \p %cds::gc::HE object in beginning of your \p main().
+        To use the containers with \p %HE, include the corresponding <tt>*_he.h</tt> header, for example,
+        <tt>cds/container/michael_list_he.h</tt>.
+    */
+    class HE
+    {
+    public:
+        /// Native guarded pointer type
+        typedef he::hazard_ptr guarded_pointer;
+
+        /// Atomic reference
+        template <typename T> using atomic_ref = atomics::atomic<T *>;
+
+        /// Atomic marked pointer
+        template <typename MarkedPtr> using atomic_marked_ptr = atomics::atomic<MarkedPtr>;
+
+        /// Atomic type
+        template <typename T> using atomic_type = atomics::atomic<T>;
+
+        /// Exception "Not enough Hazard Eras"
+        typedef he::not_enought_hazard_ptr not_enought_hazard_ptr_exception;
+
+        /// Internal statistics
+        typedef he::stat stat;
+
+        /// Hazard Eras guard
+        /**
+            The guard has the same interface as \p cds::gc::HP::Guard.
+            The guard publishes the era when the pointer has been read; the guarded pointer itself
+            is private to the owner thread.
+
+            \p %Guard object is movable but not copyable.
+
+            The guard object can be in two states:
+            - unlinked - the guard is not linked with any internal hazard era slot.
+              In this state no operation except \p link() and move assignment is supported.
+            - linked (default) - the guard allocates an internal hazard era slot and completely operable.
+
+            @warning Move assignment transfers the guard in unlinked state, use with care.
+        */
+        class Guard
+        {
+        public:
+            /// Default ctor allocates a guard (hazard era slot) from thread-private storage
+            /**
+                @warning Can throw \p not_enought_hazard_ptr_exception if internal hazard era slots are exhausted.
+            */
+            Guard()
+                : guard_( he::smr::tls()->hazards_.alloc())
+            {}
+
+            /// Initilalizes an unlinked guard i.e. the guard contains no hazard era slot. Used for move semantics support
+            explicit Guard( std::nullptr_t ) noexcept
+                : guard_( nullptr )
+            {}
+
+            /// Move ctor - \p src guard becomes unlinked (transfer internal guard ownership)
+            Guard( Guard&& src ) noexcept
+                : guard_( src.guard_ )
+            {
+                src.guard_ = nullptr;
+            }
+
+            /// Move assignment: the internal guards are swapped between \p src and \p this
+            /**
+                @warning \p src will become in unlinked state if \p this was unlinked on entry.
+            */
+            Guard& operator=( Guard&& src ) noexcept
+            {
+                std::swap( guard_, src.guard_ );
+                return *this;
+            }
+
+            /// Copy ctor is prohibited - the guard is not copyable
+            Guard( Guard const& ) = delete;
+
+            /// Copy assignment is prohibited
+            Guard& operator=( Guard const& ) = delete;
+
+            /// Frees the internal hazard era slot if the guard is in linked state
+            ~Guard()
+            {
+                unlink();
+            }
+
+            /// Checks if the guard object linked with any internal hazard era slot
+            bool is_linked() const
+            {
+                return guard_ != nullptr;
+            }
+
+            /// Links the guard with internal hazard era slot if the guard is in unlinked state
+            /**
+                @warning Can throw \p not_enought_hazard_ptr_exception if internal hazard era array is exhausted.
+            */
+            void link()
+            {
+                if ( !guard_ )
+                    guard_ = he::smr::tls()->hazards_.alloc();
+            }
+
+            /// Unlinks the guard from internal hazard era slot. The guard becomes in unlinked state
+            void unlink()
+            {
+                if ( guard_ ) {
+                    he::smr::tls()->hazards_.free( guard_ );
+                    guard_ = nullptr;
+                }
+            }
+
+            /// Protects a pointer of type \p atomic<T*>
+            /**
+                Return the value of \p toGuard
+
+                The function loads \p toGuard and publishes the current global era
+                repeatedly until the global era equals the era published by the guard.
+                If the era has not been changed since the last call, no store and no fence is performed.
+
+                @warning The guad object should be in linked state, otherwise the result is undefined
+            */
+            template <typename T>
+            T protect( atomics::atomic<T> const& toGuard )
+            {
+                assert( guard_ != nullptr );
+
+                he::thread_data* rec = he::smr::tls();
+                he::era_t prev = guard_->era( atomics::memory_order_relaxed );
+                for ( ;; ) {
+                    T pCur = toGuard.load( atomics::memory_order_acquire );
+                    he::era_t const era = rec->current_era();
+                    if ( era == prev ) {
+                        guard_->set( pCur );
+                        return pCur;
+                    }
+                    rec->publish( guard_, era );
+                    prev = era;
+                }
+            }
+
+            /// Protects a converted pointer of type \p atomic<T*>
+            /**
+                Return the value of \p toGuard
+
+                The function is the same as \p protect( toGuard ) but the result of <tt> f( toGuard.load()) </tt>
+                is stored as the guarded pointer.
+
+                The function is useful for intrusive containers when \p toGuard is a node pointer
+                that should be converted to a pointer to the value before protecting.
+                The parameter \p f of type Func is a functor that makes this conversion:
+                \code
+                    struct functor {
+                        value_type * operator()( T * p );
+                    };
+                \endcode
+
+                @warning The guad object should be in linked state, otherwise the result is undefined
+            */
+            template <typename T, class Func>
+            T protect( atomics::atomic<T> const& toGuard, Func f )
+            {
+                assert( guard_ != nullptr );
+
+                he::thread_data* rec = he::smr::tls();
+                he::era_t prev = guard_->era( atomics::memory_order_relaxed );
+                for ( ;; ) {
+                    T pCur = toGuard.load( atomics::memory_order_acquire );
+                    he::era_t const era = rec->current_era();
+                    if ( era == prev ) {
+                        guard_->set( f( pCur ));
+                        return pCur;
+                    }
+                    rec->publish( guard_, era );
+                    prev = era;
+                }
+            }
+
+            /// Store \p p to the guard
+            /**
+                The function is intended for a pointer that cannot be changed concurrently
+                or if the pointer is already guarded by another guard of the thread.
+                If another guard of the thread holds \p p, the guard publishes the era of that guard,
+                otherwise it publishes the current global era.
+
+                @warning The guad object should be in linked state, otherwise the result is undefined
+            */
+            template <typename T>
+            T * assign( T* p )
+            {
+                assert( guard_ != nullptr );
+
+                he::smr::tls()->protect_guarded( guard_, p );
+                return p;
+            }
+
+            //@cond
+            std::nullptr_t assign( std::nullptr_t )
+            {
+                assert( guard_ != nullptr );
+
+                guard_->clear();
+                return nullptr;
+            }
+            //@endcond
+
+            /// Copy a value guarded from \p src guard to \p this guard (valid only in linked state)
+            void copy( Guard const& src )
+            {
+                assert( guard_ != nullptr );
+                assert( src.guard_ != nullptr );
+
+                he::era_t const era = src.guard_->era( atomics::memory_order_relaxed );
+                if ( guard_->era( atomics::memory_order_relaxed ) != era )
+                    he::smr::tls()->publish( guard_, era );
+                guard_->set( src.guard_->get());
+            }
+
+            /// Store marked pointer \p p to the guard
+            /**
+                The function equals to a simple assignment of <tt>p.ptr()</tt>, no loop is performed.
+                Can be used for a marked pointer that cannot be changed concurrently or if the marked pointer
+                is already guarded by another guard.
+
+                @warning The guard object should be in linked state, otherwise the result is undefined
+            */
+            template <typename T, int BITMASK>
+            T * assign( cds::details::marked_ptr<T, BITMASK> p )
+            {
+                return assign( p.ptr());
+            }
+
+            /// Clear value of the guard (valid only in linked state)
+            void clear()
+            {
+                assign( nullptr );
+            }
+
+            /// Get the value currently protected (valid only in linked state)
+            template <typename T>
+            T * get() const
+            {
+                assert( guard_ != nullptr );
+                return guard_->get_as<T>();
+            }
+
+            /// Get native guarded pointer stored (valid only in linked state)
+            guarded_pointer get_native() const
+            {
+                assert( guard_ != nullptr );
+                return guard_->get();
+            }
+
+            //@cond
+            he::guard* release()
+            {
+                he::guard* g = guard_;
+                guard_ = nullptr;
+                return g;
+            }
+
+            he::guard*& guard_ref()
+            {
+                return guard_;
+            }
+
+            he::guard const* guard_ptr() const
+            {
+                return guard_;
+            }
+            //@endcond
+
+        private:
+            //@cond
+            he::guard* guard_;
+            //@endcond
+        };
+
+        /// Array of Hazard Eras guards
+        /**
+            The class is intended for allocating an array of hazard era guards.
+            Template parameter \p Count defines the size of the array.
+            The interface is the same as \p cds::gc::HP::GuardArray.
+        */
+        template <size_t Count>
+        class GuardArray
+        {
+        public:
+            /// Rebind array for other size \p Count2
+            template <size_t Count2>
+            struct rebind {
+                typedef GuardArray<Count2>  other;   ///< rebinding result
+            };
+
+            /// Array capacity
+            static constexpr const size_t c_nCapacity = Count;
+
+        public:
+            /// Default ctor allocates \p Count hazard era slots
+            GuardArray()
+            {
+                he::smr::tls()->hazards_.alloc( guards_ );
+            }
+
+            /// Move ctor is prohibited
+            GuardArray( GuardArray&& ) = delete;
+
+            /// Move assignment is prohibited
+            GuardArray& operator=( GuardArray&& ) = delete;
+
+            /// Copy ctor is prohibited
+            GuardArray( GuardArray const& ) = delete;
+
+            /// Copy assignment is prohibited
+            GuardArray& operator=( GuardArray const& ) = delete;
+
+            /// Frees allocated hazard era slots
+            ~GuardArray()
+            {
+                he::smr::tls()->hazards_.free( guards_ );
+            }
+
+            /// Protects a pointer of type \p atomic<T*>
+            /**
+                Return the value of \p toGuard
+
+                The function loads \p toGuard and publishes the current global era in the slot \p nIndex
+                repeatedly until the global era equals the era published by the slot.
+            */
+            template <typename T>
+            T protect( size_t nIndex, atomics::atomic<T> const& toGuard )
+            {
+                assert( nIndex < capacity());
+
+                he::guard* g = guards_[nIndex];
+                he::thread_data* rec = he::smr::tls();
+                he::era_t prev = g->era( atomics::memory_order_relaxed );
+                for ( ;; ) {
+                    T pRet = toGuard.load( atomics::memory_order_acquire );
+                    he::era_t const era = rec->current_era();
+                    if ( era == prev ) {
+                        g->set( pRet );
+                        return pRet;
+                    }
+                    rec->publish( g, era );
+                    prev = era;
+                }
+            }
+
+            /// Protects a pointer of type \p atomic<T*>
+            /**
+                Return the value of \p toGuard
+
+                The function is the same as \p protect( nIndex, toGuard ) but the result of <tt> f( toGuard.load()) </tt>
+                is stored as the guarded pointer.
+            */
+            template <typename T, class Func>
+            T protect( size_t nIndex, atomics::atomic<T> const& toGuard, Func f )
+            {
+                assert( nIndex < capacity());
+
+                he::guard* g = guards_[nIndex];
+                he::thread_data* rec = he::smr::tls();
+                he::era_t prev = g->era( atomics::memory_order_relaxed );
+                for ( ;; ) {
+                    T pRet = toGuard.load( atomics::memory_order_acquire );
+                    he::era_t const era = rec->current_era();
+                    if ( era == prev ) {
+                        g->set( f( pRet ));
+                        return pRet;
+                    }
+                    rec->publish( g, era );
+                    prev = era;
+                }
+            }
+
+            /// Store \p p to the slot \p nIndex
+            /**
+                The function is intended for a pointer that cannot be changed concurrently
+                or if the pointer is already guarded by another guard of the thread.
+            */
+            template <typename T>
+            T * assign( size_t nIndex, T * p )
+            {
+                assert( nIndex < capacity());
+
+                he::smr::tls()->protect_guarded( guards_[nIndex], p );
+                return p;
+            }
+
+            /// Store marked pointer \p p to the guard
+            /**
+                The function equals to a simple assignment of <tt>p.ptr()</tt>, no loop is performed.
+                Can be used for a marked pointer that cannot be changed concurrently.
+            */
+            template <typename T, int BITMASK>
+            T * assign( size_t nIndex, cds::details::marked_ptr<T, BITMASK> p )
+            {
+                return assign( nIndex, p.ptr());
+            }
+
+            /// Copy guarded value from \p src guard to slot at index \p nIndex
+            void copy( size_t nIndex, Guard const& src )
+            {
+                assert( nIndex < capacity());
+                copy_guard( guards_[nIndex], src.get_native(), src.guard_ptr());
+            }
+
+            /// Copy guarded value from slot \p nSrcIndex to the slot \p nDestIndex
+            void copy( size_t nDestIndex, size_t nSrcIndex )
+            {
+                assert( nDestIndex < capacity());
+                assert( nSrcIndex < capacity());
+                copy_guard( guards_[nDestIndex], get_native( nSrcIndex ), guards_[nSrcIndex] );
+            }
+
+            /// Clear value of the slot \p nIndex
+            void clear( size_t nIndex )
+            {
+                guards_.clear( nIndex );
+            }
+
+            /// Get current value of slot \p nIndex
+            template <typename T>
+            T * get( size_t nIndex ) const
+            {
+                assert( nIndex < capacity());
+                return guards_[nIndex]->template get_as<T>();
+            }
+
+            /// Get native guarded pointer stored
+            guarded_pointer get_native( size_t nIndex ) const
+            {
+                assert( nIndex < capacity());
+                return guards_[nIndex]->get();
+            }
+
+            //@cond
+            he::guard* release( size_t nIndex ) noexcept
+            {
+                return guards_.release( nIndex );
+            }
+            //@endcond
+
+            /// Capacity of the guard array
+            static constexpr size_t capacity()
+            {
+                return c_nCapacity;
+            }
+
+        private:
+            //@cond
+            static void copy_guard( he::guard* dest, guarded_pointer p, he::guard const* src )
+            {
+                he::era_t const era = src->era( atomics::memory_order_relaxed );
+                if ( dest->era( atomics::memory_order_relaxed ) != era )
+                    he::smr::tls()->publish( dest, era );
+                dest->set( p );
+            }
+            //@endcond
+
+        private:
+            //@cond
+            he::guard_array<c_nCapacity> guards_;
+            //@endcond
+        };
+
+        /// Guarded pointer
+        /**
+            A guarded pointer is a pair of a pointer and GC's guard.
+            Usually, it is used for returning a pointer to an element of a lock-free container.
+            The guard prevents the pointer to be early disposed (freed) by SMR.
+            After destructing \p %guarded_ptr object the pointer can be disposed (freed) automatically at any time.
+
+            The interface is the same as \p cds::gc::HP::guarded_ptr.
+
+            Template arguments:
+            - \p GuardedType - a type which the guard stores
+            - \p ValueType - a value type
+            - \p Cast - a functor for converting <tt>GuardedType*</tt> to <tt>ValueType*</tt>. Default is \p void (no casting).
+
+            You don't need use this class directly.
+            All set/map container classes from \p libcds declare the typedef for \p %guarded_ptr with appropriate casting functor.
+        */
+        template <typename GuardedType, typename ValueType=GuardedType, typename Cast=void >
+        class guarded_ptr
+        {
+            //@cond
+            struct trivial_cast {
+                ValueType * operator()( GuardedType * p ) const
+                {
+                    return p;
+                }
+            };
+
+            template <typename GT, typename VT, typename C> friend class guarded_ptr;
+            //@endcond
+
+        public:
+            typedef GuardedType guarded_type; ///< Guarded type
+            typedef ValueType   value_type;   ///< Value type
+
+            /// Functor for casting \p guarded_type to \p value_type
+            typedef typename std::conditional< std::is_same<Cast, void>::value, trivial_cast, Cast >::type value_cast;
+
+        public:
+            /// Creates empty guarded pointer
+            guarded_ptr() noexcept
+                : guard_(nullptr)
+            {}
+
+            //@cond
+            explicit guarded_ptr( he::guard* g ) noexcept
+                : guard_( g )
+            {}
+
+            /// Initializes guarded pointer with \p p
+            explicit guarded_ptr( guarded_type* p ) noexcept
+                : guard_( nullptr )
+            {
+                reset(p);
+            }
+            explicit guarded_ptr( std::nullptr_t ) noexcept
+                : guard_( nullptr )
+            {}
+            //@endcond
+
+            /// Move ctor
+            guarded_ptr( guarded_ptr&& gp ) noexcept
+                : guard_( gp.guard_ )
+            {
+                gp.guard_ = nullptr;
+            }
+
+            /// Move ctor
+            template <typename GT, typename VT, typename C>
+            guarded_ptr( guarded_ptr<GT, VT, C>&& gp ) noexcept
+                : guard_( gp.guard_ )
+            {
+                gp.guard_ = nullptr;
+            }
+
+            /// Ctor from \p Guard
+            explicit guarded_ptr( Guard&& g ) noexcept
+                : guard_( g.release())
+            {}
+
+            /// The guarded pointer is not copy-constructible
+            guarded_ptr( guarded_ptr const& gp ) = delete;
+
+            /// Clears the guarded pointer
+            /**
+                \ref release() is called if guarded pointer is not \ref empty()
+            */
+            ~guarded_ptr() noexcept
+            {
+                release();
+            }
+
+            /// Move-assignment operator
+            guarded_ptr& operator=( guarded_ptr&& gp ) noexcept
+            {
+                std::swap( guard_, gp.guard_ );
+                return *this;
+            }
+
+            /// Move-assignment from \p Guard
+            guarded_ptr& operator=( Guard&& g ) noexcept
+            {
+                std::swap( guard_, g.guard_ref());
+                return *this;
+            }
+
+            /// The guarded pointer is not copy-assignable
+            guarded_ptr& operator=(guarded_ptr const& gp) = delete;
+
+            /// Returns a pointer to guarded value
+            value_type * operator ->() const noexcept
+            {
+                assert( !empty());
+                return value_cast()( guard_->get_as<guarded_type>());
+            }
+
+            /// Returns a reference to guarded value
+            value_type& operator *() noexcept
+            {
+                assert( !empty());
+                return *value_cast()( guard_->get_as<guarded_type>());
+            }
+
+            /// Returns const reference to guarded value
+            value_type const& operator *() const noexcept
+            {
+                assert( !empty());
+                return *value_cast()( guard_->get_as<guarded_type>());
+            }
+
+            /// Checks if the guarded pointer is \p nullptr
+            bool empty() const noexcept
+            {
+                return !guard_ || guard_->get( atomics::memory_order_relaxed ) == nullptr;
+            }
+
+            /// \p bool operator returns <tt>!empty()</tt>
+            explicit operator bool() const noexcept
+            {
+                return !empty();
+            }
+
+            /// Clears guarded pointer
+            /**
+                If the guarded pointer has been released, the pointer can be disposed (freed) at any time.
+                Dereferncing the guarded pointer after \p release() is dangerous.
+            */
+            void release() noexcept
+            {
+                free_guard();
+            }
+
+            //@cond
+            // For internal use only!!!
+            void reset(guarded_type * p) noexcept
+            {
+                alloc_guard();
+                assert( guard_ );
+                he::smr::tls()->protect_guarded( guard_, p );
+            }
+            //@endcond
+
+        private:
+            //@cond
+            void alloc_guard()
+            {
+                if ( !guard_ )
+                    guard_ = he::smr::tls()->hazards_.alloc();
+            }
+
+            void free_guard()
+            {
+                if ( guard_ ) {
+                    he::smr::tls()->hazards_.free( guard_ );
+                    guard_ = nullptr;
+                }
+            }
+            //@endcond
+
+        private:
+            //@cond
+            he::guard* guard_;
+            //@endcond
+        };
+
+    public:
+        /// Initializes %HE singleton
+        /**
+            The constructor initializes Hazard Eras SMR singleton with passed parameters.
+            If the instance does not yet exist then the function creates the instance.
+            Otherwise it does nothing.
+
+            The %HE reclamation schema depends of four parameters:
+            - \p nHazardEraCount - hazard era count per thread. Usually it is small number (up to 10) depending from
+                the data structure algorithms. If \p nHazardEraCount = 0, the defaul value 8 is used.
+                Unlike \p cds::gc::HP, the hazard era array is not extended on demand, so it must hold
+                \p c_nHazardPtrCount of the container, for example, \p SkipListSet needs 67 eras
+            - \p nMaxThreadCount - max count of thread with using Hazard Eras GC in your application. Default is 100.
+            - \p nMaxRetiredPtrCount - initial capacity of array of retired pointers for each thread.
+                Default is <tt>2 * nHazardEraCount * nMaxThreadCount </tt>. The array is extended if needed.
+            - \p nEraFreq - each thread advances the global era after \p nEraFreq retired pointers. Default is 64.
+                Less value means more precise reclamation and more era publications (fences) on the read side.
+        */
+        HE(
+            size_t nHazardEraCount = 0,     ///< Hazard era count per thread
+            size_t nMaxThreadCount = 0,     ///< Max count of simultaneous working thread in your application
+            size_t nMaxRetiredPtrCount = 0, ///< Initial capacity of the array of retired objects for the thread
+            size_t nEraFreq = 0             ///< Era advance frequency
+        )
+        {
+            he::smr::construct(
+                nHazardEraCount,
+                nMaxThreadCount,
+                nMaxRetiredPtrCount,
+                nEraFreq
+            );
+        }
+
+        /// Terminates GC singleton
+        /**
+            The destructor destroys %HE global object. After calling of this function you may \b NOT
+            use CDS data structures based on \p %cds::gc::HE.
+            Usually, %HE object is destroyed at the end of your \p main().
+        */
+        ~HE()
+        {
+            he::smr::destruct( true );
+        }
+
+        /// Checks that required hazard era count \p nCountNeeded is less or equal then max hazard era count
+        /**
+            If <tt> nRequiredCount > get_hazard_ptr_count()</tt> then the exception \p not_enought_hazard_ptr is thrown
+        */
+        static void check_available_guards( size_t nCountNeeded )
+        {
+            he::smr::check_hazard_ptr_count( nCountNeeded );
+        }
+
+        /// Set memory management functions
+        /**
+            @note This function may be called <b>BEFORE</b> creating an instance
+            of Hazard Eras SMR
+
+            SMR object allocates some memory for thread-specific data and for
+            creating SMR object.
+            By default, a standard \p new and \p delete operators are used for this.
+        */
+        static void set_memory_allocator(
+            void* ( *alloc_func )( size_t size ),   ///< \p malloc() function
+            void( *free_func )( void * p )          ///< \p free() function
+        )
+        {
+            he::smr::set_memory_allocator( alloc_func, free_func );
+        }
+
+        /// Returns max Hazard Era count
+        static size_t max_hazard_count()
+        {
+            return he::smr::instance().get_hazard_ptr_count();
+        }
+
+        /// Returns max count of thread
+        static size_t max_thread_count()
+        {
+            return he::smr::instance().get_max_thread_count();
+        }
+
+        /// Returns initial capacity of retired pointer array
+        static size_t retired_array_capacity()
+        {
+            return he::smr::instance().get_max_retired_ptr_count();
+        }
+
+        /// Returns current global era
+        static he::era_t current_era()
+        {
+            return he::smr::instance().get_era();
+        }
+
+        /// Retire pointer \p p with function \p func
+        /**
+            The function places pointer \p p to array of pointers ready for removing.
+            (so called retired pointer array). The pointer can be safely removed when no thread
+            publishes an era between the birth era of \p p and the current era.
+            \p func is a disposer: when \p p can be safely removed, \p func is called.
+
+            \p T must be derived from \p cds::gc::details::node_data<HE> that holds the birth era of \p p;
+            for other types use \p retire( T*, he::era_t ) with explicit birth era.
+        */
+        template <typename T>
+        static void retire( T * p, void( *func )( void * ))
+        {
+            static_assert( std::is_base_of< details::node_data<HE>, T >::value, "HE cannot retire an object that has no birth era" );
+
+            he::thread_data* rec = he::smr::tls();
+            if ( !rec->retire( cds::gc::details::retired_ptr( p, func ), static_cast<details::node_data<HE> const*>( p )->birth_era_ ))
+                he::smr::instance().scan( rec );
+        }
+
+        /// Retire pointer \p p with functor of type \p Disposer
+        /**
+            The function places pointer \p p to array of pointers ready for removing.
+            (so called retired pointer array). The pointer can be safely removed when no thread
+            publishes an era between the birth era of \p p and the current era.
+
+            \p T must be derived from \p cds::gc::details::node_data<HE> that holds the birth era of \p p.
+            An intrusive container retires the value by \p node_data<HE>::retire() of its node
+            that works for member hooks too.
+
+            See \p cds::gc::HP::retire() for \p Disposer requirements.
+        */
+        template <class Disposer, typename T>
+        static void retire( T * p )
+        {
+            static_assert( std::is_base_of< details::node_data<HE>, T >::value, "HE cannot retire an object that has no birth era" );
+
+            retire<Disposer>( p, static_cast<details::node_data<HE> const*>( p )->birth_era_ );
+        }
+
+        /// Retire pointer \p p born at era \p birth with functor of type \p Disposer
+        /**
+            The pointer can be safely removed when no thread publishes an era in the range
+            <tt>[birth, current era]</tt>. If the birth era is unknown pass \p he::c_no_era:
+            then any thread that publishes an era before the retirement prevents \p p from freeing.
+        */
+        template <class Disposer, typename T>
+        static void retire( T * p, he::era_t birth )
+        {
+            he::thread_data* rec = he::smr::tls();
+            if ( !rec->retire( cds::gc::details::retired_ptr( p, cds::gc::details::retired_functor<Disposer, T>::get()), birth ))
+                he::smr::instance().scan( rec );
+        }
+
+        /// Checks that %HE singleton is initialized
+        static bool isUsed()
+        {
+            return he::smr::isUsed();
+        }
+
+        /// Forces reclamation
+        /**
+            The function advances the global era and frees all retired pointers of the current thread
+            that are not protected by any published era.
+            Usually, this function should not be called directly.
+        */
+        static void scan()
+        {
+            he::smr::instance().scan( he::smr::tls());
+        }
+
+        /// Synonym for \p scan()
+        static void force_dispose()
+        {
+            scan();
+        }
+
+        /// Returns internal statistics
+        /**
+            The function clears \p st before gathering statistics.
+
+            @note Internal statistics is available only if you compile
+            \p libcds and your program with \p -DCDS_ENABLE_HPSTAT.
+        */
+        static void statistics( stat& st )
+        {
+            he::smr::instance().statistics( st );
+        }
+
+        /// Returns post-mortem statistics
+        /**
+            Post-mortem statistics is gathered in the \p %HE object destructor
+            and can be accessible after destructing the global \p %HE object.
+
+            @note Internal statistics is available only if you compile
+            \p libcds and your program with \p -DCDS_ENABLE_HPSTAT.
+        */
+        CDS_EXPORT_API static stat const& postmortem_statistics();
+    };
+
+    //@cond
+    template <typename Disposer, typename T>
+    inline void details::node_data<HE>::retire( T* p ) const
+    {
+        HE::template retire<Disposer>( p, birth_era_ );
+    }
+    //@endcond
+
+}} // namespace cds::gc
+
+#endif // #ifndef CDSLIB_GC_HE_SMR_H
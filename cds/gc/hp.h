@@ -34,11 +34,13 @@
 #include <exception>
 #include <cds/gc/details/hp_common.h>
 #include <cds/details/lib.h>
+#include <cds/sync/spinlock.h>
 #include <cds/threading/model.h>
 #include <cds/details/throw_exception.h>
 #include <cds/details/static_functor.h>
 #include <cds/details/marked_ptr.h>
 #include <cds/user_setup/cache_line.h>
+#include <cds/os/membarrier.h>
 
 /**
     @page cds_garbage_collectors_comparison Hazard Pointer SMR implementations
@@ -49,25 +51,50 @@
             <th>Feature</th>
             <th>%cds::gc::HP</th>
             <th>%cds::gc::DHP</th>
+            <th>%cds::gc::HE</th>
+            <th>%cds::gc::EBR</th>
+            <th>%cds::gc::Hyaline</th>
         </tr>
         <tr>
             <td>Max number of guarded (hazard) pointers per thread</td>
-            <td>limited (specified at construction time)</td>
+            <td>unlimited (initial count is specified at construction time, extended by blocks when needed)</td>
             <td>unlimited (dynamically allocated when needed)</td>
+            <td>limited (specified at construction time)</td>
+            <td>limited (specified at construction time), guards are not published</td>
+            <td>limited (specified at construction time), guards are not published</td>
         </tr>
         <tr>
             <td>Max number of retired pointers<sup>1</sup></td>
             <td>bounded, specified at construction time</td>
             <td>bounded, adaptive, depends on current thread count and number of hazard pointer for each thread</td>
+            <td>unbounded<sup>2</sup>, initial capacity is specified at construction time</td>
+            <td>unbounded<sup>3</sup>, initial capacity is specified at construction time</td>
+            <td>unbounded<sup>3</sup>, batch size is specified at construction time</td>
         </tr>
         <tr>
             <td>Thread count</td>
             <td>bounded, upper bound is specified at construction time</td>
             <td>unbounded</td>
+            <td>bounded, upper bound is specified at construction time</td>
+            <td>unbounded</td>
+            <td>unbounded</td>
+        </tr>
+        <tr>
+            <td>Store-load fence on the read side</td>
+            <td>each \p protect() call</td>
+            <td>each \p protect() call</td>
+            <td>only when the global era is changed</td>
+            <td>once per operation (epoch announcement)</td>
+            <td>once per operation (slot activation)</td>
         </tr>
     </table>
 
     <sup>1</sup>Unbounded count of retired pointers means a possibility of memory exhaustion.
+
+    <sup>2</sup>A thread that holds an old era delays freeing of all objects retired after that era.
+
+    <sup>3</sup>A thread that stays inside an operation delays freeing of all objects retired meanwhile;
+    for \p %cds::gc::EBR it prevents the epoch advancement.
 */
 
 namespace cds {
@@ -91,11 +118,16 @@ namespace cds { namespace gc {
     namespace hp {
         using namespace cds::gc::hp::common;
 
-        /// Exception "Not enough Hazard Pointer"
+        /// Exception "Not enough Hazard Pointer" (deprecated)
+        /**
+            @deprecated The guard array of %HP thread grows on demand, so %HP never throws the exception.
+            The class is kept for source compatibility only.
+        */
         class not_enought_hazard_ptr: public std::length_error
         {
         //@cond
         public:
+            CDS_DEPRECATED("HP never throws not_enought_hazard_ptr, the guard array grows on demand")
             not_enought_hazard_ptr()
                 : std::length_error( "Not enough Hazard Pointer" )
             {}
@@ -113,17 +145,72 @@ namespace cds { namespace gc {
         //@endcond
         };
 
+        //@cond
+        /// Block of guards appended to the thread's guard array when the array is exhausted
+        /**
+            The block starts at a cache line boundary. The header occupies the first cache line,
+            the guards occupy the next four cache lines, so the guards of different blocks
+            never share a cache line with each other or with the header.
+        */
+        struct guard_block
+        {
+            atomics::atomic<guard_block*>  next_block_;  // next block, in order of allocation
+            void*   memory_;    // memory allocated for the block, the block is aligned inside it
+
+            /// Guard count of the block
+            static size_t const c_capacity = cds::c_nCacheLineSize * 4 / sizeof( guard );
+
+            /// Size of the block header, the guards follow it
+            static size_t const c_header_size = cds::c_nCacheLineSize;
+
+            explicit guard_block( void* mem )
+                : next_block_( nullptr )
+                , memory_( mem )
+            {}
+
+            guard* first()
+            {
+                return reinterpret_cast<guard*>( reinterpret_cast<char*>( this ) + c_header_size );
+            }
+
+            /// Size of memory to allocate for the block, including the slack for the alignment
+            static size_t calc_alloc_size()
+            {
+                return cds::c_nCacheLineSize - 1 + c_header_size + sizeof( guard ) * c_capacity;
+            }
+
+            /// Constructs the block at the first cache line boundary of \p mem of \p calc_alloc_size() bytes
+            static guard_block* create( void* mem )
+            {
+                uintptr_t const nMask = cds::c_nCacheLineSize - 1;
+                return new( reinterpret_cast<void*>(( reinterpret_cast<uintptr_t>( mem ) + nMask ) & ~nMask )) guard_block( mem );
+            }
+        };
+        //@endcond
+
         //@cond
         /// Per-thread hazard pointer storage
+        /**
+            The storage consists of the initial guard array allocated with the thread record
+            and of the list of \p guard_block appended on demand when all guards are in use.
+            The guards are given out in their order in the storage, so the guards ever allocated
+            form a prefix of the storage; its length \p used_count() is a high-water mark of
+            simultaneously allocated guards. \p scan() reads only this prefix.
+        */
         class thread_hp_storage {
         public:
             thread_hp_storage( guard* arr, size_t nSize ) noexcept
                 : free_head_( arr )
+                , fresh_( arr )
+                , used_( 0 )
+                , extended_list_( nullptr )
+                , extended_tail_( nullptr )
                 , array_( arr )
                 , capacity_( nSize )
 #       ifdef CDS_ENABLE_HPSTAT
                 , alloc_guard_count_(0)
                 , free_guard_count_(0)
+                , extend_call_count_(0)
 #       endif
             {
                 // Initialize guards
@@ -138,11 +225,18 @@ namespace cds { namespace gc {
             thread_hp_storage( thread_hp_storage const& ) = delete;
             thread_hp_storage( thread_hp_storage&& ) = delete;
 
+            /// Capacity of the initial guard array
             size_t capacity() const noexcept
             {
                 return capacity_;
             }
 
+            /// Length of the storage prefix that contains all guards ever allocated
+            size_t used_count() const noexcept
+            {
+                return used_.load( atomics::memory_order_acquire );
+            }
+
             bool full() const noexcept
             {
                 return free_head_ == nullptr;
@@ -150,22 +244,13 @@ namespace cds { namespace gc {
 
             guard* alloc()
             {
-#       ifdef CDS_DISABLE_SMR_EXCEPTION
-                assert( !full());
-#       else
-                if ( full())
-                    CDS_THROW_EXCEPTION( not_enought_hazard_ptr());
-#       endif
-                guard* g = free_head_;
-                free_head_ = g->next_;
+                guard* g = pop();
                 CDS_HPSTAT( ++alloc_guard_count_ );
                 return g;
             }
 
             void free( guard* g ) noexcept
             {
-                assert( g >= array_ && g < array_ + capacity());
-
                 if ( g ) {
                     g->clear();
                     g->next_ = free_head_;
@@ -177,22 +262,10 @@ namespace cds { namespace gc {
             template< size_t Capacity>
             size_t alloc( guard_array<Capacity>& arr )
             {
-                size_t i;
-                guard* g = free_head_;
-                for ( i = 0; i < Capacity && g; ++i ) {
-                    arr.reset( i, g );
-                    g = g->next_;
-                }
-
-#       ifdef CDS_DISABLE_SMR_EXCEPTION
-                assert( i == Capacity );
-#       else
-                if ( i != Capacity )
-                    CDS_THROW_EXCEPTION( not_enought_hazard_ptr());
-#       endif
-                free_head_ = g;
+                for ( size_t i = 0; i < Capacity; ++i )
+                    arr.reset( i, pop());
                 CDS_HPSTAT( alloc_guard_count_ += Capacity );
-                return i;
+                return Capacity;
             }
 
             template <size_t Capacity>
@@ -214,15 +287,35 @@ namespace cds { namespace gc {
             // cppcheck-suppress functionConst
             void clear()
             {
-                for ( guard* cur = array_, *last = array_ + capacity(); cur < last; ++cur )
-                    cur->clear();
+                for_each_used( []( guard& g ) { g.clear(); } );
             }
 
-            guard& operator[]( size_t idx )
-            {
-                assert( idx < capacity());
+            /// Calls \p f( guard& ) for each guard of the used prefix
+            /**
+                The function may be called by any thread, for example, by the thread that scans the hazard pointers.
+            */
+            template <typename Func>
+            void for_each_used( Func f )
+            {
+                size_t nUsed = used_count();
+
+                size_t const nInitial = nUsed < capacity_ ? nUsed : capacity_;
+                for ( guard* cur = array_, *last = array_ + nInitial; cur < last; ++cur )
+                    f( *cur );
+                nUsed -= nInitial;
+
+                for ( guard_block* block = extended_list_.load( atomics::memory_order_acquire ); nUsed; block = block->next_block_.load( atomics::memory_order_acquire )) {
+                    assert( block != nullptr );
+                    size_t const nCount = nUsed < guard_block::c_capacity ? nUsed : guard_block::c_capacity;
+                    for ( guard* cur = block->first(), *last = cur + nCount; cur < last; ++cur )
+                        f( *cur );
+                    nUsed -= nCount;
+                }
+            }
 
-                return array_[idx];
+            guard_block* extended_list() const noexcept
+            {
+                return extended_list_.load( atomics::memory_order_relaxed );
             }
 
             static size_t calc_array_size( size_t capacity )
@@ -230,14 +323,40 @@ namespace cds { namespace gc {
                 return sizeof( guard ) * capacity;
             }
 
+        private:
+            guard* pop()
+            {
+                if ( cds_unlikely( free_head_ == nullptr ))
+                    extend();
+
+                guard* g = free_head_;
+                free_head_ = g->next_;
+
+                // The guards that have never been allocated are linked in storage order at the tail of the free list,
+                // so the first of them extends the used prefix
+                if ( g == fresh_ ) {
+                    fresh_ = g->next_;
+                    used_.store( used_.load( atomics::memory_order_relaxed ) + 1, atomics::memory_order_release );
+                }
+                return g;
+            }
+
+            // Appends new guard block to the storage, defined in hp.cpp
+            CDS_EXPORT_API void extend();
+
         private:
             guard*          free_head_; ///< Head of free guard list
-            guard* const    array_;     ///< HP array
-            size_t const    capacity_;  ///< HP array capacity
+            guard*          fresh_;     ///< First guard that has never been allocated
+            atomics::atomic<size_t> used_;  ///< Length of the used prefix of the storage
+            atomics::atomic<guard_block*> extended_list_;   ///< Head of extended guard blocks, in order of allocation
+            guard_block*    extended_tail_; ///< Last extended guard block
+            guard* const    array_;     ///< Initial HP array
+            size_t const    capacity_;  ///< Initial HP array capacity
 #       ifdef CDS_ENABLE_HPSTAT
         public:
             size_t          alloc_guard_count_;
             size_t          free_guard_count_;
+            size_t          extend_call_count_;
 #       endif
         };
         //@endcond
@@ -328,8 +447,15 @@ namespace cds { namespace gc {
             size_t  free_count;         ///< Count of free pointers
             size_t  scan_count;         ///< Count of \p scan() call
             size_t  help_scan_count;    ///< Count of \p help_scan() call
+            size_t  reclaim_count;      ///< Count of reclamation passes of the background reclaimer thread
 
             size_t  thread_rec_count;   ///< Count of thread records
+            size_t  hp_extend_count;    ///< Count of hp array \p extend() call
+
+            size_t  retained_count;         ///< Current count of retired pointers that survived \p scan() (available even if \p CDS_ENABLE_HPSTAT is not defined)
+            size_t  budget_exceeded_count;  ///< Count of retired budget exceeding (available even if \p CDS_ENABLE_HPSTAT is not defined)
+            size_t  thread_list_count;      ///< Current count of records in the thread list scanned by \p scan() (available even if \p CDS_ENABLE_HPSTAT is not defined)
+            size_t  thread_rec_compact_count;   ///< Count of free records unlinked from the thread list (available even if \p CDS_ENABLE_HPSTAT is not defined)
 
             /// Default ctor
             stat()
@@ -346,7 +472,13 @@ namespace cds { namespace gc {
                     free_count =
                     scan_count =
                     help_scan_count =
-                    thread_rec_count = 0;
+                    reclaim_count =
+                    thread_rec_count =
+                    hp_extend_count =
+                    retained_count =
+                    budget_exceeded_count =
+                    thread_list_count =
+                    thread_rec_compact_count = 0;
             }
         };
 
@@ -358,8 +490,12 @@ namespace cds { namespace gc {
 
             char pad1_[cds::c_nCacheLineSize];
             atomics::atomic<unsigned int> sync_; ///< dummy var to introduce synchronizes-with relationship between threads
+            bool const asymmetric_fence_;        ///< \p true - \p sync() is a compiler barrier, the scanner issues \p membarrier
             char pad2_[cds::c_nCacheLineSize];
 
+            size_t  retained_count_;    ///< retired pointers survived the last \p scan(), accounted in \p smr::budget_
+            bool    in_budget_policy_;  ///< the thread applies the retired budget policy
+
 #       ifdef CDS_ENABLE_HPSTAT
             // Internal statistics:
             size_t              free_count_;
@@ -369,10 +505,13 @@ namespace cds { namespace gc {
 
             // CppCheck warn: pad1_ and pad2_ is uninitialized in ctor
             // cppcheck-suppress uninitMemberVar
-            thread_data( guard* guards, size_t guard_count, retired_ptr* retired_arr, size_t retired_capacity )
+            thread_data( guard* guards, size_t guard_count, retired_ptr* retired_arr, size_t retired_capacity, bool asymmetric_fence )
                 : hazards_( guards, guard_count )
                 , retired_( retired_arr, retired_capacity )
                 , sync_(0)
+                , asymmetric_fence_( asymmetric_fence )
+                , retained_count_( 0 )
+                , in_budget_policy_( false )
 #       ifdef CDS_ENABLE_HPSTAT
                 , free_count_(0)
                 , scan_count_(0)
@@ -386,7 +525,10 @@ namespace cds { namespace gc {
 
             void sync()
             {
-                sync_.fetch_add( 1, atomics::memory_order_acq_rel );
+                if ( asymmetric_fence_ )
+                    cds::OS::membarrier::light();
+                else
+                    sync_.fetch_add( 1, atomics::memory_order_acq_rel );
             }
         };
         //@endcond
@@ -394,7 +536,8 @@ namespace cds { namespace gc {
         /// \p smr::scan() strategy
         enum scan_type {
             classic,    ///< classic scan as described in Michael's works (see smr::classic_scan())
-            inplace     ///< inplace scan without allocation (see smr::inplace_scan())
+            inplace,    ///< inplace scan without allocation (see smr::inplace_scan())
+            hashed      ///< scan with hash set of hazard pointers (see smr::hashed_scan())
         };
 
         //@cond
@@ -422,19 +565,27 @@ namespace cds { namespace gc {
                 Otherwise it does nothing.
 
                 The Michael's HP reclamation schema depends of three parameters:
-                - \p nHazardPtrCount - HP pointer count per thread. Usually it is small number (2-4) depending from
+                - \p nHazardPtrCount - initial HP pointer count per thread. Usually it is small number (2-4) depending from
                     the data structure algorithms. By default, if \p nHazardPtrCount = 0,
-                    the function uses maximum of HP count for CDS library
+                    the function uses maximum of HP count for CDS library. If a thread needs more guards,
+                    its guard array is extended by \p guard_block
                 - \p nMaxThreadCount - max count of thread with using HP GC in your application. Default is 100.
                 - \p nMaxRetiredPtrCount - capacity of array of retired pointers for each thread. Must be greater than
                     <tt> nHazardPtrCount * nMaxThreadCount </tt>
                     Default is <tt>2 * nHazardPtrCount * nMaxThreadCount</tt>
+                - \p bAsymmetricFence - if \p true, the guards publish hazard pointers with a compiler barrier only,
+                    and \p scan() issues process-wide \p membarrier before reading the hazard arrays.
+                    If the OS does not support \p membarrier the ordinary fences are used.
+                - \p bBackgroundReclaim - if \p true, a full retired array is handed over
+                    to the background reclaimer thread that scans hazard pointers and frees retired data.
             */
             static CDS_EXPORT_API void construct(
                 size_t nHazardPtrCount = 0,     ///< Hazard pointer count per thread
                 size_t nMaxThreadCount = 0,     ///< Max count of simultaneous working thread in your application
                 size_t nMaxRetiredPtrCount = 0, ///< Capacity of the array of retired objects for the thread
-                scan_type nScanType = inplace   ///< Scan type (see \ref scan_type enum)
+                scan_type nScanType = inplace,  ///< Scan type (see \ref scan_type enum)
+                bool bAsymmetricFence = false,  ///< Use asymmetric fence
+                bool bBackgroundReclaim = false ///< Use background reclaimer thread
             );
 
             // for back-copatibility
@@ -487,7 +638,7 @@ namespace cds { namespace gc {
                 void (*free_func )( void * p )
             );
 
-            /// Returns max Hazard Pointer count per thread
+            /// Returns initial Hazard Pointer count per thread
             size_t get_hazard_ptr_count() const noexcept
             {
                 return hazard_ptr_count_;
@@ -511,22 +662,52 @@ namespace cds { namespace gc {
                 return scan_type_;
             }
 
-            /// Checks that required hazard pointer count \p nRequiredCount is less or equal then max hazard pointer count
+            /// Checks if asymmetric fence mode is active
+            /**
+                The function returns \p false if asymmetric fence has not been requested
+                at construction time or if it is not supported by the OS.
+            */
+            bool is_asymmetric_fence() const
+            {
+                return asymmetric_fence_;
+            }
+
+            /// Checks if retired data is freed by the background reclaimer thread
+            bool is_background_reclaim() const
+            {
+                return reclaimer_ != nullptr;
+            }
+
+            /// Sets the budget of retired pointers
             /**
-                If <tt> nRequiredCount > get_hazard_ptr_count()</tt> then the exception \p not_enought_hazard_ptr is thrown
+                \p nMaxRetained is the limit of retired pointers that survived \p scan() in all threads,
+                0 means no limit. When the limit is exceeded \p scan() applies \p policy,
+                see \p hp::common::retired_budget_policy. \p cb is required for \p budget_callback policy.
+
+                The function should be called before any thread retires data.
+            */
+            void set_retired_budget( size_t nMaxRetained, retired_budget_policy policy, retired_budget_callback cb )
+            {
+                budget_.set( nMaxRetained, policy, cb );
+            }
+
+            /// Returns the retired budget
+            retired_budget const& get_retired_budget() const
+            {
+                return budget_;
+            }
+
+            /// Checks that required hazard pointer count \p nRequiredCount is available
+            /**
+                The guard array of the thread grows on demand, so any count is available.
+                The function is kept for compatibility with other GCs.
             */
             static void check_hazard_ptr_count( size_t nRequiredCount )
             {
-                if ( instance().get_hazard_ptr_count() < nRequiredCount ) {
-#       ifdef CDS_DISABLE_SMR_EXCEPTION
-                    assert( false );    // not enough hazard ptr
-#       else
-                    CDS_THROW_EXCEPTION( not_enought_hazard_ptr());
-#       endif
-                }
+                CDS_UNUSED( nRequiredCount );
             }
 
-            /// Returns thread-local data for the current thread
+            /// Returns thread-local data for the current thread, attaching the thread to the GC on first call
             static CDS_EXPORT_API thread_data* tls();
 
             static CDS_EXPORT_API void attach_thread();
@@ -544,12 +725,19 @@ namespace cds { namespace gc {
                 There are the following scan algorithm:
                 - \ref hzp_gc_classic_scan "classic_scan" allocates memory for internal use
                 - \ref hzp_gc_inplace_scan "inplace_scan" does not allocate any memory
+                - \ref hzp_gc_hashed_scan "hashed_scan" allocates memory for the hash set of hazard pointers
 
                 Use \p set_scan_type() member function to setup appropriate scan algorithm.
+
+                In background reclamation mode \p scan() hands the retired array over to the reclaimer thread
+                and returns immediately, see \p background_scan().
             */
             void scan( thread_data* pRec )
             {
                 ( this->*scan_func_ )( pRec );
+
+                if ( budget_.exceeded())
+                    apply_retired_budget( pRec );
             }
 
             /// Helper scan routine
@@ -563,12 +751,27 @@ namespace cds { namespace gc {
             */
             CDS_EXPORT_API void help_scan( thread_data* pThis );
 
+            /// Frees unguarded retired pointers from <tt>[first, last)</tt>
+            /**
+                The function is called by the background reclaimer thread.
+                Guarded retired pointers are moved to the head of the range, the function returns their count.
+            */
+            CDS_EXPORT_API size_t reclaim( retired_ptr* first, retired_ptr* last );
+
+            /// Waits until the background reclaimer thread processes all retired data handed over to it
+            /**
+                If background reclamation mode is off the function does nothing.
+            */
+            CDS_EXPORT_API void wait_reclaim();
+
         private:
             CDS_EXPORT_API smr(
                 size_t nHazardPtrCount,     ///< Hazard pointer count per thread
                 size_t nMaxThreadCount,     ///< Max count of simultaneous working thread in your application
                 size_t nMaxRetiredPtrCount, ///< Capacity of the array of retired objects for the thread
-                scan_type nScanType         ///< Scan type (see \ref scan_type enum)
+                scan_type nScanType,        ///< Scan type (see \ref scan_type enum)
+                bool bAsymmetricFence,      ///< Use asymmetric fence
+                bool bBackgroundReclaim     ///< Use background reclaimer thread
             );
 
             CDS_EXPORT_API ~smr();
@@ -608,6 +811,27 @@ namespace cds { namespace gc {
             */
             CDS_EXPORT_API void inplace_scan( thread_data* pRec );
 
+            /// Hashed scan algorithm
+            /** @anchor hzp_gc_hashed_scan
+                The function is like \p classic_scan() but instead of sorting the hazard pointers
+                it builds an open-addressing hash set of them (see \p hp::common::hazard_set).
+                A retired pointer is checked by one probe that compares a group of hash slots at once,
+                so the search costs <tt>O(R + H)</tt> instead of <tt>O((R + H) log H)</tt>,
+                where \p H is the number of hazard pointers and \p R is the size of the retired array.
+                The algorithm is preferable when the number of threads and hazard pointers per thread is large.
+            */
+            CDS_EXPORT_API void hashed_scan( thread_data* pRec );
+
+            /// Background scan
+            /**
+                The function copies the retired array of the thread to the background reclaimer thread
+                and clears the array. The reclaimer thread frees retired data by classic scan algorithm.
+            */
+            CDS_EXPORT_API void background_scan( thread_data* pRec );
+
+            /// Applies the retired budget policy when the budget is exceeded
+            CDS_EXPORT_API void apply_retired_budget( thread_data* pRec );
+
         private:
             CDS_EXPORT_API thread_record* create_thread_data();
             static CDS_EXPORT_API void destroy_thread_data( thread_record* pRec );
@@ -618,15 +842,35 @@ namespace cds { namespace gc {
             /// Free HP SMR thread-private data
             CDS_EXPORT_API void free_thread_data( thread_record* pRec );
 
+            /// Unlinks free records without retired pointers from the thread list
+            /**
+                The unlinked records are kept in \p free_records_ and are reused by \p alloc_thread_data().
+                The function is called by the detaching thread when the thread list contains
+                much more free records than attached threads, so after a burst of short-lived threads
+                \p scan() and \p help_scan() walk only the records of live threads.
+            */
+            CDS_EXPORT_API void compact_thread_list();
+
         private:
+            struct reclaimer;
+
             static CDS_EXPORT_API smr* instance_;
 
             atomics::atomic< thread_record*>    thread_list_;   ///< Head of thread list
+            atomics::atomic<size_t>             thread_list_count_; ///< Count of records in \p thread_list_
+            atomics::atomic<size_t>             attached_count_;    ///< Count of attached threads
+            thread_record*                      free_records_;      ///< Records unlinked from \p thread_list_, protected by \p thread_list_lock_
+            size_t                              compact_count_;     ///< Count of unlinked records, protected by \p thread_list_lock_
+            cds::sync::spin                     thread_list_lock_;  ///< Lock for \p compact_thread_list() and \p free_records_
 
-            size_t const    hazard_ptr_count_;      ///< max count of thread's hazard pointer
+            size_t const    hazard_ptr_count_;      ///< initial count of thread's hazard pointer
             size_t const    max_thread_count_;      ///< max count of thread
             size_t const    max_retired_ptr_count_; ///< max count of retired ptr per thread
             scan_type const scan_type_;             ///< scan type (see \ref scan_type enum)
+            bool const      asymmetric_fence_;      ///< asymmetric fence mode is active
+            reclaimer*      reclaimer_;             ///< background reclaimer thread, \p nullptr if not used
+            size_t          reclaimer_retained_;    ///< retired pointers retained by the reclaimer thread, accounted in \p budget_
+            retired_budget  budget_;                ///< budget of retired pointers
             void ( smr::*scan_func_ )( thread_data* pRec );
         };
         //@endcond
@@ -668,7 +912,7 @@ namespace cds { namespace gc {
         /// Atomic type
         template <typename T> using atomic_type = atomics::atomic<T>;
 
-        /// Exception "Not enough Hazard Pointer"
+        /// Exception "Not enough Hazard Pointer" (deprecated, \p %HP never throws it)
         typedef hp::not_enought_hazard_ptr not_enought_hazard_ptr_exception;
 
         /// Internal statistics
@@ -695,7 +939,7 @@ namespace cds { namespace gc {
         public:
             /// Default ctor allocates a guard (hazard pointer) from thread-private storage
             /**
-                @warning Can throw \p too_many_hazard_ptr_exception if internal hazard pointer objects are exhausted.
+                If thread-private storage is exhausted, it is extended by new block of guards.
             */
             Guard()
                 : guard_( hp::smr::tls()->hazards_.alloc())
@@ -743,7 +987,7 @@ namespace cds { namespace gc {
 
             /// Links the guard with internal hazard pointer if the guard is in unlinked state
             /**
-                @warning Can throw \p not_enought_hazard_ptr_exception if internal hazard pointer array is exhausted.
+                If the internal hazard pointer array is exhausted, it is extended.
             */
             void link()
             {
@@ -1288,9 +1532,20 @@ namespace cds { namespace gc {
         /// \p scan() type
         enum class scan_type {
             classic = hp::classic,    ///< classic scan as described in Michael's papers
-            inplace = hp::inplace     ///< inplace scan without allocation
+            inplace = hp::inplace,    ///< inplace scan without allocation
+            hashed = hp::hashed       ///< classic scan with hash set of hazard pointers instead of sorted array
+        };
+
+        /// Policy applied when the retired budget is exceeded, see \p set_retired_budget()
+        enum class budget_policy {
+            help_scan = hp::common::budget_help_scan,   ///< scan retired data of terminated threads and rescan
+            throttle = hp::common::budget_throttle,     ///< back off the retiring thread and rescan until the budget is restored
+            callback = hp::common::budget_callback      ///< call user-provided callback
         };
 
+        /// Callback for \p budget_policy::callback: <tt>void cb( size_t nRetained, size_t nBudget )</tt>
+        typedef hp::common::retired_budget_callback budget_callback;
+
         /// Initializes %HP singleton
         /**
             The constructor initializes Hazard Pointer SMR singleton with passed parameters.
@@ -1298,24 +1553,38 @@ namespace cds { namespace gc {
             Otherwise it does nothing.
 
             The Michael's %HP reclamation schema depends of three parameters:
-            - \p nHazardPtrCount - hazard pointer count per thread. Usually it is small number (up to 10) depending from
-                the data structure algorithms. If \p nHazardPtrCount = 0, the defaul value 8 is used
+            - \p nHazardPtrCount - initial hazard pointer count per thread. Usually it is small number (up to 10) depending from
+                the data structure algorithms. If \p nHazardPtrCount = 0, the defaul value 8 is used.
+                A thread that needs more guards extends its hazard pointer array by blocks of
+                \p hp::guard_block::c_capacity guards; \p scan() reads only the guards the thread has ever used.
             - \p nMaxThreadCount - max count of thread with using Hazard Pointer GC in your application. Default is 100.
             - \p nMaxRetiredPtrCount - capacity of array of retired pointers for each thread. Must be greater than
                 <tt> nHazardPtrCount * nMaxThreadCount </tt>. Default is <tt>2 * nHazardPtrCount * nMaxThreadCount </tt>.
+            - \p bAsymmetricFence - asymmetric fence mode. In this mode \p Guard::protect() publishes
+                the hazard pointer without store-load fence, and the rare \p scan() forces the memory barrier
+                on all threads by Linux \p membarrier(2) system call. If \p membarrier is not available,
+                %HP falls back to ordinary fences; use \p asymmetric_fence() to check the actual mode.
+            - \p bBackgroundReclaim - background reclamation mode. In this mode the thread whose retired array is full
+                does not scan hazard pointers by itself. Instead, it hands the retired array over to the dedicated
+                reclaimer thread that scans hazard pointers and frees retired data. This removes long scan
+                pauses from the worker threads at the cost of one extra thread.
         */
         HP(
             size_t nHazardPtrCount = 0,     ///< Hazard pointer count per thread
             size_t nMaxThreadCount = 0,     ///< Max count of simultaneous working thread in your application
             size_t nMaxRetiredPtrCount = 0, ///< Capacity of the array of retired objects for the thread
-            scan_type nScanType = scan_type::inplace   ///< Scan type (see \p scan_type enum)
+            scan_type nScanType = scan_type::inplace,   ///< Scan type (see \p scan_type enum)
+            bool bAsymmetricFence = false,  ///< Use asymmetric fence
+            bool bBackgroundReclaim = false ///< Use background reclaimer thread
         )
         {
             hp::smr::construct(
                 nHazardPtrCount,
                 nMaxThreadCount,
                 nMaxRetiredPtrCount,
-                static_cast<hp::scan_type>(nScanType)
+                static_cast<hp::scan_type>(nScanType),
+                bAsymmetricFence,
+                bBackgroundReclaim
             );
         }
 
@@ -1330,9 +1599,9 @@ namespace cds { namespace gc {
             hp::smr::destruct( true );
         }
 
-        /// Checks that required hazard pointer count \p nCountNeeded is less or equal then max hazard pointer count
+        /// Checks that required hazard pointer count \p nCountNeeded is available
         /**
-            If <tt> nRequiredCount > get_hazard_ptr_count()</tt> then the exception \p not_enought_hazard_ptr is thrown
+            The hazard pointer array of the thread grows on demand, so the function never fails.
         */
         static void check_available_guards( size_t nCountNeeded )
         {
@@ -1356,7 +1625,7 @@ namespace cds { namespace gc {
             hp::smr::set_memory_allocator( alloc_func, free_func );
         }
 
-        /// Returns max Hazard Pointer count
+        /// Returns initial Hazard Pointer count per thread
         static size_t max_hazard_count()
         {
             return hp::smr::instance().get_hazard_ptr_count();
@@ -1405,6 +1674,11 @@ namespace cds { namespace gc {
             - it should be default-constructible
             - the result of functor call with argument \p p should not depend on where the functor will be called.
 
+            \p Disposer may also provide batch disposing operator <tt>void operator()( T ** arr, size_t count )</tt>.
+            In this case \p scan() groups unguarded retired pointers by disposer and frees each group
+            by one batch call instead of per-pointer calls; it is useful when the disposer returns memory
+            to a pool or an allocator that benefits from bulk deallocation.
+
             \par Examples:
             Operator \p delete functor:
             \code
@@ -1440,8 +1714,8 @@ namespace cds { namespace gc {
         template <class Disposer, typename T>
         static void retire( T * p )
         {
-            if ( !hp::smr::tls()->retired_.push( hp::retired_ptr( p, cds::details::static_functor<Disposer, T>::call )))
-                scan();
+            if ( !hp::smr::tls()->retired_.push( hp::retired_ptr( p, cds::gc::details::retired_functor<Disposer, T>::get())))
+                hp::smr::instance().scan( hp::smr::tls());
         }
 
         /// Get current scan strategy
@@ -1456,13 +1730,51 @@ namespace cds { namespace gc {
             return hp::smr::isUsed();
         }
 
+        /// Checks if asymmetric fence mode is active
+        static bool asymmetric_fence()
+        {
+            return hp::smr::instance().is_asymmetric_fence();
+        }
+
+        /// Checks if retired data is freed by the background reclaimer thread
+        static bool background_reclaim()
+        {
+            return hp::smr::instance().is_background_reclaim();
+        }
+
+        /// Sets the budget of retired pointers
+        /**
+            A stalled thread that holds a hazard pointer pins the retired data forever, and the other threads
+            rescan their full retired arrays over and over again. The budget limits the total count
+            of retired pointers that survived \p scan(). When the budget is exceeded, \p scan() applies \p policy:
+            - \p budget_policy::help_scan - the thread frees retired data of the terminated threads
+                and rescans its own retired array
+            - \p budget_policy::throttle - the retiring thread backs off and rescans until
+                the budget is restored or the max back-off count is reached
+            - \p budget_policy::callback - \p cb is called, for example, to log a warning
+
+            \p nMaxRetained = 0 removes the budget. The current count of retained pointers
+            is available in \p stat::retained_count.
+
+            The function should be called before any thread retires data.
+        */
+        static void set_retired_budget( size_t nMaxRetained, budget_policy policy = budget_policy::help_scan, budget_callback cb = nullptr )
+        {
+            hp::smr::instance().set_retired_budget( nMaxRetained, static_cast<hp::common::retired_budget_policy>( policy ), cb );
+        }
+
         /// Forces SMR call for current thread
         /**
             Usually, this function should not be called directly.
+
+            In background reclamation mode the function waits until the reclaimer thread
+            processes the retired data of the current thread.
         */
         static void scan()
         {
-            hp::smr::instance().scan( hp::smr::tls());
+            hp::smr& gc = hp::smr::instance();
+            gc.scan( hp::smr::tls());
+            gc.wait_reclaim();
         }
 
         /// Synonym for \p scan()
@@ -1477,6 +1789,8 @@ namespace cds { namespace gc {
 
             @note Internal statistics is available only if you compile
             \p libcds and your program with \p -DCDS_ENABLE_HPSTAT.
+            The retired budget counters \p stat::retained_count and \p stat::budget_exceeded_count
+            are always available.
         */
         static void statistics( stat& st )
         {
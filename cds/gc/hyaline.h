@@ -0,0 +1,1403 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSLIB_GC_HYALINE_SMR_H
+#define CDSLIB_GC_HYALINE_SMR_H
+
+#include <exception>
+#include <cds/gc/details/retired_ptr.h>
+#include <cds/details/lib.h>
+#include <cds/threading/model.h>
+#include <cds/details/throw_exception.h>
+#include <cds/details/static_functor.h>
+#include <cds/details/marked_ptr.h>
+#include <cds/user_setup/cache_line.h>
+
+#ifdef CDS_ENABLE_HPSTAT
+#   define CDS_HYALINESTAT( expr ) expr
+#else
+#   define CDS_HYALINESTAT( expr )
+#endif
+
+namespace cds { namespace gc {
+    /// Hyaline reclamation implementation details
+    namespace hyaline {
+
+        /// Guarded pointer type
+        typedef void*   hazard_ptr;
+
+        //@cond
+        /// Bit of the slot head that marks the slot as active (the owner thread is inside an operation)
+        static constexpr uintptr_t const c_active = 1;
+        //@endcond
+
+        /// Exception "Not enough guards"
+        class not_enought_hazard_ptr: public std::length_error
+        {
+        //@cond
+        public:
+            not_enought_hazard_ptr()
+                : std::length_error( "Not enough Hyaline guards" )
+            {}
+        //@endcond
+        };
+
+        /// Exception "Hyaline SMR is not initialized"
+        class not_initialized: public std::runtime_error
+        {
+        //@cond
+        public:
+            not_initialized()
+                : std::runtime_error( "Global Hyaline SMR object is not initialized" )
+            {}
+        //@endcond
+        };
+
+        //@cond
+        /// Hyaline guard
+        /**
+            Unlike the hazard pointer, the guarded pointer is private to the owner thread:
+            the guard only keeps the slot of the owner thread active.
+        */
+        class guard
+        {
+        public:
+            guard() noexcept
+                : ptr_( nullptr )
+                , next_( nullptr )
+            {}
+
+            hazard_ptr get() const noexcept
+            {
+                return ptr_;
+            }
+
+            hazard_ptr get( atomics::memory_order ) const noexcept
+            {
+                return ptr_;
+            }
+
+            template <typename T>
+            T* get_as() const noexcept
+            {
+                return reinterpret_cast<T*>( get());
+            }
+
+            template <typename T>
+            void set( T* ptr ) noexcept
+            {
+                ptr_ = reinterpret_cast<hazard_ptr>( ptr );
+            }
+
+            template <typename T, int BITMASK>
+            void set( cds::details::marked_ptr<T, BITMASK> ptr ) noexcept
+            {
+                set( ptr.ptr());
+            }
+
+            void clear() noexcept
+            {
+                ptr_ = nullptr;
+            }
+
+        private:
+            hazard_ptr  ptr_;   // guarded pointer, private to the owner thread
+
+        public:
+            guard* next_;   // free guard list
+        };
+
+        /// Array of guards
+        template <size_t Capacity>
+        class guard_array
+        {
+        public:
+            static size_t const c_nCapacity = Capacity;
+
+        public:
+            guard_array()
+                : arr_{ nullptr }
+            {}
+
+            static constexpr size_t capacity()
+            {
+                return c_nCapacity;
+            }
+
+            guard* operator[]( size_t idx ) const noexcept
+            {
+                assert( idx < capacity());
+                return arr_[idx];
+            }
+
+            void clear( size_t idx ) noexcept
+            {
+                assert( idx < capacity());
+                assert( arr_[idx] != nullptr );
+
+                arr_[idx]->clear();
+            }
+
+            guard* release( size_t idx ) noexcept
+            {
+                assert( idx < capacity());
+
+                guard* g = arr_[idx];
+                arr_[idx] = nullptr;
+                return g;
+            }
+
+            void reset( size_t idx, guard* g ) noexcept
+            {
+                assert( idx < capacity());
+                assert( arr_[idx] == nullptr );
+
+                arr_[idx] = g;
+            }
+
+        private:
+            guard*  arr_[c_nCapacity];
+        };
+        //@endcond
+
+        //@cond
+        /// Per-thread guard storage
+        /**
+            The storage counts allocated guards: the thread is inside an operation
+            while it owns at least one guard.
+        */
+        class thread_guard_storage {
+        public:
+            thread_guard_storage( guard* arr, size_t nSize ) noexcept
+                : free_head_( arr )
+                , array_( arr )
+                , capacity_( nSize )
+                , active_( 0 )
+#       ifdef CDS_ENABLE_HPSTAT
+                , alloc_guard_count_(0)
+                , free_guard_count_(0)
+#       endif
+            {
+                // Initialize guards
+                new( arr ) guard[nSize];
+
+                for ( guard* pEnd = arr + nSize - 1; arr < pEnd; ++arr )
+                    arr->next_ = arr + 1;
+                arr->next_ = nullptr;
+            }
+
+            thread_guard_storage() = delete;
+            thread_guard_storage( thread_guard_storage const& ) = delete;
+            thread_guard_storage( thread_guard_storage&& ) = delete;
+
+            size_t capacity() const noexcept
+            {
+                return capacity_;
+            }
+
+            bool full() const noexcept
+            {
+                return free_head_ == nullptr;
+            }
+
+            /// Count of allocated guards
+            size_t active() const noexcept
+            {
+                return active_;
+            }
+
+            guard* alloc()
+            {
+#       ifdef CDS_DISABLE_SMR_EXCEPTION
+                assert( !full());
+#       else
+                if ( full())
+                    CDS_THROW_EXCEPTION( not_enought_hazard_ptr());
+#       endif
+                guard* g = free_head_;
+                free_head_ = g->next_;
+                ++active_;
+                CDS_HYALINESTAT( ++alloc_guard_count_ );
+                return g;
+            }
+
+            void free( guard* g ) noexcept
+            {
+                assert( g >= array_ && g < array_ + capacity());
+                assert( active_ > 0 );
+
+                g->clear();
+                g->next_ = free_head_;
+                free_head_ = g;
+                --active_;
+                CDS_HYALINESTAT( ++free_guard_count_ );
+            }
+
+            template< size_t Capacity>
+            size_t alloc( guard_array<Capacity>& arr )
+            {
+                size_t i;
+                guard* g = free_head_;
+                for ( i = 0; i < Capacity && g; ++i ) {
+                    arr.reset( i, g );
+                    g = g->next_;
+                }
+
+#       ifdef CDS_DISABLE_SMR_EXCEPTION
+                assert( i == Capacity );
+#       else
+                if ( i != Capacity )
+                    CDS_THROW_EXCEPTION( not_enought_hazard_ptr());
+#       endif
+                free_head_ = g;
+                active_ += Capacity;
+                CDS_HYALINESTAT( alloc_guard_count_ += Capacity );
+                return i;
+            }
+
+            template <size_t Capacity>
+            void free( guard_array<Capacity>& arr ) noexcept
+            {
+                guard* gList = free_head_;
+                for ( size_t i = 0; i < Capacity; ++i ) {
+                    guard* g = arr[i];
+                    if ( g ) {
+                        g->clear();
+                        g->next_ = gList;
+                        gList = g;
+                        --active_;
+                        CDS_HYALINESTAT( ++free_guard_count_ );
+                    }
+                }
+                free_head_ = gList;
+            }
+
+            static size_t calc_array_size( size_t capacity )
+            {
+                return sizeof( guard ) * capacity;
+            }
+
+        private:
+            guard*          free_head_; ///< Head of free guard list
+            guard* const    array_;     ///< Guard array
+            size_t const    capacity_;  ///< Guard array capacity
+            size_t          active_;    ///< Count of allocated guards
+#       ifdef CDS_ENABLE_HPSTAT
+        public:
+            size_t          alloc_guard_count_;
+            size_t          free_guard_count_;
+#       endif
+        };
+        //@endcond
+
+
+        /// Internal statistics
+        struct stat {
+            size_t  guard_allocated;    ///< Count of allocated Hyaline guards
+            size_t  guard_freed;        ///< Count of freed Hyaline guards
+            size_t  retired_count;      ///< Count of retired pointers
+            size_t  free_count;         ///< Count of free pointers
+            size_t  batch_count;        ///< Count of retired batches
+            size_t  batch_free_count;   ///< Count of freed batches
+            size_t  enter_count;        ///< Count of slot activations, i.e. count of fences on the read side
+            size_t  traverse_count;     ///< Count of batch references released by the threads leaving the slot
+
+            size_t  thread_rec_count;   ///< Count of thread records (max count of simultaneously attached threads)
+
+            /// Default ctor
+            stat()
+            {
+                clear();
+            }
+
+            /// Clears all counters
+            void clear()
+            {
+                guard_allocated =
+                    guard_freed =
+                    retired_count =
+                    free_count =
+                    batch_count =
+                    batch_free_count =
+                    enter_count =
+                    traverse_count =
+                    thread_rec_count = 0;
+            }
+        };
+
+        //@cond
+        /// Per-thread data
+        struct thread_data {
+            thread_guard_storage    guards_;    ///< Guards private to the thread
+            atomics::atomic<uintptr_t>& head_;  ///< Head of the retired list of the thread's slot and \p c_active bit
+            cds::gc::details::retired_ptr* const retired_;  ///< The batch being filled by the thread
+            size_t const            batch_size_;    ///< Capacity of \p retired_
+            size_t                  retired_count_; ///< Count of retired pointers in \p retired_
+
+#       ifdef CDS_ENABLE_HPSTAT
+            // Internal statistics:
+            size_t              retire_call_count_;
+            size_t              free_count_;
+            size_t              batch_count_;
+            size_t              batch_free_count_;
+            size_t              enter_count_;
+            size_t              traverse_count_;
+#       endif
+
+            thread_data( guard* guards, size_t guard_count, cds::gc::details::retired_ptr* retired, size_t batch_size, atomics::atomic<uintptr_t>& head )
+                : guards_( guards, guard_count )
+                , head_( head )
+                , retired_( retired )
+                , batch_size_( batch_size )
+                , retired_count_( 0 )
+#       ifdef CDS_ENABLE_HPSTAT
+                , retire_call_count_(0)
+                , free_count_(0)
+                , batch_count_(0)
+                , batch_free_count_(0)
+                , enter_count_(0)
+                , traverse_count_(0)
+#       endif
+            {}
+
+            thread_data() = delete;
+            thread_data( thread_data const& ) = delete;
+            thread_data( thread_data&& ) = delete;
+
+            /// Activates the slot of the thread: the thread enters an operation
+            void enter()
+            {
+                // The batches retired from now on are linked to the slot
+                head_.store( c_active, atomics::memory_order_seq_cst );
+                CDS_HYALINESTAT( ++enter_count_ );
+            }
+
+            /// Deactivates the slot and releases the batches retired while the thread was inside the operation
+            inline void leave();
+
+            guard* alloc_guard()
+            {
+                guard* g = guards_.alloc();
+                if ( guards_.active() == 1 )
+                    enter();
+                return g;
+            }
+
+            void free_guard( guard* g ) noexcept
+            {
+                guards_.free( g );
+                if ( guards_.active() == 0 )
+                    leave();
+            }
+
+            template <size_t Capacity>
+            void alloc_guard( guard_array<Capacity>& arr )
+            {
+                bool const bEnter = guards_.active() == 0;
+                guards_.alloc( arr );
+                if ( bEnter )
+                    enter();
+            }
+
+            template <size_t Capacity>
+            void free_guard( guard_array<Capacity>& arr ) noexcept
+            {
+                guards_.free( arr );
+                if ( guards_.active() == 0 )
+                    leave();
+            }
+
+            /// Pushes \p p to the current batch, returns \p false if the batch is full and should be retired
+            bool retire( cds::gc::details::retired_ptr const& p ) noexcept
+            {
+                assert( retired_count_ < batch_size_ );
+                retired_[retired_count_] = p;
+                CDS_HYALINESTAT( ++retire_call_count_ );
+                return ++retired_count_ < batch_size_;
+            }
+        };
+        //@endcond
+
+        //@cond
+        /// Hyaline SMR (Safe Memory Reclamation)
+        class smr
+        {
+            struct thread_record;
+            struct slot;
+            struct slot_block;
+
+        public:
+            /// Returns the instance of Hyaline \ref smr
+            static smr& instance()
+            {
+#       ifdef CDS_DISABLE_SMR_EXCEPTION
+                assert( instance_ != nullptr );
+#       else
+                if ( !instance_ )
+                    CDS_THROW_EXCEPTION( not_initialized());
+#       endif
+                return *instance_;
+            }
+
+            /// Creates Hyaline SMR singleton
+            /**
+                Hyaline SMR is a singleton. If Hyaline instance is not initialized then the function creates the instance.
+                Otherwise it does nothing.
+
+                The parameters:
+                - \p nGuardCount - guard count per thread. Default is 72.
+                - \p nMaxThreadCount - expected max count of simultaneously attached threads, i.e. the size of the slot block. Default is 100.
+                - \p nBatchSize - count of retired pointers in a batch. Default is 64.
+            */
+            static CDS_EXPORT_API void construct(
+                size_t nGuardCount = 0,     ///< Guard count per thread
+                size_t nMaxThreadCount = 0, ///< Max count of simultaneously attached threads
+                size_t nBatchSize = 0       ///< Batch size
+            );
+
+            /// Destroys global instance of \ref smr
+            /**
+                The parameter \p bDetachAll should be used carefully: if its value is \p true,
+                then the object destroyed automatically detaches all attached threads. This feature
+                can be useful when you have no control over the thread termination, for example,
+                when \p libcds is injected into existing external thread.
+            */
+            static CDS_EXPORT_API void destruct(
+                bool bDetachAll = false     ///< Detach all threads
+            );
+
+            /// Checks if global SMR object is constructed and may be used
+            static bool isUsed() noexcept
+            {
+                return instance_ != nullptr;
+            }
+
+            /// Set memory management functions
+            /**
+                @note This function may be called <b>BEFORE</b> creating an instance
+                of Hyaline SMR
+
+                SMR object allocates some memory for thread-specific data, for retired batches and for
+                creating SMR object.
+                By default, a standard \p new and \p delete operators are used for this.
+            */
+            static CDS_EXPORT_API void set_memory_allocator(
+                void* ( *alloc_func )( size_t size ),
+                void (*free_func )( void * p )
+            );
+
+            /// Returns max guard count per thread
+            size_t get_guard_count() const noexcept
+            {
+                return guard_count_;
+            }
+
+            /// Returns the size of the slot block
+            size_t get_max_thread_count() const noexcept
+            {
+                return max_thread_count_;
+            }
+
+            /// Returns batch size
+            size_t get_batch_size() const noexcept
+            {
+                return batch_size_;
+            }
+
+            /// Checks that required guard count \p nRequiredCount is less or equal then max guard count
+            /**
+                If <tt> nRequiredCount > get_guard_count()</tt> then the exception \p not_enought_hazard_ptr is thrown
+            */
+            static void check_guard_count( size_t nRequiredCount )
+            {
+                if ( instance().get_guard_count() < nRequiredCount ) {
+#       ifdef CDS_DISABLE_SMR_EXCEPTION
+                    assert( false );    // not enough guards
+#       else
+                    CDS_THROW_EXCEPTION( not_enought_hazard_ptr());
+#       endif
+                }
+            }
+
+            /// Returns thread-local data for the current thread, attaching the thread to the GC on first call
+            static CDS_EXPORT_API thread_data* tls();
+
+            static CDS_EXPORT_API void attach_thread();
+            static CDS_EXPORT_API void detach_thread();
+
+            /// Get internal statistics
+            CDS_EXPORT_API void statistics( stat& st );
+
+        public: // for internal use only
+            /// Retires the current batch of the thread
+            /**
+                The batch is linked to the list of each active slot and its reference counter
+                is set to the count of the slots. The thread leaving the slot decrements the counter
+                of each batch of its list; the batch is freed when the counter becomes zero.
+                If no slot is active, the batch is freed immediately.
+            */
+            CDS_EXPORT_API void retire_batch( thread_data* pRec );
+
+            /// Releases the batches of the retired list \p list of the slot, called by \p thread_data::leave()
+            static CDS_EXPORT_API void traverse( thread_data* pRec, uintptr_t list );
+
+        private:
+            CDS_EXPORT_API smr(
+                size_t nGuardCount,     ///< Guard count per thread
+                size_t nMaxThreadCount, ///< Max count of simultaneously attached threads
+                size_t nBatchSize       ///< Batch size
+            );
+
+            CDS_EXPORT_API ~smr();
+
+            CDS_EXPORT_API void detach_all_thread();
+
+        private:
+            CDS_EXPORT_API thread_record* create_thread_data( slot& s );
+            static CDS_EXPORT_API void destroy_thread_data( thread_record* pRec );
+
+            CDS_EXPORT_API slot_block* create_slot_block();
+            CDS_EXPORT_API void destroy_slot_block( slot_block* pBlock );
+
+            /// Allocates a free slot and its thread private data
+            CDS_EXPORT_API thread_record* alloc_thread_data();
+
+            /// Frees the slot of the thread
+            CDS_EXPORT_API void free_thread_data( thread_record* pRec );
+
+        private:
+            static CDS_EXPORT_API smr* instance_;
+
+            size_t const    guard_count_;       ///< max count of thread's guards
+            size_t const    max_thread_count_;  ///< count of slots in the slot block
+            size_t const    batch_size_;        ///< batch size
+
+            slot_block*     slots_;             ///< List of slot blocks, the list is extended when all slots are busy
+
+            char pad1_[cds::c_nCacheLineSize];
+            atomics::atomic<size_t> slot_count_;    ///< Max index of used slot + 1, slots above are never active
+            char pad2_[cds::c_nCacheLineSize];
+        };
+        //@endcond
+
+        //@cond
+        inline void thread_data::leave()
+        {
+            uintptr_t const list = head_.exchange( 0, atomics::memory_order_acq_rel );
+            if ( list != c_active )
+                smr::traverse( this, list & ~c_active );
+        }
+        //@endcond
+
+    } // namespace hyaline
+
+    /// Hyaline SMR (Safe Memory Reclamation)
+    /**  @ingroup cds_garbage_collector
+
+        Implementation of Hyaline reclamation with a slot per thread
+
+        Sources:
+            - [2019] Ruslan Nikolaev, Binoy Ravindran "Hyaline: Fast and Transparent Lock-Free Memory Reclamation"
+
+        Hyaline is an interface-compatible replacement of \p cds::gc::HP for applications with high thread churn.
+        The thread has no record in a global thread list: attaching a thread takes the lowest free slot,
+        detaching returns it. The reclamation does not scan the threads and is proportional
+        to the max count of simultaneously attached threads.
+
+        The reader does not publish any pointer: the first guard allocated by the thread activates its slot
+        (one store and one fence per operation), the last freed guard deactivates the slot.
+        \p Guard::protect() is a plain atomic load.
+
+        The retired pointers are accumulated in a thread-private batch. A full batch is linked to the list
+        of each active slot and gets a reference counter equal to the count of these slots.
+        When the thread leaves the operation, it takes the list of its slot and decrements the counter
+        of each batch in the list. The thread that drops the counter to zero frees the batch.
+        So, a batch is freed as soon as all the threads that were inside an operation at the moment
+        of the batch retirement have left the operation.
+
+        Like epoch-based schemes, Hyaline is not robust: a thread that stays inside an operation
+        (for example, holds a \p guarded_ptr) delays freeing of all batches retired meanwhile.
+
+        Hyaline SMR is a singleton. Before use any Hyaline-related class you must initialize \p %Hyaline
+        by contructing \p %cds::gc::Hyaline object in beginning of your \p main().
+        To use the containers with \p %Hyaline, include the corresponding <tt>*_hyaline.h</tt> header, for example,
+        <tt>cds/container/michael_list_hyaline.h</tt>.
+    */
+    class Hyaline
+    {
+    public:
+        /// Native guarded pointer type
+        typedef hyaline::hazard_ptr guarded_pointer;
+
+        /// Atomic reference
+        template <typename T> using atomic_ref = atomics::atomic<T *>;
+
+        /// Atomic marked pointer
+        template <typename MarkedPtr> using atomic_marked_ptr = atomics::atomic<MarkedPtr>;
+
+        /// Atomic type
+        template <typename T> using atomic_type = atomics::atomic<T>;
+
+        /// Exception "Not enough guards"
+        typedef hyaline::not_enought_hazard_ptr not_enought_hazard_ptr_exception;
+
+        /// Internal statistics
+        typedef hyaline::stat stat;
+
+        /// Hyaline guard
+        /**
+            The guard has the same interface as \p cds::gc::HP::Guard.
+            While the thread owns at least one guard, its slot is active and any batch retired
+            meanwhile cannot be freed, so any pointer read by the thread is safe. The guarded pointer itself
+            is private to the owner thread.
+
+            \p %Guard object is movable but not copyable.
+
+            The guard object can be in two states:
+            - unlinked - the guard is not linked with any internal guard slot.
+              In this state no operation except \p link() and move assignment is supported.
+            - linked (default) - the guard allocates an internal guard slot and completely operable.
+
+            @warning Move assignment transfers the guard in unlinked state, use with care.
+        */
+        class Guard
+        {
+        public:
+            /// Default ctor allocates a guard slot from thread-private storage
+            /**
+                @warning Can throw \p not_enought_hazard_ptr_exception if internal guard slots are exhausted.
+            */
+            Guard()
+                : guard_( hyaline::smr::tls()->alloc_guard())
+            {}
+
+            /// Initilalizes an unlinked guard i.e. the guard contains no guard slot. Used for move semantics support
+            explicit Guard( std::nullptr_t ) noexcept
+                : guard_( nullptr )
+            {}
+
+            /// Move ctor - \p src guard becomes unlinked (transfer internal guard ownership)
+            Guard( Guard&& src ) noexcept
+                : guard_( src.guard_ )
+            {
+                src.guard_ = nullptr;
+            }
+
+            /// Move assignment: the internal guards are swapped between \p src and \p this
+            /**
+                @warning \p src will become in unlinked state if \p this was unlinked on entry.
+            */
+            Guard& operator=( Guard&& src ) noexcept
+            {
+                std::swap( guard_, src.guard_ );
+                return *this;
+            }
+
+            /// Copy ctor is prohibited - the guard is not copyable
+            Guard( Guard const& ) = delete;
+
+            /// Copy assignment is prohibited
+            Guard& operator=( Guard const& ) = delete;
+
+            /// Frees the internal guard slot if the guard is in linked state
+            ~Guard()
+            {
+                unlink();
+            }
+
+            /// Checks if the guard object linked with any internal guard slot
+            bool is_linked() const
+            {
+                return guard_ != nullptr;
+            }
+
+            /// Links the guard with internal guard slot if the guard is in unlinked state
+            /**
+                @warning Can throw \p not_enought_hazard_ptr_exception if internal guard array is exhausted.
+            */
+            void link()
+            {
+                if ( !guard_ )
+                    guard_ = hyaline::smr::tls()->alloc_guard();
+            }
+
+            /// Unlinks the guard from internal guard slot. The guard becomes in unlinked state
+            void unlink()
+            {
+                if ( guard_ ) {
+                    hyaline::smr::tls()->free_guard( guard_ );
+                    guard_ = nullptr;
+                }
+            }
+
+            /// Protects a pointer of type \p atomic<T*>
+            /**
+                Return the value of \p toGuard
+
+                The slot of the thread is already active, so the function is a plain load of \p toGuard.
+
+                @warning The guad object should be in linked state, otherwise the result is undefined
+            */
+            template <typename T>
+            T protect( atomics::atomic<T> const& toGuard )
+            {
+                assert( guard_ != nullptr );
+
+                T pCur = toGuard.load( atomics::memory_order_acquire );
+                guard_->set( pCur );
+                return pCur;
+            }
+
+            /// Protects a converted pointer of type \p atomic<T*>
+            /**
+                Return the value of \p toGuard
+
+                The function is the same as \p protect( toGuard ) but the result of <tt> f( toGuard.load()) </tt>
+                is stored as the guarded pointer.
+
+                The function is useful for intrusive containers when \p toGuard is a node pointer
+                that should be converted to a pointer to the value before protecting.
+                The parameter \p f of type Func is a functor that makes this conversion:
+                \code
+                    struct functor {
+                        value_type * operator()( T * p );
+                    };
+                \endcode
+
+                @warning The guad object should be in linked state, otherwise the result is undefined
+            */
+            template <typename T, class Func>
+            T protect( atomics::atomic<T> const& toGuard, Func f )
+            {
+                assert( guard_ != nullptr );
+
+                T pCur = toGuard.load( atomics::memory_order_acquire );
+                guard_->set( f( pCur ));
+                return pCur;
+            }
+
+            /// Store \p p to the guard
+            /**
+                The function is intended for a pointer that cannot be changed concurrently
+                or if the pointer is already guarded by another guard of the thread.
+
+                @warning The guad object should be in linked state, otherwise the result is undefined
+            */
+            template <typename T>
+            T * assign( T* p )
+            {
+                assert( guard_ != nullptr );
+
+                guard_->set( p );
+                return p;
+            }
+
+            //@cond
+            std::nullptr_t assign( std::nullptr_t )
+            {
+                assert( guard_ != nullptr );
+
+                guard_->clear();
+                return nullptr;
+            }
+            //@endcond
+
+            /// Copy a value guarded from \p src guard to \p this guard (valid only in linked state)
+            void copy( Guard const& src )
+            {
+                assign( src.get_native());
+            }
+
+            /// Store marked pointer \p p to the guard
+            /**
+                The function equals to a simple assignment of <tt>p.ptr()</tt>, no loop is performed.
+                Can be used for a marked pointer that cannot be changed concurrently or if the marked pointer
+                is already guarded by another guard.
+
+                @warning The guard object should be in linked state, otherwise the result is undefined
+            */
+            template <typename T, int BITMASK>
+            T * assign( cds::details::marked_ptr<T, BITMASK> p )
+            {
+                return assign( p.ptr());
+            }
+
+            /// Clear value of the guard (valid only in linked state)
+            void clear()
+            {
+                assign( nullptr );
+            }
+
+            /// Get the value currently protected (valid only in linked state)
+            template <typename T>
+            T * get() const
+            {
+                assert( guard_ != nullptr );
+                return guard_->get_as<T>();
+            }
+
+            /// Get native guarded pointer stored (valid only in linked state)
+            guarded_pointer get_native() const
+            {
+                assert( guard_ != nullptr );
+                return guard_->get();
+            }
+
+            //@cond
+            hyaline::guard* release()
+            {
+                hyaline::guard* g = guard_;
+                guard_ = nullptr;
+                return g;
+            }
+
+            hyaline::guard*& guard_ref()
+            {
+                return guard_;
+            }
+            //@endcond
+
+        private:
+            //@cond
+            hyaline::guard* guard_;
+            //@endcond
+        };
+
+        /// Array of Hyaline guards
+        /**
+            The class is intended for allocating an array of guards.
+            Template parameter \p Count defines the size of the array.
+            The interface is the same as \p cds::gc::HP::GuardArray.
+        */
+        template <size_t Count>
+        class GuardArray
+        {
+        public:
+            /// Rebind array for other size \p Count2
+            template <size_t Count2>
+            struct rebind {
+                typedef GuardArray<Count2>  other;   ///< rebinding result
+            };
+
+            /// Array capacity
+            static constexpr const size_t c_nCapacity = Count;
+
+        public:
+            /// Default ctor allocates \p Count guard slots
+            GuardArray()
+            {
+                hyaline::smr::tls()->alloc_guard( guards_ );
+            }
+
+            /// Move ctor is prohibited
+            GuardArray( GuardArray&& ) = delete;
+
+            /// Move assignment is prohibited
+            GuardArray& operator=( GuardArray&& ) = delete;
+
+            /// Copy ctor is prohibited
+            GuardArray( GuardArray const& ) = delete;
+
+            /// Copy assignment is prohibited
+            GuardArray& operator=( GuardArray const& ) = delete;
+
+            /// Frees allocated guard slots
+            ~GuardArray()
+            {
+                hyaline::smr::tls()->free_guard( guards_ );
+            }
+
+            /// Protects a pointer of type \p atomic<T*>
+            /**
+                Return the value of \p toGuard
+
+                The function is a plain load of \p toGuard, the result is stored in the slot \p nIndex.
+            */
+            template <typename T>
+            T protect( size_t nIndex, atomics::atomic<T> const& toGuard )
+            {
+                assert( nIndex < capacity());
+
+                T pRet = toGuard.load( atomics::memory_order_acquire );
+                guards_[nIndex]->set( pRet );
+                return pRet;
+            }
+
+            /// Protects a pointer of type \p atomic<T*>
+            /**
+                Return the value of \p toGuard
+
+                The function is the same as \p protect( nIndex, toGuard ) but the result of <tt> f( toGuard.load()) </tt>
+                is stored as the guarded pointer.
+            */
+            template <typename T, class Func>
+            T protect( size_t nIndex, atomics::atomic<T> const& toGuard, Func f )
+            {
+                assert( nIndex < capacity());
+
+                T pRet = toGuard.load( atomics::memory_order_acquire );
+                guards_[nIndex]->set( f( pRet ));
+                return pRet;
+            }
+
+            /// Store \p p to the slot \p nIndex
+            /**
+                The function is intended for a pointer that cannot be changed concurrently
+                or if the pointer is already guarded by another guard of the thread.
+            */
+            template <typename T>
+            T * assign( size_t nIndex, T * p )
+            {
+                assert( nIndex < capacity());
+
+                guards_[nIndex]->set( p );
+                return p;
+            }
+
+            /// Store marked pointer \p p to the guard
+            /**
+                The function equals to a simple assignment of <tt>p.ptr()</tt>, no loop is performed.
+                Can be used for a marked pointer that cannot be changed concurrently.
+            */
+            template <typename T, int BITMASK>
+            T * assign( size_t nIndex, cds::details::marked_ptr<T, BITMASK> p )
+            {
+                return assign( nIndex, p.ptr());
+            }
+
+            /// Copy guarded value from \p src guard to slot at index \p nIndex
+            void copy( size_t nIndex, Guard const& src )
+            {
+                assign( nIndex, src.get_native());
+            }
+
+            /// Copy guarded value from slot \p nSrcIndex to the slot \p nDestIndex
+            void copy( size_t nDestIndex, size_t nSrcIndex )
+            {
+                assign( nDestIndex, get_native( nSrcIndex ));
+            }
+
+            /// Clear value of the slot \p nIndex
+            void clear( size_t nIndex )
+            {
+                guards_.clear( nIndex );
+            }
+
+            /// Get current value of slot \p nIndex
+            template <typename T>
+            T * get( size_t nIndex ) const
+            {
+                assert( nIndex < capacity());
+                return guards_[nIndex]->template get_as<T>();
+            }
+
+            /// Get native guarded pointer stored
+            guarded_pointer get_native( size_t nIndex ) const
+            {
+                assert( nIndex < capacity());
+                return guards_[nIndex]->get();
+            }
+
+            //@cond
+            hyaline::guard* release( size_t nIndex ) noexcept
+            {
+                return guards_.release( nIndex );
+            }
+            //@endcond
+
+            /// Capacity of the guard array
+            static constexpr size_t capacity()
+            {
+                return c_nCapacity;
+            }
+
+        private:
+            //@cond
+            hyaline::guard_array<c_nCapacity> guards_;
+            //@endcond
+        };
+
+        /// Guarded pointer
+        /**
+            A guarded pointer is a pair of a pointer and GC's guard.
+            Usually, it is used for returning a pointer to an element of a lock-free container.
+            The guard prevents the pointer to be early disposed (freed) by SMR.
+            After destructing \p %guarded_ptr object the pointer can be disposed (freed) automatically at any time.
+
+            The interface is the same as \p cds::gc::HP::guarded_ptr.
+            Note that a live \p %guarded_ptr keeps the slot of the owner thread active and delays
+            freeing of all batches retired meanwhile, so do not hold it for a long time.
+
+            Template arguments:
+            - \p GuardedType - a type which the guard stores
+            - \p ValueType - a value type
+            - \p Cast - a functor for converting <tt>GuardedType*</tt> to <tt>ValueType*</tt>. Default is \p void (no casting).
+
+            You don't need use this class directly.
+            All set/map container classes from \p libcds declare the typedef for \p %guarded_ptr with appropriate casting functor.
+        */
+        template <typename GuardedType, typename ValueType=GuardedType, typename Cast=void >
+        class guarded_ptr
+        {
+            //@cond
+            struct trivial_cast {
+                ValueType * operator()( GuardedType * p ) const
+                {
+                    return p;
+                }
+            };
+
+            template <typename GT, typename VT, typename C> friend class guarded_ptr;
+            //@endcond
+
+        public:
+            typedef GuardedType guarded_type; ///< Guarded type
+            typedef ValueType   value_type;   ///< Value type
+
+            /// Functor for casting \p guarded_type to \p value_type
+            typedef typename std::conditional< std::is_same<Cast, void>::value, trivial_cast, Cast >::type value_cast;
+
+        public:
+            /// Creates empty guarded pointer
+            guarded_ptr() noexcept
+                : guard_(nullptr)
+            {}
+
+            //@cond
+            explicit guarded_ptr( hyaline::guard* g ) noexcept
+                : guard_( g )
+            {}
+
+            /// Initializes guarded pointer with \p p
+            explicit guarded_ptr( guarded_type* p ) noexcept
+                : guard_( nullptr )
+            {
+                reset(p);
+            }
+            explicit guarded_ptr( std::nullptr_t ) noexcept
+                : guard_( nullptr )
+            {}
+            //@endcond
+
+            /// Move ctor
+            guarded_ptr( guarded_ptr&& gp ) noexcept
+                : guard_( gp.guard_ )
+            {
+                gp.guard_ = nullptr;
+            }
+
+            /// Move ctor
+            template <typename GT, typename VT, typename C>
+            guarded_ptr( guarded_ptr<GT, VT, C>&& gp ) noexcept
+                : guard_( gp.guard_ )
+            {
+                gp.guard_ = nullptr;
+            }
+
+            /// Ctor from \p Guard
+            explicit guarded_ptr( Guard&& g ) noexcept
+                : guard_( g.release())
+            {}
+
+            /// The guarded pointer is not copy-constructible
+            guarded_ptr( guarded_ptr const& gp ) = delete;
+
+            /// Clears the guarded pointer
+            /**
+                \ref release() is called if guarded pointer is not \ref empty()
+            */
+            ~guarded_ptr() noexcept
+            {
+                release();
+            }
+
+            /// Move-assignment operator
+            guarded_ptr& operator=( guarded_ptr&& gp ) noexcept
+            {
+                std::swap( guard_, gp.guard_ );
+                return *this;
+            }
+
+            /// Move-assignment from \p Guard
+            guarded_ptr& operator=( Guard&& g ) noexcept
+            {
+                std::swap( guard_, g.guard_ref());
+                return *this;
+            }
+
+            /// The guarded pointer is not copy-assignable
+            guarded_ptr& operator=(guarded_ptr const& gp) = delete;
+
+            /// Returns a pointer to guarded value
+            value_type * operator ->() const noexcept
+            {
+                assert( !empty());
+                return value_cast()( guard_->get_as<guarded_type>());
+            }
+
+            /// Returns a reference to guarded value
+            value_type& operator *() noexcept
+            {
+                assert( !empty());
+                return *value_cast()( guard_->get_as<guarded_type>());
+            }
+
+            /// Returns const reference to guarded value
+            value_type const& operator *() const noexcept
+            {
+                assert( !empty());
+                return *value_cast()( guard_->get_as<guarded_type>());
+            }
+
+            /// Checks if the guarded pointer is \p nullptr
+            bool empty() const noexcept
+            {
+                return !guard_ || guard_->get( atomics::memory_order_relaxed ) == nullptr;
+            }
+
+            /// \p bool operator returns <tt>!empty()</tt>
+            explicit operator bool() const noexcept
+            {
+                return !empty();
+            }
+
+            /// Clears guarded pointer
+            /**
+                If the guarded pointer has been released, the pointer can be disposed (freed) at any time.
+                Dereferncing the guarded pointer after \p release() is dangerous.
+            */
+            void release() noexcept
+            {
+                free_guard();
+            }
+
+            //@cond
+            // For internal use only!!!
+            void reset(guarded_type * p) noexcept
+            {
+                alloc_guard();
+                assert( guard_ );
+                guard_->set( p );
+            }
+            //@endcond
+
+        private:
+            //@cond
+            void alloc_guard()
+            {
+                if ( !guard_ )
+                    guard_ = hyaline::smr::tls()->alloc_guard();
+            }
+
+            void free_guard()
+            {
+                if ( guard_ ) {
+                    hyaline::smr::tls()->free_guard( guard_ );
+                    guard_ = nullptr;
+                }
+            }
+            //@endcond
+
+        private:
+            //@cond
+            hyaline::guard* guard_;
+            //@endcond
+        };
+
+
+    public:
+        /// Initializes %Hyaline singleton
+        /**
+            The constructor initializes Hyaline SMR singleton with passed parameters.
+            If the instance does not yet exist then the function creates the instance.
+            Otherwise it does nothing.
+
+            The %Hyaline reclamation schema depends of three parameters:
+            - \p nGuardCount - guard count per thread. The guards are not published, so the count
+                limits only the guards that can be allocated simultaneously. If \p nGuardCount = 0, the defaul value 72
+                (enough for the skip-list) is used
+            - \p nMaxThreadCount - expected max count of simultaneously attached threads, i.e. the size of the slot block.
+                Default is 100. If all slots are busy, a new slot block is allocated. The slots are reused by the threads,
+                so the total count of threads created by the application is unbounded.
+            - \p nBatchSize - count of retired pointers in a batch. Default is 64.
+                Greater value means less atomic operations per retired pointer and longer delay of reclamation.
+        */
+        Hyaline(
+            size_t nGuardCount = 0,     ///< Guard count per thread
+            size_t nMaxThreadCount = 0, ///< Max count of simultaneously attached threads
+            size_t nBatchSize = 0       ///< Batch size
+        )
+        {
+            hyaline::smr::construct(
+                nGuardCount,
+                nMaxThreadCount,
+                nBatchSize
+            );
+        }
+
+        /// Terminates GC singleton
+        /**
+            The destructor destroys %Hyaline global object. After calling of this function you may \b NOT
+            use CDS data structures based on \p %cds::gc::Hyaline.
+            Usually, %Hyaline object is destroyed at the end of your \p main().
+        */
+        ~Hyaline()
+        {
+            hyaline::smr::destruct( true );
+        }
+
+        /// Checks that required guard count \p nCountNeeded is less or equal then max guard count
+        /**
+            If <tt> nRequiredCount > max_hazard_count()</tt> then the exception \p not_enought_hazard_ptr is thrown
+        */
+        static void check_available_guards( size_t nCountNeeded )
+        {
+            hyaline::smr::check_guard_count( nCountNeeded );
+        }
+
+        /// Set memory management functions
+        /**
+            @note This function may be called <b>BEFORE</b> creating an instance
+            of Hyaline SMR
+
+            SMR object allocates some memory for thread-specific data, for retired batches and for
+            creating SMR object.
+            By default, a standard \p new and \p delete operators are used for this.
+        */
+        static void set_memory_allocator(
+            void* ( *alloc_func )( size_t size ),   ///< \p malloc() function
+            void( *free_func )( void * p )          ///< \p free() function
+        )
+        {
+            hyaline::smr::set_memory_allocator( alloc_func, free_func );
+        }
+
+        /// Returns max guard count per thread
+        static size_t max_hazard_count()
+        {
+            return hyaline::smr::instance().get_guard_count();
+        }
+
+        /// Returns the size of the slot block
+        static size_t max_thread_count()
+        {
+            return hyaline::smr::instance().get_max_thread_count();
+        }
+
+        /// Returns batch size
+        static size_t retired_array_capacity()
+        {
+            return hyaline::smr::instance().get_batch_size();
+        }
+
+        /// Retire pointer \p p with function \p func
+        /**
+            The function places pointer \p p to the current batch of the thread.
+            The full batch is linked to the active slots and is freed when all threads
+            active at the moment of the batch retirement have left their operations.
+            \p func is a disposer: when \p p can be safely removed, \p func is called.
+        */
+        template <typename T>
+        static void retire( T * p, void( *func )( void * ))
+        {
+            hyaline::thread_data* rec = hyaline::smr::tls();
+            if ( !rec->retire( cds::gc::details::retired_ptr( p, func )))
+                hyaline::smr::instance().retire_batch( rec );
+        }
+
+        /// Retire pointer \p p with functor of type \p Disposer
+        /**
+            The function places pointer \p p to the current batch of the thread.
+            The full batch is linked to the active slots and is freed when all threads
+            active at the moment of the batch retirement have left their operations.
+
+            See \p cds::gc::HP::retire() for \p Disposer requirements.
+        */
+        template <class Disposer, typename T>
+        static void retire( T * p )
+        {
+            hyaline::thread_data* rec = hyaline::smr::tls();
+            if ( !rec->retire( cds::gc::details::retired_ptr( p, cds::gc::details::retired_functor<Disposer, T>::get())))
+                hyaline::smr::instance().retire_batch( rec );
+        }
+
+        /// Checks that %Hyaline singleton is initialized
+        static bool isUsed()
+        {
+            return hyaline::smr::isUsed();
+        }
+
+        /// Forces reclamation
+        /**
+            The function retires the current (not full) batch of the thread.
+            Usually, this function should not be called directly.
+        */
+        static void scan()
+        {
+            hyaline::smr::instance().retire_batch( hyaline::smr::tls());
+        }
+
+        /// Forces reclamation of all objects retired by the current thread
+        /**
+            The function retires the current batch of the thread. The objects are freed immediately
+            if no other thread is inside an operation, otherwise by the last thread leaving its operation.
+            The containers call this function in the destructor.
+        */
+        static void force_dispose()
+        {
+            scan();
+        }
+
+        /// Returns internal statistics
+        /**
+            The function clears \p st before gathering statistics.
+
+            @note Internal statistics is available only if you compile
+            \p libcds and your program with \p -DCDS_ENABLE_HPSTAT.
+        */
+        static void statistics( stat& st )
+        {
+            hyaline::smr::instance().statistics( st );
+        }
+
+        /// Returns post-mortem statistics
+        /**
+            Post-mortem statistics is gathered in the \p %Hyaline object destructor
+            and can be accessible after destructing the global \p %Hyaline object.
+
+            @note Internal statistics is available only if you compile
+            \p libcds and your program with \p -DCDS_ENABLE_HPSTAT.
+        */
+        CDS_EXPORT_API static stat const& postmortem_statistics();
+    };
+
+}} // namespace cds::gc
+
+#endif // #ifndef CDSLIB_GC_HYALINE_SMR_H
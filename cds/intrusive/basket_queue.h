@@ -33,6 +33,7 @@
 
 #include <type_traits>
 #include <cds/intrusive/details/single_link_struct.h>
+#include <cds/gc/details/retired_ptr.h>
 #include <cds/details/marked_ptr.h>
 
 namespace cds { namespace intrusive {
@@ -592,18 +593,28 @@ namespace cds { namespace intrusive {
             pNode->m_pNext.store( marked_ptr( nullptr ), memory_model::memory_order_release );
         }
 
+        struct internal_disposer
+        {
+            void operator()( value_type * p )
+            {
+                assert( p != nullptr );
+                BasketQueue::clear_links( node_traits::to_node_ptr( p ));
+                disposer()(p);
+            }
+
+            template <typename Q = value_type>
+            typename std::enable_if< cds::gc::details::has_batch_call< disposer, Q >::value >::type
+            operator()( value_type ** arr, size_t count )
+            {
+                for ( size_t i = 0; i < count; ++i )
+                    BasketQueue::clear_links( node_traits::to_node_ptr( arr[i] ));
+                disposer()( arr, count );
+            }
+        };
+
         void dispose_node( node_type * p )
         {
             if ( p != &m_Dummy ) {
-                struct internal_disposer
-                {
-                    void operator()( value_type * p )
-                    {
-                        assert( p != nullptr );
-                        BasketQueue::clear_links( node_traits::to_node_ptr( p ));
-                        disposer()(p);
-                    }
-                };
                 gc::template retire<internal_disposer>( node_traits::to_value_ptr(p));
             }
         }
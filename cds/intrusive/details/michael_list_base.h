@@ -36,6 +36,7 @@
 #include <cds/opt/compare.h>
 #include <cds/algo/atomic.h>
 #include <cds/details/marked_ptr.h>
+#include <cds/gc/details/node_data.h>
 #include <cds/urcu/options.h>
 
 namespace cds { namespace intrusive {
@@ -51,7 +52,7 @@ namespace cds { namespace intrusive {
             - \p Tag - a \ref cds_intrusive_hook_tag "tag"
         */
         template <class GC, typename Tag = opt::none>
-        struct node
+        struct node: public cds::gc::details::node_data<GC>
         {
             typedef GC              gc  ;   ///< Garbage collector
             typedef Tag             tag ;   ///< tag
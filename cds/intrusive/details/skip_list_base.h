@@ -33,6 +33,7 @@
 
 #include <cds/intrusive/details/base.h>
 #include <cds/details/marked_ptr.h>
+#include <cds/gc/details/node_data.h>
 #include <cds/algo/bitop.h>
 #include <cds/os/timer.h>
 #include <cds/urcu/options.h>
@@ -52,7 +53,7 @@ namespace cds { namespace intrusive {
             - \p Tag - a \ref cds_intrusive_hook_tag "tag"
         */
         template <class GC, typename Tag = opt::none>
-        class node
+        class node: public cds::gc::details::node_data<GC>
         {
         public:
             typedef GC      gc;  ///< Garbage collector
@@ -33,6 +33,7 @@
 
 #include <cds/intrusive/details/base.h>
 #include <cds/gc/default_gc.h>
+#include <cds/gc/details/node_data.h>
 #include <cds/algo/atomic.h>
 #include <cds/intrusive/details/single_link_struct.h>
 
@@ -51,7 +52,8 @@ namespace cds { namespace intrusive {
         */
 
         template <class GC, typename Tag = opt::none >
-        struct node { 
+        struct node: public cds::gc::details::node_data<GC>
+        {
             typedef GC              gc  ;   ///< Garbage collector
             typedef Tag             tag ;   ///< tag
 
@@ -152,7 +152,7 @@ namespace cds { namespace intrusive {
         //@endcond
 
         /// Flat combining kernel
-        typedef cds::algo::flat_combining::kernel< fc_record, traits > fc_kernel;
+        typedef typename traits::fc_kernel::template make_kernel< fc_record, traits >::type fc_kernel;
 
     protected:
         //@cond
@@ -33,6 +33,7 @@
 
 #include <mutex>        // unique_lock
 #include <cds/intrusive/details/lazy_list_base.h>
+#include <cds/gc/details/retired_ptr.h>
 
 namespace cds { namespace intrusive {
 
@@ -246,6 +247,15 @@ namespace cds { namespace intrusive {
                 lazy_list::node_cleaner<gc, node_type, memory_model>()( node_traits::to_node_ptr( p ));
                 disposer()( p );
             }
+
+            template <typename Q = value_type>
+            typename std::enable_if< cds::gc::details::has_batch_call< disposer, Q >::value >::type
+            operator()( value_type ** arr, size_t count )
+            {
+                for ( size_t i = 0; i < count; ++i )
+                    lazy_list::node_cleaner<gc, node_type, memory_model>()( node_traits::to_node_ptr( arr[i] ));
+                disposer()( arr, count );
+            }
         };
 
         /// Position pointer for item search
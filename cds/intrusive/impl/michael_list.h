@@ -32,6 +32,7 @@
 #define CDSLIB_INTRUSIVE_IMPL_MICHAEL_LIST_H
 
 #include <cds/intrusive/details/michael_list_base.h>
+#include <cds/gc/details/retired_ptr.h>
 #include <cds/details/make_const_type.h>
 
 namespace cds { namespace intrusive {
@@ -262,6 +263,16 @@ namespace cds { namespace intrusive {
                 michael_list::node_cleaner<gc, node_type, memory_model>()( node_traits::to_node_ptr( p ));
                 disposer()( p );
             }
+
+            // Forwards the batch call if the disposer supports it, see \p cds::gc::details::has_batch_call
+            template <typename Q = value_type>
+            typename std::enable_if< cds::gc::details::has_batch_call< disposer, Q >::value >::type
+            operator()( value_type ** arr, size_t count )
+            {
+                for ( size_t i = 0; i < count; ++i )
+                    michael_list::node_cleaner<gc, node_type, memory_model>()( node_traits::to_node_ptr( arr[i] ));
+                disposer()( arr, count );
+            }
         };
         //@endcond
 
@@ -270,7 +281,7 @@ namespace cds { namespace intrusive {
         static void retire_node( node_type * pNode )
         {
             assert( pNode != nullptr );
-            gc::template retire<clean_disposer>( node_traits::to_value_ptr( *pNode ));
+            pNode->template retire<clean_disposer>( node_traits::to_value_ptr( *pNode ));
         }
 
         static bool link_node( node_type * pNode, position& pos )
@@ -35,6 +35,7 @@
 #include <memory>
 #include <functional>   // ref
 #include <cds/intrusive/details/skip_list_base.h>
+#include <cds/gc/details/retired_ptr.h>
 #include <cds/opt/compare.h>
 #include <cds/details/binary_functor_wrapper.h>
 
@@ -1141,13 +1142,24 @@ namespace cds { namespace intrusive {
             return node_traits::to_value_ptr( p.ptr());
         }
 
-        static void dispose_node( void* p )
-        {
-            assert( p != nullptr );
-            value_type* pVal = reinterpret_cast<value_type*>( p );
-            typename node_builder::node_disposer()( node_traits::to_node_ptr( pVal ));
-            disposer()( pVal );
-        }
+        struct clean_disposer {
+            void operator()( value_type * p )
+            {
+                assert( p != nullptr );
+                typename node_builder::node_disposer()( node_traits::to_node_ptr( p ));
+                disposer()( p );
+            }
+
+            // The tower is freed per node, the items are disposed by the batch call of the disposer
+            template <typename Q = value_type>
+            typename std::enable_if< cds::gc::details::has_batch_call< disposer, Q >::value >::type
+            operator()( value_type ** arr, size_t count )
+            {
+                for ( size_t i = 0; i < count; ++i )
+                    typename node_builder::node_disposer()( node_traits::to_node_ptr( arr[i] ));
+                disposer()( arr, count );
+            }
+        };
 
         void help_remove( int nLevel, node_type* pPred, marked_node_ptr pCur )
         {
@@ -1161,7 +1173,7 @@ namespace cds { namespace intrusive {
                         memory_model::memory_order_acquire, atomics::memory_order_relaxed ))
                 {
                     if ( pCur->level_unlinked()) {
-                        gc::retire( node_traits::to_value_ptr( pCur.ptr()), dispose_node );
+                        pCur.ptr()->template retire<clean_disposer>( node_traits::to_value_ptr( pCur.ptr()));
                         m_Stat.onEraseWhileFind();
                     }
                 }
@@ -1527,7 +1539,7 @@ namespace cds { namespace intrusive {
                     }
 
                     // Fast erasing success
-                    gc::retire( node_traits::to_value_ptr( pDel ), dispose_node );
+                    pDel->template retire<clean_disposer>( node_traits::to_value_ptr( pDel ));
                     m_Stat.onFastErase();
                     return true;
                 }
@@ -1767,7 +1779,7 @@ namespace cds { namespace intrusive {
             node_type* p = m_Head.head()->next( 0 ).load( atomics::memory_order_relaxed ).ptr();
             while ( p ) {
                 node_type* pNext = p->next( 0 ).load( atomics::memory_order_relaxed ).ptr();
-                dispose_node( node_traits::to_value_ptr( p ));
+                clean_disposer()( node_traits::to_value_ptr( p ));
                 p = pNext;
             }
         }
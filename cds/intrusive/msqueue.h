@@ -33,6 +33,7 @@
 
 #include <type_traits>
 #include <cds/intrusive/details/single_link_struct.h>
+#include <cds/gc/details/retired_ptr.h>
 #include <cds/algo/atomic.h>
 
 namespace cds { namespace intrusive {
@@ -443,6 +444,24 @@ namespace cds { namespace intrusive {
             dispose_node( res.pHead );
         }
 
+        struct disposer_thunk {
+            void operator()( value_type * p ) const
+            {
+                assert( p != nullptr );
+                MSQueue::clear_links( node_traits::to_node_ptr( p ));
+                disposer()(p);
+            }
+
+            template <typename Q = value_type>
+            typename std::enable_if< cds::gc::details::has_batch_call< disposer, Q >::value >::type
+            operator()( value_type ** arr, size_t count )
+            {
+                for ( size_t i = 0; i < count; ++i )
+                    MSQueue::clear_links( node_traits::to_node_ptr( arr[i] ));
+                disposer()( arr, count );
+            }
+        };
+
         void dispose_node( node_type * p )
         {
             // Note about the dummy node:
@@ -452,15 +471,6 @@ namespace cds { namespace intrusive {
             // before HP retiring cycle invocation.
             // So, we will never clear m_Dummy
 
-            struct disposer_thunk {
-                void operator()( value_type * p ) const
-                {
-                    assert( p != nullptr );
-                    MSQueue::clear_links( node_traits::to_node_ptr( p ));
-                    disposer()(p);
-                }
-            };
-
             if ( p != &m_Dummy )
                 gc::template retire<disposer_thunk>( node_traits::to_value_ptr( p ));
         }
@@ -35,6 +35,7 @@
 #include <cds/intrusive/details/base.h>
 #include <cds/algo/atomic.h>
 #include <cds/gc/default_gc.h>
+#include <cds/gc/details/retired_ptr.h>
 
 namespace cds { namespace intrusive {
 
@@ -560,21 +561,31 @@ namespace cds { namespace intrusive {
             dispose_node( res.pHead );
         }
 
+        struct internal_disposer
+        {
+            void operator ()( value_type * p )
+            {
+                assert( p != nullptr );
+
+                OptimisticQueue::clear_links( node_traits::to_node_ptr( *p ));
+                disposer()(p);
+            }
+
+            template <typename Q = value_type>
+            typename std::enable_if< cds::gc::details::has_batch_call< disposer, Q >::value >::type
+            operator()( value_type ** arr, size_t count )
+            {
+                for ( size_t i = 0; i < count; ++i )
+                    OptimisticQueue::clear_links( node_traits::to_node_ptr( *arr[i] ));
+                disposer()( arr, count );
+            }
+        };
+
         void dispose_node( node_type * p )
         {
             assert( p != nullptr );
 
             if ( p != &m_Dummy ) {
-                struct internal_disposer
-                {
-                    void operator ()( value_type * p )
-                    {
-                        assert( p != nullptr );
-
-                        OptimisticQueue::clear_links( node_traits::to_node_ptr( *p ));
-                        disposer()(p);
-                    }
-                };
                 gc::template retire<internal_disposer>( node_traits::to_value_ptr(p));
             }
         }
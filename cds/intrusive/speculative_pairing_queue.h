@@ -254,7 +254,7 @@ namespace cds { namespace intrusive {
 			int probStale = 0; //< propability of dispose stale nodes
             //@cond
             /// Queue type
-            typedef struct QueueType {
+            typedef struct QueueType: public cds::gc::details::node_data<gc> {
 				typedef typename gc::template atomic_type<size_t> atomic_int;
 				typedef typename gc::template atomic_type<bool> atomic_bool;
 				
@@ -308,7 +308,7 @@ namespace cds { namespace intrusive {
 				//retire all except PICKET
                 if (p != PICKET)
                 {
-                    gc::template retire<disposer_node_thunk>( node_traits::to_value_ptr( p ));
+                    p->template retire<disposer_node_thunk>( node_traits::to_value_ptr( p ));
                 }
             }
 
@@ -338,7 +338,7 @@ namespace cds { namespace intrusive {
                     }
                 };
 
-				gc::template retire<disposer_thunk>(queue);
+				queue->template retire<disposer_thunk>(queue);
             }
 			
 /*			void dispose_stale_nodes( Slot &slot){
@@ -0,0 +1,68 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSLIB_OS_DETAILS_FAKE_FUTEX_H
+#define CDSLIB_OS_DETAILS_FAKE_FUTEX_H
+
+#ifndef CDSLIB_OS_FUTEX_H
+#   error "<cds/os/futex.h> must be included instead"
+#endif
+
+#include <cds/algo/atomic.h>
+#include <thread>
+
+namespace cds { namespace OS {
+
+    /// Fake futex
+    /**
+        The target OS has no futex support: \p wait() just yields the processor,
+        \p wake() does nothing.
+    */
+    struct futex {
+        /// Yields the processor, returns \p false
+        static bool wait( atomics::atomic<unsigned int>& word, unsigned int nExpected, unsigned int nTimeoutMilliseconds )
+        {
+            CDS_UNUSED( nTimeoutMilliseconds );
+            if ( word.load( atomics::memory_order_acquire ) == nExpected )
+                std::this_thread::yield();
+            return false;
+        }
+
+        /// Does nothing
+        static void wake( atomics::atomic<unsigned int>& word, int nCount = 1 )
+        {
+            CDS_UNUSED( word );
+            CDS_UNUSED( nCount );
+        }
+    };
+
+}}  // namespace cds::OS
+
+#endif  // #ifndef CDSLIB_OS_DETAILS_FAKE_FUTEX_H
@@ -0,0 +1,84 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSLIB_OS_LINUX_FUTEX_H
+#define CDSLIB_OS_LINUX_FUTEX_H
+
+#ifndef CDSLIB_OS_FUTEX_H
+#   error "<cds/os/futex.h> must be included instead"
+#endif
+
+#include <cds/algo/atomic.h>
+
+#include <time.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace cds { namespace OS {
+    inline namespace Linux {
+
+        /// Wait/wake on a 32-bit word based on Linux \p futex(2) system call
+        /**
+            The operations are process-private (\p FUTEX_PRIVATE_FLAG).
+        */
+        struct futex {
+            //@cond
+            static_assert( sizeof( atomics::atomic<unsigned int> ) == sizeof( int ), "futex word must be 32-bit" );
+            //@endcond
+
+            /// Blocks the current thread while \p word is equal to \p nExpected
+            /**
+                The thread sleeps until \p wake() is called for \p word
+                or \p nTimeoutMilliseconds is elapsed. If \p word is not equal to \p nExpected
+                the function returns immediately.
+
+                Returns \p true if the thread has been woken up by \p wake() (or spuriously),
+                \p false if the value of \p word is changed or the timeout is expired.
+            */
+            static bool wait( atomics::atomic<unsigned int>& word, unsigned int nExpected, unsigned int nTimeoutMilliseconds )
+            {
+                struct timespec ts;
+                ts.tv_sec = static_cast<time_t>( nTimeoutMilliseconds / 1000 );
+                ts.tv_nsec = static_cast<long>( nTimeoutMilliseconds % 1000 ) * 1000000;
+                return ::syscall( SYS_futex, reinterpret_cast<unsigned int *>( &word ), FUTEX_WAIT_PRIVATE, nExpected, &ts, nullptr, 0 ) == 0;
+            }
+
+            /// Wakes up to \p nCount threads blocked on \p word
+            static void wake( atomics::atomic<unsigned int>& word, int nCount = 1 )
+            {
+                ::syscall( SYS_futex, reinterpret_cast<unsigned int *>( &word ), FUTEX_WAKE_PRIVATE, nCount, nullptr, nullptr, 0 );
+            }
+        };
+    }   // namespace Linux
+
+}}  // namespace cds::OS
+
+#endif  // #ifndef CDSLIB_OS_LINUX_FUTEX_H
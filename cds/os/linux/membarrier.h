@@ -0,0 +1,110 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSLIB_OS_LINUX_MEMBARRIER_H
+#define CDSLIB_OS_LINUX_MEMBARRIER_H
+
+#ifndef CDSLIB_OS_MEMBARRIER_H
+#   error "<cds/os/membarrier.h> must be included instead"
+#endif
+
+#include <cds/algo/atomic.h>
+
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace cds { namespace OS {
+    inline namespace Linux {
+
+        /// Process-wide memory barrier based on Linux \p membarrier(2) system call
+        /**
+            The class is a building block for asymmetric fences: the frequent (reader) side
+            of an algorithm uses only the compiler barrier \p light(), and the rare side
+            calls \p heavy() that forces a full memory barrier on every running thread of the process.
+
+            \p heavy() uses \p MEMBARRIER_CMD_PRIVATE_EXPEDITED command available since Linux 4.14.
+            The process must be registered by \p register_expedited() before first \p heavy() call.
+            If \p register_expedited() returns \p false the asymmetric schema cannot be used
+            and the caller must use ordinary fences on both sides.
+
+            You may disable \p membarrier(2) usage compiling with <tt>-DCDS_LINUX_NO_membarrier</tt>.
+        */
+        struct membarrier {
+            //@cond
+            enum command {
+                cmd_query                       = 0,
+                cmd_private_expedited           = 1 << 3,
+                cmd_register_private_expedited  = 1 << 4
+            };
+            //@endcond
+
+            /// Registers the process for private expedited \p membarrier(2) command
+            /**
+                Returns \p true if the kernel supports private expedited command
+                and the registration is successful, \p false otherwise.
+                The function may be called several times.
+            */
+            static bool register_expedited()
+            {
+#           if !defined(CDS_LINUX_NO_membarrier) && defined(SYS_membarrier)
+                long const mask = ::syscall( SYS_membarrier, cmd_query, 0 );
+                if ( mask < 0 || ( mask & cmd_private_expedited ) == 0 )
+                    return false;
+                return ::syscall( SYS_membarrier, cmd_register_private_expedited, 0 ) == 0;
+#           else
+                return false;
+#           endif
+            }
+
+            /// Heavy-weight side of asymmetric fence
+            /**
+                Issues a memory barrier on all running threads of the process.
+                The process should be registered by \p register_expedited().
+            */
+            static void heavy()
+            {
+#           if !defined(CDS_LINUX_NO_membarrier) && defined(SYS_membarrier)
+                if ( ::syscall( SYS_membarrier, cmd_private_expedited, 0 ) == 0 )
+                    return;
+#           endif
+                atomics::atomic_thread_fence( atomics::memory_order_seq_cst );
+            }
+
+            /// Light-weight side of asymmetric fence: compiler barrier only
+            static void light()
+            {
+                CDS_COMPILER_RW_BARRIER;
+            }
+        };
+    }   // namespace Linux
+
+}}  // namespace cds::OS
+
+#endif  // #ifndef CDSLIB_OS_LINUX_MEMBARRIER_H
@@ -40,6 +40,16 @@
 
 #include <sys/syscall.h>
 #include <sched.h>
+#include <unistd.h>
+
+// glibc 2.35+ registers restartable sequences (rseq) area for each thread,
+// the kernel keeps the current processor number in it
+#if !defined(CDS_LINUX_NO_rseq) && defined(__GLIBC__) && ( __GLIBC__ > 2 || ( __GLIBC__ == 2 && __GLIBC_MINOR__ >= 35 )) && defined(__has_builtin)
+#   if __has_builtin( __builtin_thread_pointer )
+#       include <sys/rseq.h>
+#       define CDS_LINUX_RSEQ_ENABLED
+#   endif
+#endif
 
 namespace cds { namespace OS {
     /// Linux-specific wrappers
@@ -54,6 +64,7 @@ namespace cds { namespace OS {
         private:
             //@cond
             static unsigned int     s_nProcessorCount;
+            static unsigned int     s_nNumaNodeCount;
             //@endcond
         public:
 
@@ -65,7 +76,11 @@ namespace cds { namespace OS {
 
             /// Get current processor number
             /**
-                Caveat: \p current_processor calls system \p sched_getcpu function
+                With glibc 2.35 or newer the function reads the processor number from the restartable sequences
+                area of the current thread, that is a plain memory load. You may disable it compiling with
+                <tt>-DCDS_LINUX_NO_rseq</tt>.
+
+                Otherwise, \p current_processor calls system \p sched_getcpu function
                 that may not be defined for target system (\p sched_getcpu is available since glibc 2.6).
                 If \p sched_getcpu is not defined the function emulates "current processor number" using
                 thread-specific data. You may manually disable the \p sched_getcpu usage compiling with
@@ -73,6 +88,15 @@ namespace cds { namespace OS {
             */
             static unsigned int current_processor()
             {
+#           ifdef CDS_LINUX_RSEQ_ENABLED
+                // __rseq_size is 0 if rseq registration is disabled, for example, by glibc.pthread.rseq tunable
+                if ( __rseq_size > 0 ) {
+                    struct rseq const volatile * pRseq = reinterpret_cast<struct rseq const volatile *>(
+                        static_cast<char *>( __builtin_thread_pointer()) + __rseq_offset );
+                    return pRseq->cpu_id;
+                }
+#           endif
+
             // Compile libcds with -DCDS_LINUX_NO_sched_getcpu if your linux does not have sched_getcpu (glibc version less than 2.6)
 #           if !defined(CDS_LINUX_NO_sched_getcpu) && defined(SYS_getcpu)
                 int nProcessor = ::sched_getcpu();
@@ -105,6 +129,31 @@ namespace cds { namespace OS {
                 return current_processor();
             }
 
+            /// NUMA node count for the system
+            /**
+                The count is read from <tt>/sys/devices/system/node/possible</tt> on library initialization.
+                If the file is not available the system is considered as one node.
+            */
+            static unsigned int numa_node_count()
+            {
+                return s_nNumaNodeCount;
+            }
+
+            /// Get NUMA node of current processor
+            /**
+                The function calls \p getcpu system call. If the call is not supported it returns 0.
+            */
+            static unsigned int current_numa_node()
+            {
+#           ifdef SYS_getcpu
+                unsigned int nProcessor;
+                unsigned int nNode;
+                if ( ::syscall( SYS_getcpu, &nProcessor, &nNode, nullptr ) == 0 )
+                    return nNode;
+#           endif
+                return 0;
+            }
+
             //@cond
             static void init();
             static void fini();
@@ -33,6 +33,9 @@
 
 #include <cds/urcu/details/gp_decl.h>
 #include <cds/urcu/details/sh_decl.h>
+#include <cds/urcu/details/qs_decl.h>
+#include <cds/urcu/details/pc_decl.h>
+#include <cds/urcu/details/mb_decl.h>
 #include <cds/algo/elimination_tls.h>
 
 namespace cds {
@@ -109,6 +112,10 @@ namespace cds {
         lock-free data structs.
         See \ref cds_how_to_use "How to use" section for details
 
+        The attached thread is attached to a particular garbage collector lazily, on its first use of the GC,
+        so a thread that works with one container does not allocate thread records in the other GCs.
+        \p detachThread() detaches the thread only from the GCs it has used.
+
         <b>Note for Windows</b>
 
         When you use Garbage Collectors (GC) provided by \p libcds in your dll that dynamically loaded by \p LoadLibrary then there is no way
@@ -134,9 +141,15 @@ namespace cds {
             cds::urcu::details::thread_data< cds::urcu::general_instant_tag > *     m_pGPIRCU;
             cds::urcu::details::thread_data< cds::urcu::general_buffered_tag > *    m_pGPBRCU;
             cds::urcu::details::thread_data< cds::urcu::general_threaded_tag > *    m_pGPTRCU;
+            cds::urcu::details::thread_data< cds::urcu::general_local_buffered_tag > *  m_pGPLBRCU;
+            cds::urcu::details::thread_data< cds::urcu::quiescent_buffered_tag > *  m_pQSBRCU;
+            cds::urcu::details::thread_data< cds::urcu::percpu_buffered_tag > *     m_pPCBRCU;
 #ifdef CDS_URCU_SIGNAL_HANDLING_ENABLED
             cds::urcu::details::thread_data< cds::urcu::signal_buffered_tag > *    m_pSHBRCU;
 #endif
+#ifdef CDS_URCU_MEMBARRIER_ENABLED
+            cds::urcu::details::thread_data< cds::urcu::membarrier_buffered_tag > *    m_pMBBRCU;
+#endif
 
             //@endcond
 
@@ -159,8 +172,14 @@ namespace cds {
                 : m_pGPIRCU( nullptr )
                 , m_pGPBRCU( nullptr )
                 , m_pGPTRCU( nullptr )
+                , m_pGPLBRCU( nullptr )
+                , m_pQSBRCU( nullptr )
+                , m_pPCBRCU( nullptr )
 #ifdef CDS_URCU_SIGNAL_HANDLING_ENABLED
                 , m_pSHBRCU( nullptr )
+#endif
+#ifdef CDS_URCU_MEMBARRIER_ENABLED
+                , m_pMBBRCU( nullptr )
 #endif
                 , m_nFakeProcessorNumber( s_nLastUsedProcNo.fetch_add(1, atomics::memory_order_relaxed) % s_nProcCount )
                 , m_nAttachCount(0)
@@ -171,14 +190,45 @@ namespace cds {
                 assert( m_pGPIRCU == nullptr );
                 assert( m_pGPBRCU == nullptr );
                 assert( m_pGPTRCU == nullptr );
+                assert( m_pGPLBRCU == nullptr );
+                assert( m_pQSBRCU == nullptr );
+                assert( m_pPCBRCU == nullptr );
 #ifdef CDS_URCU_SIGNAL_HANDLING_ENABLED
                 assert( m_pSHBRCU == nullptr );
+#endif
+#ifdef CDS_URCU_MEMBARRIER_ENABLED
+                assert( m_pMBBRCU == nullptr );
 #endif
             }
 
             CDS_EXPORT_API void init();
             CDS_EXPORT_API bool fini();
 
+            // true if the thread is attached by Manager::attachThread() and not detached yet
+            bool is_attached() const
+            {
+                return m_nAttachCount > 0;
+            }
+
+            // The thread is attached to an RCU singleton on its first use of the RCU
+            template <typename RCUtag>
+            cds::urcu::details::thread_data<RCUtag> * attach_rcu( cds::urcu::details::thread_data<RCUtag> *& pRec )
+            {
+                if ( cds_unlikely( pRec == nullptr ) && is_attached() && cds::urcu::details::singleton<RCUtag>::isUsed())
+                    pRec = cds::urcu::details::singleton<RCUtag>::attach_thread();
+                return pRec;
+            }
+
+            template <typename RCUtag>
+            static void detach_rcu( cds::urcu::details::thread_data<RCUtag> *& pRec )
+            {
+                if ( pRec ) {
+                    if ( cds::urcu::details::singleton<RCUtag>::isUsed())
+                        cds::urcu::details::singleton<RCUtag>::detach_thread( pRec );
+                    pRec = nullptr;
+                }
+            }
+
             size_t fake_current_processor()
             {
                 return m_nFakeProcessorNumber;
@@ -43,6 +43,8 @@ namespace cds { namespace threading {
     /// Returns RCU thread specific data (thread GC) for current thread
     /**
         Template argument \p RCUtag is one of \ref cds_urcu_tags "RCU tags"
+
+        The thread is attached to the RCU singleton on the first call.
     */
     template <typename RCUtag> cds::urcu::details::thread_data<RCUtag> * getRCU();
 
@@ -50,24 +52,53 @@ namespace cds { namespace threading {
     template<>
     inline cds::urcu::details::thread_data<cds::urcu::general_instant_tag> * getRCU<cds::urcu::general_instant_tag>()
     {
-        return Manager::thread_data()->m_pGPIRCU;
+        ThreadData * p = Manager::thread_data();
+        return p->attach_rcu( p->m_pGPIRCU );
     }
     template<>
     inline cds::urcu::details::thread_data<cds::urcu::general_buffered_tag> * getRCU<cds::urcu::general_buffered_tag>()
     {
-        return Manager::thread_data()->m_pGPBRCU;
+        ThreadData * p = Manager::thread_data();
+        return p->attach_rcu( p->m_pGPBRCU );
     }
     template<>
     inline cds::urcu::details::thread_data<cds::urcu::general_threaded_tag> * getRCU<cds::urcu::general_threaded_tag>()
     {
-        return Manager::thread_data()->m_pGPTRCU;
+        ThreadData * p = Manager::thread_data();
+        return p->attach_rcu( p->m_pGPTRCU );
+    }
+    template<>
+    inline cds::urcu::details::thread_data<cds::urcu::general_local_buffered_tag> * getRCU<cds::urcu::general_local_buffered_tag>()
+    {
+        ThreadData * p = Manager::thread_data();
+        return p->attach_rcu( p->m_pGPLBRCU );
+    }
+    template<>
+    inline cds::urcu::details::thread_data<cds::urcu::quiescent_buffered_tag> * getRCU<cds::urcu::quiescent_buffered_tag>()
+    {
+        ThreadData * p = Manager::thread_data();
+        return p ? p->attach_rcu( p->m_pQSBRCU ) : nullptr;
+    }
+    template<>
+    inline cds::urcu::details::thread_data<cds::urcu::percpu_buffered_tag> * getRCU<cds::urcu::percpu_buffered_tag>()
+    {
+        ThreadData * p = Manager::thread_data();
+        return p->attach_rcu( p->m_pPCBRCU );
     }
 #ifdef CDS_URCU_SIGNAL_HANDLING_ENABLED
     template<>
     inline cds::urcu::details::thread_data<cds::urcu::signal_buffered_tag> * getRCU<cds::urcu::signal_buffered_tag>()
     {
         ThreadData * p = Manager::thread_data();
-        return p ? p->m_pSHBRCU : nullptr;
+        return p ? p->attach_rcu( p->m_pSHBRCU ) : nullptr;
+    }
+#endif
+#ifdef CDS_URCU_MEMBARRIER_ENABLED
+    template<>
+    inline cds::urcu::details::thread_data<cds::urcu::membarrier_buffered_tag> * getRCU<cds::urcu::membarrier_buffered_tag>()
+    {
+        ThreadData * p = Manager::thread_data();
+        return p ? p->attach_rcu( p->m_pMBBRCU ) : nullptr;
     }
 #endif
 
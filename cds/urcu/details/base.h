@@ -31,7 +31,11 @@
 #ifndef CDSLIB_URCU_DETAILS_BASE_H
 #define CDSLIB_URCU_DETAILS_BASE_H
 
+#include <chrono>
+#include <functional>
+#include <future>
 #include <cds/algo/atomic.h>
+#include <cds/algo/bitop.h>
 #include <cds/gc/details/retired_ptr.h>
 #include <cds/details/allocator.h>
 #include <cds/os/thread.h>
@@ -104,15 +108,20 @@ namespace cds {
         - The Quiescent-State-Based Reclamation (QSBR) %RCU implementation offers
           the best possible read-side performance, but requires that each thread periodically
           calls a function to announce that it is in a quiescent state, thus strongly
-          constraining the application design. This type of %RCU is not implemented in \p libcds.
+          constraining the application design. \p libcds implements this type of %RCU as \ref quiescent_buffered.
         - The general-purpose %RCU implementation places almost no constraints on the application's
           design, thus being appropriate for use within a general-purpose library, but it has
           relatively higher read-side overhead. The \p libcds contains several implementations of general-purpose
-          %RCU: \ref general_instant, \ref general_buffered, \ref general_threaded.
+          %RCU: \ref general_instant, \ref general_buffered, \ref general_threaded, \ref general_local_buffered.
         - \p signal_buffered: the signal-handling %RCU presents an implementation having low read-side overhead and
           requiring only that the application give up one POSIX signal to %RCU update processing.
+        - \p membarrier_buffered: the same low read-side overhead as the signal-handling %RCU, but the updater
+          forces memory barriers in reader threads by Linux \p membarrier() system call instead of POSIX signal.
+        - \p percpu_buffered: SRCU-like %RCU, the readers count their critical sections in per-processor counters,
+          so the cost of the grace period depends on the processor count instead of the thread count.
 
         @note The signal-handled %RCU is defined only for UNIX-like systems, not for Windows.
+        The membarrier-based %RCU is defined only for Linux.
 
         @anchor cds_urcu_type
         <b>RCU implementation type</b>
@@ -121,7 +130,11 @@ namespace cds {
         - \ref general_instant - general purpose RCU with immediate reclamation
         - \ref general_buffered - general purpose RCU with deferred (buffered) reclamation
         - \ref general_threaded - general purpose RCU with special reclamation thread
+        - \ref general_local_buffered - general purpose RCU with deferred reclamation from per-thread buffers
         - \ref signal_buffered - signal-handling RCU with deferred (buffered) reclamation
+        - \ref quiescent_buffered - quiescent-state based RCU with deferred (buffered) reclamation
+        - \ref membarrier_buffered - membarrier-based RCU with deferred (buffered) reclamation
+        - \ref percpu_buffered - RCU with per-processor reader counters and deferred (buffered) reclamation
 
         You cannot create an object of any of those classes directly.
         Instead, you should use wrapper classes.
@@ -137,8 +150,16 @@ namespace cds {
             include file <tt><cds/urcu/general_buffered.h></tt>
         - \ref cds_urcu_general_threaded_gc "gc<general_threaded>" - general purpose RCU with special reclamation thread
             include file <tt><cds/urcu/general_threaded.h></tt>
+        - \ref cds_urcu_general_local_buffered_gc "gc<general_local_buffered>" - general purpose RCU with deferred reclamation
+            from per-thread buffers, include file <tt><cds/urcu/general_local_buffered.h></tt>
         - \ref cds_urcu_signal_buffered_gc "gc<signal_buffered>" - signal-handling RCU with deferred (buffered) reclamation
             include file <tt><cds/urcu/signal_buffered.h></tt>
+        - \ref cds_urcu_quiescent_buffered_gc "gc<quiescent_buffered>" - quiescent-state based RCU with deferred (buffered) reclamation
+            include file <tt><cds/urcu/quiescent_buffered.h></tt>
+        - \ref cds_urcu_membarrier_buffered_gc "gc<membarrier_buffered>" - membarrier-based RCU with deferred (buffered) reclamation
+            include file <tt><cds/urcu/membarrier_buffered.h></tt>
+        - \ref cds_urcu_percpu_buffered_gc "gc<percpu_buffered>" - RCU with per-processor reader counters and deferred (buffered) reclamation
+            include file <tt><cds/urcu/percpu_buffered.h></tt>
 
         Any RCU-related container in \p libcds expects that its \p RCU template parameter is one of those wrapper.
 
@@ -148,7 +169,11 @@ namespace cds {
         - \ref general_instant_tag - for \ref general_instant
         - \ref general_buffered_tag - for \ref general_buffered
         - \ref general_threaded_tag - for \ref general_threaded
+        - \ref general_local_buffered_tag - for \ref general_local_buffered
         - \ref signal_buffered_tag - for \ref signal_buffered
+        - \ref quiescent_buffered_tag - for \ref quiescent_buffered
+        - \ref membarrier_buffered_tag - for \ref membarrier_buffered
+        - \ref percpu_buffered_tag - for \ref percpu_buffered
 
         @anchor cds_urcu_performance
         <b>Performance</b>
@@ -203,6 +228,36 @@ namespace cds {
         }
         \endcode
 
+        @anchor cds_urcu_call_rcu
+        <b>Deferred callbacks</b>
+
+        \p synchronize() blocks the caller until the end of a grace period.
+        Any \ref cds_urcu_gc "RCU wrapper" has also non-blocking \p call_rcu( f ) function
+        that places the callback \p f into the queue of the RCU singleton and returns immediately.
+        A dedicated thread takes all queued callbacks at once, waits for the end of one grace period
+        and then invokes the callbacks, so the callbacks of many threads share a single grace period.
+        The thread is created on the first \p call_rcu() call; it is attached to libcds infrastructure
+        and is terminated by RCU singleton destruction after invoking all pending callbacks.
+        \p call_rcu_future( f ) returns \p std::future<void> that becomes ready when \p f has been invoked:
+        \code
+        typedef cds::urcu::gc< cds::urcu::general_buffered<> >    rcu_gpb;
+
+        // Unlink the subtree under the tree lock, then free it after a grace period
+        node * pSubtree = unlink_subtree();
+        rcu_gpb::call_rcu( [pSubtree]() { free_subtree( pSubtree ); } );
+        \endcode
+
+        @anchor cds_urcu_expedited
+        <b>Expedited grace periods</b>
+
+        \p synchronize_expedited() is \p synchronize() for rare paths where reclamation latency matters more
+        than writer CPU, for example shrinking a huge container under memory pressure.
+        General-purpose RCU flavors issue a process-wide memory barrier (\p membarrier(2) on Linux)
+        so that the readers that have left their critical sections are seen at once, and poll the remaining
+        readers on every pause instead of exponential back-off, yielding only to let preempted readers run.
+        The other flavors pass an ordinary grace period. The cost of expedited grace periods is reported
+        in \p stat if the RCU flavor is instantiated with it.
+
         Each thread that deals with RCU-based container should be initialized first:
         \code
         #include <cds/urcu/general_buffered.h>
@@ -223,6 +278,10 @@ namespace cds {
 
 #   if (CDS_OS_INTERFACE == CDS_OSI_UNIX || defined(CDS_DOXYGEN_INVOKED)) && !defined(CDS_THREAD_SANITIZER_ENABLED)
 #       define CDS_URCU_SIGNAL_HANDLING_ENABLED 1
+#   endif
+
+#   if (CDS_OS_TYPE == CDS_OS_LINUX || defined(CDS_DOXYGEN_INVOKED)) && !defined(CDS_THREAD_SANITIZER_ENABLED)
+#       define CDS_URCU_MEMBARRIER_ENABLED 1
 #   endif
 
         /// General-purpose URCU type
@@ -243,6 +302,26 @@ namespace cds {
         };
 #   endif
 
+#   ifdef CDS_URCU_MEMBARRIER_ENABLED
+        /// Membarrier-based URCU type
+        struct membarrier_rcu {
+            //@cond
+            static uint32_t const c_nControlBit = 0x80000000;
+            static uint32_t const c_nNestMask   = c_nControlBit - 1;
+            //@endcond
+        };
+#   endif
+
+        /// Quiescent-state based URCU type
+        struct quiescent_state_rcu {
+            //@cond
+            static uint64_t const c_nOffline = 0;   // thread counter of the thread in extended quiescent state
+            //@endcond
+        };
+
+        /// URCU type with per-processor reader counters
+        struct percpu_rcu {};
+
         /// Tag for general_instant URCU
         struct general_instant_tag: public general_purpose_rcu {
             typedef general_purpose_rcu     rcu_class ; ///< The URCU type
@@ -259,6 +338,11 @@ namespace cds {
             typedef general_purpose_rcu     rcu_class ; ///< The URCU type
         };
 
+        /// Tag for general_local_buffered URCU
+        struct general_local_buffered_tag: public general_purpose_rcu {
+            typedef general_purpose_rcu     rcu_class ; ///< The URCU type
+        };
+
 #   ifdef CDS_URCU_SIGNAL_HANDLING_ENABLED
         /// Tag for signal_buffered URCU
         struct signal_buffered_tag: public signal_handling_rcu {
@@ -266,6 +350,155 @@ namespace cds {
         };
 #   endif
 
+#   ifdef CDS_URCU_MEMBARRIER_ENABLED
+        /// Tag for membarrier_buffered URCU
+        struct membarrier_buffered_tag: public membarrier_rcu {
+            typedef membarrier_rcu     rcu_class ; ///< The URCU type
+        };
+#   endif
+
+        /// Tag for quiescent_buffered URCU
+        struct quiescent_buffered_tag: public quiescent_state_rcu {
+            typedef quiescent_state_rcu     rcu_class ; ///< The URCU type
+        };
+
+        /// Tag for percpu_buffered URCU
+        struct percpu_buffered_tag: public percpu_rcu {
+            typedef percpu_rcu     rcu_class ; ///< The URCU type
+        };
+
+        /// Grace period statistics of general-purpose RCU
+        /**
+            The statistics is always collected, use \p gc::statistics() to get it.
+            It consists of the counters that grace period sharing maintains anyway;
+            the latency of grace periods is collected by \p stat policy.
+        */
+        struct gp_stat {
+            uint64_t    gp_count;           ///< Count of grace periods passed
+            uint64_t    gp_shared_count;    ///< Count of \p synchronize() calls that used the grace period passed by another thread
+
+            /// Default ctor
+            gp_stat()
+            {
+                clear();
+            }
+
+            /// Clears all counters
+            void clear()
+            {
+                gp_count =
+                    gp_shared_count = 0;
+            }
+        };
+
+        /// Internal statistics of general-purpose RCU
+        /**
+            Unlike \p gp_stat, this statistics is an opt-in policy: it is collected only if
+            the RCU flavor is instantiated with \p %stat as \p Stat template argument.
+            If \p CDS_ENABLE_URCU_STAT macro is defined, \p %stat<> is the default \p Stat argument
+            instead of \p empty_stat. Use \p gc::internal_statistics() to get the statistics.
+
+            The grace period latency histogram is log2-scaled: the bucket \p i counts the grace periods
+            shorter than <tt>bucket_upper_ns( i ) = 2^(i+10)</tt> nanoseconds, that is, about <tt>2^i</tt> microseconds,
+            that are not counted in the bucket <tt>i - 1</tt>. The last bucket has no upper bound.
+        */
+        template <typename Counter = cds::atomicity::event_counter >
+        struct stat
+        {
+            typedef Counter counter_type;   ///< Event counter type
+
+            static size_t const c_nLatencyBucketCount = 24; ///< Size of grace period latency histogram
+
+            counter_type    m_nGracePeriod;         ///< Count of grace periods passed
+            counter_type    m_nExpeditedGracePeriod;///< Count of expedited grace periods
+            counter_type    m_arrLatency[c_nLatencyBucketCount];   ///< Grace period latency histogram
+            atomics::atomic<uint64_t> m_nGPTotalNs;         ///< Total duration of grace periods, in nanoseconds
+            atomics::atomic<uint64_t> m_nGPMaxNs;           ///< Max duration of a grace period, in nanoseconds
+            atomics::atomic<uint64_t> m_nExpeditedTotalNs;  ///< Total duration of expedited grace periods, in nanoseconds
+            atomics::atomic<uint64_t> m_nExpeditedMaxNs;    ///< Max duration of an expedited grace period, in nanoseconds
+            counter_type    m_nForcedSynchronize;   ///< Count of grace periods forced by a full retired buffer
+            counter_type    m_nReaderWait;          ///< Count of readers that a grace period had to wait for
+            counter_type    m_nReaderWaitSpin;      ///< Count of back-off calls while waiting for readers
+            atomics::atomic<size_t> m_nBufferHighWater; ///< Max observed size of retired buffer (of a thread buffer for \p general_local_buffered)
+
+            //@cond
+            stat()
+                : m_nGPTotalNs( 0 )
+                , m_nGPMaxNs( 0 )
+                , m_nExpeditedTotalNs( 0 )
+                , m_nExpeditedMaxNs( 0 )
+                , m_nBufferHighWater( 0 )
+            {}
+            //@endcond
+
+            /// Returns the upper bound of the latency bucket \p i in nanoseconds
+            static uint64_t bucket_upper_ns( size_t i )
+            {
+                return uint64_t( 1 ) << ( i + 10 );
+            }
+
+            //@cond
+            static uint64_t timestamp()
+            {
+                return static_cast<uint64_t>( std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now().time_since_epoch()).count());
+            }
+
+            void onGracePeriod( uint64_t nDurationNs, bool bExpedited )
+            {
+                ++m_nGracePeriod;
+                m_nGPTotalNs.fetch_add( nDurationNs, atomics::memory_order_relaxed );
+                update_max( m_nGPMaxNs, nDurationNs );
+                if ( bExpedited ) {
+                    ++m_nExpeditedGracePeriod;
+                    m_nExpeditedTotalNs.fetch_add( nDurationNs, atomics::memory_order_relaxed );
+                    update_max( m_nExpeditedMaxNs, nDurationNs );
+                }
+
+                size_t nBucket = static_cast<size_t>( cds::bitop::MSB( nDurationNs >> 10 ));
+                if ( nBucket >= c_nLatencyBucketCount )
+                    nBucket = c_nLatencyBucketCount - 1;
+                ++m_arrLatency[nBucket];
+            }
+            void onForcedSynchronize()  { ++m_nForcedSynchronize; }
+            void onReaderWait()         { ++m_nReaderWait; }
+            void onReaderWaitSpin()     { ++m_nReaderWaitSpin; }
+            void onBufferSize( size_t nSize )
+            {
+                if ( nSize > m_nBufferHighWater.load( atomics::memory_order_relaxed ))
+                    m_nBufferHighWater.store( nSize, atomics::memory_order_relaxed );
+            }
+
+        private:
+            // Grace periods are serialized, so the plain store cannot lose a greater value
+            static void update_max( atomics::atomic<uint64_t>& nMax, uint64_t nValue )
+            {
+                if ( nValue > nMax.load( atomics::memory_order_relaxed ))
+                    nMax.store( nValue, atomics::memory_order_relaxed );
+            }
+            //@endcond
+        };
+
+        /// Dummy internal statistics of general-purpose RCU, the default \p Stat argument
+        struct empty_stat
+        {
+            //@cond
+            static constexpr uint64_t timestamp() { return 0; }
+            void onGracePeriod( uint64_t, bool ) const {}
+            void onForcedSynchronize()  const {}
+            void onReaderWait()         const {}
+            void onReaderWaitSpin()     const {}
+            void onBufferSize( size_t ) const {}
+            //@endcond
+        };
+
+        //@cond
+#ifdef CDS_ENABLE_URCU_STAT
+        typedef stat<> default_stat;
+#else
+        typedef empty_stat default_stat;
+#endif
+        //@endcond
+
         ///@anchor cds_urcu_retired_ptr Retired pointer, i.e. pointer that ready for reclamation
         typedef cds::gc::details::retired_ptr   retired_ptr;
         using cds::gc::make_retired_ptr;
@@ -286,13 +519,42 @@ namespace cds {
             template <typename RCUtag >
             class singleton;
 
+            class call_rcu_thread;
+
             //@cond
             class singleton_vtbl {
             protected:
+                atomics::atomic<call_rcu_thread *> m_pCallRCU;  // deferred callback thread, created on first call_rcu()
+
+                singleton_vtbl()
+                    : m_pCallRCU( nullptr )
+                {}
+
                 virtual ~singleton_vtbl()
                 {}
+
+                // Invokes pending callbacks and terminates the deferred callback thread, defined in call_rcu.h
+                void stop_call_rcu();
+
             public:
                 virtual void retire_ptr( retired_ptr& p ) = 0;
+                virtual void synchronize() = 0;
+
+                // Grace period that trades writer CPU for latency; the flavors without expedited mode pass an ordinary one
+                virtual void synchronize_expedited()
+                {
+                    synchronize();
+                }
+
+                // Extended quiescent state of the current thread; only quiescent-state based RCU tracks it
+                virtual void thread_offline()
+                {}
+                virtual void thread_online()
+                {}
+
+                // Deferred callbacks, defined in call_rcu.h
+                void call_rcu( std::function< void() >&& f );
+                std::future<void> call_rcu_future( std::function< void() >&& f );
             };
 
             class gc_common
@@ -0,0 +1,176 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSLIB_URCU_DETAILS_CALL_RCU_H
+#define CDSLIB_URCU_DETAILS_CALL_RCU_H
+
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cds/urcu/details/base.h>
+#include <cds/threading/model.h>
+
+//@cond
+namespace cds { namespace urcu { namespace details {
+
+    /// Deferred callback thread of RCU singleton
+    /**
+        The callbacks passed to \p push() are accumulated in the queue.
+        The thread takes all accumulated callbacks at once, waits for the end of one grace period
+        by \p synchronize() call and then invokes the callbacks in the order of \p push() calls.
+        Thus, the callbacks of many threads are batched behind a single grace period.
+
+        The thread is attached to libcds infrastructure, so a callback may use libcds containers
+        and retire pointers to the RCU.
+    */
+    class call_rcu_thread
+    {
+    public:
+        typedef std::function< void() > callback_type;  ///< Callback type
+
+    private:
+        typedef std::mutex              mutex_type;
+        typedef std::condition_variable condvar_type;
+        typedef std::unique_lock< mutex_type >  unique_lock;
+
+    public:
+        explicit call_rcu_thread( singleton_vtbl& rcu )
+            : rcu_( rcu )
+            , quit_( false )
+        {
+            thread_ = std::thread( &call_rcu_thread::execute, this );
+        }
+
+        ~call_rcu_thread()
+        {
+            assert( !thread_.joinable());
+        }
+
+        /// Places callback \p f to the queue
+        void push( callback_type&& f )
+        {
+            {
+                unique_lock lock( mutex_ );
+                pending_.push_back( std::move( f ));
+            }
+            cv_.notify_one();
+        }
+
+        /// Invokes all pending callbacks and terminates the thread
+        void stop()
+        {
+            {
+                unique_lock lock( mutex_ );
+                quit_ = true;
+            }
+            cv_.notify_one();
+            thread_.join();
+        }
+
+    private:
+        void execute()
+        {
+            cds::threading::Manager::attachThread();
+
+            std::vector< callback_type > batch;
+            for (;;) {
+                {
+                    unique_lock lock( mutex_ );
+                    if ( pending_.empty() && !quit_ ) {
+                        // The waiting thread must not delay the grace periods of other threads
+                        rcu_.thread_offline();
+                        while ( pending_.empty() && !quit_ )
+                            cv_.wait( lock );
+                        rcu_.thread_online();
+                    }
+
+                    // The callbacks may call call_rcu() while they are invoked,
+                    // so the thread exits only when the queue is empty
+                    if ( pending_.empty())
+                        break;
+                    batch.swap( pending_ );
+                }
+
+                rcu_.synchronize();
+
+                for ( callback_type& f : batch )
+                    f();
+                batch.clear();
+            }
+
+            cds::threading::Manager::detachThread();
+        }
+
+    private:
+        singleton_vtbl& rcu_;
+        std::thread     thread_;
+
+        mutex_type      mutex_;
+        condvar_type    cv_;
+        std::vector< callback_type > pending_;
+        bool            quit_;
+    };
+
+    inline void singleton_vtbl::call_rcu( std::function< void() >&& f )
+    {
+        call_rcu_thread * pThread = m_pCallRCU.load( atomics::memory_order_acquire );
+        if ( !pThread ) {
+            std::unique_ptr< call_rcu_thread > pNew( new call_rcu_thread( *this ));
+            if ( m_pCallRCU.compare_exchange_strong( pThread, pNew.get(), atomics::memory_order_acq_rel, atomics::memory_order_acquire ))
+                pThread = pNew.release();
+            else
+                pNew->stop();
+        }
+        pThread->push( std::move( f ));
+    }
+
+    inline std::future<void> singleton_vtbl::call_rcu_future( std::function< void() >&& f )
+    {
+        std::shared_ptr< std::packaged_task< void() >> task = std::make_shared< std::packaged_task< void() >>( std::move( f ));
+        std::future<void> result = task->get_future();
+        call_rcu( [task]() { (*task)(); } );
+        return result;
+    }
+
+    inline void singleton_vtbl::stop_call_rcu()
+    {
+        call_rcu_thread * pThread = m_pCallRCU.exchange( nullptr, atomics::memory_order_acq_rel );
+        if ( pThread ) {
+            pThread->stop();
+            delete pThread;
+        }
+    }
+
+}}} // namespace cds::urcu::details
+//@endcond
+
+#endif // #ifndef CDSLIB_URCU_DETAILS_CALL_RCU_H
@@ -33,6 +33,7 @@
 
 #include <cds/urcu/details/gp_decl.h>
 #include <cds/threading/model.h>
+#include <cds/urcu/details/call_rcu.h>
 
 //@cond
 namespace cds { namespace urcu { namespace details {
@@ -115,21 +116,90 @@ namespace cds { namespace urcu { namespace details {
     }
 
     template <typename RCUtag>
-    template <class Backoff>
-    inline void gp_singleton<RCUtag>::flip_and_wait( Backoff& bkoff )
+    template <class Backoff, class Stat>
+    inline void gp_singleton<RCUtag>::flip_and_wait( Backoff& bkoff, Stat& st )
     {
         OS::ThreadId const nullThreadId = OS::c_NullThreadId;
         m_nGlobalControl.fetch_xor( general_purpose_rcu::c_nControlBit, atomics::memory_order_seq_cst );
 
         for ( thread_record * pRec = m_ThreadList.head( atomics::memory_order_acquire ); pRec; pRec = pRec->m_list.m_pNext ) {
-            while ( pRec->m_list.m_idOwner.load( atomics::memory_order_acquire ) != nullThreadId && check_grace_period( pRec )) {
-                bkoff();
-                CDS_COMPILER_RW_BARRIER;
+            if ( pRec->m_list.m_idOwner.load( atomics::memory_order_acquire ) != nullThreadId && check_grace_period( pRec )) {
+                st.onReaderWait();
+                do {
+                    bkoff();
+                    st.onReaderWaitSpin();
+                    CDS_COMPILER_RW_BARRIER;
+                } while ( pRec->m_list.m_idOwner.load( atomics::memory_order_acquire ) != nullThreadId && check_grace_period( pRec ));
             }
             bkoff.reset();
         }
     }
 
+    template <typename RCUtag>
+    inline uint64_t gp_singleton<RCUtag>::gp_snapshot() const
+    {
+        // The removal preceding synchronize() must be ordered before the snapshot
+        atomics::atomic_thread_fence( atomics::memory_order_seq_cst );
+
+        // The sequence number at the end of the first grace period started after the call
+        return ( m_nGPSeq.load( atomics::memory_order_acquire ) + 3 ) & ~uint64_t( 1 );
+    }
+
+    template <typename RCUtag>
+    inline bool gp_singleton<RCUtag>::gp_passed( uint64_t nSnap )
+    {
+        if ( m_nGPSeq.load( atomics::memory_order_acquire ) >= nSnap ) {
+            m_nGPSharedCount.fetch_add( 1, atomics::memory_order_relaxed );
+            return true;
+        }
+        return false;
+    }
+
+    template <typename RCUtag>
+    template <class Backoff, class Stat>
+    inline void gp_singleton<RCUtag>::grace_period( Backoff& bkoff, Stat& st )
+    {
+        // The caller holds the lock that serializes grace periods
+        uint64_t const tStart = st.timestamp();
+
+        m_nGPSeq.fetch_add( 1, atomics::memory_order_seq_cst );
+        flip_and_wait( bkoff, st );
+        flip_and_wait( bkoff, st );
+        m_nGPSeq.fetch_add( 1, atomics::memory_order_release );
+
+        st.onGracePeriod( st.timestamp() - tStart, false );
+    }
+
+    template <typename RCUtag>
+    template <class Stat>
+    inline void gp_singleton<RCUtag>::grace_period_expedited( Stat& st )
+    {
+        uint64_t const tStart = st.timestamp();
+
+        if ( m_MembarrierState == membarrier_unknown )
+            m_MembarrierState = cds::OS::membarrier::register_expedited() ? membarrier_registered : membarrier_unsupported;
+
+        m_nGPSeq.fetch_add( 1, atomics::memory_order_seq_cst );
+
+        // The readers that have just left the critical section publish their control word at once
+        if ( m_MembarrierState == membarrier_registered )
+            cds::OS::membarrier::heavy();
+
+        expedited_backoff bkoff;
+        flip_and_wait( bkoff, st );
+        flip_and_wait( bkoff, st );
+        m_nGPSeq.fetch_add( 1, atomics::memory_order_release );
+
+        st.onGracePeriod( st.timestamp() - tStart, true );
+    }
+
+    template <typename RCUtag>
+    inline void gp_singleton<RCUtag>::statistics( gp_stat& st ) const
+    {
+        st.gp_count        = m_nGPSeq.load( atomics::memory_order_acquire ) / 2;
+        st.gp_shared_count = m_nGPSharedCount.load( atomics::memory_order_relaxed );
+    }
+
 
 }}} // namespace cds:urcu::details
 //@endcond
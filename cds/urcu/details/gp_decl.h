@@ -31,10 +31,13 @@
 #ifndef CDSLIB_URCU_DETAILS_GP_DECL_H
 #define CDSLIB_URCU_DETAILS_GP_DECL_H
 
+#include <vector>
 #include <cds/urcu/details/base.h>
 #include <cds/details/static_functor.h>
 #include <cds/details/lib.h>
 #include <cds/user_setup/cache_line.h>
+#include <cds/algo/backoff_strategy.h>
+#include <cds/os/membarrier.h>
 
 //@cond
 namespace cds { namespace urcu { namespace details {
@@ -58,6 +61,20 @@ namespace cds { namespace urcu { namespace details {
 
 #   undef CDS_GPURCU_DECLARE_THREAD_DATA
 
+    // general_local_buffered keeps retired pointers in the thread record
+    template <> struct thread_data<general_local_buffered_tag> {
+        typedef std::vector< epoch_retired_ptr > retired_buffer;
+
+        atomics::atomic<uint32_t>        m_nAccessControl ;
+        thread_list_record< thread_data >   m_list ;
+        char pad_[cds::c_nCacheLineSize];
+        retired_buffer                  m_Retired ; // retired pointers in epoch order, private to the owner of the record
+
+        thread_data(): m_nAccessControl(0) {}
+        explicit thread_data( OS::ThreadId owner ): m_nAccessControl(0), m_list(owner) {}
+        ~thread_data() {}
+    };
+
     template <typename RCUtag>
     struct gp_singleton_instance
     {
@@ -67,6 +84,7 @@ namespace cds { namespace urcu { namespace details {
     template<> CDS_EXPORT_API singleton_vtbl * gp_singleton_instance< general_instant_tag >::s_pRCU;
     template<> CDS_EXPORT_API singleton_vtbl * gp_singleton_instance< general_buffered_tag >::s_pRCU;
     template<> CDS_EXPORT_API singleton_vtbl * gp_singleton_instance< general_threaded_tag >::s_pRCU;
+    template<> CDS_EXPORT_API singleton_vtbl * gp_singleton_instance< general_local_buffered_tag >::s_pRCU;
 #endif
 
     template <typename GPRCUtag>
@@ -117,6 +135,7 @@ namespace cds { namespace urcu { namespace details {
     CDS_GP_RCU_DECLARE_THREAD_GC( general_instant_tag  );
     CDS_GP_RCU_DECLARE_THREAD_GC( general_buffered_tag );
     CDS_GP_RCU_DECLARE_THREAD_GC( general_threaded_tag );
+    CDS_GP_RCU_DECLARE_THREAD_GC( general_local_buffered_tag );
 
 #   undef CDS_GP_RCU_DECLARE_THREAD_GC
 
@@ -135,9 +154,36 @@ namespace cds { namespace urcu { namespace details {
         atomics::atomic<uint32_t>    m_nGlobalControl;
         thread_list< rcu_tag >          m_ThreadList;
 
+        // Grace period sequence number: twice the count of passed grace periods, odd if a grace period is in progress
+        atomics::atomic<uint64_t>   m_nGPSeq;
+        atomics::atomic<uint64_t>   m_nGPSharedCount;
+
+        // membarrier(2) registration for expedited grace periods, protected by the lock that serializes grace periods
+        enum membarrier_state {
+            membarrier_unknown,
+            membarrier_registered,
+            membarrier_unsupported
+        };
+        membarrier_state            m_MembarrierState;
+
+        // Expedited grace period polls a reader on every pause and yields soon to let a preempted reader run
+        struct expedited_backoff_traits {
+            typedef cds::backoff::pause fast_path_backoff;
+            typedef cds::backoff::yield slow_path_backoff;
+
+            enum: size_t {
+                lower_bound = 1,
+                upper_bound = 64
+            };
+        };
+        typedef cds::backoff::exponential< expedited_backoff_traits > expedited_backoff;
+
     protected:
         gp_singleton()
             : m_nGlobalControl(1)
+            , m_nGPSeq( 0 )
+            , m_nGPSharedCount( 0 )
+            , m_MembarrierState( membarrier_unknown )
         {}
 
         ~gp_singleton()
@@ -173,11 +219,29 @@ namespace cds { namespace urcu { namespace details {
             return m_nGlobalControl.load( mo );
         }
 
+        void statistics( gp_stat& st ) const;
+
     protected:
         bool check_grace_period( thread_record * pRec ) const;
 
-        template <class Backoff>
-        void flip_and_wait( Backoff& bkoff );
+        template <class Backoff, class Stat>
+        void flip_and_wait( Backoff& bkoff, Stat& st );
+
+        // Grace period sharing:
+        //  uint64_t nSnap = gp_snapshot();
+        //  lock
+        //  if ( !gp_passed( nSnap ))
+        //      grace_period( bkoff );
+        //  unlock
+        uint64_t gp_snapshot() const;
+        bool gp_passed( uint64_t nSnap );
+
+        template <class Backoff, class Stat>
+        void grace_period( Backoff& bkoff, Stat& st );
+
+        // The caller holds the lock that serializes grace periods
+        template <class Stat>
+        void grace_period_expedited( Stat& st );
     };
 
 #   define CDS_GP_RCU_DECLARE_SINGLETON( tag_ ) \
@@ -200,6 +264,7 @@ namespace cds { namespace urcu { namespace details {
     CDS_GP_RCU_DECLARE_SINGLETON( general_instant_tag  );
     CDS_GP_RCU_DECLARE_SINGLETON( general_buffered_tag );
     CDS_GP_RCU_DECLARE_SINGLETON( general_threaded_tag );
+    CDS_GP_RCU_DECLARE_SINGLETON( general_local_buffered_tag );
 
 #   undef CDS_GP_RCU_DECLARE_SINGLETON
 
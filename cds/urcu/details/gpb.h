@@ -66,11 +66,14 @@ namespace cds { namespace urcu {
         - \p Buffer - buffer type. Default is \p cds::container::VyukovMPMCCycleQueue
         - \p Lock - mutex type, default is \p std::mutex
         - \p Backoff - back-off schema, default is cds::backoff::Default
+        - \p Stat - internal statistics, \p cds::urcu::stat or \p cds::urcu::empty_stat.
+            The default is \p %empty_stat, or \p %stat<> if \p CDS_ENABLE_URCU_STAT macro is defined.
     */
     template <
         class Buffer = cds::container::VyukovMPMCCycleQueue< epoch_retired_ptr >
         ,class Lock = std::mutex
         ,class Backoff = cds::backoff::Default
+        ,class Stat = default_stat
     >
     class general_buffered: public details::gp_singleton< general_buffered_tag >
     {
@@ -82,6 +85,7 @@ namespace cds { namespace urcu {
         typedef Buffer  buffer_type ;   ///< Buffer type
         typedef Lock    lock_type   ;   ///< Lock type
         typedef Backoff back_off    ;   ///< Back-off type
+        typedef Stat    stat        ;   ///< Internal statistics type
 
         typedef base_class::thread_gc thread_gc ;   ///< Thread-side RCU part
         typedef typename thread_gc::scoped_lock scoped_lock ; ///< Access lock class
@@ -101,6 +105,8 @@ namespace cds { namespace urcu {
         atomics::atomic<uint64_t>  m_nCurEpoch;
         lock_type                  m_Lock;
         size_t const               m_nCapacity;
+        uint64_t                   m_nSafeEpoch;    // the objects retired in this epoch or earlier can be freed, protected by m_Lock
+        stat                       m_Stat;
         //@endcond
 
     public:
@@ -121,6 +127,7 @@ namespace cds { namespace urcu {
             : m_Buffer( nBufferCapacity )
             , m_nCurEpoch(0)
             , m_nCapacity( nBufferCapacity )
+            , m_nSafeEpoch( 0 )
         {}
 
         ~general_buffered()
@@ -128,10 +135,14 @@ namespace cds { namespace urcu {
             clear_buffer( std::numeric_limits< uint64_t >::max());
         }
 
-        void flip_and_wait()
+        void grace_period( bool bExpedited )
         {
-            back_off bkoff;
-            base_class::flip_and_wait( bkoff );
+            if ( bExpedited )
+                base_class::grace_period_expedited( m_Stat );
+            else {
+                back_off bkoff;
+                base_class::grace_period( bkoff, m_Stat );
+            }
         }
 
         void clear_buffer( uint64_t nEpoch )
@@ -152,7 +163,11 @@ namespace cds { namespace urcu {
         bool push_buffer( epoch_retired_ptr&& ep )
         {
             bool bPushed = m_Buffer.push( ep );
-            if ( !bPushed || m_Buffer.size() >= capacity()) {
+            // The buffer with empty item counter reports zero size, but a failed push means it is full
+            size_t const nSize = m_Buffer.size();
+            m_Stat.onBufferSize( bPushed ? nSize : capacity());
+            if ( !bPushed || nSize >= capacity()) {
+                m_Stat.onForcedSynchronize();
                 synchronize();
                 if ( !bPushed ) {
                     ep.free();
@@ -178,6 +193,7 @@ namespace cds { namespace urcu {
         static void Destruct( bool bDetachAll = false )
         {
             if ( isUsed()) {
+                instance()->stop_call_rcu();
                 instance()->clear_buffer( std::numeric_limits< uint64_t >::max());
                 if ( bDetachAll )
                     instance()->m_ThreadList.detach_all();
@@ -224,23 +240,40 @@ namespace cds { namespace urcu {
         }
 
         /// Wait to finish a grace period and then clear the buffer
-        void synchronize()
+        /**
+            The callers that come while a grace period is in progress wait for the next grace period
+            that is passed by one of them.
+        */
+        virtual void synchronize() override
         {
             epoch_retired_ptr ep( retired_ptr(), m_nCurEpoch.load( atomics::memory_order_relaxed ));
             synchronize( ep );
         }
 
+        /// Waits to finish an expedited grace period and then clears the buffer
+        /**
+            See \ref cds_urcu_expedited "expedited grace periods".
+        */
+        virtual void synchronize_expedited() override
+        {
+            epoch_retired_ptr ep( retired_ptr(), m_nCurEpoch.load( atomics::memory_order_relaxed ));
+            synchronize( ep, true );
+        }
+
         //@cond
-        bool synchronize( epoch_retired_ptr& ep )
+        bool synchronize( epoch_retired_ptr& ep, bool bExpedited = false )
         {
+            uint64_t const nSnap = base_class::gp_snapshot();
             uint64_t nEpoch;
             {
                 std::unique_lock<lock_type> sl( m_Lock );
                 if ( ep.m_p && m_Buffer.push( ep ))
                     return false;
-                nEpoch = m_nCurEpoch.fetch_add( 1, atomics::memory_order_relaxed );
-                flip_and_wait();
-                flip_and_wait();
+                if ( !base_class::gp_passed( nSnap )) {
+                    m_nSafeEpoch = m_nCurEpoch.fetch_add( 1, atomics::memory_order_relaxed );
+                    grace_period( bExpedited );
+                }
+                nEpoch = m_nSafeEpoch;
             }
             clear_buffer( nEpoch );
             return true;
@@ -252,6 +285,12 @@ namespace cds { namespace urcu {
         {
             return m_nCapacity;
         }
+
+        /// Returns internal statistics
+        stat const& internal_statistics() const
+        {
+            return m_Stat;
+        }
     };
 
     /// User-space general-purpose RCU with deferred (buffered) reclamation (stripped version)
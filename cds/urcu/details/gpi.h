@@ -53,10 +53,13 @@ namespace cds { namespace urcu {
         Template arguments:
         - \p Lock - mutex type, default is \p std::mutex
         - \p Backoff - back-off schema, default is cds::backoff::Default
+        - \p Stat - internal statistics, \p cds::urcu::stat or \p cds::urcu::empty_stat.
+            The default is \p %empty_stat, or \p %stat<> if \p CDS_ENABLE_URCU_STAT macro is defined.
     */
     template <
         class Lock = std::mutex
        ,class Backoff = cds::backoff::Default
+       ,class Stat = default_stat
     >
     class general_instant: public details::gp_singleton< general_instant_tag >
     {
@@ -68,6 +71,7 @@ namespace cds { namespace urcu {
         typedef general_instant_tag rcu_tag ;   ///< RCU tag
         typedef Lock    lock_type   ;           ///< Lock type
         typedef Backoff back_off    ;           ///< Back-off schema type
+        typedef Stat    stat        ;           ///< Internal statistics type
 
         typedef typename base_class::thread_gc  thread_gc ;   ///< Thread-side RCU part
         typedef typename thread_gc::scoped_lock scoped_lock ; ///< Access lock class
@@ -84,6 +88,7 @@ namespace cds { namespace urcu {
     protected:
         //@cond
         lock_type   m_Lock;
+        stat        m_Stat;
         //@endcond
 
     public:
@@ -107,10 +112,14 @@ namespace cds { namespace urcu {
         ~general_instant()
         {}
 
-        void flip_and_wait()
+        void grace_period( bool bExpedited )
         {
-            back_off bkoff;
-            base_class::flip_and_wait( bkoff );
+            if ( bExpedited )
+                base_class::grace_period_expedited( m_Stat );
+            else {
+                back_off bkoff;
+                base_class::grace_period( bkoff, m_Stat );
+            }
         }
         //@endcond
 
@@ -126,6 +135,7 @@ namespace cds { namespace urcu {
         static void Destruct( bool bDetachAll = false )
         {
             if ( isUsed()) {
+                instance()->stop_call_rcu();
                 if ( bDetachAll )
                     instance()->m_ThreadList.detach_all();
                 delete instance();
@@ -177,12 +187,39 @@ namespace cds { namespace urcu {
         }
 
         /// Waits to finish a grace period
-        void synchronize()
+        /**
+            The callers that come while a grace period is in progress wait for the next grace period
+            that is passed by one of them.
+        */
+        virtual void synchronize() override
+        {
+            synchronize( false );
+        }
+
+        /// Waits to finish an expedited grace period
+        /**
+            See \ref cds_urcu_expedited "expedited grace periods".
+        */
+        virtual void synchronize_expedited() override
+        {
+            synchronize( true );
+        }
+
+        //@cond
+        void synchronize( bool bExpedited )
         {
             assert( !thread_gc::is_locked());
+            uint64_t const nSnap = base_class::gp_snapshot();
             std::unique_lock<lock_type> sl( m_Lock );
-            flip_and_wait();
-            flip_and_wait();
+            if ( !base_class::gp_passed( nSnap ))
+                grace_period( bExpedited );
+        }
+        //@endcond
+
+        /// Returns internal statistics
+        stat const& internal_statistics() const
+        {
+            return m_Stat;
         }
 
         //@cond
@@ -0,0 +1,347 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSLIB_URCU_DETAILS_GPLB_H
+#define CDSLIB_URCU_DETAILS_GPLB_H
+
+#include <mutex>
+#include <limits>
+#include <cds/urcu/details/gp.h>
+#include <cds/algo/backoff_strategy.h>
+
+namespace cds { namespace urcu {
+
+    /// User-space general-purpose RCU with deferred reclamation from per-thread buffers
+    /**
+        @headerfile cds/urcu/general_local_buffered.h
+
+        This URCU implementation is similar to \ref general_buffered but each thread accumulates
+        its retired objects in its own buffer instead of one buffer shared by all threads.
+        A retired object is tagged with the current epoch. When the thread buffer becomes full,
+        the thread waits until a grace period covering all epochs of its buffer has been passed,
+        and then frees its buffer. The grace period may be passed by another thread;
+        in this case the thread frees its buffer without waiting.
+        Only the grace-period bookkeeping (the epoch counters and the lock that serializes
+        grace periods) is global, so the concurrent retiring threads do not contend on a shared buffer.
+
+        The buffer of a detached thread stays in its thread record. It is freed by the thread that
+        reuses the record, by any \p synchronize() call, or when the RCU singleton is destroyed.
+
+        There is a wrapper \ref cds_urcu_general_local_buffered_gc "gc<general_local_buffered>" for \p %general_local_buffered class
+        that provides unified RCU interface. You should use this wrapper class instead \p %general_local_buffered
+
+        Template arguments:
+        - \p Lock - mutex type, default is \p std::mutex
+        - \p Backoff - back-off schema, default is cds::backoff::Default
+        - \p Stat - internal statistics, \p cds::urcu::stat or \p cds::urcu::empty_stat.
+            The default is \p %empty_stat, or \p %stat<> if \p CDS_ENABLE_URCU_STAT macro is defined.
+    */
+    template <
+        class Lock = std::mutex
+        ,class Backoff = cds::backoff::Default
+        ,class Stat = default_stat
+    >
+    class general_local_buffered: public details::gp_singleton< general_local_buffered_tag >
+    {
+        //@cond
+        typedef details::gp_singleton< general_local_buffered_tag > base_class;
+        //@endcond
+    public:
+        typedef general_local_buffered_tag rcu_tag ;  ///< RCU tag
+        typedef Lock    lock_type   ;   ///< Lock type
+        typedef Backoff back_off    ;   ///< Back-off type
+        typedef Stat    stat        ;   ///< Internal statistics type
+
+        typedef base_class::thread_gc thread_gc ;   ///< Thread-side RCU part
+        typedef typename thread_gc::scoped_lock scoped_lock ; ///< Access lock class
+
+        //@cond
+        static bool const c_bBuffered = true ; ///< Bufferized RCU
+        //@endcond
+
+    protected:
+        //@cond
+        typedef details::gp_singleton_instance< rcu_tag >    singleton_ptr;
+        typedef typename base_class::thread_record          thread_record;
+        typedef typename thread_record::retired_buffer      retired_buffer;
+        //@endcond
+
+    protected:
+        //@cond
+        atomics::atomic<uint64_t>  m_nCurEpoch;     // epoch of new retired objects
+        atomics::atomic<uint64_t>  m_nSafeEpoch;    // the objects retired in this epoch or earlier can be freed
+        lock_type                  m_Lock;
+        size_t const               m_nCapacity;
+        stat                       m_Stat;
+        //@endcond
+
+    public:
+        /// Returns singleton instance
+        static general_local_buffered * instance()
+        {
+            return static_cast<general_local_buffered *>( base_class::instance());
+        }
+        /// Checks if the singleton is created and ready to use
+        static bool isUsed()
+        {
+            return singleton_ptr::s_pRCU != nullptr;
+        }
+
+    protected:
+        //@cond
+        general_local_buffered( size_t nBufferCapacity )
+            : m_nCurEpoch( 1 )
+            , m_nSafeEpoch( 0 )
+            , m_nCapacity( nBufferCapacity )
+        {}
+
+        ~general_local_buffered()
+        {
+            clear_buffers();
+        }
+
+        void grace_period( bool bExpedited )
+        {
+            if ( bExpedited )
+                base_class::grace_period_expedited( m_Stat );
+            else {
+                back_off bkoff;
+                base_class::grace_period( bkoff, m_Stat );
+            }
+        }
+
+        static thread_record * get_thread_record()
+        {
+            thread_record * pRec = cds::threading::getRCU< rcu_tag >();
+            assert( pRec != nullptr );
+            return pRec;
+        }
+
+        // Frees the head of the buffer retired up to the safe epoch
+        void flush( thread_record * pRec )
+        {
+            uint64_t const nSafeEpoch = m_nSafeEpoch.load( atomics::memory_order_acquire );
+            retired_buffer& buf = pRec->m_Retired;
+
+            size_t nCount = 0;
+            while ( nCount < buf.size() && buf[nCount].m_nEpoch <= nSafeEpoch )
+                ++nCount;
+            if ( nCount == 0 )
+                return;
+
+            // A disposer can retire new objects to the buffer, so the safe items are moved out before freeing
+            retired_buffer safe( buf.begin(), buf.begin() + nCount );
+            buf.erase( buf.begin(), buf.begin() + nCount );
+            for ( epoch_retired_ptr& p : safe )
+                p.free();
+        }
+
+        // Frees the buffers of the detached threads
+        void flush_free_records()
+        {
+            OS::ThreadId const nullThreadId = OS::c_NullThreadId;
+            OS::ThreadId const curThreadId = OS::get_current_thread_id();
+
+            for ( thread_record * pRec = base_class::m_ThreadList.head( atomics::memory_order_acquire ); pRec; pRec = pRec->m_list.m_pNext.load( atomics::memory_order_relaxed )) {
+                OS::ThreadId thId = nullThreadId;
+                if ( pRec->m_list.m_idOwner.compare_exchange_strong( thId, curThreadId, atomics::memory_order_acquire, atomics::memory_order_relaxed )) {
+                    flush( pRec );
+                    pRec->m_list.m_idOwner.store( nullThreadId, atomics::memory_order_release );
+                }
+            }
+        }
+
+        void clear_buffers()
+        {
+            for ( thread_record * pRec = base_class::m_ThreadList.head( atomics::memory_order_acquire ); pRec; pRec = pRec->m_list.m_pNext.load( atomics::memory_order_relaxed )) {
+                retired_buffer buf;
+                buf.swap( pRec->m_Retired );
+                for ( epoch_retired_ptr& p : buf )
+                    p.free();
+            }
+        }
+
+        // Waits until the objects retired in epoch nEpoch can be freed
+        void wait_for_epoch( uint64_t nEpoch, bool bExpedited = false )
+        {
+            std::unique_lock<lock_type> sl( m_Lock );
+
+            // The grace period may be passed by another thread while we were waiting for the lock
+            if ( m_nSafeEpoch.load( atomics::memory_order_relaxed ) >= nEpoch ) {
+                base_class::m_nGPSharedCount.fetch_add( 1, atomics::memory_order_relaxed );
+                return;
+            }
+
+            uint64_t const nCurEpoch = m_nCurEpoch.fetch_add( 1, atomics::memory_order_relaxed );
+            grace_period( bExpedited );
+            m_nSafeEpoch.store( nCurEpoch, atomics::memory_order_release );
+        }
+
+        void push_buffer( thread_record * pRec, epoch_retired_ptr&& ep )
+        {
+            retired_buffer& buf = pRec->m_Retired;
+            if ( buf.capacity() < capacity())
+                buf.reserve( capacity());
+            buf.push_back( ep );
+            m_Stat.onBufferSize( buf.size());
+
+            if ( buf.size() >= capacity()) {
+                flush( pRec );
+                if ( buf.size() >= capacity()) {
+                    m_Stat.onForcedSynchronize();
+                    wait_for_epoch( buf.back().m_nEpoch );
+                    flush( pRec );
+                }
+            }
+        }
+
+        uint64_t current_epoch() const
+        {
+            return m_nCurEpoch.load( atomics::memory_order_acquire );
+        }
+        //@endcond
+
+    public:
+        /// Creates singleton object
+        /**
+            The \p nBufferCapacity parameter defines RCU threshold for each thread buffer.
+        */
+        static void Construct( size_t nBufferCapacity = 256 )
+        {
+            if ( !singleton_ptr::s_pRCU )
+                singleton_ptr::s_pRCU = new general_local_buffered( nBufferCapacity );
+        }
+
+        /// Destroys singleton object
+        static void Destruct( bool bDetachAll = false )
+        {
+            if ( isUsed()) {
+                instance()->stop_call_rcu();
+                instance()->clear_buffers();
+                if ( bDetachAll )
+                    instance()->m_ThreadList.detach_all();
+                delete instance();
+                singleton_ptr::s_pRCU = nullptr;
+            }
+        }
+
+    public:
+        /// Retire \p p pointer
+        /**
+            The method pushes \p p pointer to the buffer of current thread.
+            When the buffer becomes full the thread waits for the end of grace period
+            and then frees all pointers from its buffer.
+        */
+        virtual void retire_ptr( retired_ptr& p ) override
+        {
+            if ( p.m_p )
+                push_buffer( get_thread_record(), epoch_retired_ptr( p, current_epoch()));
+        }
+
+        /// Retires the pointer chain [\p itFirst, \p itLast)
+        template <typename ForwardIterator>
+        void batch_retire( ForwardIterator itFirst, ForwardIterator itLast )
+        {
+            thread_record * pRec = get_thread_record();
+            uint64_t nEpoch = current_epoch();
+            while ( itFirst != itLast ) {
+                epoch_retired_ptr ep( *itFirst, nEpoch );
+                ++itFirst;
+                push_buffer( pRec, std::move(ep));
+            }
+        }
+
+        /// Retires the pointer chain until \p Func returns \p nullptr retired pointer
+        template <typename Func>
+        void batch_retire( Func e )
+        {
+            thread_record * pRec = get_thread_record();
+            uint64_t nEpoch = current_epoch();
+            for ( retired_ptr p{ e() }; p.m_p; ) {
+                epoch_retired_ptr ep( p, nEpoch );
+                p = e();
+                push_buffer( pRec, std::move(ep));
+            }
+        }
+
+        /// Waits to finish a grace period and then clears the buffer of current thread and of detached threads
+        virtual void synchronize() override
+        {
+            synchronize( false );
+        }
+
+        /// Waits to finish an expedited grace period and then clears the buffers like \p synchronize()
+        /**
+            See \ref cds_urcu_expedited "expedited grace periods".
+        */
+        virtual void synchronize_expedited() override
+        {
+            synchronize( true );
+        }
+
+        //@cond
+        void synchronize( bool bExpedited )
+        {
+            wait_for_epoch( current_epoch(), bExpedited );
+
+            thread_record * pRec = cds::threading::getRCU< rcu_tag >();
+            if ( pRec )
+                flush( pRec );
+            flush_free_records();
+        }
+        //@endcond
+
+        /// Returns the capacity of thread buffer
+        size_t capacity() const
+        {
+            return m_nCapacity;
+        }
+
+        /// Returns internal statistics
+        stat const& internal_statistics() const
+        {
+            return m_Stat;
+        }
+    };
+
+    /// User-space general-purpose RCU with deferred reclamation from per-thread buffers (stripped version)
+    /**
+        @headerfile cds/urcu/general_local_buffered.h
+
+        This short version of \p general_local_buffered is intended for stripping debug info.
+        If you use \p %general_local_buffered with default template arguments you may use
+        this stripped version. All functionality of both classes are identical.
+    */
+    class general_local_buffered_stripped: public general_local_buffered<>
+    {};
+
+}} // namespace cds::urcu
+
+#endif // #ifndef CDSLIB_URCU_DETAILS_GPLB_H
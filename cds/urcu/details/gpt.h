@@ -75,14 +75,18 @@ namespace cds { namespace urcu {
             that is incremented on each \p synchronize() call. The epoch is used internally to prevent early deletion.
         - \p Lock - mutex type, default is \p std::mutex
         - \p DisposerThread - the reclamation thread class. Default is \ref cds::urcu::dispose_thread,
-            see the description of this class for required interface.
+            see the description of this class for required interface. If one thread cannot keep up
+            with the retiring threads use \ref cds::urcu::dispose_thread_pool.
         - \p Backoff - back-off schema, default is cds::backoff::Default
+        - \p Stat - internal statistics, \p cds::urcu::stat or \p cds::urcu::empty_stat.
+            The default is \p %empty_stat, or \p %stat<> if \p CDS_ENABLE_URCU_STAT macro is defined.
     */
     template <
         class Buffer = cds::container::VyukovMPSCCycleQueue< epoch_retired_ptr >
         ,class Lock = std::mutex
         ,class DisposerThread = dispose_thread<Buffer>
         ,class Backoff = cds::backoff::Default
+        ,class Stat = default_stat
     >
     class general_threaded: public details::gp_singleton< general_threaded_tag >
     {
@@ -94,6 +98,7 @@ namespace cds { namespace urcu {
         typedef Lock            lock_type   ;   ///< Lock type
         typedef Backoff         back_off    ;   ///< Back-off scheme
         typedef DisposerThread  disposer_thread ;   ///< Disposer thread type
+        typedef Stat            stat        ;   ///< Internal statistics type
 
         typedef general_threaded_tag    rcu_tag ;       ///< Thread-side RCU part
         typedef base_class::thread_gc   thread_gc ;     ///< Access lock class
@@ -122,6 +127,7 @@ namespace cds { namespace urcu {
         lock_type                 m_Lock;
         size_t const              m_nCapacity;
         disposer_thread           m_DisposerThread;
+        stat                      m_Stat;
         //@endcond
 
     public:
@@ -144,17 +150,25 @@ namespace cds { namespace urcu {
             , m_nCapacity( nBufferCapacity )
         {}
 
-        void flip_and_wait()
+        void grace_period( bool bExpedited )
         {
-            back_off bkoff;
-            base_class::flip_and_wait( bkoff );
+            if ( bExpedited )
+                base_class::grace_period_expedited( m_Stat );
+            else {
+                back_off bkoff;
+                base_class::grace_period( bkoff, m_Stat );
+            }
         }
 
         // Return: true - synchronize has been called, false - otherwise
         bool push_buffer( epoch_retired_ptr&& p )
         {
             bool bPushed = m_Buffer.push( p );
-            if ( !bPushed || m_Buffer.size() >= capacity()) {
+            // The buffer with empty item counter reports zero size, but a failed push means it is full
+            size_t const nSize = m_Buffer.size();
+            m_Stat.onBufferSize( bPushed ? nSize : capacity());
+            if ( !bPushed || nSize >= capacity()) {
+                m_Stat.onForcedSynchronize();
                 synchronize();
                 if ( !bPushed )
                     p.free();
@@ -190,6 +204,7 @@ namespace cds { namespace urcu {
         {
             if ( isUsed()) {
                 general_threaded * pThis = instance();
+                pThis->stop_call_rcu();
                 if ( bDetachAll )
                     pThis->m_ThreadList.detach_all();
 
@@ -239,19 +254,27 @@ namespace cds { namespace urcu {
         }
 
         /// Waits to finish a grace period and calls disposing thread
-        void synchronize()
+        virtual void synchronize() override
         {
             synchronize( false );
         }
 
+        /// Waits to finish an expedited grace period and calls disposing thread
+        /**
+            See \ref cds_urcu_expedited "expedited grace periods".
+        */
+        virtual void synchronize_expedited() override
+        {
+            synchronize( false, true );
+        }
+
         //@cond
-        void synchronize( bool bSync )
+        void synchronize( bool bSync, bool bExpedited = false )
         {
             uint64_t nPrevEpoch = m_nCurEpoch.fetch_add( 1, atomics::memory_order_release );
             {
                 std::unique_lock<lock_type> sl( m_Lock );
-                flip_and_wait();
-                flip_and_wait();
+                grace_period( bExpedited );
             }
             m_DisposerThread.dispose( m_Buffer, nPrevEpoch, bSync );
         }
@@ -266,6 +289,18 @@ namespace cds { namespace urcu {
         {
             return m_nCapacity;
         }
+
+        /// Returns the reclamation thread object
+        disposer_thread const& disposer() const
+        {
+            return m_DisposerThread;
+        }
+
+        /// Returns internal statistics
+        stat const& internal_statistics() const
+        {
+            return m_Stat;
+        }
     };
 
     /// User-space general-purpose RCU with deferred threaded reclamation (stripped version)
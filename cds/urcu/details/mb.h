@@ -0,0 +1,149 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSLIB_URCU_DETAILS_MB_H
+#define CDSLIB_URCU_DETAILS_MB_H
+
+#include <cds/urcu/details/mb_decl.h>
+
+#ifdef CDS_URCU_MEMBARRIER_ENABLED
+#include <cds/threading/model.h>
+#include <cds/urcu/details/call_rcu.h>
+
+//@cond
+namespace cds { namespace urcu { namespace details {
+
+    // Inlines
+
+    // mb_thread_gc
+    template <typename RCUtag>
+    inline mb_thread_gc<RCUtag>::mb_thread_gc()
+    {
+        if ( !threading::Manager::isThreadAttached())
+            cds::threading::Manager::attachThread();
+    }
+
+    template <typename RCUtag>
+    inline mb_thread_gc<RCUtag>::~mb_thread_gc()
+    {
+        cds::threading::Manager::detachThread();
+    }
+
+    template <typename RCUtag>
+    inline typename mb_thread_gc<RCUtag>::thread_record * mb_thread_gc<RCUtag>::get_thread_record()
+    {
+        return cds::threading::getRCU<RCUtag>();
+    }
+
+    template <typename RCUtag>
+    inline void mb_thread_gc<RCUtag>::access_lock()
+    {
+        thread_record * pRec = get_thread_record();
+        assert( pRec != nullptr );
+
+        uint32_t tmp = pRec->m_nAccessControl.load( atomics::memory_order_relaxed );
+
+        if ( (tmp & rcu_class::c_nNestMask) == 0 ) {
+            mb_singleton<RCUtag> * pRCU = mb_singleton<RCUtag>::instance();
+            pRec->m_nAccessControl.store( pRCU->global_control_word(atomics::memory_order_relaxed),
+                atomics::memory_order_relaxed );
+
+            // The updater forces the memory barrier by membarrier() system call.
+            // If the kernel does not support it the reader is on its own
+            if ( pRCU->expedited())
+                cds::OS::membarrier::light();
+            else
+                atomics::atomic_thread_fence( atomics::memory_order_seq_cst );
+        }
+        else {
+            // nested lock
+            pRec->m_nAccessControl.store( tmp + 1, atomics::memory_order_relaxed );
+        }
+    }
+
+    template <typename RCUtag>
+    inline void mb_thread_gc<RCUtag>::access_unlock()
+    {
+        thread_record * pRec = get_thread_record();
+        assert( pRec != nullptr);
+
+        uint32_t tmp = pRec->m_nAccessControl.load( atomics::memory_order_relaxed );
+        assert( ( tmp & rcu_class::c_nNestMask ) > 0 );
+
+        CDS_COMPILER_RW_BARRIER;
+        pRec->m_nAccessControl.store( tmp - 1, atomics::memory_order_release );
+    }
+
+    template <typename RCUtag>
+    inline bool mb_thread_gc<RCUtag>::is_locked()
+    {
+        thread_record * pRec = get_thread_record();
+        assert( pRec != nullptr);
+
+        return (pRec->m_nAccessControl.load( atomics::memory_order_relaxed ) & rcu_class::c_nNestMask) != 0;
+    }
+
+
+    // mb_singleton
+    template <typename RCUtag>
+    inline void mb_singleton<RCUtag>::force_membar_all_threads()
+    {
+        if ( m_bExpedited )
+            cds::OS::membarrier::heavy();
+        else
+            atomics::atomic_thread_fence( atomics::memory_order_seq_cst );
+    }
+
+    template <typename RCUtag>
+    inline bool mb_singleton<RCUtag>::check_grace_period( thread_record * pRec ) const
+    {
+        uint32_t const v = pRec->m_nAccessControl.load( atomics::memory_order_acquire );
+        return (v & membarrier_rcu::c_nNestMask)
+            && ((( v ^ m_nGlobalControl.load( atomics::memory_order_relaxed )) & ~membarrier_rcu::c_nNestMask ));
+    }
+
+    template <typename RCUtag>
+    template <class Backoff>
+    inline void mb_singleton<RCUtag>::wait_for_quiescent_state( Backoff& bkOff )
+    {
+        OS::ThreadId const nullThreadId = OS::c_NullThreadId;
+
+        for ( thread_record * pRec = m_ThreadList.head( atomics::memory_order_acquire); pRec; pRec = pRec->m_list.m_pNext ) {
+            while ( pRec->m_list.m_idOwner.load( atomics::memory_order_acquire) != nullThreadId && check_grace_period( pRec ))
+                bkOff();
+            bkOff.reset();
+        }
+    }
+
+}}} // namespace cds:urcu::details
+//@endcond
+
+#endif // #ifdef CDS_URCU_MEMBARRIER_ENABLED
+#endif // #ifndef CDSLIB_URCU_DETAILS_MB_H
@@ -0,0 +1,183 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef CDSLIB_URCU_DETAILS_PC_H
+#define CDSLIB_URCU_DETAILS_PC_H
+
+#include <new>
+#include <cds/urcu/details/pc_decl.h>
+#include <cds/threading/model.h>
+#include <cds/urcu/details/call_rcu.h>
+#include <cds/os/topology.h>
+#include <cds/os/alloc_aligned.h>
+#include <cds/algo/int_algo.h>
+
+//@cond
+namespace cds { namespace urcu { namespace details {
+
+    // Inlines
+
+    // pc_thread_gc
+    template <typename RCUtag>
+    inline pc_thread_gc<RCUtag>::pc_thread_gc()
+    {
+        if ( !threading::Manager::isThreadAttached())
+            cds::threading::Manager::attachThread();
+    }
+
+    template <typename RCUtag>
+    inline pc_thread_gc<RCUtag>::~pc_thread_gc()
+    {
+        cds::threading::Manager::detachThread();
+    }
+
+    template <typename RCUtag>
+    inline typename pc_thread_gc<RCUtag>::thread_record * pc_thread_gc<RCUtag>::get_thread_record()
+    {
+        return cds::threading::getRCU<RCUtag>();
+    }
+
+    template <typename RCUtag>
+    inline void pc_thread_gc<RCUtag>::access_lock()
+    {
+        thread_record * pRec = get_thread_record();
+        assert( pRec != nullptr );
+
+        if ( pRec->m_nNesting++ == 0 ) {
+            pc_singleton<RCUtag> * pRCU = pc_singleton<RCUtag>::instance();
+            uint32_t const nIdx = pRCU->current_index( atomics::memory_order_acquire );
+            pRec->m_nIdx = nIdx;
+            pRCU->current_counter().m_nLock[nIdx].fetch_add( 1, atomics::memory_order_relaxed );
+
+            // Pairs with the fence of the updater between the scans of unlock and lock counters
+            atomics::atomic_thread_fence( atomics::memory_order_seq_cst );
+        }
+    }
+
+    template <typename RCUtag>
+    inline void pc_thread_gc<RCUtag>::access_unlock()
+    {
+        thread_record * pRec = get_thread_record();
+        assert( pRec != nullptr );
+        assert( pRec->m_nNesting > 0 );
+
+        if ( --pRec->m_nNesting == 0 ) {
+            // The thread may run on another processor now, the updater checks the sums only
+            pc_singleton<RCUtag>::instance()->current_counter().m_nUnlock[pRec->m_nIdx].fetch_add( 1, atomics::memory_order_release );
+        }
+    }
+
+    template <typename RCUtag>
+    inline bool pc_thread_gc<RCUtag>::is_locked()
+    {
+        thread_record * pRec = get_thread_record();
+        assert( pRec != nullptr );
+
+        return pRec->m_nNesting != 0;
+    }
+
+
+    // pc_singleton
+    template <typename RCUtag>
+    inline pc_singleton<RCUtag>::pc_singleton()
+        : m_nIdx( 0 )
+        , m_nCounterMask( cds::beans::ceil2( cds::OS::topology::processor_count()) - 1 )
+    {
+        m_pCounters = reinterpret_cast<percpu_reader_counter *>(
+            cds::OS::aligned_malloc( sizeof( percpu_reader_counter ) * counter_count(), cds::c_nCacheLineSize ));
+        if ( !m_pCounters )
+            throw std::bad_alloc();
+        for ( size_t i = 0; i < counter_count(); ++i )
+            new ( m_pCounters + i ) percpu_reader_counter;
+    }
+
+    template <typename RCUtag>
+    inline pc_singleton<RCUtag>::~pc_singleton()
+    {
+        for ( size_t i = 0; i < counter_count(); ++i )
+            m_pCounters[i].~percpu_reader_counter();
+        cds::OS::aligned_free( m_pCounters );
+    }
+
+    template <typename RCUtag>
+    inline percpu_reader_counter& pc_singleton<RCUtag>::current_counter() const
+    {
+        return m_pCounters[ cds::OS::topology::current_processor() & m_nCounterMask ];
+    }
+
+    template <typename RCUtag>
+    inline bool pc_singleton<RCUtag>::readers_done( uint32_t nIdx ) const
+    {
+        uint64_t nUnlock = 0;
+        for ( size_t i = 0; i < counter_count(); ++i )
+            nUnlock += m_pCounters[i].m_nUnlock[nIdx].load( atomics::memory_order_acquire );
+
+        // A reader whose unlock is counted above is counted in the lock sum below
+        atomics::atomic_thread_fence( atomics::memory_order_seq_cst );
+
+        uint64_t nLock = 0;
+        for ( size_t i = 0; i < counter_count(); ++i )
+            nLock += m_pCounters[i].m_nLock[nIdx].load( atomics::memory_order_relaxed );
+
+        return nLock == nUnlock;
+    }
+
+    template <typename RCUtag>
+    template <class Backoff>
+    inline void pc_singleton<RCUtag>::wait_readers( uint32_t nIdx, Backoff& bkoff )
+    {
+        while ( !readers_done( nIdx )) {
+            bkoff();
+            CDS_COMPILER_RW_BARRIER;
+        }
+        bkoff.reset();
+    }
+
+    template <typename RCUtag>
+    template <class Backoff>
+    inline void pc_singleton<RCUtag>::wait_for_quiescent_state( Backoff& bkoff )
+    {
+        // The removal preceding synchronize() must be ordered before the counter scans
+        atomics::atomic_thread_fence( atomics::memory_order_seq_cst );
+
+        uint32_t const nIdx = current_index( atomics::memory_order_relaxed );
+
+        // A reader that fetched the index before the previous flip may increment the inactive counters just now
+        wait_readers( nIdx ^ 1, bkoff );
+
+        m_nIdx.fetch_add( 1, atomics::memory_order_seq_cst );
+        atomics::atomic_thread_fence( atomics::memory_order_seq_cst );
+
+        wait_readers( nIdx, bkoff );
+    }
+
+}}} // namespace cds::urcu::details
+//@endcond
+
+#endif // #ifndef CDSLIB_URCU_DETAILS_PC_H
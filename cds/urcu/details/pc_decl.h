@@ -0,0 +1,228 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef CDSLIB_URCU_DETAILS_PC_DECL_H
+#define CDSLIB_URCU_DETAILS_PC_DECL_H
+
+#include <cds/urcu/details/base.h>
+#include <cds/details/static_functor.h>
+#include <cds/details/lib.h>
+#include <cds/user_setup/cache_line.h>
+
+//@cond
+namespace cds { namespace urcu { namespace details {
+
+    // The thread data is private to the owner thread, the updater does not scan the thread list.
+    // m_nIdx is the counter index the outermost read-side critical section has been entered with
+#   define CDS_PCURCU_DECLARE_THREAD_DATA(tag_) \
+    template <> struct thread_data<tag_> { \
+        uint32_t                         m_nNesting ; \
+        uint32_t                         m_nIdx ; \
+        thread_list_record< thread_data >   m_list ; \
+        char pad_[cds::c_nCacheLineSize]; \
+        thread_data(): m_nNesting(0), m_nIdx(0) {} \
+        explicit thread_data( OS::ThreadId owner ): m_nNesting(0), m_nIdx(0), m_list(owner) {} \
+        ~thread_data() {} \
+    }
+
+    CDS_PCURCU_DECLARE_THREAD_DATA( percpu_buffered_tag );
+
+#   undef CDS_PCURCU_DECLARE_THREAD_DATA
+
+    // Reader counters of one processor
+    struct percpu_reader_counter
+    {
+        atomics::atomic<uint64_t>   m_nLock[2];
+        atomics::atomic<uint64_t>   m_nUnlock[2];
+        char pad_[cds::c_nCacheLineSize - 4 * sizeof( atomics::atomic<uint64_t> )];
+
+        percpu_reader_counter()
+        {
+            for ( unsigned i = 0; i < 2; ++i ) {
+                m_nLock[i].store( 0, atomics::memory_order_relaxed );
+                m_nUnlock[i].store( 0, atomics::memory_order_relaxed );
+            }
+        }
+    };
+
+    template <typename RCUtag>
+    struct pc_singleton_instance
+    {
+        static CDS_EXPORT_API singleton_vtbl *     s_pRCU;
+    };
+#if !( CDS_COMPILER == CDS_COMPILER_MSVC || (CDS_COMPILER == CDS_COMPILER_INTEL && CDS_OS_INTERFACE == CDS_OSI_WINDOWS))
+    template<> CDS_EXPORT_API singleton_vtbl * pc_singleton_instance< percpu_buffered_tag >::s_pRCU;
+#endif
+
+    template <typename PCRCUtag>
+    class pc_thread_gc
+    {
+    public:
+        typedef PCRCUtag                    rcu_tag;
+        typedef typename rcu_tag::rcu_class rcu_class;
+        typedef thread_data< rcu_tag >      thread_record;
+        typedef cds::urcu::details::scoped_lock< pc_thread_gc > scoped_lock;
+
+    protected:
+        static thread_record * get_thread_record();
+
+    public:
+        pc_thread_gc();
+        ~pc_thread_gc();
+    public:
+        static void access_lock();
+        static void access_unlock();
+        static bool is_locked();
+
+        /// Retire pointer \p by the disposer \p Disposer
+        template <typename Disposer, typename T>
+        static void retire( T * p )
+        {
+            retire( p, cds::details::static_functor<Disposer, T>::call );
+        }
+
+        /// Retire pointer \p by the disposer \p pFunc
+        template <typename T>
+        static void retire( T * p, void (* pFunc)(T *))
+        {
+            retired_ptr rp( reinterpret_cast<void *>( p ), reinterpret_cast<free_retired_ptr_func>( pFunc ));
+            retire( rp );
+        }
+
+        /// Retire pointer \p
+        static void retire( retired_ptr& p )
+        {
+            assert( pc_singleton_instance< rcu_tag >::s_pRCU );
+            pc_singleton_instance< rcu_tag >::s_pRCU->retire_ptr( p );
+        }
+    };
+
+#   define CDS_PC_RCU_DECLARE_THREAD_GC( tag_ ) template <> class thread_gc<tag_>: public pc_thread_gc<tag_> {}
+
+    CDS_PC_RCU_DECLARE_THREAD_GC( percpu_buffered_tag );
+
+#   undef CDS_PC_RCU_DECLARE_THREAD_GC
+
+    template <class RCUtag>
+    class pc_singleton: public singleton_vtbl
+    {
+    public:
+        typedef RCUtag  rcu_tag;
+        typedef cds::urcu::details::thread_gc< rcu_tag >   thread_gc;
+
+    protected:
+        typedef typename thread_gc::thread_record   thread_record;
+        typedef pc_singleton_instance< rcu_tag >    rcu_instance;
+
+    protected:
+        atomics::atomic<uint32_t>   m_nIdx;         // the lowest bit is the index of the reader counters
+        size_t const                m_nCounterMask; // counter count - 1, the count is a power of 2
+        percpu_reader_counter *     m_pCounters;
+        thread_list< rcu_tag >      m_ThreadList;
+
+    protected:
+        pc_singleton();
+        ~pc_singleton();
+
+    public:
+        static pc_singleton * instance()
+        {
+            return static_cast< pc_singleton *>( rcu_instance::s_pRCU );
+        }
+
+        static bool isUsed()
+        {
+            return rcu_instance::s_pRCU != nullptr;
+        }
+
+    public:
+        virtual void retire_ptr( retired_ptr& p ) = 0;
+
+    public: // thread_gc interface
+        thread_record * attach_thread()
+        {
+            thread_record * pRec = m_ThreadList.alloc();
+            pRec->m_nNesting = 0;
+            return pRec;
+        }
+
+        void detach_thread( thread_record * pRec )
+        {
+            assert( pRec->m_nNesting == 0 );
+            m_ThreadList.retire( pRec );
+        }
+
+        uint32_t current_index( atomics::memory_order mo ) const
+        {
+            return m_nIdx.load( mo ) & 1;
+        }
+
+        percpu_reader_counter& current_counter() const;
+
+        // Returns the count of per-processor counters
+        size_t counter_count() const
+        {
+            return m_nCounterMask + 1;
+        }
+
+    protected:
+        bool readers_done( uint32_t nIdx ) const;
+
+        template <class Backoff>
+        void wait_readers( uint32_t nIdx, Backoff& bkoff );
+
+        // Flips the counter index and waits until the readers of the old index leave their critical sections
+        template <class Backoff>
+        void wait_for_quiescent_state( Backoff& bkoff );
+    };
+
+#   define CDS_PC_RCU_DECLARE_SINGLETON( tag_ ) \
+    template <> class singleton< tag_ > { \
+    public: \
+        typedef tag_  rcu_tag ; \
+        typedef cds::urcu::details::thread_gc< rcu_tag >   thread_gc ; \
+    protected: \
+        typedef thread_gc::thread_record            thread_record ; \
+        typedef pc_singleton_instance< rcu_tag >    rcu_instance  ; \
+        typedef pc_singleton< rcu_tag >             rcu_singleton ; \
+    public: \
+        static bool isUsed() { return rcu_singleton::isUsed() ; } \
+        static rcu_singleton * instance() { assert( rcu_instance::s_pRCU ); return static_cast<rcu_singleton *>( rcu_instance::s_pRCU ); } \
+        static thread_record * attach_thread() { return instance()->attach_thread() ; } \
+        static void detach_thread( thread_record * pRec ) { return instance()->detach_thread( pRec ) ; } \
+    }
+
+    CDS_PC_RCU_DECLARE_SINGLETON( percpu_buffered_tag );
+
+#   undef CDS_PC_RCU_DECLARE_SINGLETON
+
+}}} // namespace cds::urcu::details
+//@endcond
+
+#endif // #ifndef CDSLIB_URCU_DETAILS_PC_DECL_H
@@ -0,0 +1,160 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSLIB_URCU_DETAILS_QS_H
+#define CDSLIB_URCU_DETAILS_QS_H
+
+#include <cds/urcu/details/qs_decl.h>
+#include <cds/threading/model.h>
+#include <cds/urcu/details/call_rcu.h>
+
+//@cond
+namespace cds { namespace urcu { namespace details {
+
+    // Inlines
+
+    // qs_thread_gc
+    template <typename RCUtag>
+    inline qs_thread_gc<RCUtag>::qs_thread_gc()
+    {
+        if ( !threading::Manager::isThreadAttached())
+            cds::threading::Manager::attachThread();
+    }
+
+    template <typename RCUtag>
+    inline qs_thread_gc<RCUtag>::~qs_thread_gc()
+    {
+        cds::threading::Manager::detachThread();
+    }
+
+    template <typename RCUtag>
+    inline typename qs_thread_gc<RCUtag>::thread_record * qs_thread_gc<RCUtag>::get_thread_record()
+    {
+        return cds::threading::getRCU<RCUtag>();
+    }
+
+    template <typename RCUtag>
+    inline void qs_thread_gc<RCUtag>::access_lock()
+    {
+        // The read-side critical section is not visible to other threads,
+        // the nesting counter is kept only for deadlock checking
+        thread_record * pRec = get_thread_record();
+        assert( pRec != nullptr );
+
+        if ( pRec->m_nNesting == 0 && pRec->m_nCtr.load( atomics::memory_order_relaxed ) == rcu_class::c_nOffline )
+            thread_online();
+
+        ++pRec->m_nNesting;
+    }
+
+    template <typename RCUtag>
+    inline void qs_thread_gc<RCUtag>::access_unlock()
+    {
+        thread_record * pRec = get_thread_record();
+        assert( pRec != nullptr );
+        assert( pRec->m_nNesting > 0 );
+
+        --pRec->m_nNesting;
+    }
+
+    template <typename RCUtag>
+    inline bool qs_thread_gc<RCUtag>::is_locked()
+    {
+        thread_record * pRec = get_thread_record();
+        assert( pRec != nullptr );
+
+        return pRec->m_nNesting != 0;
+    }
+
+    template <typename RCUtag>
+    inline void qs_thread_gc<RCUtag>::quiescent_state()
+    {
+        thread_record * pRec = get_thread_record();
+        assert( pRec != nullptr );
+        assert( pRec->m_nNesting == 0 );
+
+        uint64_t const nCtr = qs_singleton<RCUtag>::instance()->global_counter( atomics::memory_order_acquire );
+
+        // Nothing to announce if no grace period has been started since the last quiescent state
+        if ( pRec->m_nCtr.load( atomics::memory_order_relaxed ) != nCtr ) {
+            atomics::atomic_thread_fence( atomics::memory_order_seq_cst );
+            pRec->m_nCtr.store( nCtr, atomics::memory_order_release );
+            atomics::atomic_thread_fence( atomics::memory_order_seq_cst );
+        }
+    }
+
+    template <typename RCUtag>
+    inline void qs_thread_gc<RCUtag>::thread_offline()
+    {
+        thread_record * pRec = get_thread_record();
+        assert( pRec != nullptr );
+        assert( pRec->m_nNesting == 0 );
+
+        atomics::atomic_thread_fence( atomics::memory_order_seq_cst );
+        pRec->m_nCtr.store( rcu_class::c_nOffline, atomics::memory_order_release );
+    }
+
+    template <typename RCUtag>
+    inline void qs_thread_gc<RCUtag>::thread_online()
+    {
+        thread_record * pRec = get_thread_record();
+        assert( pRec != nullptr );
+
+        pRec->m_nCtr.store( qs_singleton<RCUtag>::instance()->global_counter( atomics::memory_order_acquire ), atomics::memory_order_relaxed );
+        atomics::atomic_thread_fence( atomics::memory_order_seq_cst );
+    }
+
+
+    // qs_singleton
+    template <typename RCUtag>
+    template <class Backoff>
+    inline void qs_singleton<RCUtag>::wait_for_quiescent_state( Backoff& bkoff )
+    {
+        OS::ThreadId const nullThreadId = OS::c_NullThreadId;
+        uint64_t const nCtr = m_nGlobalCtr.fetch_add( 1, atomics::memory_order_seq_cst ) + 1;
+
+        for ( thread_record * pRec = m_ThreadList.head( atomics::memory_order_acquire ); pRec; pRec = pRec->m_list.m_pNext ) {
+            for (;;) {
+                if ( pRec->m_list.m_idOwner.load( atomics::memory_order_acquire ) == nullThreadId )
+                    break;
+                uint64_t const nThreadCtr = pRec->m_nCtr.load( atomics::memory_order_acquire );
+                if ( nThreadCtr == rcu_tag::c_nOffline || nThreadCtr >= nCtr )
+                    break;
+                bkoff();
+                CDS_COMPILER_RW_BARRIER;
+            }
+            bkoff.reset();
+        }
+    }
+
+}}} // namespace cds::urcu::details
+//@endcond
+
+#endif // #ifndef CDSLIB_URCU_DETAILS_QS_H
@@ -0,0 +1,284 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSLIB_URCU_DETAILS_QS_BUFFERED_H
+#define CDSLIB_URCU_DETAILS_QS_BUFFERED_H
+
+#include <mutex>
+#include <limits>
+#include <cds/urcu/details/qs.h>
+#include <cds/algo/backoff_strategy.h>
+#include <cds/container/vyukov_mpmc_cycle_queue.h>
+
+namespace cds { namespace urcu {
+
+    /// User-space quiescent-state based RCU with deferred (buffered) reclamation
+    /**
+        @headerfile cds/urcu/quiescent_buffered.h
+
+        In this URCU implementation the read-side critical section costs nothing:
+        \p access_lock() and \p access_unlock() change only a private nesting counter
+        of the thread that is used for deadlock checking. Instead, each attached thread should periodically
+        announce a quiescent state by calling \p quiescent_state(), i.e. the point where
+        the thread holds no pointers to RCU-protected data, for example, between two requests
+        in the event loop of the thread. The protection of the data read by the thread lasts until its next quiescent state,
+        not until the end of the read-side critical section.
+
+        A thread that is going to block for a long time (waiting for I/O, on a condition variable and so on)
+        should call \p thread_offline() before and \p thread_online() after the blocking, otherwise
+        the grace period cannot end until the thread wakes up and announces a quiescent state.
+        A thread is attached offline, so a thread that does not use the RCU never delays grace periods.
+        It goes online on \p thread_online(), \p quiescent_state() or its first read-side critical section,
+        and is offline after detaching.
+        \p synchronize() puts the caller offline while it waits for the end of a grace period.
+
+        This URCU implementation contains an internal buffer where retired objects are
+        accumulated. When the buffer becomes full, the RCU \p synchronize function is called
+        that waits until each online thread passes a quiescent state.
+        After that the buffer and all retired objects are freed.
+        This synchronization cycle may be called in any thread that calls \p retire_ptr function.
+
+        The \p Buffer contains items of \ref cds_urcu_retired_ptr "epoch_retired_ptr" type and it should support a queue interface with
+        three function:
+        - <tt> bool push( retired_ptr& p ) </tt> - places the retired pointer \p p into queue. If the function
+            returns \p false it means that the buffer is full and RCU synchronization cycle must be processed.
+        - <tt>bool pop( retired_ptr& p ) </tt> - pops queue's head item into \p p parameter; if the queue is empty
+            this function must return \p false
+        - <tt>size_t size()</tt> - returns queue's item count.
+
+        The buffer is considered as full if \p push returns \p false or the buffer size reaches the RCU threshold.
+
+        There is a wrapper \ref cds_urcu_quiescent_buffered_gc "gc<quiescent_buffered>" for \p %quiescent_buffered class
+        that provides unified RCU interface. You should use this wrapper class instead \p %quiescent_buffered
+
+        Template arguments:
+        - \p Buffer - buffer type. Default is \p cds::container::VyukovMPMCCycleQueue
+        - \p Lock - mutex type, default is \p std::mutex
+        - \p Backoff - back-off schema, default is cds::backoff::Default
+    */
+    template <
+        class Buffer = cds::container::VyukovMPMCCycleQueue< epoch_retired_ptr >
+        ,class Lock = std::mutex
+        ,class Backoff = cds::backoff::Default
+    >
+    class quiescent_buffered: public details::qs_singleton< quiescent_buffered_tag >
+    {
+        //@cond
+        typedef details::qs_singleton< quiescent_buffered_tag > base_class;
+        //@endcond
+    public:
+        typedef quiescent_buffered_tag rcu_tag ;  ///< RCU tag
+        typedef Buffer  buffer_type ;   ///< Buffer type
+        typedef Lock    lock_type   ;   ///< Lock type
+        typedef Backoff back_off    ;   ///< Back-off type
+
+        typedef base_class::thread_gc thread_gc ;   ///< Thread-side RCU part
+        typedef typename thread_gc::scoped_lock scoped_lock ; ///< Access lock class
+
+        //@cond
+        static bool const c_bBuffered = true ; ///< Bufferized RCU
+        //@endcond
+
+    protected:
+        //@cond
+        typedef details::qs_singleton_instance< rcu_tag >    singleton_ptr;
+        //@endcond
+
+    protected:
+        //@cond
+        buffer_type               m_Buffer;
+        atomics::atomic<uint64_t> m_nCurEpoch;
+        lock_type                 m_Lock;
+        size_t const              m_nCapacity;
+        //@endcond
+
+    public:
+        /// Returns singleton instance
+        static quiescent_buffered * instance()
+        {
+            return static_cast<quiescent_buffered *>( base_class::instance());
+        }
+        /// Checks if the singleton is created and ready to use
+        static bool isUsed()
+        {
+            return singleton_ptr::s_pRCU != nullptr;
+        }
+
+    protected:
+        //@cond
+        quiescent_buffered( size_t nBufferCapacity )
+            : m_Buffer( nBufferCapacity )
+            , m_nCurEpoch(0)
+            , m_nCapacity( nBufferCapacity )
+        {}
+
+        ~quiescent_buffered()
+        {
+            clear_buffer( std::numeric_limits< uint64_t >::max());
+        }
+
+        void clear_buffer( uint64_t nEpoch )
+        {
+            epoch_retired_ptr p;
+            while ( m_Buffer.pop( p )) {
+                if ( p.m_nEpoch <= nEpoch ) {
+                    p.free();
+                }
+                else {
+                    push_buffer( std::move(p));
+                    break;
+                }
+            }
+        }
+
+        bool push_buffer( epoch_retired_ptr&& ep )
+        {
+            bool bPushed = m_Buffer.push( ep );
+            if ( !bPushed || m_Buffer.size() >= capacity()) {
+                synchronize();
+                if ( !bPushed ) {
+                    ep.free();
+                }
+                return true;
+            }
+            return false;
+        }
+        //@endcond
+
+    public:
+        /// Creates singleton object
+        /**
+            The \p nBufferCapacity parameter defines RCU threshold.
+        */
+        static void Construct( size_t nBufferCapacity = 256 )
+        {
+            if ( !singleton_ptr::s_pRCU )
+                singleton_ptr::s_pRCU = new quiescent_buffered( nBufferCapacity );
+        }
+
+        /// Destroys singleton object
+        static void Destruct( bool bDetachAll = false )
+        {
+            if ( isUsed()) {
+                instance()->stop_call_rcu();
+                instance()->clear_buffer( std::numeric_limits< uint64_t >::max());
+                if ( bDetachAll )
+                    instance()->m_ThreadList.detach_all();
+                delete instance();
+                singleton_ptr::s_pRCU = nullptr;
+            }
+        }
+
+    public:
+        /// Retire \p p pointer
+        /**
+            The method pushes \p p pointer to internal buffer.
+            When the buffer becomes full \ref synchronize function is called
+            to wait for the end of grace period and then to free all pointers from the buffer.
+        */
+        virtual void retire_ptr( retired_ptr& p ) override
+        {
+            if ( p.m_p )
+                push_buffer( epoch_retired_ptr( p, m_nCurEpoch.load( atomics::memory_order_relaxed )));
+        }
+
+        /// Retires the pointer chain [\p itFirst, \p itLast)
+        template <typename ForwardIterator>
+        void batch_retire( ForwardIterator itFirst, ForwardIterator itLast )
+        {
+            uint64_t nEpoch = m_nCurEpoch.load( atomics::memory_order_relaxed );
+            while ( itFirst != itLast ) {
+                epoch_retired_ptr ep( *itFirst, nEpoch );
+                ++itFirst;
+                push_buffer( std::move(ep));
+            }
+        }
+
+        /// Retires the pointer chain until \p Func returns \p nullptr retired pointer
+        template <typename Func>
+        void batch_retire( Func e )
+        {
+            uint64_t nEpoch = m_nCurEpoch.load( atomics::memory_order_relaxed );
+            for ( retired_ptr p{ e() }; p.m_p; ) {
+                epoch_retired_ptr ep( p, nEpoch );
+                p = e();
+                push_buffer( std::move(ep));
+            }
+        }
+
+        /// Waits to finish a grace period and then clears the buffer
+        /**
+            The caller must not be inside read-side critical section.
+            If the caller is online, it is put offline while it waits for other threads.
+        */
+        virtual void synchronize() override
+        {
+            typename thread_gc::thread_record * pRec = cds::threading::getRCU< rcu_tag >();
+            bool const bOnline = pRec && pRec->m_nCtr.load( atomics::memory_order_relaxed ) != rcu_tag::c_nOffline;
+            if ( bOnline )
+                thread_gc::thread_offline();
+
+            uint64_t nEpoch;
+            {
+                std::unique_lock<lock_type> sl( m_Lock );
+                nEpoch = m_nCurEpoch.fetch_add( 1, atomics::memory_order_relaxed );
+
+                back_off bkOff;
+                base_class::wait_for_quiescent_state( bkOff );
+            }
+
+            if ( bOnline )
+                thread_gc::thread_online();
+
+            clear_buffer( nEpoch );
+        }
+
+        /// Returns the threshold of internal buffer
+        size_t capacity() const
+        {
+            return m_nCapacity;
+        }
+    };
+
+
+    /// User-space quiescent-state based RCU with deferred (buffered) reclamation (stripped version)
+    /**
+        @headerfile cds/urcu/quiescent_buffered.h
+
+        This short version of \p quiescent_buffered is intended for stripping debug info.
+        If you use \p %quiescent_buffered with default template arguments you may use
+        this stripped version. All functionality of both classes are identical.
+    */
+    class quiescent_buffered_stripped: public quiescent_buffered<>
+    {};
+
+}} // namespace cds::urcu
+
+#endif // #ifndef CDSLIB_URCU_DETAILS_QS_BUFFERED_H
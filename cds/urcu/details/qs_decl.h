@@ -0,0 +1,223 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSLIB_URCU_DETAILS_QS_DECL_H
+#define CDSLIB_URCU_DETAILS_QS_DECL_H
+
+#include <cds/urcu/details/base.h>
+#include <cds/details/static_functor.h>
+#include <cds/details/lib.h>
+#include <cds/user_setup/cache_line.h>
+
+//@cond
+namespace cds { namespace urcu { namespace details {
+
+    // m_nCtr is the value of the global counter at the last quiescent state of the thread,
+    // quiescent_state_rcu::c_nOffline if the thread is in extended quiescent state.
+    // m_nNesting is private to the owner thread and is used only for deadlock checking
+#   define CDS_QSURCU_DECLARE_THREAD_DATA(tag_) \
+    template <> struct thread_data<tag_> { \
+        atomics::atomic<uint64_t>        m_nCtr ; \
+        uint32_t                         m_nNesting ; \
+        thread_list_record< thread_data >   m_list ; \
+        char pad_[cds::c_nCacheLineSize]; \
+        thread_data(): m_nCtr( quiescent_state_rcu::c_nOffline ), m_nNesting(0) {} \
+        explicit thread_data( OS::ThreadId owner ): m_nCtr( quiescent_state_rcu::c_nOffline ), m_nNesting(0), m_list(owner) {} \
+        ~thread_data() {} \
+    }
+
+    CDS_QSURCU_DECLARE_THREAD_DATA( quiescent_buffered_tag );
+
+#   undef CDS_QSURCU_DECLARE_THREAD_DATA
+
+    template <typename RCUtag>
+    struct qs_singleton_instance
+    {
+        static CDS_EXPORT_API singleton_vtbl *     s_pRCU;
+    };
+#if !( CDS_COMPILER == CDS_COMPILER_MSVC || (CDS_COMPILER == CDS_COMPILER_INTEL && CDS_OS_INTERFACE == CDS_OSI_WINDOWS))
+    template<> CDS_EXPORT_API singleton_vtbl * qs_singleton_instance< quiescent_buffered_tag >::s_pRCU;
+#endif
+
+    template <typename QSRCUtag>
+    class qs_thread_gc
+    {
+    public:
+        typedef QSRCUtag                    rcu_tag;
+        typedef typename rcu_tag::rcu_class rcu_class;
+        typedef thread_data< rcu_tag >      thread_record;
+        typedef cds::urcu::details::scoped_lock< qs_thread_gc > scoped_lock;
+
+    protected:
+        static thread_record * get_thread_record();
+
+    public:
+        qs_thread_gc();
+        ~qs_thread_gc();
+    public:
+        static void access_lock();
+        static void access_unlock();
+        static bool is_locked();
+
+        static void quiescent_state();
+        static void thread_offline();
+        static void thread_online();
+
+        /// Retire pointer \p by the disposer \p Disposer
+        template <typename Disposer, typename T>
+        static void retire( T * p )
+        {
+            retire( p, cds::details::static_functor<Disposer, T>::call );
+        }
+
+        /// Retire pointer \p by the disposer \p pFunc
+        template <typename T>
+        static void retire( T * p, void (* pFunc)(T *))
+        {
+            retired_ptr rp( reinterpret_cast<void *>( p ), reinterpret_cast<free_retired_ptr_func>( pFunc ));
+            retire( rp );
+        }
+
+        /// Retire pointer \p
+        static void retire( retired_ptr& p )
+        {
+            assert( qs_singleton_instance< rcu_tag >::s_pRCU );
+            qs_singleton_instance< rcu_tag >::s_pRCU->retire_ptr( p );
+        }
+    };
+
+#   define CDS_QS_RCU_DECLARE_THREAD_GC( tag_ ) template <> class thread_gc<tag_>: public qs_thread_gc<tag_> {}
+
+    CDS_QS_RCU_DECLARE_THREAD_GC( quiescent_buffered_tag );
+
+#   undef CDS_QS_RCU_DECLARE_THREAD_GC
+
+    template <class RCUtag>
+    class qs_singleton: public singleton_vtbl
+    {
+    public:
+        typedef RCUtag  rcu_tag;
+        typedef cds::urcu::details::thread_gc< rcu_tag >   thread_gc;
+
+    protected:
+        typedef typename thread_gc::thread_record   thread_record;
+        typedef qs_singleton_instance< rcu_tag >    rcu_instance;
+
+    protected:
+        atomics::atomic<uint64_t>   m_nGlobalCtr;
+        thread_list< rcu_tag >      m_ThreadList;
+
+    protected:
+        qs_singleton()
+            : m_nGlobalCtr( 1 )
+        {}
+
+        ~qs_singleton()
+        {}
+
+    public:
+        static qs_singleton * instance()
+        {
+            return static_cast< qs_singleton *>( rcu_instance::s_pRCU );
+        }
+
+        static bool isUsed()
+        {
+            return rcu_instance::s_pRCU != nullptr;
+        }
+
+    public:
+        virtual void retire_ptr( retired_ptr& p ) = 0;
+
+        virtual void thread_offline() override
+        {
+            thread_gc::thread_offline();
+        }
+
+        virtual void thread_online() override
+        {
+            thread_gc::thread_online();
+        }
+
+    public: // thread_gc interface
+        thread_record * attach_thread()
+        {
+            thread_record * pRec = m_ThreadList.alloc();
+            pRec->m_nNesting = 0;
+
+            // The thread is attached offline: a thread that never uses the RCU must not delay grace periods.
+            // It goes online on thread_online(), quiescent_state() or its first read-side critical section
+            pRec->m_nCtr.store( rcu_tag::c_nOffline, atomics::memory_order_release );
+            return pRec;
+        }
+
+        void detach_thread( thread_record * pRec )
+        {
+            pRec->m_nCtr.store( rcu_tag::c_nOffline, atomics::memory_order_release );
+            m_ThreadList.retire( pRec );
+        }
+
+        uint64_t global_counter( atomics::memory_order mo ) const
+        {
+            return m_nGlobalCtr.load( mo );
+        }
+
+    protected:
+        // Starts new grace period and waits until each online thread passes a quiescent state.
+        // The caller should be in extended quiescent state
+        template <class Backoff>
+        void wait_for_quiescent_state( Backoff& bkoff );
+    };
+
+#   define CDS_QS_RCU_DECLARE_SINGLETON( tag_ ) \
+    template <> class singleton< tag_ > { \
+    public: \
+        typedef tag_  rcu_tag ; \
+        typedef cds::urcu::details::thread_gc< rcu_tag >   thread_gc ; \
+    protected: \
+        typedef thread_gc::thread_record            thread_record ; \
+        typedef qs_singleton_instance< rcu_tag >    rcu_instance  ; \
+        typedef qs_singleton< rcu_tag >             rcu_singleton ; \
+    public: \
+        static bool isUsed() { return rcu_singleton::isUsed() ; } \
+        static rcu_singleton * instance() { assert( rcu_instance::s_pRCU ); return static_cast<rcu_singleton *>( rcu_instance::s_pRCU ); } \
+        static thread_record * attach_thread() { return instance()->attach_thread() ; } \
+        static void detach_thread( thread_record * pRec ) { return instance()->detach_thread( pRec ) ; } \
+        static uint64_t global_counter( atomics::memory_order mo ) { return instance()->global_counter( mo ) ; } \
+    }
+
+    CDS_QS_RCU_DECLARE_SINGLETON( quiescent_buffered_tag );
+
+#   undef CDS_QS_RCU_DECLARE_SINGLETON
+
+}}} // namespace cds::urcu::details
+//@endcond
+
+#endif // #ifndef CDSLIB_URCU_DETAILS_QS_DECL_H
@@ -36,6 +36,7 @@
 
 #ifdef CDS_URCU_SIGNAL_HANDLING_ENABLED
 #include <cds/threading/model.h>
+#include <cds/urcu/details/call_rcu.h>
 
 //@cond
 namespace cds { namespace urcu { namespace details {
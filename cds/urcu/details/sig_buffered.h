@@ -176,6 +176,7 @@ namespace cds { namespace urcu {
         static void Destruct( bool bDetachAll = false )
         {
             if ( isUsed()) {
+                instance()->stop_call_rcu();
                 instance()->clear_buffer( std::numeric_limits< uint64_t >::max());
                 if ( bDetachAll )
                     instance()->m_ThreadList.detach_all();
@@ -222,7 +223,7 @@ namespace cds { namespace urcu {
         }
 
         /// Wait to finish a grace period and then clear the buffer
-        void synchronize()
+        virtual void synchronize() override
         {
             epoch_retired_ptr ep( retired_ptr(), m_nCurEpoch.load( atomics::memory_order_relaxed ));
             synchronize( ep );
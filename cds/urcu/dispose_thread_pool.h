@@ -0,0 +1,430 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef CDSLIB_URCU_DISPOSE_THREAD_POOL_H
+#define CDSLIB_URCU_DISPOSE_THREAD_POOL_H
+
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+#include <cds/urcu/details/base.h>
+#include <cds/os/topology.h>
+
+namespace cds { namespace urcu {
+
+    /// Worker initializer of \p dispose_thread_pool that does nothing
+    struct dispose_pool_no_init
+    {
+        //@cond
+        void operator()( size_t /*nWorker*/, size_t /*nWorkerCount*/ ) const
+        {}
+        //@endcond
+    };
+
+    /// Shard selector of \p dispose_thread_pool: memory page of the retired object
+    /**
+        The objects placed in the same memory page are freed by the same worker,
+        so the allocator's per-thread caches and per-node arenas are touched
+        by the least possible number of workers.
+    */
+    struct dispose_pool_page_shard
+    {
+        //@cond
+        size_t operator()( epoch_retired_ptr const& p, size_t nWorkerCount ) const
+        {
+            return static_cast<size_t>( reinterpret_cast<uintptr_t>( p.m_p ) >> 12 ) % nWorkerCount;
+        }
+        //@endcond
+    };
+
+    /// \p dispose_thread_pool traits
+    struct dispose_thread_pool_traits
+    {
+        /// Count of worker threads, 0 - the processor count
+        static constexpr size_t const thread_count = 0;
+
+        /// Count of retired objects handed over to a worker at once
+        static constexpr size_t const batch_size = 64;
+
+        /// Back-pressure limit: max count of the objects handed over to the workers but not freed yet
+        /**
+            When the limit is reached the dispatching pass waits for the workers.
+            The next \p synchronize() call waits for the pass,
+            so the retiring threads slow down until the workers catch up.
+            0 means no limit.
+        */
+        static constexpr size_t const max_pending = 0;
+
+        /// Worker initializer: <tt>void operator()( size_t nWorker, size_t nWorkerCount )</tt>
+        /**
+            The functor is called in each worker thread before its first disposing pass.
+            This is the place to bind the worker to a processor set or a NUMA node,
+            for example by \p numa_run_on_node() of \p libnuma.
+        */
+        typedef dispose_pool_no_init worker_init;
+
+        /// Shard selector: <tt>size_t operator()( epoch_retired_ptr const& p, size_t nWorkerCount )</tt>
+        /**
+            Returns the index of the worker that frees \p p. If the workers are bound to NUMA nodes
+            the selector may return the worker bound to the node where \p p.m_p is allocated,
+            for example by \p get_mempolicy( MPOL_F_NODE | MPOL_F_ADDR ).
+        */
+        typedef dispose_pool_page_shard shard;
+    };
+
+    /// Pool of reclamation threads for \p general_threaded URCU
+    /**
+        @headerfile cds/urcu/dispose_thread_pool.h
+
+        \p dispose_thread frees all retired objects in one thread and may fall behind
+        the retiring threads under heavy erase load. The pool has the same interface
+        and may be passed as \p DisposerThread template argument of \p general_threaded:
+        \code
+        #include <cds/urcu/general_threaded.h>
+        #include <cds/urcu/dispose_thread_pool.h>
+
+        typedef cds::container::VyukovMPSCCycleQueue< cds::urcu::epoch_retired_ptr > rcu_buffer;
+        typedef cds::urcu::gc< cds::urcu::general_threaded< rcu_buffer, std::mutex, cds::urcu::dispose_thread_pool< rcu_buffer >>> rcu_type;
+        \endcode
+
+        The grace period is passed once by \p synchronize() caller as usual.
+        Then the dispatching thread of the pool moves the objects ready to free from the RCU buffer
+        to the workers in batches of \p Traits::batch_size. \p Traits::shard selects the worker for each object.
+        The workers free their batches in parallel.
+
+        If \p Traits::max_pending is not zero the dispatching thread waits while the workers have
+        more than \p max_pending objects to free. Since \p synchronize() waits for the previous dispatching pass
+        the retiring threads are throttled by the slowest worker instead of growing the memory footprint.
+
+        Template arguments:
+        - \p Buffer - the buffer type of \ref general_threaded URCU
+        - \p Traits - pool traits, default is \p dispose_thread_pool_traits.
+    */
+    template <class Buffer, class Traits = dispose_thread_pool_traits>
+    class dispose_thread_pool
+    {
+    public:
+        typedef Buffer  buffer_type ;   ///< Buffer type
+        typedef Traits  traits      ;   ///< Pool traits
+    private:
+        //@cond
+        typedef std::thread             thread_type;
+        typedef std::mutex              mutex_type;
+        typedef std::condition_variable condvar_type;
+        typedef std::unique_lock< mutex_type >  unique_lock;
+        typedef std::vector< epoch_retired_ptr > batch_type;
+
+        struct worker {
+            mutex_type              m_Mutex;
+            condvar_type            m_cvDataReady;
+            condvar_type            m_cvDone;
+            std::deque< batch_type > m_Queue;
+            uint64_t                m_nDispatched = 0;  // count of batches handed over to the worker
+            uint64_t                m_nDone = 0;        // count of batches freed by the worker
+            bool                    m_bQuit = false;
+            thread_type             m_Thread;
+        };
+
+        size_t const                    m_nWorkerCount;
+        std::unique_ptr< worker[] >     m_Workers;
+        std::vector< batch_type >       m_Batches;      // batches being filled by the dispatching thread
+        thread_type                     m_DispatchThread;
+
+        // synchronization with dispatching thread
+        mutex_type      m_Mutex;
+        condvar_type    m_cvDataReady;
+
+        // Task for dispatching thread (dispose cycle)
+        buffer_type *   m_pBuffer = nullptr;
+        uint64_t        m_nCurEpoch = 0;
+
+        // Quit flag
+        bool    m_bQuit = false;
+
+        // dispatching pass sync
+        condvar_type    m_cvReady;
+        bool            m_bReady = false;
+
+        // back-pressure
+        mutable mutex_type m_PendingMutex;
+        condvar_type    m_cvPending;
+        size_t          m_nPending = 0;
+        //@endcond
+
+    private: // methods called from dispatching thread
+        //@cond
+        void execute()
+        {
+            buffer_type *   pBuffer;
+            uint64_t        nCurEpoch;
+            bool            bQuit = false;
+
+            while ( !bQuit ) {
+
+                // signal that we are ready to dispose
+                {
+                    unique_lock lock( m_Mutex );
+                    m_bReady = true;
+                }
+                m_cvReady.notify_all();
+
+                {
+                    // wait new data portion
+                    unique_lock lock( m_Mutex );
+
+                    while ( ( pBuffer = m_pBuffer ) == nullptr )
+                        m_cvDataReady.wait( lock );
+
+                    // New work is ready
+                    m_bReady = false; // we are busy
+
+                    bQuit = m_bQuit;
+                    nCurEpoch = m_nCurEpoch;
+                    m_pBuffer = nullptr;
+                }
+
+                dispatch_buffer( pBuffer, nCurEpoch );
+            }
+        }
+
+        void dispatch_buffer( buffer_type * pBuf, uint64_t nCurEpoch )
+        {
+            typename traits::shard shard;
+            epoch_retired_ptr * p;
+            while ( ( p = pBuf->front()) != nullptr && p->m_nEpoch <= nCurEpoch ) {
+                size_t const nWorker = shard( *p, m_nWorkerCount );
+                assert( nWorker < m_nWorkerCount );
+
+                m_Batches[nWorker].push_back( *p );
+                CDS_VERIFY( pBuf->pop_front());
+
+                if ( m_Batches[nWorker].size() >= traits::batch_size )
+                    hand_over( nWorker );
+            }
+
+            for ( size_t i = 0; i < m_nWorkerCount; ++i ) {
+                if ( !m_Batches[i].empty())
+                    hand_over( i );
+            }
+        }
+
+        void hand_over( size_t nWorker )
+        {
+            batch_type batch;
+            batch.reserve( traits::batch_size );
+            batch.swap( m_Batches[nWorker] );
+
+            {
+                unique_lock lock( m_PendingMutex );
+                // The batch is handed over anyway if the workers are idle, even if it is larger than the limit
+                while ( traits::max_pending != 0 && m_nPending != 0 && m_nPending + batch.size() > traits::max_pending )
+                    m_cvPending.wait( lock );
+                m_nPending += batch.size();
+            }
+
+            worker& w = m_Workers[nWorker];
+            {
+                unique_lock lock( w.m_Mutex );
+                w.m_Queue.push_back( std::move( batch ));
+                ++w.m_nDispatched;
+            }
+            w.m_cvDataReady.notify_one();
+        }
+        //@endcond
+
+    private: // methods called from worker threads
+        //@cond
+        void worker_func( size_t nWorker )
+        {
+            typename traits::worker_init()( nWorker, m_nWorkerCount );
+
+            worker& w = m_Workers[nWorker];
+            for ( ;; ) {
+                batch_type batch;
+                {
+                    unique_lock lock( w.m_Mutex );
+                    while ( w.m_Queue.empty() && !w.m_bQuit )
+                        w.m_cvDataReady.wait( lock );
+
+                    // the worker quits when its queue is empty
+                    if ( w.m_Queue.empty())
+                        break;
+
+                    batch.swap( w.m_Queue.front());
+                    w.m_Queue.pop_front();
+                }
+
+                for ( auto& p : batch )
+                    p.free();
+
+                {
+                    unique_lock lock( m_PendingMutex );
+                    m_nPending -= batch.size();
+                }
+                m_cvPending.notify_one();
+
+                {
+                    unique_lock lock( w.m_Mutex );
+                    ++w.m_nDone;
+                }
+                w.m_cvDone.notify_all();
+            }
+        }
+
+        void wait_workers()
+        {
+            for ( size_t i = 0; i < m_nWorkerCount; ++i ) {
+                worker& w = m_Workers[i];
+                unique_lock lock( w.m_Mutex );
+                uint64_t const nDispatched = w.m_nDispatched;
+                while ( w.m_nDone < nDispatched )
+                    w.m_cvDone.wait( lock );
+            }
+        }
+
+        static size_t worker_count()
+        {
+            size_t const nCount = traits::thread_count ? traits::thread_count : cds::OS::topology::processor_count();
+            return nCount ? nCount : 1;
+        }
+        //@endcond
+
+    public: // methods called from any thread
+        //@cond
+        dispose_thread_pool()
+            : m_nWorkerCount( worker_count())
+            , m_Workers( new worker[ m_nWorkerCount ] )
+            , m_Batches( m_nWorkerCount )
+        {}
+        //@endcond
+
+        /// Returns the count of worker threads
+        size_t thread_count() const
+        {
+            return m_nWorkerCount;
+        }
+
+        /// Returns the count of objects handed over to the workers but not freed yet
+        size_t pending() const
+        {
+            unique_lock lock( m_PendingMutex );
+            return m_nPending;
+        }
+
+        /// Start reclamation threads
+        /**
+            This function is called by \ref general_threaded object to start
+            the worker threads and the dispatching thread.
+        */
+        void start()
+        {
+            for ( size_t i = 0; i < m_nWorkerCount; ++i )
+                m_Workers[i].m_Thread = thread_type( [this, i]() { worker_func( i ); } );
+            m_DispatchThread = thread_type( [this]() { execute(); } );
+        }
+
+        /// Stop reclamation threads
+        /**
+            This function is called by \ref general_threaded object to
+            start the last reclamation cycle and then to terminate all threads of the pool.
+
+            \p buf buffer contains retired objects ready to free.
+        */
+        void stop( buffer_type& buf, uint64_t nCurEpoch )
+        {
+            {
+                unique_lock lock( m_Mutex );
+
+                // wait while dispatching pass done
+                while ( !m_bReady )
+                    m_cvReady.wait( lock );
+
+                // give a new work and set stop flag
+                m_nCurEpoch = nCurEpoch;
+                m_pBuffer = &buf;
+                m_bQuit = true;
+            }
+            m_cvDataReady.notify_one();
+
+            m_DispatchThread.join();
+
+            for ( size_t i = 0; i < m_nWorkerCount; ++i ) {
+                worker& w = m_Workers[i];
+                {
+                    unique_lock lock( w.m_Mutex );
+                    w.m_bQuit = true;
+                }
+                w.m_cvDataReady.notify_one();
+                w.m_Thread.join();
+            }
+        }
+
+        /// Start reclamation cycle
+        /**
+            This function is called by \ref general_threaded object
+            to notify the dispatching thread about a new work.
+            \p buf buffer contains retired objects ready to free.
+            The pool should free all \p buf objects
+            \p m_nEpoch field of which is no more than \p nCurEpoch.
+
+            If \p bSync parameter is \p true the calling thread
+            waits until the workers free all objects dispatched so far.
+        */
+        void dispose( buffer_type& buf, uint64_t nCurEpoch, bool bSync )
+        {
+            {
+                unique_lock lock( m_Mutex );
+
+                // wait while dispatching pass done
+                while ( !m_bReady )
+                    m_cvReady.wait( lock );
+
+                // new work
+                m_bReady = false;
+                m_nCurEpoch = nCurEpoch;
+                m_pBuffer = &buf;
+            }
+            m_cvDataReady.notify_one();
+
+            if ( bSync ) {
+                {
+                    unique_lock lock( m_Mutex );
+                    while ( !m_bReady )
+                        m_cvReady.wait( lock );
+                }
+                wait_workers();
+            }
+        }
+    };
+}} // namespace cds::urcu
+
+#endif // #ifndef CDSLIB_URCU_DISPOSE_THREAD_POOL_H
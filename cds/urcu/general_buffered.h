@@ -45,26 +45,30 @@ namespace cds { namespace urcu {
             Default is \p cds::container::VyukovMPMCCycleQueue< retired_ptr >
         - \p Lock - mutex type, default is \p std::mutex
         - \p Backoff - back-off schema, default is \p cds::backoff::Default
+        - \p Stat - internal statistics, see \p cds::urcu::stat
     */
     template <
 #ifdef CDS_DOXGEN_INVOKED
         class Buffer = cds::container::VyukovMPMCCycleQueue< retired_ptr >
         ,class Lock = std::mutex
         ,class Backoff = cds::backoff::Default
+        ,class Stat = default_stat
 #else
         class Buffer
        ,class Lock
        ,class Backoff
+       ,class Stat
 #endif
     >
-    class gc< general_buffered< Buffer, Lock, Backoff > >: public details::gc_common
+    class gc< general_buffered< Buffer, Lock, Backoff, Stat > >: public details::gc_common
     {
     public:
-        typedef general_buffered< Buffer, Lock, Backoff >  rcu_implementation   ;    ///< Wrapped URCU implementation
+        typedef general_buffered< Buffer, Lock, Backoff, Stat >  rcu_implementation   ;    ///< Wrapped URCU implementation
 
         typedef typename rcu_implementation::rcu_tag     rcu_tag     ;   ///< URCU tag
         typedef typename rcu_implementation::thread_gc   thread_gc   ;   ///< Thread-side RCU part
         typedef typename rcu_implementation::scoped_lock scoped_lock ;   ///< Access lock class
+        typedef typename rcu_implementation::stat        stat        ;   ///< Internal statistics type
 
         using details::gc_common::atomic_marked_ptr;
 
@@ -92,6 +96,46 @@ namespace cds { namespace urcu {
             rcu_implementation::instance()->synchronize();
         }
 
+        /// Waits to finish an expedited grace period
+        /**
+            Like \ref synchronize but trades CPU for latency, see \ref cds_urcu_expedited "expedited grace periods".
+            The cost is reported by \ref statistics.
+        */
+        static void synchronize_expedited()
+        {
+            rcu_implementation::instance()->synchronize_expedited();
+        }
+
+        /// Calls \p f after the end of a grace period without blocking the caller
+        /**
+            See \ref cds_urcu_call_rcu "deferred callbacks". \p f must not throw.
+        */
+        template <typename Func>
+        static void call_rcu( Func f )
+        {
+            rcu_implementation::instance()->call_rcu( std::function< void() >( std::move( f )));
+        }
+
+        /// Calls \p f after the end of a grace period and returns the future of the call
+        /**
+            See \ref cds_urcu_call_rcu "deferred callbacks". The exception thrown by \p f
+            is stored in the returned future.
+        */
+        template <typename Func>
+        static std::future<void> call_rcu_future( Func f )
+        {
+            return rcu_implementation::instance()->call_rcu_future( std::function< void() >( std::move( f )));
+        }
+
+        /// Returns grace period statistics
+        /**
+            See \p cds::urcu::gp_stat.
+        */
+        static void statistics( gp_stat& st )
+        {
+            rcu_implementation::instance()->statistics( st );
+        }
+
         /// Places retired pointer <\p p, \p pFunc> to internal buffer
         /**
             If the buffer is full, \ref synchronize function is invoked.
@@ -160,6 +204,12 @@ namespace cds { namespace urcu {
             return rcu_implementation::instance()->capacity();
         }
 
+        /// Returns internal statistics of the RCU singleton
+        static stat const& internal_statistics()
+        {
+            return rcu_implementation::instance()->internal_statistics();
+        }
+
         /// Checks if the thread is inside read-side critical section (i.e. the lock is acquired)
         /**
             Usually, this function is used internally to be convinced
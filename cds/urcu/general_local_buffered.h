@@ -0,0 +1,240 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSLIB_URCU_GENERAL_LOCAL_BUFFERED_H
+#define CDSLIB_URCU_GENERAL_LOCAL_BUFFERED_H
+
+#include <cds/urcu/details/gplb.h>
+
+namespace cds { namespace urcu {
+
+    /// User-space general-purpose RCU with deferred reclamation from per-thread buffers
+    /** @anchor cds_urcu_general_local_buffered_gc
+
+        This is a wrapper around \p general_local_buffered class.
+
+        Template arguments:
+        - \p Lock - mutex type, default is \p std::mutex
+        - \p Backoff - back-off schema, default is \p cds::backoff::Default
+        - \p Stat - internal statistics, see \p cds::urcu::stat
+    */
+    template <
+#ifdef CDS_DOXGEN_INVOKED
+        class Lock = std::mutex
+        ,class Backoff = cds::backoff::Default
+        ,class Stat = default_stat
+#else
+        class Lock
+       ,class Backoff
+       ,class Stat
+#endif
+    >
+    class gc< general_local_buffered< Lock, Backoff, Stat > >: public details::gc_common
+    {
+    public:
+        typedef general_local_buffered< Lock, Backoff, Stat >  rcu_implementation   ;    ///< Wrapped URCU implementation
+
+        typedef typename rcu_implementation::rcu_tag     rcu_tag     ;   ///< URCU tag
+        typedef typename rcu_implementation::thread_gc   thread_gc   ;   ///< Thread-side RCU part
+        typedef typename rcu_implementation::scoped_lock scoped_lock ;   ///< Access lock class
+        typedef typename rcu_implementation::stat        stat        ;   ///< Internal statistics type
+
+        using details::gc_common::atomic_marked_ptr;
+
+    public:
+        /// Creates URCU \p %general_local_buffered singleton.
+        /**
+            \p nBufferCapacity is the capacity of the retired buffer of each thread.
+        */
+        gc( size_t nBufferCapacity = 256 )
+        {
+            rcu_implementation::Construct( nBufferCapacity );
+        }
+
+        /// Destroys URCU \p %general_local_buffered singleton
+        ~gc()
+        {
+            rcu_implementation::Destruct( true );
+        }
+
+    public:
+        /// Waits to finish a grace period and clears the buffer of current thread
+        /**
+            After grace period finished the function frees all retired pointer
+            from the buffer of current thread and from the buffers of detached threads.
+        */
+        static void synchronize()
+        {
+            rcu_implementation::instance()->synchronize();
+        }
+
+        /// Waits to finish an expedited grace period
+        /**
+            Like \ref synchronize but trades CPU for latency, see \ref cds_urcu_expedited "expedited grace periods".
+            The cost is reported by \ref statistics.
+        */
+        static void synchronize_expedited()
+        {
+            rcu_implementation::instance()->synchronize_expedited();
+        }
+
+        /// Calls \p f after the end of a grace period without blocking the caller
+        /**
+            See \ref cds_urcu_call_rcu "deferred callbacks". \p f must not throw.
+        */
+        template <typename Func>
+        static void call_rcu( Func f )
+        {
+            rcu_implementation::instance()->call_rcu( std::function< void() >( std::move( f )));
+        }
+
+        /// Calls \p f after the end of a grace period and returns the future of the call
+        /**
+            See \ref cds_urcu_call_rcu "deferred callbacks". The exception thrown by \p f
+            is stored in the returned future.
+        */
+        template <typename Func>
+        static std::future<void> call_rcu_future( Func f )
+        {
+            return rcu_implementation::instance()->call_rcu_future( std::function< void() >( std::move( f )));
+        }
+
+        /// Returns grace period statistics
+        /**
+            See \p cds::urcu::gp_stat.
+        */
+        static void statistics( gp_stat& st )
+        {
+            rcu_implementation::instance()->statistics( st );
+        }
+
+        /// Places retired pointer <\p p, \p pFunc> to the buffer of current thread
+        /**
+            If the buffer is full, the thread waits for a grace period and frees the buffer.
+        */
+        template <typename T>
+        static void retire_ptr( T * p, free_retired_ptr_func pFunc )
+        {
+            retired_ptr rp( p, pFunc );
+            retire_ptr( rp );
+        }
+
+        /// Places retired pointer \p p with \p Disposer to the buffer of current thread
+        /**
+            If the buffer is full, the thread waits for a grace period and frees the buffer.
+        */
+        template <typename Disposer, typename T>
+        static void retire_ptr( T * p )
+        {
+            retire_ptr( p, cds::details::static_functor<Disposer, T>::call );
+        }
+
+        /// Places retired pointer \p p to the buffer of current thread
+        /**
+            If the buffer is full, the thread waits for a grace period and frees the buffer.
+        */
+        static void retire_ptr( retired_ptr& p )
+        {
+            rcu_implementation::instance()->retire_ptr(p);
+        }
+
+        /// Frees chain [ \p itFirst, \p itLast) in one synchronization cycle
+        template <typename ForwardIterator>
+        static void batch_retire( ForwardIterator itFirst, ForwardIterator itLast )
+        {
+            rcu_implementation::instance()->batch_retire( itFirst, itLast );
+        }
+
+        /// Retires the pointer chain until \p Func returns \p nullptr retired pointer
+        template <typename Func>
+        static void batch_retire( Func e )
+        {
+            rcu_implementation::instance()->batch_retire( e );
+        }
+
+        /// Acquires access lock (so called RCU reader-side lock)
+        /**
+            For safety reasons, it is better to use \ref scoped_lock class for locking/unlocking
+        */
+        static void access_lock()
+        {
+            thread_gc::access_lock();
+        }
+
+        /// Releases access lock (so called RCU reader-side lock)
+        /**
+            For safety reasons, it is better to use \ref scoped_lock class for locking/unlocking
+        */
+        static void access_unlock()
+        {
+            thread_gc::access_unlock();
+        }
+
+        /// Returns the threshold of the thread buffer
+        static size_t capacity()
+        {
+            return rcu_implementation::instance()->capacity();
+        }
+
+        /// Returns internal statistics of the RCU singleton
+        static stat const& internal_statistics()
+        {
+            return rcu_implementation::instance()->internal_statistics();
+        }
+
+        /// Checks if the thread is inside read-side critical section (i.e. the lock is acquired)
+        /**
+            Usually, this function is used internally to be convinced
+            that subsequent remove action is not lead to a deadlock.
+        */
+        static bool is_locked()
+        {
+            return thread_gc::is_locked();
+        }
+
+        /// Forces retired object removal
+        /**
+            This function calls \ref synchronize
+        */
+        static void force_dispose()
+        {
+            synchronize();
+        }
+    };
+
+    //@cond
+    template<>
+    class gc< general_local_buffered_stripped >: public gc< general_local_buffered<>>
+    {};
+    //@endcond
+
+}} // namespace cds::urcu
+
+#endif // #ifndef CDSLIB_URCU_GENERAL_LOCAL_BUFFERED_H
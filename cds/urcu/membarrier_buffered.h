@@ -0,0 +1,228 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSLIB_URCU_MEMBARRIER_BUFFERED_H
+#define CDSLIB_URCU_MEMBARRIER_BUFFERED_H
+
+#include <cds/urcu/details/mb_buffered.h>
+#ifdef CDS_URCU_MEMBARRIER_ENABLED
+
+namespace cds { namespace urcu {
+
+    /// User-space membarrier-based RCU with deferred buffered reclamation
+    /** @anchor cds_urcu_membarrier_buffered_gc
+
+        This is a wrapper around \p membarrier_buffered class.
+
+        Template arguments:
+        - \p Buffer - lock-free queue or lock-free bounded queue.
+            Default is \p cds::container::VyukovMPMCCycleQueue< retired_ptr >
+        - \p Lock - mutex type, default is \p std::mutex
+        - \p Backoff - back-off schema, default is \p cds::backoff::Default
+    */
+    template <
+#ifdef CDS_DOXGEN_INVOKED
+        class Buffer = cds::container::VyukovMPMCCycleQueue< retired_ptr >
+        ,class Lock = std::mutex
+        ,class Backoff = cds::backoff::Default
+#else
+        class Buffer
+       ,class Lock
+       ,class Backoff
+#endif
+    >
+    class gc< membarrier_buffered< Buffer, Lock, Backoff > >: public details::gc_common
+    {
+    public:
+        typedef membarrier_buffered< Buffer, Lock, Backoff >  rcu_implementation   ;    ///< Wrapped URCU implementation
+
+        typedef typename rcu_implementation::rcu_tag     rcu_tag     ;   ///< URCU tag
+        typedef typename rcu_implementation::thread_gc   thread_gc   ;   ///< Thread-side RCU part
+        typedef typename rcu_implementation::scoped_lock scoped_lock ;   ///< Access lock class
+
+        using details::gc_common::atomic_marked_ptr;
+
+    public:
+        /// Creates URCU \p %membarrier_buffered singleton.
+        /**
+            The \p nBufferCapacity parameter defines RCU threshold.
+        */
+        gc( size_t nBufferCapacity = 256 )
+        {
+            rcu_implementation::Construct( nBufferCapacity );
+        }
+
+        /// Destroys URCU \p %membarrier_buffered singleton
+        ~gc()
+        {
+            rcu_implementation::Destruct( true );
+        }
+
+    public:
+        /// Waits to finish a grace period and clears the buffer
+        /**
+            After grace period finished the function frees all retired pointer
+            from internal buffer.
+        */
+        static void synchronize()
+        {
+            rcu_implementation::instance()->synchronize();
+        }
+
+        /// Waits to finish a grace period
+        /**
+            The flavor has no expedited mode, the function is the same as \ref synchronize.
+            It is provided for uniformity with \ref cds_urcu_expedited "general-purpose RCU".
+        */
+        static void synchronize_expedited()
+        {
+            rcu_implementation::instance()->synchronize_expedited();
+        }
+
+        /// Calls \p f after the end of a grace period without blocking the caller
+        /**
+            See \ref cds_urcu_call_rcu "deferred callbacks". \p f must not throw.
+        */
+        template <typename Func>
+        static void call_rcu( Func f )
+        {
+            rcu_implementation::instance()->call_rcu( std::function< void() >( std::move( f )));
+        }
+
+        /// Calls \p f after the end of a grace period and returns the future of the call
+        /**
+            See \ref cds_urcu_call_rcu "deferred callbacks". The exception thrown by \p f
+            is stored in the returned future.
+        */
+        template <typename Func>
+        static std::future<void> call_rcu_future( Func f )
+        {
+            return rcu_implementation::instance()->call_rcu_future( std::function< void() >( std::move( f )));
+        }
+
+        /// Places retired pointer <\p p, \p pFunc> to internal buffer
+        /**
+            If the buffer is full, \ref synchronize function is invoked.
+        */
+        template <typename T>
+        static void retire_ptr( T* p, free_retired_ptr_func pFunc )
+        {
+            retired_ptr rp( p, pFunc );
+            retire_ptr( rp );
+        }
+
+        /// Places retired pointer \p p with \p Disposer to internal buffer
+        /**
+            If the buffer is full, \ref synchronize function is invoked.
+        */
+        template <typename Disposer, typename T>
+        static void retire_ptr( T* p )
+        {
+            retire_ptr( p, cds::details::static_functor<Disposer, T>::call );
+        }
+
+        /// Places retired pointer \p p to internal buffer
+        /**
+            If the buffer is full, \ref synchronize function is invoked.
+        */
+        static void retire_ptr( retired_ptr& p )
+        {
+            rcu_implementation::instance()->retire_ptr(p);
+        }
+
+        /// Frees chain [ \p itFirst, \p itLast) in one synchronization cycle
+        template <typename ForwardIterator>
+        static void batch_retire( ForwardIterator itFirst, ForwardIterator itLast )
+        {
+            rcu_implementation::instance()->batch_retire( itFirst, itLast );
+        }
+
+        /// Retires the pointer chain until \p Func returns \p nullptr retired pointer
+        template <typename Func>
+        static void batch_retire( Func e )
+        {
+            rcu_implementation::instance()->batch_retire( e );
+        }
+
+        /// Acquires access lock (so called RCU reader-side lock)
+        /**
+            For safety reasons, it is better to use \ref scoped_lock class for locking/unlocking
+        */
+        static void access_lock()
+        {
+            thread_gc::access_lock();
+        }
+
+        /// Releases access lock (so called RCU reader-side lock)
+        /**
+            For safety reasons, it is better to use \ref scoped_lock class for locking/unlocking
+        */
+        static void access_unlock()
+        {
+            thread_gc::access_unlock();
+        }
+
+        /// Returns the threshold of internal buffer
+        static size_t capacity()
+        {
+            return rcu_implementation::instance()->capacity();
+        }
+
+        /// Checks if the thread is inside read-side critical section (i.e. the lock is acquired)
+        /**
+            Usually, this function is used internally to be convinced
+            that subsequent remove action is not lead to a deadlock.
+        */
+        static bool is_locked()
+        {
+            return thread_gc::is_locked();
+        }
+
+        /// Forces retired object removal
+        /**
+            This function calls \ref synchronize
+        */
+        static void force_dispose()
+        {
+            synchronize();
+        }
+    };
+
+    //@cond
+    template<>
+    class gc< membarrier_buffered_stripped >: public gc< membarrier_buffered<>>
+    {};
+    //@endcond
+
+
+}} // namespace cds::urcu
+
+#endif // #ifdef CDS_URCU_MEMBARRIER_ENABLED
+#endif // #ifndef CDSLIB_URCU_MEMBARRIER_BUFFERED_H
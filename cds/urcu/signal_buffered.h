@@ -98,6 +98,37 @@ namespace cds { namespace urcu {
             rcu_implementation::instance()->synchronize();
         }
 
+        /// Waits to finish a grace period
+        /**
+            The flavor has no expedited mode, the function is the same as \ref synchronize.
+            It is provided for uniformity with \ref cds_urcu_expedited "general-purpose RCU".
+        */
+        static void synchronize_expedited()
+        {
+            rcu_implementation::instance()->synchronize_expedited();
+        }
+
+        /// Calls \p f after the end of a grace period without blocking the caller
+        /**
+            See \ref cds_urcu_call_rcu "deferred callbacks". \p f must not throw.
+        */
+        template <typename Func>
+        static void call_rcu( Func f )
+        {
+            rcu_implementation::instance()->call_rcu( std::function< void() >( std::move( f )));
+        }
+
+        /// Calls \p f after the end of a grace period and returns the future of the call
+        /**
+            See \ref cds_urcu_call_rcu "deferred callbacks". The exception thrown by \p f
+            is stored in the returned future.
+        */
+        template <typename Func>
+        static std::future<void> call_rcu_future( Func f )
+        {
+            return rcu_implementation::instance()->call_rcu_future( std::function< void() >( std::move( f )));
+        }
+
         /// Places retired pointer <\p p, \p pFunc> to internal buffer
         /**
             If the buffer is full, \ref synchronize function is invoked.
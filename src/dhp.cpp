@@ -30,9 +30,13 @@
 
 #include <algorithm>
 #include <vector>
+#include <mutex>
 
 #include <cds/gc/dhp.h>
+#include <cds/gc/details/hp_reclaimer.h>
+#include <cds/gc/details/hp_hazard_set.h>
 #include <cds/os/thread.h>
+#include <cds/algo/backoff_strategy.h>
 
 namespace cds { namespace gc { namespace dhp {
 
@@ -49,6 +53,7 @@ namespace cds { namespace gc { namespace dhp {
 
         struct defaults {
             static size_t const c_extended_guard_block_size = 16;
+            static size_t const c_nThreadListSlack = 16;   // free records kept in the thread list for fast reuse
         };
 
         void* ( *s_alloc_memory )( size_t size ) = default_alloc_memory;
@@ -74,9 +79,24 @@ namespace cds { namespace gc { namespace dhp {
             {
                 s_free_memory( reinterpret_cast<void*>( p ));
             }
+
+            template <class U>
+            bool operator ==( allocator<U> const& ) const
+            {
+                return true;
+            }
+
+            template <class U>
+            bool operator !=( allocator<U> const& ) const
+            {
+                return false;
+            }
         };
 
         stat s_postmortem_stat;
+
+        // max back-off count for budget_throttle policy
+        static const unsigned c_nBudgetThrottleCount = 64;
     } // namespace
 
     /*static*/ CDS_EXPORT_API smr* smr::instance_ = nullptr;
@@ -146,17 +166,33 @@ namespace cds { namespace gc { namespace dhp {
         atomics::atomic<thread_record*>     m_pNextNode; ///< next hazard ptr record in list
         atomics::atomic<cds::OS::ThreadId>  m_idOwner;   ///< Owner thread id; 0 - the record is free (not owned)
         atomics::atomic<bool>               m_bFree;     ///< true if record is free (not owned)
+        thread_record*                      m_pNextFree; ///< next record in smr::free_records_ list
 
-        thread_record( guard* guards, size_t guard_count )
-            : thread_data( guards, guard_count )
+        thread_record( guard* guards, size_t guard_count, bool asymmetric_fence )
+            : thread_data( guards, guard_count, asymmetric_fence )
             , m_pNextNode( nullptr )
             , m_idOwner( cds::OS::c_NullThreadId )
             , m_bFree( false )
+            , m_pNextFree( nullptr )
+        {}
+    };
+
+    struct smr::reclaimer: public hp::common::reclaimer_thread< smr, allocator<retired_ptr>>
+    {
+        explicit reclaimer( smr& s )
+            : hp::common::reclaimer_thread< smr, allocator<retired_ptr>>( s )
         {}
     };
 
     /*static*/ CDS_EXPORT_API thread_data* smr::tls()
     {
+        // The thread attached to the Manager is attached to the GC on its first use of the GC.
+        // A thread not attached to the Manager would never be detached, so it gets no record
+        if ( cds_unlikely( tls_ == nullptr ) && cds::threading::Manager::isThreadAttached()
+            && cds::threading::Manager::thread_data()->is_attached())
+        {
+            attach_thread();
+        }
         assert( tls_ != nullptr );
         return tls_;
     }
@@ -173,10 +209,10 @@ namespace cds { namespace gc { namespace dhp {
         s_free_memory = free_func;
     }
 
-    /*static*/ CDS_EXPORT_API void smr::construct( size_t nInitialHazardPtrCount )
+    /*static*/ CDS_EXPORT_API void smr::construct( size_t nInitialHazardPtrCount, bool bAsymmetricFence, bool bBackgroundReclaim )
     {
         if ( !instance_ ) {
-            instance_ = new( s_alloc_memory( sizeof( smr ))) smr( nInitialHazardPtrCount );
+            instance_ = new( s_alloc_memory( sizeof( smr ))) smr( nInitialHazardPtrCount, bAsymmetricFence, bBackgroundReclaim );
         }
     }
 
@@ -190,13 +226,25 @@ namespace cds { namespace gc { namespace dhp {
             s_free_memory( instance_ );
             instance_ = nullptr;
         }
+        // The record of the current thread is freed with the GC
+        tls_ = nullptr;
     }
 
-    CDS_EXPORT_API smr::smr( size_t nInitialHazardPtrCount )
+    CDS_EXPORT_API smr::smr( size_t nInitialHazardPtrCount, bool bAsymmetricFence, bool bBackgroundReclaim )
         : initial_hazard_count_( nInitialHazardPtrCount < 4 ? 16 : nInitialHazardPtrCount )
+        , asymmetric_fence_( bAsymmetricFence && cds::OS::membarrier::register_expedited())
+        , reclaimer_( nullptr )
+        , reclaimer_retained_( 0 )
         , last_plist_size_( initial_hazard_count_ * 64 )
     {
         thread_list_.store( nullptr, atomics::memory_order_release );
+        thread_list_count_.store( 0, atomics::memory_order_relaxed );
+        attached_count_.store( 0, atomics::memory_order_relaxed );
+        free_records_ = nullptr;
+        compact_count_ = 0;
+
+        if ( bBackgroundReclaim )
+            reclaimer_ = new( s_alloc_memory( sizeof( reclaimer ))) reclaimer( *this );
     }
 
     CDS_EXPORT_API smr::~smr()
@@ -204,8 +252,24 @@ namespace cds { namespace gc { namespace dhp {
         CDS_DEBUG_ONLY( const cds::OS::ThreadId nullThreadId = cds::OS::c_NullThreadId; )
         CDS_DEBUG_ONLY( const cds::OS::ThreadId mainThreadId = cds::OS::get_current_thread_id(); )
 
+        reclaimer::retired_vector leftover;
+        if ( reclaimer_ )
+            reclaimer_->stop( leftover );
+
         CDS_HPSTAT( statistics( s_postmortem_stat ));
 
+        if ( reclaimer_ ) {
+            for ( retired_ptr& p : leftover ) {
+                p.free();
+                CDS_HPSTAT( ++s_postmortem_stat.free_count );
+            }
+            leftover.clear();
+
+            reclaimer_->~reclaimer();
+            s_free_memory( reclaimer_ );
+            reclaimer_ = nullptr;
+        }
+
         thread_record* pHead = thread_list_.load( atomics::memory_order_relaxed );
         thread_list_.store( nullptr, atomics::memory_order_release );
 
@@ -237,6 +301,13 @@ namespace cds { namespace gc { namespace dhp {
             hprec->m_bFree.store( true, atomics::memory_order_relaxed );
             destroy_thread_data( hprec );
         }
+
+        // The records unlinked by compact_thread_list() have no retired pointers
+        for ( thread_record* hprec = free_records_; hprec; hprec = pNext ) {
+            pNext = hprec->m_pNextFree;
+            destroy_thread_data( hprec );
+        }
+        free_records_ = nullptr;
     }
 
     /*static*/ CDS_EXPORT_API void smr::attach_thread()
@@ -289,7 +360,7 @@ namespace cds { namespace gc { namespace dhp {
 
         char* mem = reinterpret_cast<char*>( s_alloc_memory( sizeof( thread_record ) + guard_array_size ));
         return new( mem ) thread_record(
-            reinterpret_cast<guard*>( mem + sizeof( thread_record )), initial_hazard_count_
+            reinterpret_cast<guard*>( mem + sizeof( thread_record )), initial_hazard_count_, asymmetric_fence_
         );
     }
 
@@ -316,16 +387,34 @@ namespace cds { namespace gc { namespace dhp {
         }
 
         if ( !hprec ) {
-            // No HP records available for reuse
-            // Allocate and push a new HP record
-            hprec = create_thread_data();
+            // Then try to reuse a record unlinked by compact_thread_list()
+            {
+                std::unique_lock< cds::sync::spin > lock( thread_list_lock_ );
+                hprec = free_records_;
+                if ( hprec )
+                    free_records_ = hprec->m_pNextFree;
+            }
+
+            if ( hprec ) {
+                hprec->m_pNextFree = nullptr;
+                hprec->m_bFree.store( false, atomics::memory_order_relaxed );
+            }
+            else {
+                // No HP records available for reuse
+                // Allocate a new HP record
+                hprec = create_thread_data();
+            }
             hprec->m_idOwner.store( curThreadId, atomics::memory_order_relaxed );
 
+            // Push the record to the thread list
             thread_record* pOldHead = thread_list_.load( atomics::memory_order_acquire );
             do {
                 hprec->m_pNextNode.store( pOldHead, atomics::memory_order_release );
             } while ( !thread_list_.compare_exchange_weak( pOldHead, hprec, atomics::memory_order_release, atomics::memory_order_acquire ));
+
+            thread_list_count_.fetch_add( 1, atomics::memory_order_relaxed );
         }
+        attached_count_.fetch_add( 1, atomics::memory_order_relaxed );
 
         hprec->hazards_.init();
         hprec->retired_.init();
@@ -361,10 +450,67 @@ namespace cds { namespace gc { namespace dhp {
         }
 
         pRec->m_idOwner.store( cds::OS::c_NullThreadId, atomics::memory_order_release );
+
+        // Compact the thread list if it contains much more free records than attached threads
+        size_t const nAttached = attached_count_.fetch_sub( 1, atomics::memory_order_relaxed ) - 1;
+        size_t const nRecords = thread_list_count_.load( atomics::memory_order_relaxed );
+        if ( nRecords > nAttached && nRecords - nAttached > std::max( nAttached, static_cast<size_t>( defaults::c_nThreadListSlack )))
+            compact_thread_list();
+    }
+
+    CDS_EXPORT_API void smr::compact_thread_list()
+    {
+        const cds::OS::ThreadId nullThreadId = cds::OS::c_NullThreadId;
+        const cds::OS::ThreadId curThreadId = cds::OS::get_current_thread_id();
+
+        // Only one thread unlinks the records; the other threads can push new records to the head concurrently.
+        // An unlinked record is never freed until the SMR destruction and keeps its m_pNextNode,
+        // so the thread that walks the list and stands on the record continues with the rest of the list.
+        std::unique_lock< cds::sync::spin > lock( thread_list_lock_ );
+
+        thread_record* pPrev = nullptr;
+        thread_record* hprec = thread_list_.load( atomics::memory_order_acquire );
+        while ( hprec ) {
+            thread_record* pNext = hprec->m_pNextNode.load( atomics::memory_order_acquire );
+
+            // Owns hprec if it is free
+            cds::OS::ThreadId thId = nullThreadId;
+            if ( hprec->m_idOwner.compare_exchange_strong( thId, curThreadId, atomics::memory_order_acquire, atomics::memory_order_relaxed )) {
+                // The record with retired pointers must remain in the list to be adopted by help_scan()
+                bool bUnlinked = false;
+                if ( hprec->m_bFree.load( atomics::memory_order_acquire )) {
+                    if ( pPrev ) {
+                        pPrev->m_pNextNode.store( pNext, atomics::memory_order_release );
+                        bUnlinked = true;
+                    }
+                    else {
+                        // A new record may be pushed to the head concurrently, keep hprec in that case
+                        thread_record* pHead = hprec;
+                        bUnlinked = thread_list_.compare_exchange_strong( pHead, pNext, atomics::memory_order_acq_rel, atomics::memory_order_relaxed );
+                    }
+                }
+
+                if ( bUnlinked ) {
+                    // The unlinked record remains owned, so nobody can catch it in the list
+                    hprec->m_pNextFree = free_records_;
+                    free_records_ = hprec;
+                    ++compact_count_;
+                    thread_list_count_.fetch_sub( 1, atomics::memory_order_relaxed );
+                    hprec = pNext;
+                    continue;
+                }
+
+                hprec->m_idOwner.store( nullThreadId, atomics::memory_order_release );
+            }
+
+            pPrev = hprec;
+            hprec = pNext;
+        }
     }
 
     namespace {
         typedef std::vector<void*, allocator<void*>> hp_vector;
+        typedef hp::common::hazard_set< allocator<uintptr_t>> hp_set;
 
         inline void copy_hazards( hp_vector& vect, guard const* arr, size_t size )
         {
@@ -375,17 +521,23 @@ namespace cds { namespace gc { namespace dhp {
             }
         }
 
-        inline size_t retire_data( hp_vector const& plist, retired_array& stg, retired_block* block, size_t block_size )
+        inline void make_hazard_set( hp_set& set, hp_vector const& plist )
+        {
+            for ( void* hp : plist )
+                set.insert( hp );
+        }
+
+        inline size_t retire_data( hp_set const& hazards, retired_array& stg, retired_block* block, size_t block_size )
         {
-            auto hp_begin = plist.begin();
-            auto hp_end = plist.end();
             size_t count = 0;
 
+            // repush() may overwrite the block, so unguarded pointers are collected to a local buffer
+            cds::gc::details::retired_free_buffer< retired_ptr > to_free;
             for ( retired_ptr* p = block->first(), *end = p + block_size; p != end; ++p ) {
-                if ( cds_unlikely( std::binary_search( hp_begin, hp_end, p->m_p )))
+                if ( cds_unlikely( hazards.contains( p->m_p )))
                     stg.repush( p );
                 else {
-                    p->free();
+                    to_free.push( *p );
                     ++count;
                 }
             }
@@ -399,12 +551,29 @@ namespace cds { namespace gc { namespace dhp {
     {
         thread_record* pRec = static_cast<thread_record*>( pThreadRec );
 
+        do_scan( pRec );
+
+        if ( budget_.exceeded())
+            apply_retired_budget( pRec );
+    }
+
+    CDS_EXPORT_API void smr::do_scan( thread_record* pRec )
+    {
         CDS_HPSTAT( ++pRec->scan_call_count_ );
 
+        if ( reclaimer_ ) {
+            background_scan( pRec );
+            return;
+        }
+
         hp_vector plist;
         size_t plist_size = last_plist_size_.load( std::memory_order_relaxed );
         plist.reserve( plist_size );
 
+        // Asymmetric fence: force the readers' hazard pointer stores to be visible
+        if ( asymmetric_fence_ )
+            cds::OS::membarrier::heavy();
+
         // Stage 1: Scan HP list and insert non-null values in plist
         thread_record* pNode = thread_list_.load( atomics::memory_order_acquire );
         while ( pNode ) {
@@ -426,12 +595,14 @@ namespace cds { namespace gc { namespace dhp {
         if ( plist.size() > plist_size )
             last_plist_size_.compare_exchange_weak( plist_size, plist.size(), std::memory_order_relaxed, std::memory_order_relaxed );
 
-        // Sort plist to simplify search in
-        std::sort( plist.begin(), plist.end());
+        // Build hash set of hazard pointers to simplify search in
+        hp_set hazards( plist.size());
+        make_hazard_set( hazards, plist );
 
-        // Stage 2: Search plist
+        // Stage 2: Search hazard set
         size_t free_count = 0;
         size_t retired_count = 0;
+        size_t scanned_count = 0;
         retired_block* last_block = pRec->retired_.current_block_;
         retired_ptr*   last_block_cell = pRec->retired_.current_cell_;
 
@@ -443,18 +614,127 @@ namespace cds { namespace gc { namespace dhp {
             size_t const size = end_block ? last_block_cell - block->first() : retired_block::c_capacity;
 
             retired_count += retired_block::c_capacity;
-            free_count += retire_data( plist, pRec->retired_, block, size );
+            scanned_count += size;
+            free_count += retire_data( hazards, pRec->retired_, block, size );
 
             if ( end_block )
                 break;
         }
         CDS_HPSTAT( pRec->free_call_count_ += free_count );
+        budget_.update( pRec->retained_count_, scanned_count - free_count );
 
         // If the count of freed elements is too small, increase retired array
         if ( free_count < retired_count / 4 && last_block == pRec->retired_.list_tail_ && last_block_cell == last_block->last())
             pRec->retired_.extend();
     }
 
+    CDS_EXPORT_API void smr::background_scan( thread_record* pRec )
+    {
+        retired_array& retired = pRec->retired_;
+
+        for ( retired_block* block = retired.list_head_; block; block = block->next_ ) {
+            bool const end_block = block == retired.current_block_;
+            reclaimer_->push( block->first(), end_block ? retired.current_cell_ : block->last());
+
+            if ( end_block )
+                break;
+        }
+
+        retired.current_block_ = retired.list_head_;
+        retired.current_cell_ = retired.current_block_->first();
+        budget_.update( pRec->retained_count_, 0 );
+    }
+
+    CDS_EXPORT_API void smr::apply_retired_budget( thread_record* pRec )
+    {
+        // help_scan() calls scan() that can call us again
+        if ( pRec->in_budget_policy_ )
+            return;
+        pRec->in_budget_policy_ = true;
+
+        switch ( budget_.on_exceeded()) {
+        case budget_help_scan:
+            help_scan( pRec );
+            break;
+        case budget_throttle:
+            {
+                cds::backoff::exponential<> bkoff;
+                for ( unsigned i = 0; i < c_nBudgetThrottleCount && budget_.exceeded(); ++i ) {
+                    bkoff();
+                    if ( reclaimer_ )
+                        reclaimer_->flush();
+                    else
+                        do_scan( pRec );
+                }
+            }
+            break;
+        default:
+            // budget_callback: the callback has been called by on_exceeded()
+            break;
+        }
+
+        pRec->in_budget_policy_ = false;
+    }
+
+    CDS_EXPORT_API void smr::wait_reclaim()
+    {
+        if ( reclaimer_ )
+            reclaimer_->flush();
+    }
+
+    CDS_EXPORT_API size_t smr::reclaim( retired_ptr* first, retired_ptr* last )
+    {
+        // The reclaimer thread is not attached to the SMR, so it has no thread_data to sync() with
+        atomics::atomic_thread_fence( atomics::memory_order_seq_cst );
+
+        hp_vector plist;
+        size_t plist_size = last_plist_size_.load( std::memory_order_relaxed );
+        plist.reserve( plist_size );
+
+        // Asymmetric fence: force the readers' hazard pointer stores to be visible
+        if ( asymmetric_fence_ )
+            cds::OS::membarrier::heavy();
+
+        // Stage 1: Scan HP list and insert non-null values in plist
+        thread_record* pNode = thread_list_.load( atomics::memory_order_acquire );
+        while ( pNode ) {
+            if ( pNode->m_idOwner.load( std::memory_order_relaxed ) != cds::OS::c_NullThreadId ) {
+                copy_hazards( plist, pNode->hazards_.array_, pNode->hazards_.initial_capacity_ );
+
+                for ( guard_block* block = pNode->hazards_.extended_list_.load( atomics::memory_order_acquire );
+                    block;
+                    block = block->next_block_.load( atomics::memory_order_acquire ))
+                {
+                    copy_hazards( plist, block->first(), defaults::c_extended_guard_block_size );
+                }
+            }
+
+            pNode = pNode->m_pNextNode.load( atomics::memory_order_relaxed );
+        }
+
+        // Store plist size for next scan() call (vector reallocation optimization)
+        if ( plist.size() > plist_size )
+            last_plist_size_.compare_exchange_weak( plist_size, plist.size(), std::memory_order_relaxed, std::memory_order_relaxed );
+
+        hp_set hazards( plist.size());
+        make_hazard_set( hazards, plist );
+
+        // Stage 2: free unguarded retired pointers, move guarded ones to the head of the range
+        retired_ptr* insert_pos = first;
+        for ( retired_ptr* it = first; it != last; ++it ) {
+            if ( hazards.contains( it->m_p )) {
+                if ( insert_pos != it )
+                    std::swap( *insert_pos, *it );
+                ++insert_pos;
+            }
+        }
+        cds::gc::details::free_retired( insert_pos, last );
+
+        size_t const nGuarded = static_cast<size_t>( insert_pos - first );
+        budget_.update( reclaimer_retained_, nGuarded );
+        return nGuarded;
+    }
+
     CDS_EXPORT_API void smr::help_scan( thread_data* pThis )
     {
         assert( static_cast<thread_record*>( pThis )->m_idOwner.load( atomics::memory_order_relaxed ) == cds::OS::get_current_thread_id());
@@ -504,6 +784,7 @@ namespace cds { namespace gc { namespace dhp {
             }
 
             src.fini();
+            budget_.update( hprec->retained_count_, 0 );
             hprec->m_bFree.store( true, atomics::memory_order_relaxed );
             hprec->m_idOwner.store( nullThreadId, atomics::memory_order_release );
         }
@@ -530,11 +811,40 @@ namespace cds { namespace gc { namespace dhp {
             CDS_TSAN_ANNOTATE_IGNORE_READS_END;
         }
 
+        {
+            // The counters of the unlinked records
+            std::unique_lock< cds::sync::spin > lock( thread_list_lock_ );
+            for ( thread_record* hprec = free_records_; hprec; hprec = hprec->m_pNextFree ) {
+                ++st.thread_rec_count;
+                st.guard_allocated      += hprec->hazards_.alloc_guard_count_;
+                st.guard_freed          += hprec->hazards_.free_guard_count_;
+                st.hp_extend_count      += hprec->hazards_.extend_call_count_;
+                st.retired_count        += hprec->retired_.retire_call_count_;
+                st.retired_extend_count += hprec->retired_.extend_call_count_;
+                st.free_count           += hprec->free_call_count_;
+                st.scan_count           += hprec->scan_call_count_;
+                st.help_scan_count      += hprec->help_scan_call_count_;
+            }
+        }
+
+        if ( reclaimer_ ) {
+            st.reclaim_count += reclaimer_->pass_count();
+            st.free_count    += reclaimer_->free_count();
+        }
+
         CDS_TSAN_ANNOTATE_IGNORE_READS_BEGIN;
         st.hp_block_count = hp_allocator_.block_allocated_.load( atomics::memory_order_relaxed );
         st.retired_block_count = retired_allocator_.block_allocated_.load( atomics::memory_order_relaxed );
         CDS_TSAN_ANNOTATE_IGNORE_READS_END;
 #   endif
+
+        st.retained_count        = budget_.retained();
+        st.budget_exceeded_count = budget_.exceeded_count();
+        st.thread_list_count     = thread_list_count_.load( atomics::memory_order_relaxed );
+        {
+            std::unique_lock< cds::sync::spin > lock( thread_list_lock_ );
+            st.thread_rec_compact_count = compact_count_;
+        }
     }
 
 
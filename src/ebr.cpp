@@ -0,0 +1,443 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+
+#include <cds/gc/ebr.h>
+#include <cds/os/thread.h>
+
+namespace cds { namespace gc { namespace ebr {
+
+    namespace {
+        void * default_alloc_memory( size_t size )
+        {
+            return new uintptr_t[( size + sizeof( uintptr_t ) - 1 ) / sizeof( uintptr_t) ];
+        }
+
+        void default_free_memory( void* p )
+        {
+            delete[] reinterpret_cast<uintptr_t*>( p );
+        }
+
+        void* ( *s_alloc_memory )( size_t size ) = default_alloc_memory;
+        void ( *s_free_memory )( void* p ) = default_free_memory;
+
+        struct defaults {
+            static const size_t c_nGuardCount = 72;    // enough for the skip-list of max height 32
+            static const size_t c_nBagCapacity = 256;
+            static const size_t c_nEpochFreq = 64;
+        };
+
+        stat s_postmortem_stat;
+    } // namespace
+
+    /*static*/ CDS_EXPORT_API smr* smr::instance_ = nullptr;
+    thread_local thread_data* tls_ = nullptr;
+
+    /*static*/ CDS_EXPORT_API thread_data* smr::tls()
+    {
+        // The thread attached to the Manager is attached to the GC on its first use of the GC.
+        // A thread not attached to the Manager would never be detached, so it gets no record
+        if ( cds_unlikely( tls_ == nullptr ) && cds::threading::Manager::isThreadAttached()
+            && cds::threading::Manager::thread_data()->is_attached())
+        {
+            attach_thread();
+        }
+        assert( tls_ != nullptr );
+        return tls_;
+    }
+
+    struct smr::thread_record: thread_data
+    {
+        atomics::atomic<thread_record*>     m_pNextNode; ///< next EBR record in list
+        atomics::atomic<cds::OS::ThreadId>  m_idOwner;   ///< Owner thread id; 0 - the record is free (not owned)
+        atomics::atomic<bool>               m_bFree;     ///< true if record is free (not owned)
+
+        thread_record( guard* guards, size_t guard_count, cds::gc::details::retired_ptr* bag_arr, size_t bag_capacity, atomics::atomic<epoch_t>& global_epoch, size_t epoch_freq )
+            : thread_data( guards, guard_count, bag_arr, bag_capacity, global_epoch, epoch_freq )
+            , m_pNextNode( nullptr )
+            , m_idOwner( cds::OS::c_NullThreadId )
+            , m_bFree( false )
+        {}
+    };
+
+    /*static*/ CDS_EXPORT_API void smr::set_memory_allocator(
+        void* ( *alloc_func )( size_t size ),
+        void( *free_func )( void * p )
+    )
+    {
+        // The memory allocation functions may be set BEFORE initializing EBR SMR!!!
+        assert( instance_ == nullptr );
+
+        s_alloc_memory = alloc_func;
+        s_free_memory = free_func;
+    }
+
+
+    /*static*/ CDS_EXPORT_API void smr::construct( size_t nGuardCount, size_t nBagCapacity, size_t nEpochFreq )
+    {
+        if ( !instance_ ) {
+            instance_ = new( s_alloc_memory(sizeof(smr))) smr( nGuardCount, nBagCapacity, nEpochFreq );
+        }
+    }
+
+    /*static*/ CDS_EXPORT_API void smr::destruct( bool bDetachAll )
+    {
+        if ( instance_ ) {
+            if ( bDetachAll )
+                instance_->detach_all_thread();
+
+            instance_->~smr();
+            s_free_memory( instance_ );
+            instance_ = nullptr;
+        }
+        // The record of the current thread is freed with the GC
+        tls_ = nullptr;
+    }
+
+    CDS_EXPORT_API smr::smr( size_t nGuardCount, size_t nBagCapacity, size_t nEpochFreq )
+        : guard_count_( nGuardCount == 0 ? defaults::c_nGuardCount : nGuardCount )
+        , bag_capacity_( nBagCapacity == 0 ? defaults::c_nBagCapacity : nBagCapacity )
+        , epoch_freq_( nEpochFreq == 0 ? defaults::c_nEpochFreq : nEpochFreq )
+        , global_epoch_( c_quiescent + 1 )
+    {
+        thread_list_.store( nullptr, atomics::memory_order_release );
+    }
+
+    CDS_EXPORT_API smr::~smr()
+    {
+        CDS_DEBUG_ONLY( const cds::OS::ThreadId nullThreadId = cds::OS::c_NullThreadId; )
+        CDS_DEBUG_ONLY( const cds::OS::ThreadId mainThreadId = cds::OS::get_current_thread_id();)
+
+        CDS_EBRSTAT( statistics( s_postmortem_stat ));
+
+        thread_record* pHead = thread_list_.load( atomics::memory_order_relaxed );
+        thread_list_.store( nullptr, atomics::memory_order_release );
+
+        thread_record* pNext = nullptr;
+        for ( thread_record* rec = pHead; rec; rec = pNext )
+        {
+            assert( rec->m_idOwner.load( atomics::memory_order_relaxed ) == nullThreadId
+                || rec->m_idOwner.load( atomics::memory_order_relaxed ) == mainThreadId );
+
+            // No thread is alive, all limbo bags can be freed
+            for ( limbo_bag& bag : rec->bags_ ) {
+                size_t const nFreed = bag.free_all();
+                CDS_EBRSTAT( s_postmortem_stat.free_count += nFreed );
+                CDS_UNUSED( nFreed );
+            }
+
+            pNext = rec->m_pNextNode.load( atomics::memory_order_relaxed );
+            rec->m_bFree.store( true, atomics::memory_order_relaxed );
+            destroy_thread_data( rec );
+        }
+    }
+
+
+    CDS_EXPORT_API smr::thread_record* smr::create_thread_data()
+    {
+        size_t const guard_array_size = thread_guard_storage::calc_array_size( get_guard_count());
+        size_t const bag_array_size = limbo_bag::calc_array_size( get_bag_capacity()) * c_nLimboBagCount;
+        size_t const nSize = sizeof( thread_record ) + guard_array_size + bag_array_size;
+
+        /*
+            The memory is allocated by contnuous block
+            Memory layout:
+            +--------------------------+
+            |                          |
+            | thread_record            |
+            |         guards_          +---+
+        +---|         bags_[3]         |   |
+        |   |                          |   |
+        |   |--------------------------|   |
+        |   | guard[]                  |<--+
+        |   |                          |
+        |   |--------------------------|
+        +-->| retired_ptr[] bag 0      |
+            | retired_ptr[] bag 1      |
+            | retired_ptr[] bag 2      |
+            +--------------------------+
+
+            If a limbo bag is extended, the extended array is allocated separately
+        */
+
+        uint8_t* mem = reinterpret_cast<uint8_t*>( s_alloc_memory( nSize ));
+
+        return new( mem ) thread_record(
+            reinterpret_cast<guard*>( mem + sizeof( thread_record )),
+            get_guard_count(),
+            reinterpret_cast<cds::gc::details::retired_ptr*>( mem + sizeof( thread_record ) + guard_array_size ),
+            get_bag_capacity(),
+            global_epoch_,
+            get_epoch_freq()
+        );
+    }
+
+    /*static*/ CDS_EXPORT_API void smr::destroy_thread_data( thread_record* pRec )
+    {
+        for ( limbo_bag& bag : pRec->bags_ ) {
+            // all retired pointers must be freed
+            assert( bag.empty());
+
+            if ( bag.retired_ != bag.initial_ )
+                s_free_memory( bag.retired_ );
+        }
+
+        pRec->~thread_record();
+        s_free_memory( pRec );
+    }
+
+
+    CDS_EXPORT_API smr::thread_record* smr::alloc_thread_data()
+    {
+        thread_record * rec;
+        const cds::OS::ThreadId nullThreadId = cds::OS::c_NullThreadId;
+        const cds::OS::ThreadId curThreadId = cds::OS::get_current_thread_id();
+
+        // First try to reuse a free (non-active) EBR record
+        for ( rec = thread_list_.load( atomics::memory_order_acquire ); rec; rec = rec->m_pNextNode.load( atomics::memory_order_acquire )) {
+            cds::OS::ThreadId thId = nullThreadId;
+            if ( !rec->m_idOwner.compare_exchange_strong( thId, curThreadId, atomics::memory_order_relaxed, atomics::memory_order_relaxed ))
+                continue;
+            rec->m_bFree.store( false, atomics::memory_order_release );
+            return rec;
+        }
+
+        // No EBR records available for reuse
+        // Allocate and push a new EBR record
+        rec = create_thread_data();
+        rec->m_idOwner.store( curThreadId, atomics::memory_order_relaxed );
+
+        thread_record* pOldHead = thread_list_.load( atomics::memory_order_relaxed );
+        do {
+            rec->m_pNextNode.store( pOldHead, atomics::memory_order_release );
+        } while ( !thread_list_.compare_exchange_weak( pOldHead, rec, atomics::memory_order_release, atomics::memory_order_acquire ));
+
+        return rec;
+    }
+
+    CDS_EXPORT_API void smr::free_thread_data( smr::thread_record* pRec )
+    {
+        assert( pRec != nullptr );
+
+        // The thread cannot hold any guard after detaching.
+        // The limbo bags of the threads detached earlier are adopted first,
+        // so the last detached thread frees everything
+        pRec->leave();
+        help_scan( pRec );
+        force_dispose( pRec );
+        pRec->m_idOwner.store( cds::OS::c_NullThreadId, atomics::memory_order_release );
+    }
+
+    CDS_EXPORT_API void smr::detach_all_thread()
+    {
+        thread_record * pNext = nullptr;
+        const cds::OS::ThreadId nullThreadId = cds::OS::c_NullThreadId;
+
+        for ( thread_record * rec = thread_list_.load( atomics::memory_order_relaxed ); rec; rec = pNext ) {
+            pNext = rec->m_pNextNode.load( atomics::memory_order_relaxed );
+            if ( rec->m_idOwner.load( atomics::memory_order_relaxed ) != nullThreadId ) {
+                free_thread_data( rec );
+            }
+        }
+    }
+
+    /*static*/ CDS_EXPORT_API void smr::attach_thread()
+    {
+        if ( !tls_ )
+            tls_ = instance().alloc_thread_data();
+    }
+
+    /*static*/ CDS_EXPORT_API void smr::detach_thread()
+    {
+        thread_data* rec = tls_;
+        if ( rec ) {
+            tls_ = nullptr;
+            instance().free_thread_data( static_cast<thread_record*>( rec ));
+        }
+    }
+
+    epoch_t smr::try_advance( thread_data* pRec )
+    {
+        epoch_t epoch = global_epoch_.load( atomics::memory_order_acquire );
+
+        // Pairs with the fence of thread_data::enter()
+        atomics::atomic_thread_fence( atomics::memory_order_seq_cst );
+
+        for ( thread_record* pNode = thread_list_.load( atomics::memory_order_acquire ); pNode; pNode = pNode->m_pNextNode.load( atomics::memory_order_relaxed )) {
+            epoch_t const announced = pNode->announce_.load( atomics::memory_order_acquire );
+            if ( announced != c_quiescent && announced != epoch ) {
+                // The thread is inside an operation started in the previous epoch
+                CDS_EBRSTAT( ++pRec->stall_count_ );
+                CDS_UNUSED( pRec );
+                return global_epoch_.load( atomics::memory_order_acquire );
+            }
+        }
+
+        if ( global_epoch_.compare_exchange_strong( epoch, epoch + 1, atomics::memory_order_acq_rel, atomics::memory_order_acquire )) {
+            CDS_EBRSTAT( ++pRec->advance_count_ );
+            return epoch + 1;
+        }
+
+        // Another thread has advanced the epoch
+        return epoch;
+    }
+
+    void smr::extend_bag( limbo_bag& bag )
+    {
+        size_t const nSize = bag.size();
+        size_t const nCapacity = bag.capacity() * 2;
+
+        cds::gc::details::retired_ptr* new_arr = reinterpret_cast<cds::gc::details::retired_ptr*>( s_alloc_memory( limbo_bag::calc_array_size( nCapacity )));
+        std::copy( bag.first(), bag.last(), new_arr );
+
+        if ( bag.retired_ != bag.initial_ )
+            s_free_memory( bag.retired_ );
+
+        bag.retired_ = new_arr;
+        bag.current_ = new_arr + nSize;
+        bag.last_ = new_arr + nCapacity;
+        CDS_EBRSTAT( ++bag.extend_call_count_ );
+    }
+
+    CDS_EXPORT_API void smr::scan( thread_data* pRec )
+    {
+        CDS_EBRSTAT( ++pRec->scan_count_ );
+
+        pRec->retire_count_ = 0;
+        epoch_t const epoch = try_advance( pRec );
+        pRec->rotate( epoch );
+
+        // A lagging thread prevents the epoch advancement: extend the bag to avoid scanning on each retire
+        limbo_bag& bag = pRec->bags_[epoch % c_nLimboBagCount];
+        if ( bag.full())
+            extend_bag( bag );
+    }
+
+    CDS_EXPORT_API void smr::force_dispose( thread_data* pRec )
+    {
+        // An object retired in epoch e can be freed in epoch e + 2
+        for ( size_t i = 0; i < 2; ++i )
+            scan( pRec );
+    }
+
+    CDS_EXPORT_API void smr::help_scan( thread_data* pThis )
+    {
+        assert( static_cast<thread_record*>( pThis )->m_idOwner.load( atomics::memory_order_relaxed ) == cds::OS::get_current_thread_id());
+
+        CDS_EBRSTAT( ++pThis->help_scan_count_ );
+
+        const cds::OS::ThreadId nullThreadId = cds::OS::c_NullThreadId;
+        const cds::OS::ThreadId curThreadId = cds::OS::get_current_thread_id();
+        for ( thread_record* rec = thread_list_.load( atomics::memory_order_acquire ); rec; rec = rec->m_pNextNode.load( atomics::memory_order_relaxed ))
+        {
+            if ( rec == static_cast<thread_record*>( pThis ))
+                continue;
+
+            // If m_bFree == true then rec->bags_ are empty - we don't need to see it
+            if ( rec->m_bFree.load( atomics::memory_order_acquire ))
+                continue;
+
+            // Owns rec if it is empty.
+            // Several threads may work concurrently so we use atomic technique only.
+            {
+                cds::OS::ThreadId curOwner = rec->m_idOwner.load( atomics::memory_order_relaxed );
+                if ( curOwner == nullThreadId ) {
+                    if ( !rec->m_idOwner.compare_exchange_strong( curOwner, curThreadId, atomics::memory_order_acquire, atomics::memory_order_relaxed ))
+                        continue;
+                }
+                else
+                    continue;
+            }
+
+            // We own the thread record successfully. Now, we move its limbo bags to pThis.
+            // After rotate() the bags of pThis and of rec have the epochs in (epoch - 2, epoch],
+            // so the bag of the same index has the same epoch.
+            epoch_t const epoch = global_epoch_.load( atomics::memory_order_acquire );
+            pThis->rotate( epoch );
+
+            for ( limbo_bag& src : rec->bags_ ) {
+                if ( src.empty())
+                    continue;
+
+                if ( src.epoch() + 2 <= epoch ) {
+                    size_t const nFreed = src.free_all();
+                    CDS_EBRSTAT( pThis->free_count_ += nFreed );
+                    CDS_UNUSED( nFreed );
+                    continue;
+                }
+
+                limbo_bag& dest = pThis->bags_[src.epoch() % c_nLimboBagCount];
+                assert( dest.empty() || dest.epoch() == src.epoch());
+                for ( cds::gc::details::retired_ptr* p = src.first(), *last = src.last(); p != last; ++p ) {
+                    if ( !dest.repush( *p, src.epoch()))
+                        extend_bag( dest );
+                }
+                src.current_ = src.retired_;
+            }
+
+            rec->m_bFree.store( true, atomics::memory_order_release );
+            rec->m_idOwner.store( nullThreadId, atomics::memory_order_release );
+        }
+
+        scan( pThis );
+    }
+
+    CDS_EXPORT_API void smr::statistics( stat& st )
+    {
+        st.clear();
+#   ifdef CDS_ENABLE_HPSTAT
+        for ( thread_record* rec = thread_list_.load( atomics::memory_order_acquire ); rec; rec = rec->m_pNextNode.load( atomics::memory_order_relaxed ))
+        {
+            CDS_TSAN_ANNOTATE_IGNORE_READS_BEGIN;
+            ++st.thread_rec_count;
+            st.guard_allocated      += rec->guards_.alloc_guard_count_;
+            st.guard_freed          += rec->guards_.free_guard_count_;
+            for ( limbo_bag const& bag : rec->bags_ ) {
+                st.retired_count    += bag.retire_call_count_;
+                st.bag_extend_count += bag.extend_call_count_;
+            }
+            st.free_count           += rec->free_count_;
+            st.scan_count           += rec->scan_count_;
+            st.help_scan_count      += rec->help_scan_count_;
+            st.announce_count       += rec->announce_count_;
+            st.advance_count        += rec->advance_count_;
+            st.stall_count          += rec->stall_count_;
+            CDS_TSAN_ANNOTATE_IGNORE_READS_END;
+        }
+#   endif
+    }
+
+}}} // namespace cds::gc::ebr
+
+CDS_EXPORT_API /*static*/ cds::gc::EBR::stat const& cds::gc::EBR::postmortem_statistics()
+{
+    return cds::gc::ebr::s_postmortem_stat;
+}
@@ -0,0 +1,471 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <vector>
+
+#include <cds/gc/he.h>
+#include <cds/os/thread.h>
+
+namespace cds { namespace gc { namespace he {
+
+    namespace {
+        void * default_alloc_memory( size_t size )
+        {
+            return new uintptr_t[( size + sizeof( uintptr_t ) - 1 ) / sizeof( uintptr_t) ];
+        }
+
+        void default_free_memory( void* p )
+        {
+            delete[] reinterpret_cast<uintptr_t*>( p );
+        }
+
+        void* ( *s_alloc_memory )( size_t size ) = default_alloc_memory;
+        void ( *s_free_memory )( void* p ) = default_free_memory;
+
+        template <typename T>
+        class allocator
+        {
+        public:
+            typedef T   value_type;
+
+            allocator() {}
+            allocator( allocator const& ) {}
+            template <class U>
+            explicit allocator( allocator<U> const& ) {}
+
+            static T* allocate( size_t nCount )
+            {
+                return reinterpret_cast<T*>( s_alloc_memory( sizeof( value_type ) * nCount ));
+            }
+
+            static void deallocate( T* p, size_t /*nCount*/ )
+            {
+                s_free_memory( reinterpret_cast<void*>( p ));
+            }
+
+            template <class U>
+            bool operator ==( allocator<U> const& ) const
+            {
+                return true;
+            }
+
+            template <class U>
+            bool operator !=( allocator<U> const& ) const
+            {
+                return false;
+            }
+        };
+
+        struct defaults {
+            static const size_t c_nHazardEraPerThread = 8;
+            static const size_t c_nMaxThreadCount = 100;
+            static const size_t c_nEraFreq = 64;
+        };
+
+        size_t calc_retired_size( size_t nSize, size_t nHPCount, size_t nThreadCount )
+        {
+            size_t const min_size = nHPCount * nThreadCount;
+            return nSize < min_size ? min_size * 2 : nSize;
+        }
+
+        stat s_postmortem_stat;
+    } // namespace
+
+    /*static*/ CDS_EXPORT_API smr* smr::instance_ = nullptr;
+    thread_local thread_data* tls_ = nullptr;
+
+    /*static*/ CDS_EXPORT_API thread_data* smr::tls()
+    {
+        // The thread attached to the Manager is attached to the GC on its first use of the GC.
+        // A thread not attached to the Manager would never be detached, so it gets no record
+        if ( cds_unlikely( tls_ == nullptr ) && cds::threading::Manager::isThreadAttached()
+            && cds::threading::Manager::thread_data()->is_attached())
+        {
+            attach_thread();
+        }
+        assert( tls_ != nullptr );
+        return tls_;
+    }
+
+    struct smr::thread_record: thread_data
+    {
+        atomics::atomic<thread_record*>     m_pNextNode; ///< next hazard era record in list
+        atomics::atomic<cds::OS::ThreadId>  m_idOwner;   ///< Owner thread id; 0 - the record is free (not owned)
+        atomics::atomic<bool>               m_bFree;     ///< true if record is free (not owned)
+
+        thread_record( guard* guards, size_t guard_count, retired_ptr* retired_arr, size_t retired_capacity, atomics::atomic<era_t>& global_era, size_t era_freq )
+            : thread_data( guards, guard_count, retired_arr, retired_capacity, global_era, era_freq )
+            , m_pNextNode( nullptr )
+            , m_idOwner( cds::OS::c_NullThreadId )
+            , m_bFree( false )
+        {}
+    };
+
+    /*static*/ CDS_EXPORT_API void smr::set_memory_allocator(
+        void* ( *alloc_func )( size_t size ),
+        void( *free_func )( void * p )
+    )
+    {
+        // The memory allocation functions may be set BEFORE initializing HE SMR!!!
+        assert( instance_ == nullptr );
+
+        s_alloc_memory = alloc_func;
+        s_free_memory = free_func;
+    }
+
+
+    /*static*/ CDS_EXPORT_API void smr::construct( size_t nHazardEraCount, size_t nMaxThreadCount, size_t nMaxRetiredPtrCount, size_t nEraFreq )
+    {
+        if ( !instance_ ) {
+            instance_ = new( s_alloc_memory(sizeof(smr))) smr( nHazardEraCount, nMaxThreadCount, nMaxRetiredPtrCount, nEraFreq );
+        }
+    }
+
+    /*static*/ CDS_EXPORT_API void smr::destruct( bool bDetachAll )
+    {
+        if ( instance_ ) {
+            if ( bDetachAll )
+                instance_->detach_all_thread();
+
+            instance_->~smr();
+            s_free_memory( instance_ );
+            instance_ = nullptr;
+        }
+        // The record of the current thread is freed with the GC
+        tls_ = nullptr;
+    }
+
+    CDS_EXPORT_API smr::smr( size_t nHazardEraCount, size_t nMaxThreadCount, size_t nMaxRetiredPtrCount, size_t nEraFreq )
+        : hazard_ptr_count_( nHazardEraCount == 0 ? defaults::c_nHazardEraPerThread : nHazardEraCount )
+        , max_thread_count_( nMaxThreadCount == 0 ? defaults::c_nMaxThreadCount : nMaxThreadCount )
+        , max_retired_ptr_count_( calc_retired_size( nMaxRetiredPtrCount, hazard_ptr_count_, max_thread_count_ ))
+        , era_freq_( nEraFreq == 0 ? defaults::c_nEraFreq : nEraFreq )
+        , global_era_( c_no_era + 1 )
+    {
+        thread_list_.store( nullptr, atomics::memory_order_release );
+    }
+
+    CDS_EXPORT_API smr::~smr()
+    {
+        CDS_DEBUG_ONLY( const cds::OS::ThreadId nullThreadId = cds::OS::c_NullThreadId; )
+        CDS_DEBUG_ONLY( const cds::OS::ThreadId mainThreadId = cds::OS::get_current_thread_id();)
+
+        CDS_HESTAT( statistics( s_postmortem_stat ));
+
+        thread_record* pHead = thread_list_.load( atomics::memory_order_relaxed );
+        thread_list_.store( nullptr, atomics::memory_order_release );
+
+        thread_record* pNext = nullptr;
+        for ( thread_record* herec = pHead; herec; herec = pNext )
+        {
+            assert( herec->m_idOwner.load( atomics::memory_order_relaxed ) == nullThreadId
+                || herec->m_idOwner.load( atomics::memory_order_relaxed ) == mainThreadId );
+
+            retired_array& arr = herec->retired_;
+            for ( retired_ptr* cur{ arr.first() }, *last{ arr.last() }; cur != last; ++cur ) {
+                cur->free();
+                CDS_HESTAT( ++s_postmortem_stat.free_count );
+            }
+
+            arr.reset( 0 );
+            pNext = herec->m_pNextNode.load( atomics::memory_order_relaxed );
+            herec->m_bFree.store( true, atomics::memory_order_relaxed );
+            destroy_thread_data( herec );
+        }
+    }
+
+
+    CDS_EXPORT_API smr::thread_record* smr::create_thread_data()
+    {
+        size_t const guard_array_size = thread_he_storage::calc_array_size( get_hazard_ptr_count());
+        size_t const retired_array_size = retired_array::calc_array_size( get_max_retired_ptr_count());
+        size_t const nSize = sizeof( thread_record ) + guard_array_size + retired_array_size;
+
+        /*
+            The memory is allocated by contnuous block
+            Memory layout:
+            +--------------------------+
+            |                          |
+            | thread_record            |
+            |         hazards_         +---+
+        +---|         retired_         |   |
+        |   |                          |   |
+        |   |--------------------------|   |
+        |   | guard[]                  |<--+
+        |   |                          |
+        |   |                          |
+        |   |--------------------------|
+        +-->| retired_ptr[]            |
+            |                          |
+            |                          |
+            +--------------------------+
+
+            If the retired array is extended, the extended array is allocated separately
+        */
+
+        uint8_t* mem = reinterpret_cast<uint8_t*>( s_alloc_memory( nSize ));
+
+        return new( mem ) thread_record(
+            reinterpret_cast<guard*>( mem + sizeof( thread_record )),
+            get_hazard_ptr_count(),
+            reinterpret_cast<retired_ptr*>( mem + sizeof( thread_record ) + guard_array_size ),
+            get_max_retired_ptr_count(),
+            global_era_,
+            get_era_freq()
+        );
+    }
+
+    /*static*/ CDS_EXPORT_API void smr::destroy_thread_data( thread_record* pRec )
+    {
+        // all retired pointers must be freed
+        assert( pRec->retired_.size() == 0 );
+
+        if ( pRec->retired_.retired_ != pRec->retired_.initial_ )
+            s_free_memory( pRec->retired_.retired_ );
+
+        pRec->~thread_record();
+        s_free_memory( pRec );
+    }
+
+
+    CDS_EXPORT_API smr::thread_record* smr::alloc_thread_data()
+    {
+        thread_record * herec;
+        const cds::OS::ThreadId nullThreadId = cds::OS::c_NullThreadId;
+        const cds::OS::ThreadId curThreadId = cds::OS::get_current_thread_id();
+
+        // First try to reuse a free (non-active) HE record
+        for ( herec = thread_list_.load( atomics::memory_order_acquire ); herec; herec = herec->m_pNextNode.load( atomics::memory_order_acquire )) {
+            cds::OS::ThreadId thId = nullThreadId;
+            if ( !herec->m_idOwner.compare_exchange_strong( thId, curThreadId, atomics::memory_order_relaxed, atomics::memory_order_relaxed ))
+                continue;
+            herec->m_bFree.store( false, atomics::memory_order_release );
+            return herec;
+        }
+
+        // No HE records available for reuse
+        // Allocate and push a new HE record
+        herec = create_thread_data();
+        herec->m_idOwner.store( curThreadId, atomics::memory_order_relaxed );
+
+        thread_record* pOldHead = thread_list_.load( atomics::memory_order_relaxed );
+        do {
+            herec->m_pNextNode.store( pOldHead, atomics::memory_order_release );
+        } while ( !thread_list_.compare_exchange_weak( pOldHead, herec, atomics::memory_order_release, atomics::memory_order_acquire ));
+
+        return herec;
+    }
+
+    CDS_EXPORT_API void smr::free_thread_data( smr::thread_record* pRec )
+    {
+        assert( pRec != nullptr );
+
+        pRec->hazards_.clear();
+        scan( pRec );
+        help_scan( pRec );
+        pRec->m_idOwner.store( cds::OS::c_NullThreadId, atomics::memory_order_release );
+    }
+
+    CDS_EXPORT_API void smr::detach_all_thread()
+    {
+        thread_record * pNext = nullptr;
+        const cds::OS::ThreadId nullThreadId = cds::OS::c_NullThreadId;
+
+        for ( thread_record * herec = thread_list_.load( atomics::memory_order_relaxed ); herec; herec = pNext ) {
+            pNext = herec->m_pNextNode.load( atomics::memory_order_relaxed );
+            if ( herec->m_idOwner.load( atomics::memory_order_relaxed ) != nullThreadId ) {
+                free_thread_data( herec );
+            }
+        }
+    }
+
+    /*static*/ CDS_EXPORT_API void smr::attach_thread()
+    {
+        if ( !tls_ )
+            tls_ = instance().alloc_thread_data();
+    }
+
+    /*static*/ CDS_EXPORT_API void smr::detach_thread()
+    {
+        thread_data* rec = tls_;
+        if ( rec ) {
+            tls_ = nullptr;
+            instance().free_thread_data( static_cast<thread_record*>( rec ));
+        }
+    }
+
+    void smr::extend_retired( retired_array& arr )
+    {
+        size_t const nSize = arr.size();
+        size_t const nCapacity = arr.capacity() * 2;
+
+        retired_ptr* new_arr = reinterpret_cast<retired_ptr*>( s_alloc_memory( retired_array::calc_array_size( nCapacity )));
+        std::copy( arr.first(), arr.last(), new_arr );
+
+        if ( arr.retired_ != arr.initial_ )
+            s_free_memory( arr.retired_ );
+
+        arr.retired_ = new_arr;
+        arr.current_ = new_arr + nSize;
+        arr.last_ = new_arr + nCapacity;
+        CDS_HESTAT( ++arr.extend_call_count_ );
+    }
+
+    CDS_EXPORT_API void smr::scan( thread_data* pRec )
+    {
+        CDS_HESTAT( ++pRec->scan_count_ );
+
+        // The objects retired before the call have the era less than the new global era.
+        // Advancing the era allows to free them as soon as the readers leave the old era.
+        global_era_.fetch_add( 1, atomics::memory_order_acq_rel );
+        pRec->retire_count_ = 0;
+        atomics::atomic_thread_fence( atomics::memory_order_seq_cst );
+
+        // Stage 1: collect the eras published by all threads
+        std::vector< era_t, allocator<era_t>> plist;
+        plist.reserve( get_max_thread_count() * get_hazard_ptr_count());
+
+        for ( thread_record* pNode = thread_list_.load( atomics::memory_order_acquire ); pNode; pNode = pNode->m_pNextNode.load( atomics::memory_order_relaxed )) {
+            if ( pNode->m_idOwner.load( atomics::memory_order_relaxed ) != cds::OS::c_NullThreadId ) {
+                thread_he_storage& hestg = pNode->hazards_;
+                for ( size_t i = 0; i < hazard_ptr_count_; ++i ) {
+                    era_t const era = hestg[i].era();
+                    if ( era != c_no_era )
+                        plist.push_back( era );
+                }
+            }
+        }
+
+        std::sort( plist.begin(), plist.end());
+
+        // Stage 2: free the objects whose lifetime [birth, retire] contains no published era
+        retired_array& retired = pRec->retired_;
+        retired_ptr* first_retired = retired.first();
+        retired_ptr* last_retired = retired.last();
+
+        retired_ptr* insert_pos = first_retired;
+        for ( retired_ptr* it = first_retired; it != last_retired; ++it ) {
+            auto itEra = std::lower_bound( plist.begin(), plist.end(), it->birth_ );
+            if ( itEra != plist.end() && *itEra <= it->era_ ) {
+                // The object may be guarded by the thread that published *itEra
+                if ( insert_pos != it )
+                    std::swap( *insert_pos, *it );
+                ++insert_pos;
+            }
+        }
+
+        cds::gc::details::free_retired( insert_pos, last_retired );
+        CDS_HESTAT( pRec->free_count_ += last_retired - insert_pos );
+        retired.reset( insert_pos - first_retired );
+
+        // A stalled reader holds an era when many objects were alive: extend the array to avoid scanning on each retire
+        if ( retired.size() > retired.capacity() / 2 )
+            extend_retired( retired );
+    }
+
+    CDS_EXPORT_API void smr::help_scan( thread_data* pThis )
+    {
+        assert( static_cast<thread_record*>( pThis )->m_idOwner.load( atomics::memory_order_relaxed ) == cds::OS::get_current_thread_id());
+
+        CDS_HESTAT( ++pThis->help_scan_count_ );
+
+        const cds::OS::ThreadId nullThreadId = cds::OS::c_NullThreadId;
+        const cds::OS::ThreadId curThreadId = cds::OS::get_current_thread_id();
+        for ( thread_record* herec = thread_list_.load( atomics::memory_order_acquire ); herec; herec = herec->m_pNextNode.load( atomics::memory_order_relaxed ))
+        {
+            if ( herec == static_cast<thread_record*>( pThis ))
+                continue;
+
+            // If m_bFree == true then herec->retired_ is empty - we don't need to see it
+            if ( herec->m_bFree.load( atomics::memory_order_acquire ))
+                continue;
+
+            // Owns herec if it is empty.
+            // Several threads may work concurrently so we use atomic technique only.
+            {
+                cds::OS::ThreadId curOwner = herec->m_idOwner.load( atomics::memory_order_relaxed );
+                if ( curOwner == nullThreadId ) {
+                    if ( !herec->m_idOwner.compare_exchange_strong( curOwner, curThreadId, atomics::memory_order_acquire, atomics::memory_order_relaxed ))
+                        continue;
+                }
+                else
+                    continue;
+            }
+
+            // We own the thread record successfully. Now, we can see whether it has retired pointers.
+            // If it has ones then we move them to pThis that is private for current thread.
+            retired_array& src = herec->retired_;
+            retired_array& dest = pThis->retired_;
+            assert( !dest.full());
+
+            retired_ptr* src_first = src.first();
+            retired_ptr* src_last = src.last();
+
+            for ( ; src_first != src_last; ++src_first ) {
+                if ( !dest.repush( *src_first ))
+                    scan( pThis );
+            }
+
+            src.reset( 0 );
+            herec->m_bFree.store( true, atomics::memory_order_release );
+            herec->m_idOwner.store( nullThreadId, atomics::memory_order_release );
+
+            scan( pThis );
+        }
+    }
+
+    CDS_EXPORT_API void smr::statistics( stat& st )
+    {
+        st.clear();
+#   ifdef CDS_ENABLE_HPSTAT
+        for ( thread_record* herec = thread_list_.load( atomics::memory_order_acquire ); herec; herec = herec->m_pNextNode.load( atomics::memory_order_relaxed ))
+        {
+            CDS_TSAN_ANNOTATE_IGNORE_READS_BEGIN;
+            ++st.thread_rec_count;
+            st.guard_allocated      += herec->hazards_.alloc_guard_count_;
+            st.guard_freed          += herec->hazards_.free_guard_count_;
+            st.retired_count        += herec->retired_.retire_call_count_;
+            st.retired_extend_count += herec->retired_.extend_call_count_;
+            st.free_count           += herec->free_count_;
+            st.scan_count           += herec->scan_count_;
+            st.help_scan_count      += herec->help_scan_count_;
+            st.era_publish_count    += herec->publish_count_;
+            CDS_TSAN_ANNOTATE_IGNORE_READS_END;
+        }
+#   endif
+    }
+
+}}} // namespace cds::gc::he
+
+CDS_EXPORT_API /*static*/ cds::gc::HE::stat const& cds::gc::HE::postmortem_statistics()
+{
+    return cds::gc::he::s_postmortem_stat;
+}
@@ -30,9 +30,13 @@
 
 #include <algorithm>
 #include <vector>
+#include <mutex>
 
 #include <cds/gc/hp.h>
+#include <cds/gc/details/hp_reclaimer.h>
+#include <cds/gc/details/hp_hazard_set.h>
 #include <cds/os/thread.h>
+#include <cds/algo/backoff_strategy.h>
 
 namespace cds { namespace gc { namespace hp {
 
@@ -70,11 +74,24 @@ namespace cds { namespace gc { namespace hp {
             {
                 s_free_memory( reinterpret_cast<void*>( p ));
             }
+
+            template <class U>
+            bool operator ==( allocator<U> const& ) const
+            {
+                return true;
+            }
+
+            template <class U>
+            bool operator !=( allocator<U> const& ) const
+            {
+                return false;
+            }
         };
 
         struct defaults {
             static const size_t c_nHazardPointerPerThread = 8;
             static const size_t c_nMaxThreadCount = 100;
+            static const size_t c_nThreadListSlack = 16;   // free records kept in the thread list for fast reuse
         };
 
         size_t calc_retired_size( size_t nSize, size_t nHPCount, size_t nThreadCount )
@@ -84,6 +101,9 @@ namespace cds { namespace gc { namespace hp {
         }
 
         stat s_postmortem_stat;
+
+        // max back-off count for budget_throttle policy
+        static const unsigned c_nBudgetThrottleCount = 64;
     } // namespace
 
     /*static*/ CDS_EXPORT_API smr* smr::instance_ = nullptr;
@@ -91,6 +111,13 @@ namespace cds { namespace gc { namespace hp {
 
     /*static*/ CDS_EXPORT_API thread_data* smr::tls()
     {
+        // The thread attached to the Manager is attached to the GC on its first use of the GC.
+        // A thread not attached to the Manager would never be detached, so it gets no record
+        if ( cds_unlikely( tls_ == nullptr ) && cds::threading::Manager::isThreadAttached()
+            && cds::threading::Manager::thread_data()->is_attached())
+        {
+            attach_thread();
+        }
         assert( tls_ != nullptr );
         return tls_;
     }
@@ -100,12 +127,21 @@ namespace cds { namespace gc { namespace hp {
         atomics::atomic<thread_record*>     m_pNextNode; ///< next hazard ptr record in list
         atomics::atomic<cds::OS::ThreadId>  m_idOwner;   ///< Owner thread id; 0 - the record is free (not owned)
         atomics::atomic<bool>               m_bFree;     ///< true if record is free (not owned)
+        thread_record*                      m_pNextFree; ///< next record in smr::free_records_ list
 
-        thread_record( guard* guards, size_t guard_count, retired_ptr* retired_arr, size_t retired_capacity )
-            : thread_data( guards, guard_count, retired_arr, retired_capacity )
+        thread_record( guard* guards, size_t guard_count, retired_ptr* retired_arr, size_t retired_capacity, bool asymmetric_fence )
+            : thread_data( guards, guard_count, retired_arr, retired_capacity, asymmetric_fence )
             , m_pNextNode( nullptr )
             , m_idOwner( cds::OS::c_NullThreadId )
             , m_bFree( false )
+            , m_pNextFree( nullptr )
+        {}
+    };
+
+    struct smr::reclaimer: public hp::common::reclaimer_thread< smr, allocator<retired_ptr>>
+    {
+        explicit reclaimer( smr& s )
+            : hp::common::reclaimer_thread< smr, allocator<retired_ptr>>( s )
         {}
     };
 
@@ -122,10 +158,10 @@ namespace cds { namespace gc { namespace hp {
     }
 
 
-    /*static*/ CDS_EXPORT_API void smr::construct( size_t nHazardPtrCount, size_t nMaxThreadCount, size_t nMaxRetiredPtrCount, scan_type nScanType )
+    /*static*/ CDS_EXPORT_API void smr::construct( size_t nHazardPtrCount, size_t nMaxThreadCount, size_t nMaxRetiredPtrCount, scan_type nScanType, bool bAsymmetricFence, bool bBackgroundReclaim )
     {
         if ( !instance_ ) {
-            instance_ = new( s_alloc_memory(sizeof(smr))) smr( nHazardPtrCount, nMaxThreadCount, nMaxRetiredPtrCount, nScanType );
+            instance_ = new( s_alloc_memory(sizeof(smr))) smr( nHazardPtrCount, nMaxThreadCount, nMaxRetiredPtrCount, nScanType, bAsymmetricFence, bBackgroundReclaim );
         }
     }
 
@@ -139,16 +175,30 @@ namespace cds { namespace gc { namespace hp {
             s_free_memory( instance_ );
             instance_ = nullptr;
         }
+        // The record of the current thread is freed with the GC
+        tls_ = nullptr;
     }
 
-    CDS_EXPORT_API smr::smr( size_t nHazardPtrCount, size_t nMaxThreadCount, size_t nMaxRetiredPtrCount, scan_type nScanType )
+    CDS_EXPORT_API smr::smr( size_t nHazardPtrCount, size_t nMaxThreadCount, size_t nMaxRetiredPtrCount, scan_type nScanType, bool bAsymmetricFence, bool bBackgroundReclaim )
         : hazard_ptr_count_( nHazardPtrCount == 0 ? defaults::c_nHazardPointerPerThread : nHazardPtrCount )
         , max_thread_count_( nMaxThreadCount == 0 ? defaults::c_nMaxThreadCount : nMaxThreadCount )
         , max_retired_ptr_count_( calc_retired_size( nMaxRetiredPtrCount, hazard_ptr_count_, max_thread_count_ ))
         , scan_type_( nScanType )
-        , scan_func_( nScanType == classic ? &smr::classic_scan : &smr::inplace_scan )
+        , asymmetric_fence_( bAsymmetricFence && cds::OS::membarrier::register_expedited())
+        , reclaimer_( nullptr )
+        , reclaimer_retained_( 0 )
+        , scan_func_( nScanType == classic ? &smr::classic_scan : nScanType == hashed ? &smr::hashed_scan : &smr::inplace_scan )
     {
         thread_list_.store( nullptr, atomics::memory_order_release );
+        thread_list_count_.store( 0, atomics::memory_order_relaxed );
+        attached_count_.store( 0, atomics::memory_order_relaxed );
+        free_records_ = nullptr;
+        compact_count_ = 0;
+
+        if ( bBackgroundReclaim ) {
+            reclaimer_ = new( s_alloc_memory( sizeof( reclaimer ))) reclaimer( *this );
+            scan_func_ = &smr::background_scan;
+        }
     }
 
     CDS_EXPORT_API smr::~smr()
@@ -156,8 +206,24 @@ namespace cds { namespace gc { namespace hp {
         CDS_DEBUG_ONLY( const cds::OS::ThreadId nullThreadId = cds::OS::c_NullThreadId; )
         CDS_DEBUG_ONLY( const cds::OS::ThreadId mainThreadId = cds::OS::get_current_thread_id();)
 
+        reclaimer::retired_vector leftover;
+        if ( reclaimer_ )
+            reclaimer_->stop( leftover );
+
         CDS_HPSTAT( statistics( s_postmortem_stat ));
 
+        if ( reclaimer_ ) {
+            for ( retired_ptr& p : leftover ) {
+                p.free();
+                CDS_HPSTAT( ++s_postmortem_stat.free_count );
+            }
+            leftover.clear();
+
+            reclaimer_->~reclaimer();
+            s_free_memory( reclaimer_ );
+            reclaimer_ = nullptr;
+        }
+
         thread_record* pHead = thread_list_.load( atomics::memory_order_relaxed );
         thread_list_.store( nullptr, atomics::memory_order_release );
 
@@ -178,6 +244,13 @@ namespace cds { namespace gc { namespace hp {
             hprec->m_bFree.store( true, atomics::memory_order_relaxed );
             destroy_thread_data( hprec );
         }
+
+        // The records unlinked by compact_thread_list() have no retired pointers
+        for ( thread_record* hprec = free_records_; hprec; hprec = pNext ) {
+            pNext = hprec->m_pNextFree;
+            destroy_thread_data( hprec );
+        }
+        free_records_ = nullptr;
     }
 
 
@@ -213,7 +286,8 @@ namespace cds { namespace gc { namespace hp {
             reinterpret_cast<guard*>( mem + sizeof( thread_record )),
             get_hazard_ptr_count(),
             reinterpret_cast<retired_ptr*>( mem + sizeof( thread_record ) + guard_array_size ),
-            get_max_retired_ptr_count()
+            get_max_retired_ptr_count(),
+            is_asymmetric_fence()
         );
     }
 
@@ -222,11 +296,44 @@ namespace cds { namespace gc { namespace hp {
         // all retired pointers must be freed
         assert( pRec->retired_.size() == 0 );
 
+        // free the extended guard blocks
+        for ( guard_block* block = pRec->hazards_.extended_list(); block; ) {
+            guard_block* pNext = block->next_block_.load( atomics::memory_order_relaxed );
+            void* mem = block->memory_;
+            block->~guard_block();
+            s_free_memory( mem );
+            block = pNext;
+        }
+
         pRec->~thread_record();
         s_free_memory( pRec );
     }
 
 
+    CDS_EXPORT_API void thread_hp_storage::extend()
+    {
+        static_assert( sizeof( guard_block ) <= guard_block::c_header_size, "The header of guard_block does not fit its cache line" );
+        static_assert( sizeof( guard ) * guard_block::c_capacity == cds::c_nCacheLineSize * 4, "The guards of guard_block do not fill whole cache lines" );
+
+        assert( free_head_ == nullptr );
+
+        // All guards of the storage are in use, so the new block continues the used prefix
+        guard_block* block = guard_block::create( s_alloc_memory( guard_block::calc_alloc_size()));
+        guard* p = new( block->first()) guard[guard_block::c_capacity];
+        for ( guard* pEnd = p + guard_block::c_capacity - 1; p != pEnd; ++p )
+            p->next_ = p + 1;
+        p->next_ = nullptr;
+
+        if ( extended_tail_ )
+            extended_tail_->next_block_.store( block, atomics::memory_order_release );
+        else
+            extended_list_.store( block, atomics::memory_order_release );
+        extended_tail_ = block;
+
+        free_head_ = fresh_ = block->first();
+        CDS_HPSTAT( ++extend_call_count_ );
+    }
+
     CDS_EXPORT_API smr::thread_record* smr::alloc_thread_data()
     {
         thread_record * hprec;
@@ -239,19 +346,37 @@ namespace cds { namespace gc { namespace hp {
             if ( !hprec->m_idOwner.compare_exchange_strong( thId, curThreadId, atomics::memory_order_relaxed, atomics::memory_order_relaxed ))
                 continue;
             hprec->m_bFree.store( false, atomics::memory_order_release );
+            attached_count_.fetch_add( 1, atomics::memory_order_relaxed );
             return hprec;
         }
 
-        // No HP records available for reuse
-        // Allocate and push a new HP record
-        hprec = create_thread_data();
+        // Then try to reuse a record unlinked by compact_thread_list()
+        {
+            std::unique_lock< cds::sync::spin > lock( thread_list_lock_ );
+            hprec = free_records_;
+            if ( hprec )
+                free_records_ = hprec->m_pNextFree;
+        }
+
+        if ( hprec ) {
+            hprec->m_pNextFree = nullptr;
+            hprec->m_bFree.store( false, atomics::memory_order_relaxed );
+        }
+        else {
+            // No HP records available for reuse
+            // Allocate a new HP record
+            hprec = create_thread_data();
+        }
         hprec->m_idOwner.store( curThreadId, atomics::memory_order_relaxed );
 
+        // Push the record to the thread list
         thread_record* pOldHead = thread_list_.load( atomics::memory_order_relaxed );
         do {
             hprec->m_pNextNode.store( pOldHead, atomics::memory_order_release );
         } while ( !thread_list_.compare_exchange_weak( pOldHead, hprec, atomics::memory_order_release, atomics::memory_order_acquire ));
 
+        thread_list_count_.fetch_add( 1, atomics::memory_order_relaxed );
+        attached_count_.fetch_add( 1, atomics::memory_order_relaxed );
         return hprec;
     }
 
@@ -263,6 +388,63 @@ namespace cds { namespace gc { namespace hp {
         scan( pRec );
         help_scan( pRec );
         pRec->m_idOwner.store( cds::OS::c_NullThreadId, atomics::memory_order_release );
+
+        // Compact the thread list if it contains much more free records than attached threads
+        size_t const nAttached = attached_count_.fetch_sub( 1, atomics::memory_order_relaxed ) - 1;
+        size_t const nRecords = thread_list_count_.load( atomics::memory_order_relaxed );
+        if ( nRecords > nAttached && nRecords - nAttached > std::max( nAttached, static_cast<size_t>( defaults::c_nThreadListSlack )))
+            compact_thread_list();
+    }
+
+    CDS_EXPORT_API void smr::compact_thread_list()
+    {
+        const cds::OS::ThreadId nullThreadId = cds::OS::c_NullThreadId;
+        const cds::OS::ThreadId curThreadId = cds::OS::get_current_thread_id();
+
+        // Only one thread unlinks the records; the other threads can push new records to the head concurrently.
+        // An unlinked record is never freed until the SMR destruction and keeps its m_pNextNode,
+        // so the thread that walks the list and stands on the record continues with the rest of the list.
+        std::unique_lock< cds::sync::spin > lock( thread_list_lock_ );
+
+        thread_record* pPrev = nullptr;
+        thread_record* hprec = thread_list_.load( atomics::memory_order_acquire );
+        while ( hprec ) {
+            thread_record* pNext = hprec->m_pNextNode.load( atomics::memory_order_acquire );
+
+            // Owns hprec if it is free
+            cds::OS::ThreadId thId = nullThreadId;
+            if ( hprec->m_idOwner.compare_exchange_strong( thId, curThreadId, atomics::memory_order_acquire, atomics::memory_order_relaxed )) {
+                // The record with retired pointers must remain in the list to be adopted by help_scan()
+                bool bUnlinked = false;
+                if ( hprec->retired_.size() == 0 ) {
+                    if ( pPrev ) {
+                        pPrev->m_pNextNode.store( pNext, atomics::memory_order_release );
+                        bUnlinked = true;
+                    }
+                    else {
+                        // A new record may be pushed to the head concurrently, keep hprec in that case
+                        thread_record* pHead = hprec;
+                        bUnlinked = thread_list_.compare_exchange_strong( pHead, pNext, atomics::memory_order_acq_rel, atomics::memory_order_relaxed );
+                    }
+                }
+
+                if ( bUnlinked ) {
+                    // The unlinked record remains owned, so nobody can catch it in the list
+                    hprec->m_bFree.store( true, atomics::memory_order_relaxed );
+                    hprec->m_pNextFree = free_records_;
+                    free_records_ = hprec;
+                    ++compact_count_;
+                    thread_list_count_.fetch_sub( 1, atomics::memory_order_relaxed );
+                    hprec = pNext;
+                    continue;
+                }
+
+                hprec->m_idOwner.store( nullThreadId, atomics::memory_order_release );
+            }
+
+            pPrev = hprec;
+            hprec = pNext;
+        }
     }
 
     CDS_EXPORT_API void smr::detach_all_thread()
@@ -336,6 +518,10 @@ namespace cds { namespace gc { namespace hp {
         }
 #   endif
 
+        // Asymmetric fence: force the readers' hazard pointer stores to be visible
+        if ( asymmetric_fence_ )
+            cds::OS::membarrier::heavy();
+
         // Search guarded pointers in retired array
         thread_record* pNode = thread_list_.load( atomics::memory_order_acquire );
 
@@ -343,10 +529,10 @@ namespace cds { namespace gc { namespace hp {
             retired_ptr dummy_retired;
             while ( pNode ) {
                 if ( pNode->m_idOwner.load( atomics::memory_order_relaxed ) != cds::OS::c_NullThreadId ) {
-                    thread_hp_storage& hpstg = pNode->hazards_;
-                    for ( size_t i = 0; i < hazard_ptr_count_; ++i ) {
+                    pRec->sync();
+                    pNode->hazards_.for_each_used( [&]( guard& g ) {
                         pRec->sync();
-                        void * hptr = hpstg[i].get();
+                        void * hptr = g.get();
                         if ( hptr ) {
                             dummy_retired.m_p = hptr;
                             retired_ptr* it = std::lower_bound( first_retired, last_retired, dummy_retired, retired_ptr::less );
@@ -355,7 +541,7 @@ namespace cds { namespace gc { namespace hp {
                                 it->m_n |= 1;
                             }
                         }
-                    }
+                    });
                 }
                 pNode = pNode->m_pNextNode.load( atomics::memory_order_relaxed );
             }
@@ -368,17 +554,17 @@ namespace cds { namespace gc { namespace hp {
                 if ( it->m_n & 1 ) {
                     it->m_n &= ~uintptr_t(1);
                     if ( insert_pos != it )
-                        *insert_pos = *it;
+                        std::swap( *insert_pos, *it );
                     ++insert_pos;
                 }
-                else {
-                    // Retired pointer may be freed
-                    it->free();
-                    CDS_HPSTAT( ++pRec->free_count_ );
-                }
             }
+
+            // Free unguarded retired pointers grouped by disposer
+            cds::gc::details::free_retired( insert_pos, last_retired );
+            CDS_HPSTAT( pRec->free_count_ += last_retired - insert_pos );
             const size_t nDeferred = insert_pos - first_retired;
             pRec->retired_.reset( nDeferred );
+            budget_.update( pRec->retained_count_, nDeferred );
         }
     }
 
@@ -395,16 +581,21 @@ namespace cds { namespace gc { namespace hp {
 
         // Stage 1: Scan HP list and insert non-null values in plist
 
+        // Asymmetric fence: force the readers' hazard pointer stores to be visible
+        if ( asymmetric_fence_ )
+            cds::OS::membarrier::heavy();
+
         thread_record* pNode = thread_list_.load( atomics::memory_order_acquire );
 
         while ( pNode ) {
             if ( pNode->m_idOwner.load( std::memory_order_relaxed ) != cds::OS::c_NullThreadId ) {
-                for ( size_t i = 0; i < get_hazard_ptr_count(); ++i ) {
+                pRec->sync();
+                pNode->hazards_.for_each_used( [&]( guard& g ) {
                     pRec->sync();
-                    void * hptr = pNode->hazards_[i].get();
+                    void * hptr = g.get();
                     if ( hptr )
                         plist.push_back( hptr );
-                }
+                });
             }
             pNode = pNode->m_pNextNode.load( atomics::memory_order_relaxed );
         }
@@ -423,21 +614,163 @@ namespace cds { namespace gc { namespace hp {
             auto itEnd = plist.end();
             retired_ptr* insert_pos = first_retired;
             for ( retired_ptr* it = first_retired; it != last_retired; ++it ) {
-                if ( std::binary_search( itBegin, itEnd, first_retired->m_p )) {
+                if ( std::binary_search( itBegin, itEnd, it->m_p )) {
                     if ( insert_pos != it )
-                        *insert_pos = *it;
+                        std::swap( *insert_pos, *it );
                     ++insert_pos;
                 }
-                else {
-                    it->free();
-                    CDS_HPSTAT( ++pRec->free_count_ );
-                }
             }
 
+            cds::gc::details::free_retired( insert_pos, last_retired );
+            CDS_HPSTAT( pRec->free_count_ += last_retired - insert_pos );
+
             retired.reset( insert_pos - first_retired );
+            budget_.update( pRec->retained_count_, retired.size());
         }
     }
 
+    // cppcheck-suppress functionConst
+    CDS_EXPORT_API void smr::hashed_scan( thread_data* pThreadRec )
+    {
+        thread_record* pRec = static_cast<thread_record*>( pThreadRec );
+
+        CDS_HPSTAT( ++pThreadRec->scan_count_ );
+
+        std::vector< void*, allocator<void*>>   plist;
+        plist.reserve( get_max_thread_count() * get_hazard_ptr_count());
+
+        // Stage 1: Scan HP list and insert non-null values in plist
+
+        // Asymmetric fence: force the readers' hazard pointer stores to be visible
+        if ( asymmetric_fence_ )
+            cds::OS::membarrier::heavy();
+
+        for ( thread_record* pNode = thread_list_.load( atomics::memory_order_acquire ); pNode; pNode = pNode->m_pNextNode.load( atomics::memory_order_relaxed )) {
+            if ( pNode->m_idOwner.load( std::memory_order_relaxed ) != cds::OS::c_NullThreadId ) {
+                pRec->sync();
+                pNode->hazards_.for_each_used( [&]( guard& g ) {
+                    pRec->sync();
+                    void * hptr = g.get();
+                    if ( hptr )
+                        plist.push_back( hptr );
+                });
+            }
+        }
+
+        // Build hash set of hazard pointers
+        hp::common::hazard_set< allocator<uintptr_t>> hazards( plist.size());
+        for ( void* hptr : plist )
+            hazards.insert( hptr );
+
+        // Stage 2: Search the hash set
+        retired_array& retired = pRec->retired_;
+        retired_ptr* first_retired = retired.first();
+        retired_ptr* last_retired = retired.last();
+
+        retired_ptr* insert_pos = first_retired;
+        for ( retired_ptr* it = first_retired; it != last_retired; ++it ) {
+            if ( hazards.contains( it->m_p )) {
+                if ( insert_pos != it )
+                    std::swap( *insert_pos, *it );
+                ++insert_pos;
+            }
+        }
+
+        cds::gc::details::free_retired( insert_pos, last_retired );
+        CDS_HPSTAT( pRec->free_count_ += last_retired - insert_pos );
+
+        retired.reset( insert_pos - first_retired );
+        budget_.update( pRec->retained_count_, retired.size());
+    }
+
+    CDS_EXPORT_API void smr::background_scan( thread_data* pRec )
+    {
+        CDS_HPSTAT( ++pRec->scan_count_ );
+
+        retired_array& retired = pRec->retired_;
+        reclaimer_->push( retired.first(), retired.last());
+        retired.reset( 0 );
+        budget_.update( pRec->retained_count_, 0 );
+    }
+
+    CDS_EXPORT_API void smr::apply_retired_budget( thread_data* pRec )
+    {
+        // help_scan() calls scan() that can call us again
+        if ( pRec->in_budget_policy_ )
+            return;
+        pRec->in_budget_policy_ = true;
+
+        switch ( budget_.on_exceeded()) {
+        case budget_help_scan:
+            help_scan( pRec );
+            break;
+        case budget_throttle:
+            {
+                cds::backoff::exponential<> bkoff;
+                for ( unsigned i = 0; i < c_nBudgetThrottleCount && budget_.exceeded(); ++i ) {
+                    bkoff();
+                    if ( reclaimer_ )
+                        reclaimer_->flush();
+                    else
+                        ( this->*scan_func_ )( pRec );
+                }
+            }
+            break;
+        default:
+            // budget_callback: the callback has been called by on_exceeded()
+            break;
+        }
+
+        pRec->in_budget_policy_ = false;
+    }
+
+    CDS_EXPORT_API void smr::wait_reclaim()
+    {
+        if ( reclaimer_ )
+            reclaimer_->flush();
+    }
+
+    CDS_EXPORT_API size_t smr::reclaim( retired_ptr* first, retired_ptr* last )
+    {
+        std::vector< void*, allocator<void*>>   plist;
+        plist.reserve( get_max_thread_count() * get_hazard_ptr_count());
+
+        // The reclaimer thread is not attached to the SMR, so it has no thread_data to sync() with
+        atomics::atomic_thread_fence( atomics::memory_order_seq_cst );
+
+        // Asymmetric fence: force the readers' hazard pointer stores to be visible
+        if ( asymmetric_fence_ )
+            cds::OS::membarrier::heavy();
+
+        // Stage 1: Scan HP list and insert non-null values in plist
+        for ( thread_record* pNode = thread_list_.load( atomics::memory_order_acquire ); pNode; pNode = pNode->m_pNextNode.load( atomics::memory_order_relaxed )) {
+            if ( pNode->m_idOwner.load( std::memory_order_relaxed ) != cds::OS::c_NullThreadId ) {
+                pNode->hazards_.for_each_used( [&plist]( guard& g ) {
+                    void * hptr = g.get( atomics::memory_order_acquire );
+                    if ( hptr )
+                        plist.push_back( hptr );
+                });
+            }
+        }
+
+        std::sort( plist.begin(), plist.end());
+
+        // Stage 2: free unguarded retired pointers, move guarded ones to the head of the range
+        retired_ptr* insert_pos = first;
+        for ( retired_ptr* it = first; it != last; ++it ) {
+            if ( std::binary_search( plist.begin(), plist.end(), it->m_p )) {
+                if ( insert_pos != it )
+                    std::swap( *insert_pos, *it );
+                ++insert_pos;
+            }
+        }
+        cds::gc::details::free_retired( insert_pos, last );
+
+        size_t const nGuarded = static_cast<size_t>( insert_pos - first );
+        budget_.update( reclaimer_retained_, nGuarded );
+        return nGuarded;
+    }
+
     CDS_EXPORT_API void smr::help_scan( thread_data* pThis )
     {
         assert( static_cast<thread_record*>( pThis )->m_idOwner.load( atomics::memory_order_relaxed ) == cds::OS::get_current_thread_id());
@@ -482,6 +815,7 @@ namespace cds { namespace gc { namespace hp {
             }
 
             src.interthread_clear();
+            budget_.update( hprec->retained_count_, 0 );
             hprec->m_bFree.store( true, atomics::memory_order_release );
             hprec->m_idOwner.store( nullThreadId, atomics::memory_order_release );
 
@@ -499,13 +833,42 @@ namespace cds { namespace gc { namespace hp {
             ++st.thread_rec_count;
             st.guard_allocated += hprec->hazards_.alloc_guard_count_;
             st.guard_freed     += hprec->hazards_.free_guard_count_;
+            st.hp_extend_count += hprec->hazards_.extend_call_count_;
             st.retired_count   += hprec->retired_.retire_call_count_;
             st.free_count      += hprec->free_count_;
             st.scan_count      += hprec->scan_count_;
             st.help_scan_count += hprec->help_scan_count_;
             CDS_TSAN_ANNOTATE_IGNORE_READS_END;
         }
+
+        {
+            // The counters of the unlinked records
+            std::unique_lock< cds::sync::spin > lock( thread_list_lock_ );
+            for ( thread_record* hprec = free_records_; hprec; hprec = hprec->m_pNextFree ) {
+                ++st.thread_rec_count;
+                st.guard_allocated += hprec->hazards_.alloc_guard_count_;
+                st.guard_freed     += hprec->hazards_.free_guard_count_;
+                st.hp_extend_count += hprec->hazards_.extend_call_count_;
+                st.retired_count   += hprec->retired_.retire_call_count_;
+                st.free_count      += hprec->free_count_;
+                st.scan_count      += hprec->scan_count_;
+                st.help_scan_count += hprec->help_scan_count_;
+            }
+        }
+
+        if ( reclaimer_ ) {
+            st.reclaim_count += reclaimer_->pass_count();
+            st.free_count    += reclaimer_->free_count();
+        }
 #   endif
+
+        st.retained_count        = budget_.retained();
+        st.budget_exceeded_count = budget_.exceeded_count();
+        st.thread_list_count     = thread_list_count_.load( atomics::memory_order_relaxed );
+        {
+            std::unique_lock< cds::sync::spin > lock( thread_list_lock_ );
+            st.thread_rec_compact_count = compact_count_;
+        }
     }
 
 }}} // namespace cds::gc::hp
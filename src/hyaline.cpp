@@ -0,0 +1,474 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+
+#include <cds/gc/hyaline.h>
+
+namespace cds { namespace gc { namespace hyaline {
+
+    namespace {
+        void * default_alloc_memory( size_t size )
+        {
+            return new uintptr_t[( size + sizeof( uintptr_t ) - 1 ) / sizeof( uintptr_t) ];
+        }
+
+        void default_free_memory( void* p )
+        {
+            delete[] reinterpret_cast<uintptr_t*>( p );
+        }
+
+        void* ( *s_alloc_memory )( size_t size ) = default_alloc_memory;
+        void ( *s_free_memory )( void* p ) = default_free_memory;
+
+        struct defaults {
+            static const size_t c_nGuardCount = 72;    // enough for the skip-list of max height 32
+            static const size_t c_nMaxThreadCount = 100;
+            static const size_t c_nBatchSize = 64;
+        };
+
+        stat s_postmortem_stat;
+
+        /// Retired batch
+        /*
+            The batch is allocated by contnuous block
+            Memory layout:
+            +--------------------------+
+            | retired_batch            |
+            |--------------------------|
+            | retired_ptr[count_]      |
+            |--------------------------|
+            | link[slot_count]         |
+            +--------------------------+
+
+            Each active slot gets its own link, so the batch is a node of several slot lists simultaneously.
+        */
+        struct retired_batch
+        {
+            struct link {
+                link*           next_;  ///< next link in the slot list
+                retired_batch*  batch_; ///< the batch owning the link
+            };
+
+            atomics::atomic<intptr_t>   refs_;  ///< count of the slot lists containing the batch
+            size_t                      count_; ///< count of retired pointers
+
+            explicit retired_batch( size_t count )
+                : refs_( 0 )
+                , count_( count )
+            {}
+
+            cds::gc::details::retired_ptr* items()
+            {
+                return reinterpret_cast<cds::gc::details::retired_ptr*>( this + 1 );
+            }
+
+            link* links()
+            {
+                return reinterpret_cast<link*>( items() + count_ );
+            }
+
+            static size_t calc_size( size_t count, size_t slot_count )
+            {
+                return sizeof( retired_batch ) + sizeof( cds::gc::details::retired_ptr ) * count + sizeof( link ) * slot_count;
+            }
+        };
+
+        static_assert( sizeof( retired_batch ) % sizeof( uintptr_t ) == 0, "retired_batch must be pointer-aligned" );
+
+        void free_batch( thread_data* pRec, retired_batch* b )
+        {
+            cds::gc::details::free_retired( b->items(), b->items() + b->count_ );
+            CDS_HYALINESTAT( pRec->free_count_ += b->count_ );
+            CDS_HYALINESTAT( ++pRec->batch_free_count_ );
+            CDS_UNUSED( pRec );
+
+            b->~retired_batch();
+            s_free_memory( b );
+        }
+    } // namespace
+
+    /*static*/ CDS_EXPORT_API smr* smr::instance_ = nullptr;
+    thread_local thread_data* tls_ = nullptr;
+
+    /*static*/ CDS_EXPORT_API thread_data* smr::tls()
+    {
+        // The thread attached to the Manager is attached to the GC on its first use of the GC.
+        // A thread not attached to the Manager would never be detached, so it gets no record
+        if ( cds_unlikely( tls_ == nullptr ) && cds::threading::Manager::isThreadAttached()
+            && cds::threading::Manager::thread_data()->is_attached())
+        {
+            attach_thread();
+        }
+        assert( tls_ != nullptr );
+        return tls_;
+    }
+
+    struct smr::slot
+    {
+        atomics::atomic<uintptr_t>  head_;  ///< Head of the retired list and c_active bit
+        char pad_[cds::c_nCacheLineSize - sizeof( atomics::atomic<uintptr_t>)];
+        atomics::atomic<bool>       busy_;  ///< true if the slot is owned by a thread
+        atomics::atomic<thread_record*> rec_;   ///< Thread data of the slot, created on first use and reused
+
+        slot()
+            : head_( 0 )
+            , busy_( false )
+            , rec_( nullptr )
+        {}
+    };
+
+    struct smr::slot_block
+    {
+        atomics::atomic<slot_block*>    next_;  ///< next slot block
+
+        slot_block()
+            : next_( nullptr )
+        {}
+
+        slot* slots()
+        {
+            return reinterpret_cast<slot*>( this + 1 );
+        }
+    };
+
+    struct smr::thread_record: thread_data
+    {
+        slot&   slot_;  ///< the owned slot
+
+        thread_record( guard* guards, size_t guard_count, cds::gc::details::retired_ptr* retired, size_t batch_size, slot& s )
+            : thread_data( guards, guard_count, retired, batch_size, s.head_ )
+            , slot_( s )
+        {}
+    };
+
+    /*static*/ CDS_EXPORT_API void smr::set_memory_allocator(
+        void* ( *alloc_func )( size_t size ),
+        void( *free_func )( void * p )
+    )
+    {
+        // The memory allocation functions may be set BEFORE initializing Hyaline SMR!!!
+        assert( instance_ == nullptr );
+
+        s_alloc_memory = alloc_func;
+        s_free_memory = free_func;
+    }
+
+
+    /*static*/ CDS_EXPORT_API void smr::construct( size_t nGuardCount, size_t nMaxThreadCount, size_t nBatchSize )
+    {
+        if ( !instance_ ) {
+            instance_ = new( s_alloc_memory(sizeof(smr))) smr( nGuardCount, nMaxThreadCount, nBatchSize );
+        }
+    }
+
+    /*static*/ CDS_EXPORT_API void smr::destruct( bool bDetachAll )
+    {
+        if ( instance_ ) {
+            if ( bDetachAll )
+                instance_->detach_all_thread();
+
+            instance_->~smr();
+            s_free_memory( instance_ );
+            instance_ = nullptr;
+        }
+        // The record of the current thread is freed with the GC
+        tls_ = nullptr;
+    }
+
+    CDS_EXPORT_API smr::smr( size_t nGuardCount, size_t nMaxThreadCount, size_t nBatchSize )
+        : guard_count_( nGuardCount == 0 ? defaults::c_nGuardCount : nGuardCount )
+        , max_thread_count_( nMaxThreadCount == 0 ? defaults::c_nMaxThreadCount : nMaxThreadCount )
+        , batch_size_( nBatchSize == 0 ? defaults::c_nBatchSize : nBatchSize )
+        , slot_count_( 0 )
+    {
+        slots_ = create_slot_block();
+    }
+
+    CDS_EXPORT_API smr::~smr()
+    {
+        CDS_HYALINESTAT( statistics( s_postmortem_stat ));
+
+        for ( slot_block* block = slots_; block; ) {
+            slot* s = block->slots();
+            for ( size_t i = 0; i < max_thread_count_; ++i ) {
+                // No thread is alive, all slots are inactive and all batches are freed
+                assert( s[i].head_.load( atomics::memory_order_relaxed ) == 0 );
+
+                thread_record* rec = s[i].rec_.load( atomics::memory_order_relaxed );
+                if ( rec )
+                    destroy_thread_data( rec );
+            }
+
+            slot_block* next = block->next_.load( atomics::memory_order_relaxed );
+            destroy_slot_block( block );
+            block = next;
+        }
+    }
+
+    CDS_EXPORT_API smr::slot_block* smr::create_slot_block()
+    {
+        slot_block* block = new( s_alloc_memory( sizeof( slot_block ) + sizeof( slot ) * max_thread_count_ )) slot_block;
+        slot* s = block->slots();
+        for ( size_t i = 0; i < max_thread_count_; ++i )
+            new( s + i ) slot;
+        return block;
+    }
+
+    CDS_EXPORT_API void smr::destroy_slot_block( slot_block* pBlock )
+    {
+        slot* s = pBlock->slots();
+        for ( size_t i = 0; i < max_thread_count_; ++i )
+            s[i].~slot();
+        pBlock->~slot_block();
+        s_free_memory( pBlock );
+    }
+
+
+    CDS_EXPORT_API smr::thread_record* smr::create_thread_data( slot& s )
+    {
+        size_t const guard_array_size = thread_guard_storage::calc_array_size( get_guard_count());
+        size_t const batch_array_size = sizeof( cds::gc::details::retired_ptr ) * get_batch_size();
+        size_t const nSize = sizeof( thread_record ) + guard_array_size + batch_array_size;
+
+        /*
+            The memory is allocated by contnuous block
+            Memory layout:
+            +--------------------------+
+            |                          |
+            | thread_record            |
+            |         guards_          +---+
+        +---|         retired_         |   |
+        |   |                          |   |
+        |   |--------------------------|   |
+        |   | guard[]                  |<--+
+        |   |                          |
+        |   |--------------------------|
+        +-->| retired_ptr[]            |
+            +--------------------------+
+        */
+
+        uint8_t* mem = reinterpret_cast<uint8_t*>( s_alloc_memory( nSize ));
+
+        return new( mem ) thread_record(
+            reinterpret_cast<guard*>( mem + sizeof( thread_record )),
+            get_guard_count(),
+            reinterpret_cast<cds::gc::details::retired_ptr*>( mem + sizeof( thread_record ) + guard_array_size ),
+            get_batch_size(),
+            s
+        );
+    }
+
+    /*static*/ CDS_EXPORT_API void smr::destroy_thread_data( thread_record* pRec )
+    {
+        // all retired pointers must be retired as a batch
+        assert( pRec->retired_count_ == 0 );
+
+        pRec->~thread_record();
+        s_free_memory( pRec );
+    }
+
+
+    CDS_EXPORT_API smr::thread_record* smr::alloc_thread_data()
+    {
+        // Take the lowest free slot so that the high-water mark of the slots grows slowly
+        size_t idx = 0;
+        for ( slot_block* block = slots_; ; ) {
+            slot* slots = block->slots();
+            for ( size_t i = 0; i < max_thread_count_; ++i, ++idx ) {
+                slot& s = slots[i];
+                bool busy = false;
+                if ( s.busy_.load( atomics::memory_order_relaxed )
+                    || !s.busy_.compare_exchange_strong( busy, true, atomics::memory_order_acquire, atomics::memory_order_relaxed ))
+                {
+                    continue;
+                }
+
+                thread_record* rec = s.rec_.load( atomics::memory_order_relaxed );
+                if ( !rec ) {
+                    rec = create_thread_data( s );
+                    s.rec_.store( rec, atomics::memory_order_release );
+                }
+
+                // The slot must be visible to retire_batch() before the thread activates it
+                size_t nCount = slot_count_.load( atomics::memory_order_relaxed );
+                while ( nCount <= idx && !slot_count_.compare_exchange_weak( nCount, idx + 1, atomics::memory_order_seq_cst, atomics::memory_order_relaxed ));
+
+                return rec;
+            }
+
+            // All slots of the block are busy, go to the next block
+            slot_block* next = block->next_.load( atomics::memory_order_acquire );
+            if ( !next ) {
+                slot_block* new_block = create_slot_block();
+                if ( block->next_.compare_exchange_strong( next, new_block, atomics::memory_order_acq_rel, atomics::memory_order_acquire ))
+                    next = new_block;
+                else
+                    destroy_slot_block( new_block );
+            }
+            block = next;
+        }
+    }
+
+    CDS_EXPORT_API void smr::free_thread_data( smr::thread_record* pRec )
+    {
+        assert( pRec != nullptr );
+
+        // The thread cannot hold any guard after detaching
+        pRec->leave();
+        retire_batch( pRec );
+
+        pRec->slot_.busy_.store( false, atomics::memory_order_release );
+    }
+
+    CDS_EXPORT_API void smr::detach_all_thread()
+    {
+        // Deactivate all slots first, so the batches retired below are freed immediately
+        for ( int pass = 0; pass < 2; ++pass ) {
+            for ( slot_block* block = slots_; block; block = block->next_.load( atomics::memory_order_acquire )) {
+                slot* s = block->slots();
+                for ( size_t i = 0; i < max_thread_count_; ++i ) {
+                    thread_record* rec = s[i].rec_.load( atomics::memory_order_acquire );
+                    if ( rec && s[i].busy_.load( atomics::memory_order_acquire )) {
+                        if ( pass == 0 )
+                            rec->leave();
+                        else
+                            free_thread_data( rec );
+                    }
+                }
+            }
+        }
+    }
+
+    /*static*/ CDS_EXPORT_API void smr::attach_thread()
+    {
+        if ( !tls_ )
+            tls_ = instance().alloc_thread_data();
+    }
+
+    /*static*/ CDS_EXPORT_API void smr::detach_thread()
+    {
+        thread_data* rec = tls_;
+        if ( rec ) {
+            tls_ = nullptr;
+            instance().free_thread_data( static_cast<thread_record*>( rec ));
+        }
+    }
+
+    CDS_EXPORT_API void smr::retire_batch( thread_data* pRec )
+    {
+        size_t const nCount = pRec->retired_count_;
+        if ( nCount == 0 )
+            return;
+        pRec->retired_count_ = 0;
+
+        // The retired objects are unlinked from the containers before this point.
+        // Pairs with the seq_cst store of thread_data::enter(): a slot activated after the fence
+        // cannot see the retired objects, a slot activated before the fence is found below
+        atomics::atomic_thread_fence( atomics::memory_order_seq_cst );
+        size_t const nSlots = slot_count_.load( atomics::memory_order_seq_cst );
+
+        retired_batch* b = new( s_alloc_memory( retired_batch::calc_size( nCount, nSlots ))) retired_batch( nCount );
+        std::copy( pRec->retired_, pRec->retired_ + nCount, b->items());
+        CDS_HYALINESTAT( ++pRec->batch_count_ );
+
+        // The blocks of first nSlots slots are linked before slot_count_ is raised
+        retired_batch::link* link = b->links();
+        intptr_t nInserted = 0;
+        size_t idx = 0;
+        for ( slot_block* block = slots_; idx < nSlots; block = block->next_.load( atomics::memory_order_acquire )) {
+            slot* s = block->slots();
+            for ( size_t i = 0; i < max_thread_count_ && idx < nSlots; ++i, ++idx, ++link ) {
+                atomics::atomic<uintptr_t>& head = s[i].head_;
+                uintptr_t cur = head.load( atomics::memory_order_acquire );
+                while ( cur & c_active ) {
+                    link->next_ = reinterpret_cast<retired_batch::link*>( cur & ~c_active );
+                    link->batch_ = b;
+                    if ( head.compare_exchange_weak( cur, reinterpret_cast<uintptr_t>( link ) | c_active, atomics::memory_order_acq_rel, atomics::memory_order_acquire )) {
+                        ++nInserted;
+                        break;
+                    }
+                }
+            }
+        }
+
+        // The threads may have left their slots already, so the counter may be negative here
+        if ( b->refs_.fetch_add( nInserted, atomics::memory_order_acq_rel ) + nInserted == 0 )
+            free_batch( pRec, b );
+    }
+
+    /*static*/ CDS_EXPORT_API void smr::traverse( thread_data* pRec, uintptr_t list )
+    {
+        for ( retired_batch::link* l = reinterpret_cast<retired_batch::link*>( list ); l; ) {
+            // The link is a part of the batch and can be freed by fetch_sub below
+            retired_batch::link* next = l->next_;
+            retired_batch* b = l->batch_;
+
+            CDS_HYALINESTAT( ++pRec->traverse_count_ );
+            if ( b->refs_.fetch_sub( 1, atomics::memory_order_acq_rel ) == 1 )
+                free_batch( pRec, b );
+
+            l = next;
+        }
+    }
+
+    CDS_EXPORT_API void smr::statistics( stat& st )
+    {
+        st.clear();
+#   ifdef CDS_ENABLE_HPSTAT
+        for ( slot_block* block = slots_; block; block = block->next_.load( atomics::memory_order_acquire )) {
+            slot* s = block->slots();
+            for ( size_t i = 0; i < max_thread_count_; ++i ) {
+                thread_record* rec = s[i].rec_.load( atomics::memory_order_acquire );
+                if ( !rec )
+                    continue;
+
+                CDS_TSAN_ANNOTATE_IGNORE_READS_BEGIN;
+                ++st.thread_rec_count;
+                st.guard_allocated      += rec->guards_.alloc_guard_count_;
+                st.guard_freed          += rec->guards_.free_guard_count_;
+                st.retired_count        += rec->retire_call_count_;
+                st.free_count           += rec->free_count_;
+                st.batch_count          += rec->batch_count_;
+                st.batch_free_count     += rec->batch_free_count_;
+                st.enter_count          += rec->enter_count_;
+                st.traverse_count       += rec->traverse_count_;
+                CDS_TSAN_ANNOTATE_IGNORE_READS_END;
+            }
+        }
+#   endif
+    }
+
+}}} // namespace cds::gc::hyaline
+
+CDS_EXPORT_API /*static*/ cds::gc::Hyaline::stat const& cds::gc::Hyaline::postmortem_statistics()
+{
+    return cds::gc::hyaline::s_postmortem_stat;
+}
@@ -31,6 +31,7 @@
 #include <cds/init.h>
 #include <cds/algo/atomic.h>
 #include <cds/algo/backoff_strategy.h>
+#include <cds/gc/details/retired_ptr.h>
 
 #if CDS_OS_INTERFACE == CDS_OSI_WINDOWS && CDS_OS_TYPE != CDS_OS_MINGW
 #   if CDS_COMPILER == CDS_COMPILER_MSVC || CDS_COMPILER == CDS_COMPILER_INTEL
@@ -88,6 +89,47 @@ namespace cds {
         }
     } // namespace details
 
+    namespace gc { namespace details {
+        namespace {
+            struct batch_disposer_entry {
+                atomics::atomic<free_retired_ptr_func>  func;
+                free_retired_batch_func                 batch_func;
+            };
+
+            static size_t const c_nBatchDisposerCapacity = 64;
+            batch_disposer_entry s_batchDisposers[c_nBatchDisposerCapacity];
+            atomics::atomic<size_t> s_nBatchDisposerCount( 0 );
+        } // namespace
+
+        /*static*/ CDS_EXPORT_API bool batch_disposer_registry::add( free_retired_ptr_func func, free_retired_batch_func batch_func )
+        {
+            size_t const idx = s_nBatchDisposerCount.fetch_add( 1, atomics::memory_order_relaxed );
+            if ( idx >= c_nBatchDisposerCapacity ) {
+                s_nBatchDisposerCount.fetch_sub( 1, atomics::memory_order_relaxed );
+                return false;
+            }
+
+            s_batchDisposers[idx].batch_func = batch_func;
+            s_batchDisposers[idx].func.store( func, atomics::memory_order_release );
+            return true;
+        }
+
+        /*static*/ CDS_EXPORT_API free_retired_batch_func batch_disposer_registry::find( free_retired_ptr_func func )
+        {
+            size_t const count = std::min( s_nBatchDisposerCount.load( atomics::memory_order_acquire ), c_nBatchDisposerCapacity );
+            for ( size_t i = 0; i < count; ++i ) {
+                if ( s_batchDisposers[i].func.load( atomics::memory_order_acquire ) == func )
+                    return s_batchDisposers[i].batch_func;
+            }
+            return nullptr;
+        }
+
+        /*static*/ CDS_EXPORT_API bool batch_disposer_registry::empty()
+        {
+            return s_nBatchDisposerCount.load( atomics::memory_order_relaxed ) == 0;
+        }
+    }} // namespace gc::details
+
     namespace backoff {
         /*static*/ size_t exponential_runtime_traits::lower_bound = 16;
         /*static*/ size_t exponential_runtime_traits::upper_bound = 16 * 1024;
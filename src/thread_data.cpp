@@ -31,6 +31,9 @@
 #include <cds/threading/details/_common.h>
 #include <cds/gc/hp.h>
 #include <cds/gc/dhp.h>
+#include <cds/gc/he.h>
+#include <cds/gc/ebr.h>
+#include <cds/gc/hyaline.h>
 
 namespace cds { namespace threading {
 
@@ -39,50 +42,37 @@ namespace cds { namespace threading {
 
     CDS_EXPORT_API void ThreadData::init()
     {
-        if ( m_nAttachCount++ == 0 ) {
-            if ( cds::gc::HP::isUsed())
-                cds::gc::hp::smr::attach_thread();
-            if ( cds::gc::DHP::isUsed())
-                cds::gc::dhp::smr::attach_thread();
-
-            if ( cds::urcu::details::singleton<cds::urcu::general_instant_tag>::isUsed())
-                m_pGPIRCU = cds::urcu::details::singleton<cds::urcu::general_instant_tag>::attach_thread();
-            if ( cds::urcu::details::singleton<cds::urcu::general_buffered_tag>::isUsed())
-                m_pGPBRCU = cds::urcu::details::singleton<cds::urcu::general_buffered_tag>::attach_thread();
-            if ( cds::urcu::details::singleton<cds::urcu::general_threaded_tag>::isUsed())
-                m_pGPTRCU = cds::urcu::details::singleton<cds::urcu::general_threaded_tag>::attach_thread();
-#ifdef CDS_URCU_SIGNAL_HANDLING_ENABLED
-            if ( cds::urcu::details::singleton<cds::urcu::signal_buffered_tag>::isUsed())
-                m_pSHBRCU = cds::urcu::details::singleton<cds::urcu::signal_buffered_tag>::attach_thread();
-#endif
-        }
+        // The thread is attached to each GC lazily on its first use of the GC,
+        // see cds::gc::hp::smr::tls() and ThreadData::attach_rcu()
+        ++m_nAttachCount;
     }
 
     CDS_EXPORT_API bool ThreadData::fini()
     {
         if ( --m_nAttachCount == 0 ) {
+            // detach_thread() does nothing if the thread has not used the GC
+            if ( cds::gc::Hyaline::isUsed())
+                cds::gc::hyaline::smr::detach_thread();
+            if ( cds::gc::EBR::isUsed())
+                cds::gc::ebr::smr::detach_thread();
+            if ( cds::gc::HE::isUsed())
+                cds::gc::he::smr::detach_thread();
             if ( cds::gc::DHP::isUsed())
                 cds::gc::dhp::smr::detach_thread();
             if ( cds::gc::HP::isUsed())
                 cds::gc::hp::smr::detach_thread();
 
-            if ( cds::urcu::details::singleton<cds::urcu::general_instant_tag>::isUsed()) {
-                cds::urcu::details::singleton<cds::urcu::general_instant_tag>::detach_thread( m_pGPIRCU );
-                m_pGPIRCU = nullptr;
-            }
-            if ( cds::urcu::details::singleton<cds::urcu::general_buffered_tag>::isUsed()) {
-                cds::urcu::details::singleton<cds::urcu::general_buffered_tag>::detach_thread( m_pGPBRCU );
-                m_pGPBRCU = nullptr;
-            }
-            if ( cds::urcu::details::singleton<cds::urcu::general_threaded_tag>::isUsed()) {
-                cds::urcu::details::singleton<cds::urcu::general_threaded_tag>::detach_thread( m_pGPTRCU );
-                m_pGPTRCU = nullptr;
-            }
+            detach_rcu( m_pGPIRCU );
+            detach_rcu( m_pGPBRCU );
+            detach_rcu( m_pGPTRCU );
+            detach_rcu( m_pGPLBRCU );
+            detach_rcu( m_pQSBRCU );
+            detach_rcu( m_pPCBRCU );
 #ifdef CDS_URCU_SIGNAL_HANDLING_ENABLED
-            if ( cds::urcu::details::singleton<cds::urcu::signal_buffered_tag>::isUsed()) {
-                cds::urcu::details::singleton<cds::urcu::signal_buffered_tag>::detach_thread( m_pSHBRCU );
-                m_pSHBRCU = nullptr;
-            }
+            detach_rcu( m_pSHBRCU );
+#endif
+#ifdef CDS_URCU_MEMBARRIER_ENABLED
+            detach_rcu( m_pMBBRCU );
 #endif
             return true;
         }
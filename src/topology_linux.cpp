@@ -33,6 +33,8 @@
 #if CDS_OS_TYPE == CDS_OS_LINUX
 
 #include <thread>
+#include <fstream>
+#include <string>
 /*
 #include <unistd.h>
 #include <fstream>
@@ -41,6 +43,7 @@
 namespace cds { namespace OS { inline namespace Linux {
 
     unsigned int topology::s_nProcessorCount = 0;
+    unsigned int topology::s_nNumaNodeCount = 1;
 
     void topology::init()
     {
@@ -70,6 +73,18 @@ namespace cds { namespace OS { inline namespace Linux {
             }
          }
 */
+
+        // The file contains the list of possible node ranges like "0", "0-1" or "0,2-3",
+        // the last number is the max node id
+        s_nNumaNodeCount = 1;
+        std::ifstream nodes( "/sys/devices/system/node/possible" );
+        std::string line;
+        if ( nodes.is_open() && std::getline( nodes, line )) {
+            std::string::size_type pos = line.find_last_not_of( "0123456789" );
+            std::string const maxNode = pos == std::string::npos ? line : line.substr( pos + 1 );
+            if ( !maxNode.empty())
+                s_nNumaNodeCount = static_cast<unsigned int>( std::stoul( maxNode )) + 1;
+        }
     }
 
     void topology::fini()
@@ -38,7 +38,9 @@ namespace cds { namespace urcu { namespace details {
     template <>
     void sh_singleton<signal_buffered_tag>::signal_handler( int /*signo*/, siginfo_t * /*sigInfo*/, void * /*context*/ )
     {
-        thread_record * pRec = cds::threading::getRCU<signal_buffered_tag>();
+        // Do not use getRCU() here: it attaches the thread lazily, that is not async-signal-safe
+        cds::threading::ThreadData * pData = cds::threading::Manager::thread_data();
+        thread_record * pRec = pData ? pData->m_pSHBRCU : nullptr;
         if ( pRec ) {
             atomics::atomic_signal_fence( atomics::memory_order_acquire );
             pRec->m_bNeedMemBar.store( false, atomics::memory_order_relaxed );
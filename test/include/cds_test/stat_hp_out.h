@@ -47,7 +47,13 @@ namespace cds_test {
             << CDS_HPSTAT_OUT( s, free_count )
             << CDS_HPSTAT_OUT( s, scan_count )
             << CDS_HPSTAT_OUT( s, help_scan_count )
-            << CDS_HPSTAT_OUT( s, thread_rec_count );
+            << CDS_HPSTAT_OUT( s, reclaim_count )
+            << CDS_HPSTAT_OUT( s, thread_rec_count )
+            << CDS_HPSTAT_OUT( s, hp_extend_count )
+            << CDS_HPSTAT_OUT( s, retained_count )
+            << CDS_HPSTAT_OUT( s, budget_exceeded_count )
+            << CDS_HPSTAT_OUT( s, thread_list_count )
+            << CDS_HPSTAT_OUT( s, thread_rec_compact_count );
 #   undef CDS_HPSTAT_OUT
 #else
         return o;
@@ -68,7 +74,13 @@ static inline std::ostream& operator <<( std::ostream& o, cds::gc::HP::stat cons
         << CDS_HPSTAT_OUT( s, free_count )
         << CDS_HPSTAT_OUT( s, scan_count )
         << CDS_HPSTAT_OUT( s, help_scan_count )
-        << CDS_HPSTAT_OUT( s, thread_rec_count );
+        << CDS_HPSTAT_OUT( s, reclaim_count )
+        << CDS_HPSTAT_OUT( s, thread_rec_count )
+        << CDS_HPSTAT_OUT( s, hp_extend_count )
+        << CDS_HPSTAT_OUT( s, retained_count )
+        << CDS_HPSTAT_OUT( s, budget_exceeded_count )
+        << CDS_HPSTAT_OUT( s, thread_list_count )
+        << CDS_HPSTAT_OUT( s, thread_rec_compact_count );
 #   undef CDS_HPSTAT_OUT
 #else
     return o;
@@ -0,0 +1,77 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CDSTEST_STAT_URCU_OUT_H
+#define CDSTEST_STAT_URCU_OUT_H
+
+#include <cds/urcu/details/base.h>
+#include <string>
+
+namespace cds_test {
+
+    static inline property_stream& operator <<( property_stream& o, cds::urcu::empty_stat const& /*s*/ )
+    {
+        return o;
+    }
+
+    template <typename Counter>
+    static inline property_stream& operator <<( property_stream& o, cds::urcu::stat<Counter> const& s )
+    {
+        typedef cds::urcu::stat<Counter> stat_type;
+
+        o   << CDSSTRESS_STAT_OUT( s, m_nGracePeriod )
+            << CDSSTRESS_STAT_OUT( s, m_nExpeditedGracePeriod )
+            << CDSSTRESS_STAT_OUT( s, m_nForcedSynchronize )
+            << CDSSTRESS_STAT_OUT( s, m_nReaderWait )
+            << CDSSTRESS_STAT_OUT( s, m_nReaderWaitSpin )
+            << CDSSTRESS_STAT_OUT_( property_stream::stat_prefix() + ".m_nGPTotalNs", s.m_nGPTotalNs.load( atomics::memory_order_relaxed ))
+            << CDSSTRESS_STAT_OUT_( property_stream::stat_prefix() + ".m_nGPMaxNs", s.m_nGPMaxNs.load( atomics::memory_order_relaxed ))
+            << CDSSTRESS_STAT_OUT_( property_stream::stat_prefix() + ".m_nExpeditedTotalNs", s.m_nExpeditedTotalNs.load( atomics::memory_order_relaxed ))
+            << CDSSTRESS_STAT_OUT_( property_stream::stat_prefix() + ".m_nExpeditedMaxNs", s.m_nExpeditedMaxNs.load( atomics::memory_order_relaxed ))
+            << CDSSTRESS_STAT_OUT_( property_stream::stat_prefix() + ".m_nBufferHighWater", s.m_nBufferHighWater.load( atomics::memory_order_relaxed ));
+
+        // Only non-empty buckets of the latency histogram are printed
+        for ( size_t i = 0; i < stat_type::c_nLatencyBucketCount; ++i ) {
+            auto nCount = s.m_arrLatency[i].get();
+            if ( nCount == 0 )
+                continue;
+            std::string name = property_stream::stat_prefix();
+            if ( i + 1 < stat_type::c_nLatencyBucketCount )
+                name += ".gp_latency_lt_" + std::to_string( stat_type::bucket_upper_ns( i )) + "ns";
+            else
+                name += ".gp_latency_ge_" + std::to_string( stat_type::bucket_upper_ns( i - 1 )) + "ns";
+            o << CDSSTRESS_STAT_OUT_( name, nCount );
+        }
+        return o;
+    }
+
+} // namespace cds_test
+
+#endif // #ifndef CDSTEST_STAT_URCU_OUT_H
@@ -184,6 +184,7 @@ namespace cds_test {
         void TearDown()
         {
             print_hp_stat();
+            print_rcu_stat();
             base_class::TearDown();
         }
 
@@ -193,6 +194,7 @@ namespace cds_test {
         }
 
         static void print_hp_stat();
+        static void print_rcu_stat();
 
     public:
         static config const& get_config( char const * slot );
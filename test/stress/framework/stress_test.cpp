@@ -35,6 +35,17 @@
 #ifdef CDS_ENABLE_HPSTAT
 #   include <cds_test/stat_hp_out.h>
 #   include <cds_test/stat_dhp_out.h>
+#   include <cds_test/stat_he_out.h>
+#   include <cds_test/stat_ebr_out.h>
+#   include <cds_test/stat_hyaline_out.h>
+#endif
+
+#ifdef CDS_ENABLE_URCU_STAT
+#   include <cds/urcu/general_instant.h>
+#   include <cds/urcu/general_buffered.h>
+#   include <cds/urcu/general_threaded.h>
+#   include <cds/urcu/general_local_buffered.h>
+#   include <cds_test/stat_urcu_out.h>
 #endif
 
 namespace cds_test {
@@ -73,6 +84,37 @@ namespace cds_test {
             cds::gc::DHP::statistics( st );
             propout() << st;
         }
+        {
+            cds::gc::HE::stat st;
+            cds::gc::HE::statistics( st );
+            propout() << st;
+        }
+        {
+            cds::gc::EBR::stat st;
+            cds::gc::EBR::statistics( st );
+            propout() << st;
+        }
+        {
+            cds::gc::Hyaline::stat st;
+            cds::gc::Hyaline::statistics( st );
+            propout() << st;
+        }
+#endif
+    }
+
+    /*static*/ void stress_fixture::print_rcu_stat()
+    {
+#ifdef CDS_ENABLE_URCU_STAT
+        // The statistics of the default instantiations only; it is cumulative for the RCU singleton lifetime
+        if ( cds::urcu::general_instant<>::isUsed())
+            propout() << stat_prefix( "rcu_gpi" ) << cds::urcu::general_instant<>::instance()->internal_statistics();
+        if ( cds::urcu::general_buffered<>::isUsed())
+            propout() << stat_prefix( "rcu_gpb" ) << cds::urcu::general_buffered<>::instance()->internal_statistics();
+        if ( cds::urcu::general_threaded<>::isUsed())
+            propout() << stat_prefix( "rcu_gpt" ) << cds::urcu::general_threaded<>::instance()->internal_statistics();
+        if ( cds::urcu::general_local_buffered<>::isUsed())
+            propout() << stat_prefix( "rcu_gplb" ) << cds::urcu::general_local_buffered<>::instance()->internal_statistics();
+        propout() << stat_prefix();
 #endif
     }
 
@@ -0,0 +1,195 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cds_test/stress_test.h>
+#include <cds/gc/hp.h>
+#include <cds/gc/dhp.h>
+
+// Benchmark of HP/DHP scan() algorithm.
+// Each thread holds all its guards on the live items and retires an item on each iteration,
+// so scan() searches a full retired array against <tt>ThreadCount * GuardCount</tt> hazard pointers.
+// Run it with different hp_scan_strategy values to compare HP scan algorithms.
+namespace {
+
+    class hp_scan: public cds_test::stress_fixture
+    {
+    protected:
+        static size_t s_nThreadCount;
+        static size_t s_nGuardCount;
+        static size_t s_nPassCount;
+
+        static atomics::atomic<size_t> s_nDisposedCount;
+
+        struct item
+        {
+            size_t  nNo;
+
+            explicit item( size_t n )
+                : nNo( n )
+            {}
+        };
+
+        struct disposer
+        {
+            void operator()( item* p ) const
+            {
+                s_nDisposedCount.fetch_add( 1, atomics::memory_order_relaxed );
+                delete p;
+            }
+        };
+
+        template <class GC>
+        class Worker: public cds_test::thread
+        {
+            typedef cds_test::thread base_class;
+        public:
+            size_t  m_nRetired = 0;
+
+        public:
+            explicit Worker( cds_test::thread_pool& pool )
+                : base_class( pool )
+            {}
+
+            Worker( Worker& src )
+                : base_class( src )
+            {}
+
+            virtual thread * clone()
+            {
+                return new Worker( *this );
+            }
+
+            virtual void test()
+            {
+                std::unique_ptr< typename GC::Guard[] > guards( new typename GC::Guard[ s_nGuardCount ] );
+
+                for ( size_t pass = 0; pass < s_nPassCount; ++pass ) {
+                    typename GC::Guard& g = guards[ pass % s_nGuardCount ];
+
+                    item* old = g.template get<item>();
+                    g.assign( new item( pass ));
+                    if ( old ) {
+                        GC::template retire<disposer>( old );
+                        ++m_nRetired;
+                    }
+                }
+
+                for ( size_t i = 0; i < s_nGuardCount; ++i ) {
+                    item* old = guards[i].template get<item>();
+                    guards[i].clear();
+                    if ( old ) {
+                        GC::template retire<disposer>( old );
+                        ++m_nRetired;
+                    }
+                }
+            }
+        };
+
+    public:
+        static void SetUpTestCase()
+        {
+            cds_test::config const& cfg = get_config( "hp_scan" );
+
+            s_nThreadCount = cfg.get_size_t( "ThreadCount", s_nThreadCount );
+            s_nGuardCount = cfg.get_size_t( "GuardCount", s_nGuardCount );
+            s_nPassCount = cfg.get_size_t( "PassCount", s_nPassCount );
+
+            if ( s_nThreadCount == 0 )
+                s_nThreadCount = 1;
+            if ( s_nGuardCount == 0 )
+                s_nGuardCount = 1;
+            if ( s_nPassCount == 0 )
+                s_nPassCount = 100000;
+        }
+
+    protected:
+        template <class GC>
+        void test( size_t nGuardCount )
+        {
+            cds_test::thread_pool& pool = get_pool();
+
+            size_t const nSaveGuardCount = s_nGuardCount;
+            s_nGuardCount = nGuardCount;
+            s_nDisposedCount.store( 0, atomics::memory_order_relaxed );
+
+            pool.add( new Worker<GC>( pool ), s_nThreadCount );
+
+            propout() << std::make_pair( "thread_count", s_nThreadCount )
+                << std::make_pair( "guard_count", s_nGuardCount )
+                << std::make_pair( "pass_count", s_nPassCount );
+
+            std::chrono::milliseconds duration = pool.run();
+
+            propout() << std::make_pair( "duration", duration );
+
+            size_t nRetired = 0;
+            for ( size_t i = 0; i < pool.size(); ++i )
+                nRetired += static_cast<Worker<GC>&>( pool.get( i )).m_nRetired;
+
+            GC::force_dispose();
+
+            size_t const nDisposed = s_nDisposedCount.load( atomics::memory_order_relaxed );
+            EXPECT_LE( nDisposed, nRetired );
+            propout() << std::make_pair( "retired_count", nRetired )
+                << std::make_pair( "disposed_count", nDisposed );
+
+            s_nGuardCount = nSaveGuardCount;
+        }
+    };
+
+    size_t hp_scan::s_nThreadCount = 8;
+    size_t hp_scan::s_nGuardCount = 16;
+    size_t hp_scan::s_nPassCount = 1000000;
+    atomics::atomic<size_t> hp_scan::s_nDisposedCount( 0 );
+
+    TEST_F( hp_scan, HP )
+    {
+        switch ( cds::gc::HP::getScanType()) {
+        case cds::gc::HP::scan_type::classic:
+            propout() << std::make_pair( "scan_type", "classic" );
+            break;
+        case cds::gc::HP::scan_type::inplace:
+            propout() << std::make_pair( "scan_type", "inplace" );
+            break;
+        case cds::gc::HP::scan_type::hashed:
+            propout() << std::make_pair( "scan_type", "hashed" );
+            break;
+        }
+
+        // the thread's guard count is limited by HP hazard_pointer_count
+        test<cds::gc::HP>( std::min( s_nGuardCount, cds::gc::HP::max_hazard_count()));
+    }
+
+    TEST_F( hp_scan, DHP )
+    {
+        test<cds::gc::DHP>( s_nGuardCount );
+    }
+
+} // namespace
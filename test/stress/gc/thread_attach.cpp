@@ -0,0 +1,216 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cds_test/stress_test.h>
+#include <cds/gc/hp.h>
+#include <cds/gc/dhp.h>
+#ifdef CDSUNIT_USE_URCU
+#   include <cds/urcu/general_buffered.h>
+#endif
+
+// Benchmark of thread create/attach/detach latency.
+// Each of ThreadCount threads starts PassCount short-lived threads one by one.
+// A short-lived thread attaches to cds::threading::Manager, uses one GC and detaches.
+// The thread is attached to a GC on its first use of the GC, so a thread that uses one GC
+// should not pay for other constructed GCs and should not appear in their thread lists.
+namespace {
+
+    class thread_attach: public cds_test::stress_fixture
+    {
+    protected:
+        static size_t s_nThreadCount;
+        static size_t s_nPassCount;
+
+        typedef std::chrono::steady_clock clock_type;
+
+        struct no_gc
+        {
+            static void use()
+            {}
+        };
+
+        template <class GC>
+        struct hp_like_gc
+        {
+            static void use()
+            {
+                typename GC::Guard g;
+                int n = 0;
+                g.assign( &n );
+            }
+        };
+
+#ifdef CDSUNIT_USE_URCU
+        struct gpb_rcu
+        {
+            typedef cds::urcu::gc< cds::urcu::general_buffered<>> rcu_type;
+
+            static void use()
+            {
+                rcu_type::scoped_lock sl;
+            }
+        };
+#endif
+
+        template <class UseGC>
+        class Worker: public cds_test::thread
+        {
+            typedef cds_test::thread base_class;
+        public:
+            clock_type::duration    m_nCreateTime{};
+            clock_type::duration    m_nAttachTime{};
+            clock_type::duration    m_nDetachTime{};
+            clock_type::duration    m_nMaxTime{};
+
+        public:
+            explicit Worker( cds_test::thread_pool& pool )
+                : base_class( pool )
+            {}
+
+            Worker( Worker& src )
+                : base_class( src )
+            {}
+
+            virtual thread * clone()
+            {
+                return new Worker( *this );
+            }
+
+            virtual void test()
+            {
+                for ( size_t pass = 0; pass < s_nPassCount; ++pass ) {
+                    clock_type::time_point tAttach, tDetach, tEnd;
+
+                    clock_type::time_point const tStart = clock_type::now();
+                    std::thread t( [&tAttach, &tDetach, &tEnd]() {
+                        tAttach = clock_type::now();
+                        cds::threading::Manager::attachThread();
+                        UseGC::use();
+                        tDetach = clock_type::now();
+                        cds::threading::Manager::detachThread();
+                        tEnd = clock_type::now();
+                    });
+                    t.join();
+                    clock_type::duration const d = clock_type::now() - tStart;
+
+                    m_nCreateTime += tAttach - tStart;
+                    m_nAttachTime += tDetach - tAttach;
+                    m_nDetachTime += tEnd - tDetach;
+                    if ( d > m_nMaxTime )
+                        m_nMaxTime = d;
+                }
+            }
+        };
+
+    public:
+        static void SetUpTestCase()
+        {
+            cds_test::config const& cfg = get_config( "thread_attach" );
+
+            s_nThreadCount = cfg.get_size_t( "ThreadCount", s_nThreadCount );
+            s_nPassCount = cfg.get_size_t( "PassCount", s_nPassCount );
+
+            if ( s_nThreadCount == 0 )
+                s_nThreadCount = 1;
+            if ( s_nPassCount == 0 )
+                s_nPassCount = 1000;
+        }
+
+    protected:
+        static size_t hp_thread_list_count()
+        {
+            cds::gc::HP::stat st;
+            cds::gc::HP::statistics( st );
+            return st.thread_list_count;
+        }
+
+        template <class UseGC>
+        void test()
+        {
+            cds_test::thread_pool& pool = get_pool();
+            pool.add( new Worker<UseGC>( pool ), s_nThreadCount );
+
+            propout() << std::make_pair( "thread_count", s_nThreadCount )
+                << std::make_pair( "pass_count", s_nPassCount );
+
+            size_t const nHPThreadCount = hp_thread_list_count();
+
+            std::chrono::milliseconds duration = pool.run();
+            propout() << std::make_pair( "duration", duration );
+
+            clock_type::duration tCreate{}, tAttach{}, tDetach{}, tMax{};
+            for ( size_t i = 0; i < pool.size(); ++i ) {
+                Worker<UseGC>& w = static_cast<Worker<UseGC>&>( pool.get( i ));
+                tCreate += w.m_nCreateTime;
+                tAttach += w.m_nAttachTime;
+                tDetach += w.m_nDetachTime;
+                if ( w.m_nMaxTime > tMax )
+                    tMax = w.m_nMaxTime;
+            }
+
+            typedef std::chrono::nanoseconds ns;
+            size_t const nTotal = s_nThreadCount * s_nPassCount;
+            propout() << std::make_pair( "avg_create_ns", static_cast<size_t>( std::chrono::duration_cast<ns>( tCreate ).count() / nTotal ))
+                << std::make_pair( "avg_attach_ns", static_cast<size_t>( std::chrono::duration_cast<ns>( tAttach ).count() / nTotal ))
+                << std::make_pair( "avg_detach_ns", static_cast<size_t>( std::chrono::duration_cast<ns>( tDetach ).count() / nTotal ))
+                << std::make_pair( "max_thread_ns", static_cast<size_t>( std::chrono::duration_cast<ns>( tMax ).count()));
+
+            // Threads that do not use HP must not be attached to HP
+            if ( !std::is_same< UseGC, hp_like_gc<cds::gc::HP>>::value )
+                EXPECT_LE( hp_thread_list_count(), nHPThreadCount );
+        }
+    };
+
+    size_t thread_attach::s_nThreadCount = 4;
+    size_t thread_attach::s_nPassCount = 10000;
+
+    TEST_F( thread_attach, no_gc )
+    {
+        test<no_gc>();
+    }
+
+    TEST_F( thread_attach, HP )
+    {
+        test<hp_like_gc<cds::gc::HP>>();
+    }
+
+    TEST_F( thread_attach, DHP )
+    {
+        test<hp_like_gc<cds::gc::DHP>>();
+    }
+
+#ifdef CDSUNIT_USE_URCU
+    TEST_F( thread_attach, RCU_GPB )
+    {
+        test<gpb_rcu>();
+    }
+#endif
+
+} // namespace
@@ -0,0 +1,218 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cds_test/stress_test.h>
+#include <cds/gc/hp.h>
+#include <cds/gc/dhp.h>
+
+// Thread churn test of HP/DHP thread list.
+// BurstCount times BurstThreadCount short-lived threads attach, retire some items and detach.
+// After the burst the free thread records should be unlinked from the thread list,
+// so scan() of ThreadCount long-lived threads costs the same as before the burst.
+namespace {
+
+    class thread_churn: public cds_test::stress_fixture
+    {
+    protected:
+        static size_t s_nThreadCount;
+        static size_t s_nPassCount;
+        static size_t s_nBurstThreadCount;
+        static size_t s_nBurstCount;
+        static size_t s_nBurstPassCount;
+
+        static atomics::atomic<size_t> s_nDisposedCount;
+
+        struct item
+        {
+            size_t  nNo;
+
+            explicit item( size_t n )
+                : nNo( n )
+            {}
+        };
+
+        struct disposer
+        {
+            void operator()( item* p ) const
+            {
+                s_nDisposedCount.fetch_add( 1, atomics::memory_order_relaxed );
+                delete p;
+            }
+        };
+
+        template <class GC>
+        class Worker: public cds_test::thread
+        {
+            typedef cds_test::thread base_class;
+        public:
+            size_t  m_nRetired = 0;
+            size_t const m_nPassCount;
+
+        public:
+            Worker( cds_test::thread_pool& pool, size_t nPassCount )
+                : base_class( pool )
+                , m_nPassCount( nPassCount )
+            {}
+
+            Worker( Worker& src )
+                : base_class( src )
+                , m_nPassCount( src.m_nPassCount )
+            {}
+
+            virtual thread * clone()
+            {
+                return new Worker( *this );
+            }
+
+            virtual void test()
+            {
+                typename GC::Guard g;
+
+                for ( size_t pass = 0; pass < m_nPassCount; ++pass ) {
+                    item* old = g.template get<item>();
+                    g.assign( new item( pass ));
+                    if ( old ) {
+                        GC::template retire<disposer>( old );
+                        ++m_nRetired;
+                    }
+                }
+
+                item* old = g.template get<item>();
+                g.clear();
+                if ( old ) {
+                    GC::template retire<disposer>( old );
+                    ++m_nRetired;
+                }
+            }
+        };
+
+    public:
+        static void SetUpTestCase()
+        {
+            cds_test::config const& cfg = get_config( "thread_churn" );
+
+            s_nThreadCount = cfg.get_size_t( "ThreadCount", s_nThreadCount );
+            s_nPassCount = cfg.get_size_t( "PassCount", s_nPassCount );
+            s_nBurstThreadCount = cfg.get_size_t( "BurstThreadCount", s_nBurstThreadCount );
+            s_nBurstCount = cfg.get_size_t( "BurstCount", s_nBurstCount );
+            s_nBurstPassCount = cfg.get_size_t( "BurstPassCount", s_nBurstPassCount );
+
+            if ( s_nThreadCount == 0 )
+                s_nThreadCount = 1;
+            if ( s_nPassCount == 0 )
+                s_nPassCount = 100000;
+            if ( s_nBurstThreadCount == 0 )
+                s_nBurstThreadCount = 64;
+            if ( s_nBurstCount == 0 )
+                s_nBurstCount = 1;
+        }
+
+    protected:
+        template <class GC>
+        size_t run_workers( size_t nThreadCount, size_t nPassCount, std::chrono::milliseconds& duration )
+        {
+            cds_test::thread_pool& pool = get_pool();
+            pool.add( new Worker<GC>( pool, nPassCount ), nThreadCount );
+
+            duration = pool.run();
+
+            size_t nRetired = 0;
+            for ( size_t i = 0; i < pool.size(); ++i )
+                nRetired += static_cast<Worker<GC>&>( pool.get( i )).m_nRetired;
+            pool.clear();
+
+            return nRetired;
+        }
+
+        template <class GC>
+        void test()
+        {
+            s_nDisposedCount.store( 0, atomics::memory_order_relaxed );
+
+            propout() << std::make_pair( "thread_count", s_nThreadCount )
+                << std::make_pair( "pass_count", s_nPassCount )
+                << std::make_pair( "burst_thread_count", s_nBurstThreadCount )
+                << std::make_pair( "burst_count", s_nBurstCount )
+                << std::make_pair( "burst_pass_count", s_nBurstPassCount );
+
+            typename GC::stat st;
+            std::chrono::milliseconds duration;
+            size_t nRetired = 0;
+
+            // scan() cost before the burst
+            nRetired += run_workers<GC>( s_nThreadCount, s_nPassCount, duration );
+            propout() << std::make_pair( "duration_before_burst", duration );
+
+            // Thread burst
+            for ( size_t i = 0; i < s_nBurstCount; ++i ) {
+                nRetired += run_workers<GC>( s_nBurstThreadCount, s_nBurstPassCount, duration );
+                propout() << std::make_pair( "burst_duration", duration );
+            }
+
+            // Only the main thread is attached now
+            GC::statistics( st );
+            propout() << std::make_pair( "thread_list_count", st.thread_list_count )
+                << std::make_pair( "thread_rec_compact_count", st.thread_rec_compact_count );
+            EXPECT_LT( st.thread_list_count, s_nBurstThreadCount / 2 + 1 );
+
+            // scan() cost after the burst
+            nRetired += run_workers<GC>( s_nThreadCount, s_nPassCount, duration );
+            propout() << std::make_pair( "duration_after_burst", duration );
+
+            GC::statistics( st );
+            EXPECT_LT( st.thread_list_count, s_nBurstThreadCount / 2 + 1 );
+
+            GC::force_dispose();
+
+            size_t const nDisposed = s_nDisposedCount.load( atomics::memory_order_relaxed );
+            EXPECT_LE( nDisposed, nRetired );
+            propout() << std::make_pair( "retired_count", nRetired )
+                << std::make_pair( "disposed_count", nDisposed );
+        }
+    };
+
+    size_t thread_churn::s_nThreadCount = 4;
+    size_t thread_churn::s_nPassCount = 1000000;
+    size_t thread_churn::s_nBurstThreadCount = 256;
+    size_t thread_churn::s_nBurstCount = 4;
+    size_t thread_churn::s_nBurstPassCount = 1000;
+    atomics::atomic<size_t> thread_churn::s_nDisposedCount( 0 );
+
+    TEST_F( thread_churn, HP )
+    {
+        test<cds::gc::HP>();
+    }
+
+    TEST_F( thread_churn, DHP )
+    {
+        test<cds::gc::DHP>();
+    }
+
+} // namespace
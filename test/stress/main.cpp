@@ -33,21 +33,39 @@
 #include <cds/init.h>
 #include <cds/gc/hp.h>
 #include <cds/gc/dhp.h>
+#include <cds/gc/he.h>
+#include <cds/gc/ebr.h>
+#include <cds/gc/hyaline.h>
 #ifdef CDSUNIT_USE_URCU
 #   include <cds/urcu/general_instant.h>
 #   include <cds/urcu/general_buffered.h>
 #   include <cds/urcu/general_threaded.h>
 #   include <cds/urcu/signal_buffered.h>
+#   include <cds/urcu/membarrier_buffered.h>
 #endif
 
 #ifdef CDS_ENABLE_HPSTAT
 #   include <cds_test/stat_hp_out.h>
 #   include <cds_test/stat_dhp_out.h>
+#   include <cds_test/stat_he_out.h>
+#   include <cds_test/stat_ebr_out.h>
+#   include <cds_test/stat_hyaline_out.h>
 #   include <iostream>
 #endif
 #include <random>
 
 
+namespace {
+    cds::gc::HP::scan_type hp_scan_type( std::string const& strategy )
+    {
+        if ( strategy == "inplace" )
+            return cds::gc::HP::scan_type::inplace;
+        if ( strategy == "hashed" )
+            return cds::gc::HP::scan_type::hashed;
+        return cds::gc::HP::scan_type::classic;
+    }
+} // namespace
+
 /*static*/ std::random_device cds_test::fixture::random_dev_;
 /*static*/ std::mt19937 cds_test::fixture::random_gen_( random_dev_() );
 
@@ -71,11 +89,44 @@ int main( int argc, char **argv )
             general_cfg.get_size_t( "hazard_pointer_count", 16 ),
             general_cfg.get_size_t( "hp_max_thread_count", 0 ),
             general_cfg.get_size_t( "hp_retired_ptr_count", 0 ),
-            general_cfg.get( "hp_scan_strategy", "inplace" ) == "inplace" ? cds::gc::HP::scan_type::inplace : cds::gc::HP::scan_type::classic
+            hp_scan_type( general_cfg.get( "hp_scan_strategy", "inplace" )),
+            general_cfg.get_bool( "hp_asymmetric_fence", false ),
+            general_cfg.get_bool( "hp_background_reclaim", false )
         );
 
         cds::gc::DHP dhpGC(
-            general_cfg.get_size_t( "dhp_init_guard_count", 16 )
+            general_cfg.get_size_t( "dhp_init_guard_count", 16 ),
+            general_cfg.get_bool( "dhp_asymmetric_fence", false ),
+            general_cfg.get_bool( "dhp_background_reclaim", false )
+        );
+
+        // Retired budget, 0 - no budget
+        if ( general_cfg.get( "retired_budget_policy", "help_scan" ) == "throttle" ) {
+            cds::gc::HP::set_retired_budget( general_cfg.get_size_t( "hp_retired_budget", 0 ), cds::gc::HP::budget_policy::throttle );
+            cds::gc::DHP::set_retired_budget( general_cfg.get_size_t( "dhp_retired_budget", 0 ), cds::gc::DHP::budget_policy::throttle );
+        }
+        else {
+            cds::gc::HP::set_retired_budget( general_cfg.get_size_t( "hp_retired_budget", 0 ));
+            cds::gc::DHP::set_retired_budget( general_cfg.get_size_t( "dhp_retired_budget", 0 ));
+        }
+
+        cds::gc::HE heGC(
+            general_cfg.get_size_t( "hazard_pointer_count", 16 ),
+            general_cfg.get_size_t( "hp_max_thread_count", 0 ),
+            general_cfg.get_size_t( "hp_retired_ptr_count", 0 ),
+            general_cfg.get_size_t( "he_era_freq", 0 )
+        );
+
+        cds::gc::EBR ebrGC(
+            general_cfg.get_size_t( "hazard_pointer_count", 16 ),
+            general_cfg.get_size_t( "ebr_bag_capacity", 0 ),
+            general_cfg.get_size_t( "ebr_epoch_freq", 0 )
+        );
+
+        cds::gc::Hyaline hyalineGC(
+            general_cfg.get_size_t( "hazard_pointer_count", 16 ),
+            general_cfg.get_size_t( "hp_max_thread_count", 0 ),
+            general_cfg.get_size_t( "hyaline_batch_size", 0 )
         );
 
 #ifdef CDSUNIT_USE_URCU
@@ -95,6 +146,10 @@ int main( int argc, char **argv )
         typedef cds::urcu::gc< cds::urcu::signal_buffered<> >    rcu_shb;
         rcu_shb   shbRCU( rcu_buffer_size, SIGUSR1 );
 #   endif
+#   ifdef CDS_URCU_MEMBARRIER_ENABLED
+        typedef cds::urcu::gc< cds::urcu::membarrier_buffered<> >    rcu_mbb;
+        rcu_mbb   mbbRCU( rcu_buffer_size );
+#   endif
 #endif // CDSUNIT_USE_URCU
 
         cds::threading::Manager::attachThread();
@@ -117,6 +172,25 @@ int main( int argc, char **argv )
         EXPECT_EQ( st.retired_count, st.free_count );
         std::cout << st;
     }
+    {
+        cds::gc::HE::stat const& st = cds::gc::HE::postmortem_statistics();
+        EXPECT_EQ( st.guard_allocated, st.guard_freed );
+        EXPECT_EQ( st.retired_count, st.free_count );
+        std::cout << st;
+    }
+    {
+        cds::gc::EBR::stat const& st = cds::gc::EBR::postmortem_statistics();
+        EXPECT_EQ( st.guard_allocated, st.guard_freed );
+        EXPECT_EQ( st.retired_count, st.free_count );
+        std::cout << st;
+    }
+    {
+        cds::gc::Hyaline::stat const& st = cds::gc::Hyaline::postmortem_statistics();
+        EXPECT_EQ( st.guard_allocated, st.guard_freed );
+        EXPECT_EQ( st.retired_count, st.free_count );
+        EXPECT_EQ( st.batch_count, st.batch_free_count );
+        std::cout << st;
+    }
 #endif
 
     cds::Terminate();
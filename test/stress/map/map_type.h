@@ -35,6 +35,7 @@
 #include <cds/urcu/general_buffered.h>
 #include <cds/urcu/general_threaded.h>
 #include <cds/urcu/signal_buffered.h>
+#include <cds/urcu/membarrier_buffered.h>
 
 #include <cds/sync/spinlock.h>
 #include <cds/opt/hash.h>
@@ -53,6 +54,9 @@ namespace map {
 #ifdef CDS_URCU_SIGNAL_HANDLING_ENABLED
     typedef cds::urcu::gc< cds::urcu::signal_buffered_stripped >  rcu_shb;
 #endif
+#ifdef CDS_URCU_MEMBARRIER_ENABLED
+    typedef cds::urcu::gc< cds::urcu::membarrier_buffered_stripped >  rcu_mbb;
+#endif
 
     template <typename Key>
     struct less;
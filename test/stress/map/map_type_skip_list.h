@@ -35,6 +35,7 @@
 
 #include <cds/container/skip_list_map_hp.h>
 #include <cds/container/skip_list_map_dhp.h>
+#include <cds/container/skip_list_map_he.h>
 #include <cds/container/skip_list_map_rcu.h>
 #include <cds/container/skip_list_map_nogc.h>
 
@@ -91,6 +92,7 @@ namespace map {
         {};
         typedef SkipListMap< cds::gc::HP, Key, Value, traits_SkipListMap_less_turbo32 > SkipListMap_hp_less_turbo32;
         typedef SkipListMap< cds::gc::DHP, Key, Value, traits_SkipListMap_less_turbo32 > SkipListMap_dhp_less_turbo32;
+        typedef SkipListMap< cds::gc::HE, Key, Value, traits_SkipListMap_less_turbo32 > SkipListMap_he_less_turbo32;
         typedef SkipListMap< cds::gc::nogc, Key, Value, traits_SkipListMap_less_turbo32 > SkipListMap_nogc_less_turbo32;
         typedef SkipListMap< rcu_gpi, Key, Value, traits_SkipListMap_less_turbo32 > SkipListMap_rcu_gpi_less_turbo32;
         typedef SkipListMap< rcu_gpb, Key, Value, traits_SkipListMap_less_turbo32 > SkipListMap_rcu_gpb_less_turbo32;
@@ -98,6 +100,9 @@ namespace map {
 #ifdef CDS_URCU_SIGNAL_HANDLING_ENABLED
         typedef SkipListMap< rcu_shb, Key, Value, traits_SkipListMap_less_turbo32 > SkipListMap_rcu_shb_less_turbo32;
 #endif
+#ifdef CDS_URCU_MEMBARRIER_ENABLED
+        typedef SkipListMap< rcu_mbb, Key, Value, traits_SkipListMap_less_turbo32 > SkipListMap_rcu_mbb_less_turbo32;
+#endif
 
         class traits_SkipListMap_less_turbo24: public cc::skip_list::make_traits <
             co::less< less >
@@ -114,6 +119,9 @@ namespace map {
 #ifdef CDS_URCU_SIGNAL_HANDLING_ENABLED
         typedef SkipListMap< rcu_shb, Key, Value, traits_SkipListMap_less_turbo24 > SkipListMap_rcu_shb_less_turbo24;
 #endif
+#ifdef CDS_URCU_MEMBARRIER_ENABLED
+        typedef SkipListMap< rcu_mbb, Key, Value, traits_SkipListMap_less_turbo24 > SkipListMap_rcu_mbb_less_turbo24;
+#endif
 
         class traits_SkipListMap_less_turbo16: public cc::skip_list::make_traits <
             co::less< less >
@@ -130,6 +138,9 @@ namespace map {
 #ifdef CDS_URCU_SIGNAL_HANDLING_ENABLED
         typedef SkipListMap< rcu_shb, Key, Value, traits_SkipListMap_less_turbo16 > SkipListMap_rcu_shb_less_turbo16;
 #endif
+#ifdef CDS_URCU_MEMBARRIER_ENABLED
+        typedef SkipListMap< rcu_mbb, Key, Value, traits_SkipListMap_less_turbo16 > SkipListMap_rcu_mbb_less_turbo16;
+#endif
 
         class traits_SkipListMap_less_turbo32_seqcst: public cc::skip_list::make_traits <
                 co::less< less >
@@ -147,6 +158,9 @@ namespace map {
 #ifdef CDS_URCU_SIGNAL_HANDLING_ENABLED
         typedef SkipListMap< rcu_shb, Key, Value, traits_SkipListMap_less_turbo32_seqcst > SkipListMap_rcu_shb_less_turbo32_seqcst;
 #endif
+#ifdef CDS_URCU_MEMBARRIER_ENABLED
+        typedef SkipListMap< rcu_mbb, Key, Value, traits_SkipListMap_less_turbo32_seqcst > SkipListMap_rcu_mbb_less_turbo32_seqcst;
+#endif
 
         class traits_SkipListMap_less_turbo32_stat: public cc::skip_list::make_traits <
                 co::less< less >
@@ -164,6 +178,9 @@ namespace map {
 #ifdef CDS_URCU_SIGNAL_HANDLING_ENABLED
         typedef SkipListMap< rcu_shb, Key, Value, traits_SkipListMap_less_turbo32_stat > SkipListMap_rcu_shb_less_turbo32_stat;
 #endif
+#ifdef CDS_URCU_MEMBARRIER_ENABLED
+        typedef SkipListMap< rcu_mbb, Key, Value, traits_SkipListMap_less_turbo32_stat > SkipListMap_rcu_mbb_less_turbo32_stat;
+#endif
 
         class traits_SkipListMap_less_turbo24_stat: public cc::skip_list::make_traits <
             co::less< less >
@@ -181,6 +198,9 @@ namespace map {
 #ifdef CDS_URCU_SIGNAL_HANDLING_ENABLED
         typedef SkipListMap< rcu_shb, Key, Value, traits_SkipListMap_less_turbo24_stat > SkipListMap_rcu_shb_less_turbo24_stat;
 #endif
+#ifdef CDS_URCU_MEMBARRIER_ENABLED
+        typedef SkipListMap< rcu_mbb, Key, Value, traits_SkipListMap_less_turbo24_stat > SkipListMap_rcu_mbb_less_turbo24_stat;
+#endif
 
         class traits_SkipListMap_less_turbo16_stat: public cc::skip_list::make_traits <
             co::less< less >
@@ -198,6 +218,9 @@ namespace map {
 #ifdef CDS_URCU_SIGNAL_HANDLING_ENABLED
         typedef SkipListMap< rcu_shb, Key, Value, traits_SkipListMap_less_turbo16_stat > SkipListMap_rcu_shb_less_turbo16_stat;
 #endif
+#ifdef CDS_URCU_MEMBARRIER_ENABLED
+        typedef SkipListMap< rcu_mbb, Key, Value, traits_SkipListMap_less_turbo16_stat > SkipListMap_rcu_mbb_less_turbo16_stat;
+#endif
 
         class traits_SkipListMap_cmp_turbo32: public cc::skip_list::make_traits <
                 co::compare< compare >
@@ -214,6 +237,9 @@ namespace map {
 #ifdef CDS_URCU_SIGNAL_HANDLING_ENABLED
         typedef SkipListMap< rcu_shb, Key, Value, traits_SkipListMap_cmp_turbo32 > SkipListMap_rcu_shb_cmp_turbo32;
 #endif
+#ifdef CDS_URCU_MEMBARRIER_ENABLED
+        typedef SkipListMap< rcu_mbb, Key, Value, traits_SkipListMap_cmp_turbo32 > SkipListMap_rcu_mbb_cmp_turbo32;
+#endif
 
         class traits_SkipListMap_cmp_turbo32_stat: public cc::skip_list::make_traits <
                 co::compare< compare >
@@ -224,6 +250,7 @@ namespace map {
         {};
         typedef SkipListMap< cds::gc::HP, Key, Value, traits_SkipListMap_cmp_turbo32_stat > SkipListMap_hp_cmp_turbo32_stat;
         typedef SkipListMap< cds::gc::DHP, Key, Value, traits_SkipListMap_cmp_turbo32_stat > SkipListMap_dhp_cmp_turbo32_stat;
+        typedef SkipListMap< cds::gc::HE, Key, Value, traits_SkipListMap_cmp_turbo32_stat > SkipListMap_he_cmp_turbo32_stat;
         typedef SkipListMap< cds::gc::nogc, Key, Value, traits_SkipListMap_cmp_turbo32_stat > SkipListMap_nogc_cmp_turbo32_stat;
         typedef SkipListMap< rcu_gpi, Key, Value, traits_SkipListMap_cmp_turbo32_stat > SkipListMap_rcu_gpi_cmp_turbo32_stat;
         typedef SkipListMap< rcu_gpb, Key, Value, traits_SkipListMap_cmp_turbo32_stat > SkipListMap_rcu_gpb_cmp_turbo32_stat;
@@ -231,6 +258,9 @@ namespace map {
 #ifdef CDS_URCU_SIGNAL_HANDLING_ENABLED
         typedef SkipListMap< rcu_shb, Key, Value, traits_SkipListMap_cmp_turbo32_stat > SkipListMap_rcu_shb_cmp_turbo32_stat;
 #endif
+#ifdef CDS_URCU_MEMBARRIER_ENABLED
+        typedef SkipListMap< rcu_mbb, Key, Value, traits_SkipListMap_cmp_turbo32_stat > SkipListMap_rcu_mbb_cmp_turbo32_stat;
+#endif
 
         class traits_SkipListMap_less_xorshift32: public cc::skip_list::make_traits <
                 co::less< less >
@@ -247,6 +277,9 @@ namespace map {
 #ifdef CDS_URCU_SIGNAL_HANDLING_ENABLED
         typedef SkipListMap< rcu_shb, Key, Value, traits_SkipListMap_less_xorshift32 > SkipListMap_rcu_shb_less_xorshift32;
 #endif
+#ifdef CDS_URCU_MEMBARRIER_ENABLED
+        typedef SkipListMap< rcu_mbb, Key, Value, traits_SkipListMap_less_xorshift32 > SkipListMap_rcu_mbb_less_xorshift32;
+#endif
 
         class traits_SkipListMap_less_xorshift24: public cc::skip_list::make_traits <
             co::less< less >
@@ -263,6 +296,9 @@ namespace map {
 #ifdef CDS_URCU_SIGNAL_HANDLING_ENABLED
         typedef SkipListMap< rcu_shb, Key, Value, traits_SkipListMap_less_xorshift24 > SkipListMap_rcu_shb_less_xorshift24;
 #endif
+#ifdef CDS_URCU_MEMBARRIER_ENABLED
+        typedef SkipListMap< rcu_mbb, Key, Value, traits_SkipListMap_less_xorshift24 > SkipListMap_rcu_mbb_less_xorshift24;
+#endif
 
         class traits_SkipListMap_less_xorshift16: public cc::skip_list::make_traits <
             co::less< less >
@@ -279,6 +315,9 @@ namespace map {
 #ifdef CDS_URCU_SIGNAL_HANDLING_ENABLED
         typedef SkipListMap< rcu_shb, Key, Value, traits_SkipListMap_less_xorshift16 > SkipListMap_rcu_shb_less_xorshift16;
 #endif
+#ifdef CDS_URCU_MEMBARRIER_ENABLED
+        typedef SkipListMap< rcu_mbb, Key, Value, traits_SkipListMap_less_xorshift16 > SkipListMap_rcu_mbb_less_xorshift16;
+#endif
 
         class traits_SkipListMap_less_xorshift32_stat: public cc::skip_list::make_traits <
                 co::less< less >
@@ -296,6 +335,9 @@ namespace map {
 #ifdef CDS_URCU_SIGNAL_HANDLING_ENABLED
         typedef SkipListMap< rcu_shb, Key, Value, traits_SkipListMap_less_xorshift32_stat > SkipListMap_rcu_shb_less_xorshift32_stat;
 #endif
+#ifdef CDS_URCU_MEMBARRIER_ENABLED
+        typedef SkipListMap< rcu_mbb, Key, Value, traits_SkipListMap_less_xorshift32_stat > SkipListMap_rcu_mbb_less_xorshift32_stat;
+#endif
 
         class traits_SkipListMap_less_xorshift24_stat: public cc::skip_list::make_traits <
             co::less< less >
@@ -313,6 +355,9 @@ namespace map {
 #ifdef CDS_URCU_SIGNAL_HANDLING_ENABLED
         typedef SkipListMap< rcu_shb, Key, Value, traits_SkipListMap_less_xorshift24_stat > SkipListMap_rcu_shb_less_xorshift24_stat;
 #endif
+#ifdef CDS_URCU_MEMBARRIER_ENABLED
+        typedef SkipListMap< rcu_mbb, Key, Value, traits_SkipListMap_less_xorshift24_stat > SkipListMap_rcu_mbb_less_xorshift24_stat;
+#endif
 
         class traits_SkipListMap_less_xorshift16_stat: public cc::skip_list::make_traits <
             co::less< less >
@@ -330,6 +375,9 @@ namespace map {
 #ifdef CDS_URCU_SIGNAL_HANDLING_ENABLED
         typedef SkipListMap< rcu_shb, Key, Value, traits_SkipListMap_less_xorshift16_stat > SkipListMap_rcu_shb_less_xorshift16_stat;
 #endif
+#ifdef CDS_URCU_MEMBARRIER_ENABLED
+        typedef SkipListMap< rcu_mbb, Key, Value, traits_SkipListMap_less_xorshift16_stat > SkipListMap_rcu_mbb_less_xorshift16_stat;
+#endif
 
         class traits_SkipListMap_cmp_xorshift32: public cc::skip_list::make_traits <
                 co::compare< compare >
@@ -346,6 +394,9 @@ namespace map {
 #ifdef CDS_URCU_SIGNAL_HANDLING_ENABLED
         typedef SkipListMap< rcu_shb, Key, Value, traits_SkipListMap_cmp_xorshift32 > SkipListMap_rcu_shb_cmp_xorshift32;
 #endif
+#ifdef CDS_URCU_MEMBARRIER_ENABLED
+        typedef SkipListMap< rcu_mbb, Key, Value, traits_SkipListMap_cmp_xorshift32 > SkipListMap_rcu_mbb_cmp_xorshift32;
+#endif
 
         class traits_SkipListMap_cmp_xorshift32_stat: public cc::skip_list::make_traits <
                 co::compare< compare >
@@ -363,6 +414,9 @@ namespace map {
 #ifdef CDS_URCU_SIGNAL_HANDLING_ENABLED
         typedef SkipListMap< rcu_shb, Key, Value, traits_SkipListMap_cmp_xorshift32_stat > SkipListMap_rcu_shb_cmp_xorshift32_stat;
 #endif
+#ifdef CDS_URCU_MEMBARRIER_ENABLED
+        typedef SkipListMap< rcu_mbb, Key, Value, traits_SkipListMap_cmp_xorshift32_stat > SkipListMap_rcu_mbb_cmp_xorshift32_stat;
+#endif
 
     };
 
@@ -415,6 +469,40 @@ namespace map {
 #   define CDSSTRESS_SkipListMap_SHRCU( fixture, test_case, key_type, value_type )
 #endif
 
+#ifdef CDS_URCU_MEMBARRIER_ENABLED
+
+#if defined(CDS_STRESS_TEST_LEVEL) && CDS_STRESS_TEST_LEVEL > 1
+#   define CDSSTRESS_SkipListMap_MBRCU_2( fixture, test_case, key_type, value_type ) \
+        CDSSTRESS_SkipListMap_case( fixture, test_case, SkipListMap_rcu_mbb_less_turbo32_seqcst, key_type, value_type ) \
+
+#else
+#   define CDSSTRESS_SkipListMap_MBRCU_2( fixture, test_case, key_type, value_type )
+#endif
+
+#if defined(CDS_STRESS_TEST_LEVEL) && CDS_STRESS_TEST_LEVEL == 1
+#   define CDSSTRESS_SkipListMap_MBRCU_1( fixture, test_case, key_type, value_type ) \
+        CDSSTRESS_SkipListMap_case( fixture, test_case, SkipListMap_rcu_mbb_less_turbo32_stat,   key_type, value_type ) \
+        CDSSTRESS_SkipListMap_case( fixture, test_case, SkipListMap_rcu_mbb_cmp_turbo32,         key_type, value_type ) \
+        CDSSTRESS_SkipListMap_case( fixture, test_case, SkipListMap_rcu_mbb_cmp_turbo32_stat,    key_type, value_type ) \
+        CDSSTRESS_SkipListMap_case( fixture, test_case, SkipListMap_rcu_mbb_less_xorshift32_stat, key_type, value_type ) \
+        CDSSTRESS_SkipListMap_case( fixture, test_case, SkipListMap_rcu_mbb_cmp_xorshift32,       key_type, value_type ) \
+
+#else
+#   define CDSSTRESS_SkipListMap_MBRCU_1( fixture, test_case, key_type, value_type )
+#endif
+
+
+#   define CDSSTRESS_SkipListMap_MBRCU( fixture, test_case, key_type, value_type ) \
+        CDSSTRESS_SkipListMap_case( fixture, test_case, SkipListMap_rcu_mbb_less_turbo32,        key_type, value_type ) \
+        CDSSTRESS_SkipListMap_case( fixture, test_case, SkipListMap_rcu_mbb_less_xorshift32,      key_type, value_type ) \
+        CDSSTRESS_SkipListMap_case( fixture, test_case, SkipListMap_rcu_mbb_cmp_xorshift32_stat,  key_type, value_type ) \
+        CDSSTRESS_SkipListMap_MBRCU_1( fixture, test_case, key_type, value_type ) \
+        CDSSTRESS_SkipListMap_MBRCU_2( fixture, test_case, key_type, value_type ) \
+
+#else
+#   define CDSSTRESS_SkipListMap_MBRCU( fixture, test_case, key_type, value_type )
+#endif
+
 #if defined(CDS_STRESS_TEST_LEVEL) && CDS_STRESS_TEST_LEVEL > 1
 #   define CDSSTRESS_SkipListMap_HP_2( fixture, test_case, key_type, value_type ) \
         CDSSTRESS_SkipListMap_case( fixture, test_case, SkipListMap_hp_less_turbo32_seqcst,      key_type, value_type ) \
@@ -489,6 +577,8 @@ namespace map {
     CDSSTRESS_SkipListMap_case( fixture, test_case, SkipListMap_dhp_less_xorshift16_stat,     key_type, value_type ) \
     CDSSTRESS_SkipListMap_case( fixture, test_case, SkipListMap_dhp_cmp_xorshift32,           key_type, value_type ) \
     CDSSTRESS_SkipListMap_case( fixture, test_case, SkipListMap_hp_cmp_xorshift32_stat,       key_type, value_type ) \
+    CDSSTRESS_SkipListMap_case( fixture, test_case, SkipListMap_he_less_turbo32,              key_type, value_type ) \
+    CDSSTRESS_SkipListMap_case( fixture, test_case, SkipListMap_he_cmp_turbo32_stat,          key_type, value_type ) \
     CDSSTRESS_SkipListMap_HP_1( fixture, test_case, key_type, value_type ) \
     CDSSTRESS_SkipListMap_HP_2( fixture, test_case, key_type, value_type ) \
 
@@ -509,6 +599,7 @@ namespace map {
     CDSSTRESS_SkipListMap_case( fixture, test_case, SkipListMap_rcu_gpb_cmp_xorshift32,       key_type, value_type ) \
     CDSSTRESS_SkipListMap_case( fixture, test_case, SkipListMap_rcu_gpi_cmp_xorshift32_stat,  key_type, value_type ) \
     CDSSTRESS_SkipListMap_case( fixture, test_case, SkipListMap_rcu_gpt_cmp_xorshift32_stat,  key_type, value_type ) \
+    CDSSTRESS_SkipListMap_MBRCU( fixture, test_case, key_type, value_type ) \
     CDSSTRESS_SkipListMap_RCU_1( fixture, test_case, key_type, value_type ) \
     CDSSTRESS_SkipListMap_RCU_2( fixture, test_case, key_type, value_type ) \
 
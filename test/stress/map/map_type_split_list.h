@@ -35,6 +35,9 @@
 
 #include <cds/container/michael_kvlist_hp.h>
 #include <cds/container/michael_kvlist_dhp.h>
+#include <cds/container/michael_kvlist_ebr.h>
+#include <cds/container/michael_kvlist_hyaline.h>
+#include <cds/container/michael_kvlist_he.h>
 #include <cds/container/michael_kvlist_rcu.h>
 #include <cds/container/michael_kvlist_nogc.h>
 
@@ -156,6 +159,9 @@ namespace map {
         {};
         typedef SplitListMap< cds::gc::HP, Key, Value, traits_SplitList_Michael_dyn_cmp > SplitList_Michael_HP_dyn_cmp;
         typedef SplitListMap< cds::gc::DHP, Key, Value, traits_SplitList_Michael_dyn_cmp > SplitList_Michael_DHP_dyn_cmp;
+        typedef SplitListMap< cds::gc::EBR, Key, Value, traits_SplitList_Michael_dyn_cmp > SplitList_Michael_EBR_dyn_cmp;
+        typedef SplitListMap< cds::gc::Hyaline, Key, Value, traits_SplitList_Michael_dyn_cmp > SplitList_Michael_Hyaline_dyn_cmp;
+        typedef SplitListMap< cds::gc::HE, Key, Value, traits_SplitList_Michael_dyn_cmp > SplitList_Michael_HE_dyn_cmp;
         typedef SplitListMap< cds::gc::nogc, Key, Value, traits_SplitList_Michael_dyn_cmp > SplitList_Michael_NOGC_dyn_cmp;
         typedef SplitListMap< rcu_gpi, Key, Value, traits_SplitList_Michael_dyn_cmp > SplitList_Michael_RCU_GPI_dyn_cmp;
         typedef SplitListMap< rcu_gpb, Key, Value, traits_SplitList_Michael_dyn_cmp > SplitList_Michael_RCU_GPB_dyn_cmp;
@@ -188,6 +194,9 @@ namespace map {
         };
         typedef SplitListMap< cds::gc::HP, Key, Value, traits_SplitList_Michael_dyn_cmp_stat > SplitList_Michael_HP_dyn_cmp_stat;
         typedef SplitListMap< cds::gc::DHP, Key, Value, traits_SplitList_Michael_dyn_cmp_stat > SplitList_Michael_DHP_dyn_cmp_stat;
+        typedef SplitListMap< cds::gc::EBR, Key, Value, traits_SplitList_Michael_dyn_cmp_stat > SplitList_Michael_EBR_dyn_cmp_stat;
+        typedef SplitListMap< cds::gc::Hyaline, Key, Value, traits_SplitList_Michael_dyn_cmp_stat > SplitList_Michael_Hyaline_dyn_cmp_stat;
+        typedef SplitListMap< cds::gc::HE, Key, Value, traits_SplitList_Michael_dyn_cmp_stat > SplitList_Michael_HE_dyn_cmp_stat;
         typedef SplitListMap< cds::gc::nogc, Key, Value, traits_SplitList_Michael_dyn_cmp_stat> SplitList_Michael_NOGC_dyn_cmp_stat;
         typedef SplitListMap< rcu_gpi, Key, Value, traits_SplitList_Michael_dyn_cmp_stat > SplitList_Michael_RCU_GPI_dyn_cmp_stat;
         typedef SplitListMap< rcu_gpb, Key, Value, traits_SplitList_Michael_dyn_cmp_stat > SplitList_Michael_RCU_GPB_dyn_cmp_stat;
@@ -718,6 +727,12 @@ namespace map {
     CDSSTRESS_SplitListMap_case( fixture, test_case, SplitList_Lazy_HP_dyn_less,                key_type, value_type ) \
     CDSSTRESS_SplitListMap_case( fixture, test_case, SplitList_Lazy_DHP_st_less,                key_type, value_type ) \
     CDSSTRESS_SplitListMap_case( fixture, test_case, SplitList_Lazy_HP_st_less_stat,            key_type, value_type ) \
+    CDSSTRESS_SplitListMap_case( fixture, test_case, SplitList_Michael_EBR_dyn_cmp,             key_type, value_type ) \
+    CDSSTRESS_SplitListMap_case( fixture, test_case, SplitList_Michael_EBR_dyn_cmp_stat,        key_type, value_type ) \
+    CDSSTRESS_SplitListMap_case( fixture, test_case, SplitList_Michael_Hyaline_dyn_cmp,         key_type, value_type ) \
+    CDSSTRESS_SplitListMap_case( fixture, test_case, SplitList_Michael_Hyaline_dyn_cmp_stat,    key_type, value_type ) \
+    CDSSTRESS_SplitListMap_case( fixture, test_case, SplitList_Michael_HE_dyn_cmp,              key_type, value_type ) \
+    CDSSTRESS_SplitListMap_case( fixture, test_case, SplitList_Michael_HE_dyn_cmp_stat,         key_type, value_type ) \
     CDSSTRESS_SplitListMap_HP_1( fixture, test_case, key_type, value_type ) \
     CDSSTRESS_SplitListMap_HP_2( fixture, test_case, key_type, value_type ) \
 
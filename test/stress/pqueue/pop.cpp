@@ -241,6 +241,8 @@ namespace {
     CDSSTRESS_PriorityQueue( pqueue_pop, FCPQueue_boost_deque_stat )
     CDSSTRESS_PriorityQueue( pqueue_pop, FCPQueue_boost_stable_vector )
     CDSSTRESS_PriorityQueue( pqueue_pop, FCPQueue_boost_stable_vector_stat )
+    CDSSTRESS_PriorityQueue( pqueue_pop, FCPQueue_vector_elimination_stat )
+    CDSSTRESS_PriorityQueue( pqueue_pop, FCPQueue_vector_parallel_stat )
 
     CDSSTRESS_PriorityQueue( pqueue_pop, EllenBinTree_HP_max )
     CDSSTRESS_PriorityQueue( pqueue_pop, EllenBinTree_HP_max_stat )
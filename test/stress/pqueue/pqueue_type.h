@@ -687,6 +687,29 @@ namespace pqueue {
             ,traits_FCPQueue_stat
         > FCPQueue_boost_stable_vector_stat;
 
+        struct traits_FCPQueue_elimination_stat : public
+            cds::container::fcpqueue::make_traits <
+                cds::opt::enable_elimination< true >
+                , cds::opt::stat < cds::container::fcpqueue::stat<> >
+            > ::type
+        {};
+        typedef cds::container::FCPriorityQueue< Value
+            ,std::priority_queue<Value>
+            ,traits_FCPQueue_elimination_stat
+        > FCPQueue_vector_elimination_stat;
+
+        struct traits_FCPQueue_parallel_stat : public
+            cds::container::fcpqueue::make_traits <
+                cds::opt::enable_elimination< true >
+                , cds::opt::fc_kernel< cds::algo::flat_combining::parallel_kernel<4>>
+                , cds::opt::stat < cds::container::fcpqueue::stat<> >
+            > ::type
+        {};
+        typedef cds::container::FCPriorityQueue< Value
+            ,std::priority_queue<Value>
+            ,traits_FCPQueue_parallel_stat
+        > FCPQueue_vector_parallel_stat;
+
         /// Standard priority_queue
         typedef details::StdPQueue< Value, std::vector<Value>, cds::sync::spin> StdPQueue_vector_spin;
         typedef details::StdPQueue< Value, std::vector<Value>, std::mutex >  StdPQueue_vector_mutex;
@@ -718,6 +741,7 @@ namespace cds_test {
             << CDSSTRESS_STAT_OUT( s, m_nPushMove )
             << CDSSTRESS_STAT_OUT( s, m_nPop )
             << CDSSTRESS_STAT_OUT( s, m_nFailedPop )
+            << CDSSTRESS_STAT_OUT( s, m_nCollided )
             << static_cast<cds::algo::flat_combining::stat<> const&>(s);
     }
 
@@ -202,6 +202,8 @@ namespace pqueue {
     CDSSTRESS_PriorityQueue( pqueue_push, FCPQueue_boost_deque_stat )
     CDSSTRESS_PriorityQueue( pqueue_push, FCPQueue_boost_stable_vector )
     CDSSTRESS_PriorityQueue( pqueue_push, FCPQueue_boost_stable_vector_stat )
+    CDSSTRESS_PriorityQueue( pqueue_push, FCPQueue_vector_elimination_stat )
+    CDSSTRESS_PriorityQueue( pqueue_push, FCPQueue_vector_parallel_stat )
 
     CDSSTRESS_PriorityQueue( pqueue_push, EllenBinTree_HP_max )
     CDSSTRESS_PriorityQueue( pqueue_push, EllenBinTree_HP_max_stat )
@@ -348,6 +348,9 @@ namespace {
     CDSSTRESS_MSQueue( simple_queue_push_pop )
 */
     CDSSTRESS_SPQueue( simple_queue_push_pop )
+    CDSSTRESS_FCQueue_NUMA( simple_queue_push_pop )
+    CDSSTRESS_FCQueue_Slot( simple_queue_push_pop )
+    CDSSTRESS_FCQueue_Futex( simple_queue_push_pop )
 /*
     CDSSTRESS_MoirQueue( simple_queue_push_pop )
     CDSSTRESS_BasketQueue( simple_queue_push_pop )
@@ -45,6 +45,9 @@
 
 #include <cds/gc/hp.h>
 #include <cds/gc/dhp.h>
+#include <cds/gc/he.h>
+#include <cds/gc/ebr.h>
+#include <cds/gc/hyaline.h>
 
 #include "std_queue.h"
 #include "lock/win32_lock.h"
@@ -226,6 +229,9 @@ namespace fc_details{
         // SPQueue
         typedef cds::container::SPQueue<cds::gc::HP,  Value > SPQueue_HP;
         typedef cds::container::SPQueue<cds::gc::DHP, Value > SPQueue_DHP;
+        typedef cds::container::SPQueue<cds::gc::HE,  Value > SPQueue_HE;
+        typedef cds::container::SPQueue<cds::gc::EBR, Value > SPQueue_EBR;
+        typedef cds::container::SPQueue<cds::gc::Hyaline, Value > SPQueue_Hyaline;
 
         struct traits_SPQueue_seqcst : public
            cds::container::speculative_pairing_queue::make_traits <
@@ -252,6 +258,9 @@ namespace fc_details{
         {};
         typedef cds::container::SPQueue< cds::gc::HP,  Value, traits_SPQueue_stat > SPQueue_HP_stat;
         typedef cds::container::SPQueue< cds::gc::DHP, Value, traits_SPQueue_stat > SPQueue_DHP_stat;
+        typedef cds::container::SPQueue< cds::gc::HE,  Value, traits_SPQueue_stat > SPQueue_HE_stat;
+        typedef cds::container::SPQueue< cds::gc::EBR, Value, traits_SPQueue_stat > SPQueue_EBR_stat;
+        typedef cds::container::SPQueue< cds::gc::Hyaline, Value, traits_SPQueue_stat > SPQueue_Hyaline_stat;
     
 /* ========== SPECULATIVE QUEUE ENDS ================== */
 
@@ -502,6 +511,57 @@ namespace fc_details{
             >::type
         {};
 
+        // FCQueue with hierarchical (NUMA-aware) flat combining kernel
+        struct traits_FCQueue_numa:
+            public cds::container::fcqueue::make_traits<
+                cds::opt::fc_kernel< cds::algo::flat_combining::numa_kernel >
+            >::type
+        {};
+        struct traits_FCQueue_numa_stat: traits_FCQueue_numa
+        {
+            typedef cds::container::fcqueue::stat<> stat;
+        };
+        struct traits_FCQueue_numa_elimination_stat:
+            public cds::container::fcqueue::make_traits<
+                cds::opt::fc_kernel< cds::algo::flat_combining::numa_kernel >
+                ,cds::opt::enable_elimination< true >
+                ,cds::opt::stat< cds::container::fcqueue::stat<> >
+            >::type
+        {};
+        // Two virtual nodes, for the systems with one NUMA node
+        struct traits_FCQueue_numa2_stat: traits_FCQueue_numa_stat
+        {
+            typedef cds::algo::flat_combining::numa::round_robin<2> numa_topology;
+        };
+
+        // FCQueue with array-based publication slots
+        struct traits_FCQueue_slot_stat:
+            public cds::container::fcqueue::make_traits<
+                cds::opt::fc_kernel< cds::algo::flat_combining::slot_kernel<> >
+                ,cds::opt::stat< cds::container::fcqueue::stat<> >
+            >::type
+        {};
+        struct traits_FCQueue_slot_elimination_stat: traits_FCQueue_slot_stat
+        {
+            static constexpr const bool enable_elimination = true;
+        };
+        // FCQueue with futex wait strategy
+        struct traits_FCQueue_futex_stat:
+            public cds::container::fcqueue::make_traits<
+                cds::opt::wait_strategy< cds::algo::flat_combining::wait_strategy::futex<>>
+                ,cds::opt::stat< cds::container::fcqueue::stat<> >
+            >::type
+        {};
+        struct traits_FCQueue_futex_elimination_stat: traits_FCQueue_futex_stat
+        {
+            static constexpr const bool enable_elimination = true;
+        };
+        // Less slots than threads, some threads use overflow records
+        struct traits_FCQueue_slot4_stat: traits_FCQueue_slot_stat
+        {
+            typedef cds::algo::flat_combining::slot_kernel<4> fc_kernel;
+        };
+
         typedef cds::container::FCQueue< Value > FCQueue_deque;
         typedef cds::container::FCQueue< Value, std::queue<Value>, traits_FCQueue_stat > FCQueue_deque_stat;
         typedef cds::container::FCQueue< Value, std::queue<Value>, traits_FCQueue_single_mutex_single_condvar> FCQueue_deque_wait_ss;
@@ -514,6 +574,16 @@ namespace fc_details{
         typedef cds::container::FCQueue< Value, std::queue<Value>, traits_FCQueue_elimination > FCQueue_deque_elimination;
         typedef cds::container::FCQueue< Value, std::queue<Value>, traits_FCQueue_elimination_stat > FCQueue_deque_elimination_stat;
 
+        typedef cds::container::FCQueue< Value, std::queue<Value>, traits_FCQueue_numa > FCQueue_deque_numa;
+        typedef cds::container::FCQueue< Value, std::queue<Value>, traits_FCQueue_numa_stat > FCQueue_deque_numa_stat;
+        typedef cds::container::FCQueue< Value, std::queue<Value>, traits_FCQueue_numa_elimination_stat > FCQueue_deque_numa_elimination_stat;
+        typedef cds::container::FCQueue< Value, std::queue<Value>, traits_FCQueue_numa2_stat > FCQueue_deque_numa2_stat;
+        typedef cds::container::FCQueue< Value, std::queue<Value>, traits_FCQueue_slot_stat > FCQueue_deque_slot_stat;
+        typedef cds::container::FCQueue< Value, std::queue<Value>, traits_FCQueue_slot_elimination_stat > FCQueue_deque_slot_elimination_stat;
+        typedef cds::container::FCQueue< Value, std::queue<Value>, traits_FCQueue_slot4_stat > FCQueue_deque_slot4_stat;
+        typedef cds::container::FCQueue< Value, std::queue<Value>, traits_FCQueue_futex_stat > FCQueue_deque_futex_stat;
+        typedef cds::container::FCQueue< Value, std::queue<Value>, traits_FCQueue_futex_elimination_stat > FCQueue_deque_futex_elimination_stat;
+
         typedef cds::container::FCQueue< Value, std::queue<Value, std::list<Value>>> FCQueue_list;
         typedef cds::container::FCQueue< Value, std::queue<Value, std::list<Value>>, traits_FCQueue_stat> FCQueue_list_stat;
         typedef cds::container::FCQueue< Value, std::queue<Value, std::list<Value>>, traits_FCQueue_single_mutex_single_condvar> FCQueue_list_wait_ss;
@@ -525,6 +595,8 @@ namespace fc_details{
 
         typedef cds::container::FCQueue< Value, std::queue<Value, std::list<Value> >, traits_FCQueue_elimination > FCQueue_list_elimination;
         typedef cds::container::FCQueue< Value, std::queue<Value, std::list<Value> >, traits_FCQueue_elimination_stat > FCQueue_list_elimination_stat;
+        typedef cds::container::FCQueue< Value, std::queue<Value, std::list<Value> >, traits_FCQueue_numa_stat > FCQueue_list_numa_stat;
+        typedef cds::container::FCQueue< Value, std::queue<Value, std::list<Value> >, traits_FCQueue_slot_stat > FCQueue_list_slot_stat;
 
 
 
@@ -670,6 +742,7 @@ namespace cds_test {
                 << CDSSTRESS_STAT_OUT( s, m_nDequeue )
                 << CDSSTRESS_STAT_OUT( s, m_nFailedDeq )
                 << CDSSTRESS_STAT_OUT( s, m_nCollided )
+                << CDSSTRESS_STAT_OUT( s, m_nEliminationPass )
                 << static_cast<cds::algo::flat_combining::stat<> const&>(s);
     }
 
@@ -695,6 +768,7 @@ namespace cds_test {
             << CDSSTRESS_STAT_OUT( s, m_nPopBack )
             << CDSSTRESS_STAT_OUT( s, m_nFailedPopBack )
             << CDSSTRESS_STAT_OUT( s, m_nCollided )
+            << CDSSTRESS_STAT_OUT( s, m_nEliminationPass )
             << static_cast<cds::algo::flat_combining::stat<> const&>(s);
     }
 
@@ -839,6 +913,12 @@ namespace cds_test {
     CDSSTRESS_Queue_F( test_fixture, SPQueue_HP_stat    ) \
     CDSSTRESS_Queue_F( test_fixture, SPQueue_DHP        ) \
     CDSSTRESS_Queue_F( test_fixture, SPQueue_DHP_stat   ) \
+    CDSSTRESS_Queue_F( test_fixture, SPQueue_HE         ) \
+    CDSSTRESS_Queue_F( test_fixture, SPQueue_HE_stat    ) \
+    CDSSTRESS_Queue_F( test_fixture, SPQueue_EBR        ) \
+    CDSSTRESS_Queue_F( test_fixture, SPQueue_EBR_stat   ) \
+    CDSSTRESS_Queue_F( test_fixture, SPQueue_Hyaline    ) \
+    CDSSTRESS_Queue_F( test_fixture, SPQueue_Hyaline_stat ) \
     CDSSTRESS_SPQueue_1( test_fixture )
 /* ========== SPECULATIVE QUEUE ENDS ================ */
 
@@ -878,6 +958,29 @@ namespace cds_test {
     CDSSTRESS_Queue_F( test_fixture, FCQueue_list_elimination_stat ) \
     CDSSTRESS_FCQueue_1( test_fixture )
 
+// Hierarchical FC kernel compared with the plain kernel
+#define CDSSTRESS_FCQueue_NUMA( test_fixture ) \
+    CDSSTRESS_Queue_F( test_fixture, FCQueue_deque_stat         ) \
+    CDSSTRESS_Queue_F( test_fixture, FCQueue_deque_numa         ) \
+    CDSSTRESS_Queue_F( test_fixture, FCQueue_deque_numa_stat    ) \
+    CDSSTRESS_Queue_F( test_fixture, FCQueue_deque_numa2_stat   ) \
+    CDSSTRESS_Queue_F( test_fixture, FCQueue_deque_elimination_stat ) \
+    CDSSTRESS_Queue_F( test_fixture, FCQueue_deque_numa_elimination_stat ) \
+    CDSSTRESS_Queue_F( test_fixture, FCQueue_list_stat          ) \
+    CDSSTRESS_Queue_F( test_fixture, FCQueue_list_numa_stat     )
+
+// FC kernel with publication slots, the plain kernel baselines are in CDSSTRESS_FCQueue_NUMA
+#define CDSSTRESS_FCQueue_Slot( test_fixture ) \
+    CDSSTRESS_Queue_F( test_fixture, FCQueue_deque_slot_stat    ) \
+    CDSSTRESS_Queue_F( test_fixture, FCQueue_deque_slot4_stat   ) \
+    CDSSTRESS_Queue_F( test_fixture, FCQueue_deque_slot_elimination_stat ) \
+    CDSSTRESS_Queue_F( test_fixture, FCQueue_list_slot_stat     )
+
+// Futex wait strategy, the condvar strategies are in CDSSTRESS_FCQueue
+#define CDSSTRESS_FCQueue_Futex( test_fixture ) \
+    CDSSTRESS_Queue_F( test_fixture, FCQueue_deque_futex_stat   ) \
+    CDSSTRESS_Queue_F( test_fixture, FCQueue_deque_futex_elimination_stat )
+
 
 #define CDSSTRESS_FCDeque( test_fixture ) \
     CDSSTRESS_Queue_F( test_fixture, FCDequeL_default           ) \
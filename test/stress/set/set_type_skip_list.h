@@ -35,6 +35,7 @@
 
 #include <cds/container/skip_list_set_hp.h>
 #include <cds/container/skip_list_set_dhp.h>
+#include <cds/container/skip_list_set_he.h>
 #include <cds/container/skip_list_set_rcu.h>
 
 #include <cds_test/stat_skiplist_out.h>
@@ -75,6 +76,7 @@ namespace set {
         {};
         typedef SkipListSet< cds::gc::HP, key_val, traits_SkipListSet_less_turbo32 > SkipListSet_hp_less_turbo32;
         typedef SkipListSet< cds::gc::DHP, key_val, traits_SkipListSet_less_turbo32 > SkipListSet_dhp_less_turbo32;
+        typedef SkipListSet< cds::gc::HE, key_val, traits_SkipListSet_less_turbo32 > SkipListSet_he_less_turbo32;
         typedef SkipListSet< rcu_gpi, key_val, traits_SkipListSet_less_turbo32 > SkipListSet_rcu_gpi_less_turbo32;
         typedef SkipListSet< rcu_gpb, key_val, traits_SkipListSet_less_turbo32 > SkipListSet_rcu_gpb_less_turbo32;
         typedef SkipListSet< rcu_gpt, key_val, traits_SkipListSet_less_turbo32 > SkipListSet_rcu_gpt_less_turbo32;
@@ -200,6 +202,7 @@ namespace set {
         {};
         typedef SkipListSet< cds::gc::HP, key_val, traits_SkipListSet_cmp_turbo32_stat > SkipListSet_hp_cmp_turbo32_stat;
         typedef SkipListSet< cds::gc::DHP, key_val, traits_SkipListSet_cmp_turbo32_stat > SkipListSet_dhp_cmp_turbo32_stat;
+        typedef SkipListSet< cds::gc::HE, key_val, traits_SkipListSet_cmp_turbo32_stat > SkipListSet_he_cmp_turbo32_stat;
         typedef SkipListSet< rcu_gpi, key_val, traits_SkipListSet_cmp_turbo32_stat > SkipListSet_rcu_gpi_cmp_turbo32_stat;
         typedef SkipListSet< rcu_gpb, key_val, traits_SkipListSet_cmp_turbo32_stat > SkipListSet_rcu_gpb_cmp_turbo32_stat;
         typedef SkipListSet< rcu_gpt, key_val, traits_SkipListSet_cmp_turbo32_stat > SkipListSet_rcu_gpt_cmp_turbo32_stat;
@@ -445,6 +448,8 @@ namespace set {
     CDSSTRESS_SkipListSet_case( fixture, test_case, SkipListSet_dhp_less_xorshift16_stat,     key_type, value_type ) \
     CDSSTRESS_SkipListSet_case( fixture, test_case, SkipListSet_dhp_cmp_xorshift32,           key_type, value_type ) \
     CDSSTRESS_SkipListSet_case( fixture, test_case, SkipListSet_hp_cmp_xorshift32_stat,       key_type, value_type ) \
+    CDSSTRESS_SkipListSet_case( fixture, test_case, SkipListSet_he_less_turbo32,              key_type, value_type ) \
+    CDSSTRESS_SkipListSet_case( fixture, test_case, SkipListSet_he_cmp_turbo32_stat,          key_type, value_type ) \
     CDSSTRESS_SkipListSet_HP_1( fixture, test_case, key_type, value_type ) \
     CDSSTRESS_SkipListSet_HP_2( fixture, test_case, key_type, value_type ) \
 
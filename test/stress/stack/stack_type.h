@@ -386,6 +386,13 @@ namespace stack {
                 cds::opt::enable_elimination< true >
             >::type
         {};
+        struct traits_FCDeque_parallel_stat:
+            public cds::container::fcdeque::make_traits<
+                cds::opt::stat< cds::container::fcdeque::stat<> >,
+                cds::opt::enable_elimination< true >,
+                cds::opt::fc_kernel< cds::algo::flat_combining::parallel_kernel<4>>
+            >::type
+        {};
         struct traits_FCDeque_mutex:
             public cds::container::fcdeque::make_traits<
                 cds::opt::lock_type< std::mutex >
@@ -398,12 +405,14 @@ namespace stack {
         typedef details::FCDequeL< T, traits_FCDeque_stat > FCDequeL_stat;
         typedef details::FCDequeL< T, traits_FCDeque_elimination > FCDequeL_elimination;
         typedef details::FCDequeL< T, traits_FCDeque_elimination_stat > FCDequeL_elimination_stat;
+        typedef details::FCDequeL< T, traits_FCDeque_parallel_stat > FCDequeL_parallel_stat;
 
         typedef details::FCDequeR< T > FCDequeR_default;
         typedef details::FCDequeR< T, traits_FCDeque_mutex > FCDequeR_mutex;
         typedef details::FCDequeR< T, traits_FCDeque_stat > FCDequeR_stat;
         typedef details::FCDequeR< T, traits_FCDeque_elimination > FCDequeR_elimination;
         typedef details::FCDequeR< T, traits_FCDeque_elimination_stat > FCDequeR_elimination_stat;
+        typedef details::FCDequeR< T, traits_FCDeque_parallel_stat > FCDequeR_parallel_stat;
 
 
         // std::stack
@@ -470,6 +479,7 @@ namespace cds_test {
             << CDSSTRESS_STAT_OUT( s, m_nPopBack )
             << CDSSTRESS_STAT_OUT( s, m_nFailedPopBack )
             << CDSSTRESS_STAT_OUT( s, m_nCollided )
+            << CDSSTRESS_STAT_OUT( s, m_nEliminationPass )
             << static_cast<cds::algo::flat_combining::stat<> const&>(s);
     }
 } // namespace cds_test
@@ -551,11 +561,13 @@ namespace cds_test {
     CDSSTRESS_Stack_F( test_fixture, FCDequeL_stat ) \
     CDSSTRESS_Stack_F( test_fixture, FCDequeL_elimination ) \
     CDSSTRESS_Stack_F( test_fixture, FCDequeL_elimination_stat ) \
+    CDSSTRESS_Stack_F( test_fixture, FCDequeL_parallel_stat ) \
     CDSSTRESS_Stack_F( test_fixture, FCDequeR_default ) \
     CDSSTRESS_Stack_F( test_fixture, FCDequeR_mutex ) \
     CDSSTRESS_Stack_F( test_fixture, FCDequeR_stat ) \
     CDSSTRESS_Stack_F( test_fixture, FCDequeR_elimination ) \
-    CDSSTRESS_Stack_F( test_fixture, FCDequeR_elimination_stat )
+    CDSSTRESS_Stack_F( test_fixture, FCDequeR_elimination_stat ) \
+    CDSSTRESS_Stack_F( test_fixture, FCDequeR_parallel_stat )
 
 #define CDSSTRESS_StdStack( test_fixture ) \
     CDSSTRESS_Stack_F( test_fixture, StdStack_Deque_Mutex  ) \
@@ -31,11 +31,49 @@
 #include <cds_test/ext_gtest.h>
 #include <cds/container/fcdeque.h>
 #include <boost/container/deque.hpp>
+#include <thread>
+#include <vector>
+#include <algorithm>
 
 namespace {
 
     class FCDeque: public ::testing::Test
     {
+    public:
+        // The deque yields the combiner, so the other threads publish their requests
+        // and the combiner gets a batch of them even on a single core
+        template <typename T>
+        struct yield_deque: public std::deque<T>
+        {
+            typedef std::deque<T> base_class;
+
+            template <typename Q>
+            void push_front( Q&& v )
+            {
+                std::this_thread::yield();
+                base_class::push_front( std::forward<Q>( v ));
+            }
+
+            template <typename Q>
+            void push_back( Q&& v )
+            {
+                std::this_thread::yield();
+                base_class::push_back( std::forward<Q>( v ));
+            }
+
+            void pop_front()
+            {
+                std::this_thread::yield();
+                base_class::pop_front();
+            }
+
+            void pop_back()
+            {
+                std::this_thread::yield();
+                base_class::pop_back();
+            }
+        };
+
     protected:
         template <class Deque>
         void test( Deque& dq )
@@ -116,6 +154,70 @@ namespace {
             dq.clear();
             EXPECT_TRUE( dq.empty());
         }
+
+        // Each thread pushes its values and pops at random ends in random order concurrently.
+        // If nPrefill > 0 the deque is never empty, so only the same-end push/pop can be paired
+        template <class Deque>
+        void test_concurrent( Deque& dq, int nPrefill = 0 )
+        {
+            static unsigned int const c_nThreadCount = 4;
+            static int const c_nPassCount = 2000;  // per thread
+            static int const c_nTotal = static_cast<int>( c_nThreadCount ) * c_nPassCount;
+
+            ASSERT_TRUE( dq.empty());
+            for ( int i = 0; i < nPrefill; ++i )
+                ASSERT_TRUE( dq.push_back( c_nTotal + i ));
+
+            std::vector< std::vector<int>> arrPopped( c_nThreadCount );
+            std::vector< std::thread > threads;
+            for ( unsigned int t = 0; t < c_nThreadCount; ++t ) {
+                threads.emplace_back( [&dq, &arrPopped, t]() {
+                    // The threads go almost in lockstep, so the order of push and pop differs by the random choice
+                    unsigned int nRand = t + 1;
+                    int val;
+                    for ( int i = 0; i < c_nPassCount; ++i ) {
+                        int v = static_cast<int>( t ) * c_nPassCount + i;
+                        nRand = nRand * 1103515245 + 12345;
+                        unsigned int const nChoice = nRand >> 16;
+
+                        for ( unsigned int k = 0; k < 2; ++k ) {
+                            if ( ( k + nChoice ) & 1 ) {
+                                if ( ( nChoice & 2 ) ? dq.pop_front( val ) : dq.pop_back( val ))
+                                    arrPopped[t].push_back( val );
+                            }
+                            else if ( nChoice & 4 ) {
+                                if ( nChoice & 8 )
+                                    dq.push_front( std::move( v ));
+                                else
+                                    dq.push_front( v );
+                            }
+                            else {
+                                if ( nChoice & 8 )
+                                    dq.push_back( std::move( v ));
+                                else
+                                    dq.push_back( v );
+                            }
+                        }
+                    }
+                });
+            }
+            for ( auto& thr : threads )
+                thr.join();
+
+            std::vector<int> arrAll;
+            for ( auto const& vec : arrPopped )
+                arrAll.insert( arrAll.end(), vec.begin(), vec.end());
+            int val;
+            while ( dq.pop_front( val ))
+                arrAll.push_back( val );
+            EXPECT_TRUE( dq.empty());
+
+            // Every value is received once
+            ASSERT_EQ( arrAll.size(), static_cast<size_t>( c_nTotal + nPrefill ));
+            std::sort( arrAll.begin(), arrAll.end());
+            for ( size_t i = 0; i < arrAll.size(); ++i )
+                ASSERT_EQ( arrAll[i], static_cast<int>( i ));
+        }
     };
 
     TEST_F( FCDeque, std )
@@ -162,6 +264,68 @@ namespace {
         test( dq );
     }
 
+    TEST_F( FCDeque, std_numa_elimination )
+    {
+        typedef cds::container::FCDeque<int, std::deque<int>,
+            cds::container::fcdeque::make_traits<
+                cds::opt::enable_elimination< true >
+                , cds::opt::fc_kernel< cds::algo::flat_combining::numa_kernel >
+                , cds::opt::numa_topology< cds::algo::flat_combining::numa::round_robin<2>>
+            >::type
+        > deque_type;
+
+        deque_type dq;
+        test( dq );
+    }
+
+    TEST_F( FCDeque, std_parallel_elimination )
+    {
+        typedef cds::container::FCDeque<int, std::deque<int>,
+            cds::container::fcdeque::make_traits<
+                cds::opt::enable_elimination< true >
+                , cds::opt::fc_kernel< cds::algo::flat_combining::parallel_kernel<2>>
+                , cds::opt::stat< cds::container::fcdeque::stat<>>
+            >::type
+        > deque_type;
+
+        deque_type dq;
+        test( dq );
+    }
+
+    TEST_F( FCDeque, std_parallel_elimination_concurrent )
+    {
+        typedef cds::container::FCDeque<int, yield_deque<int>,
+            cds::container::fcdeque::make_traits<
+                cds::opt::enable_elimination< true >
+                , cds::opt::fc_kernel< cds::algo::flat_combining::parallel_kernel<2>>
+                , cds::opt::wait_strategy< cds::algo::flat_combining::wait_strategy::multi_mutex_multi_condvar<>>
+                , cds::opt::stat< cds::container::fcdeque::stat<>>
+            >::type
+        > deque_type;
+
+        deque_type dq;
+        test_concurrent( dq );
+        EXPECT_GT( dq.statistics().m_nCollided.get(), 0u );
+        EXPECT_GT( dq.statistics().m_nEliminationPass.get(), 0u );
+    }
+
+    TEST_F( FCDeque, std_elimination_concurrent )
+    {
+        typedef cds::container::FCDeque<int, yield_deque<int>,
+            cds::container::fcdeque::make_traits<
+                cds::opt::enable_elimination< true >
+                , cds::opt::wait_strategy< cds::algo::flat_combining::wait_strategy::multi_mutex_multi_condvar<>>
+                , cds::opt::stat< cds::container::fcdeque::stat<>>
+            >::type
+        > deque_type;
+
+        // The deque is not empty, so the pairs are matched at the same end only
+        deque_type dq;
+        test_concurrent( dq, 100 );
+        EXPECT_GT( dq.statistics().m_nCollided.get(), 0u );
+        EXPECT_GT( dq.statistics().m_nEliminationPass.get(), 0u );
+    }
+
     TEST_F( FCDeque, std_elimination_single_mutex_single_condvar )
     {
         typedef cds::container::FCDeque<int, std::deque<int>,
@@ -181,10 +181,35 @@ TYPED_TEST_P( MichaelList, wrapped_stat )
     this->test_rcu( l );
 }
 
+TYPED_TEST_P( MichaelList, call_rcu )
+{
+    typedef typename TestFixture::rcu_type rcu_type;
+    typedef typename rcu_type::scoped_lock rcu_lock;
+
+    static const size_t nCount = 100;
+    std::atomic<size_t> nCalled( 0 );
+
+    for ( size_t i = 0; i < nCount; ++i )
+        rcu_type::call_rcu( [&nCalled]() { nCalled.fetch_add( 1 ); } );
+
+    std::future<void> done;
+    {
+        rcu_lock lock;
+        done = rcu_type::call_rcu_future( [&nCalled]() { nCalled.fetch_add( 1 ); } );
+
+        // The grace period cannot end while the current thread is in read-side critical section
+        EXPECT_EQ( done.wait_for( std::chrono::milliseconds( 10 )), std::future_status::timeout );
+    }
+    done.get();
+
+    // The callbacks are invoked in the order of call_rcu() calls
+    EXPECT_EQ( nCalled.load(), nCount + 1 );
+}
+
 // GCC 5: All test names should be written on single line, otherwise a runtime error will be encountered like as
 // "No test named <test_name> can be found in this test case"
 REGISTER_TYPED_TEST_CASE_P( MichaelList,
-    less_ordered, compare_ordered, mix_ordered, item_counting, backoff, seq_cst, stat, wrapped_stat
+    less_ordered, compare_ordered, mix_ordered, item_counting, backoff, seq_cst, stat, wrapped_stat, call_rcu
     );
 
 #endif // CDSUNIT_LIST_TEST_MICHAEL_LIST_RCU_H
@@ -0,0 +1,281 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cds_test/ext_gtest.h>
+#include <vector>
+
+#include <cds/gc/hp.h>
+#include <cds/gc/dhp.h>
+#include <cds/gc/he.h>
+#include <cds/intrusive/michael_list_hp.h>
+
+namespace {
+
+    // cds::gc::HE retires only the objects that have the birth era
+    struct item: public cds::intrusive::michael_list::node< cds::gc::HP >, public cds::gc::details::node_data< cds::gc::HE >
+    {
+        int nKey;
+        size_t nDisposed;
+
+        item()
+            : nKey( 0 )
+            , nDisposed( 0 )
+        {}
+    };
+
+    struct less {
+        bool operator()( item const& i1, item const& i2 ) const
+        {
+            return i1.nKey < i2.nKey;
+        }
+    };
+
+    struct disposer_stat {
+        size_t  nCall;          // per-pointer calls
+        size_t  nBatchCall;     // batch calls
+        size_t  nBatchItem;     // items disposed by batch calls
+
+        void clear()
+        {
+            nCall = nBatchCall = nBatchItem = 0;
+        }
+    };
+
+    disposer_stat s_stat;
+
+    struct plain_disposer {
+        void operator()( item* p )
+        {
+            ++p->nDisposed;
+            ++s_stat.nCall;
+        }
+    };
+
+    struct batch_disposer {
+        void operator()( item* p )
+        {
+            ++p->nDisposed;
+            ++s_stat.nCall;
+        }
+
+        void operator()( item** arr, size_t count )
+        {
+            for ( size_t i = 0; i < count; ++i )
+                ++arr[i]->nDisposed;
+            ++s_stat.nBatchCall;
+            s_stat.nBatchItem += count;
+        }
+    };
+
+    static_assert( cds::gc::details::has_batch_call< batch_disposer, item >::value, "batch disposer must be detected" );
+    static_assert( !cds::gc::details::has_batch_call< plain_disposer, item >::value, "plain disposer has no batch call" );
+
+    struct hp_gc {
+        typedef cds::gc::HP gc;
+        static void construct()
+        {
+            cds::gc::hp::GarbageCollector::Construct( 4, 1, 16 );
+        }
+        static void destruct()
+        {
+            cds::gc::hp::GarbageCollector::Destruct( true );
+        }
+    };
+
+    struct dhp_gc {
+        typedef cds::gc::DHP gc;
+        static void construct()
+        {
+            cds::gc::dhp::smr::construct( 4 );
+        }
+        static void destruct()
+        {
+            cds::gc::dhp::smr::destruct( true );
+        }
+    };
+
+    struct he_gc {
+        typedef cds::gc::HE gc;
+        static void construct()
+        {
+            cds::gc::he::smr::construct( 4, 1, 16 );
+        }
+        static void destruct()
+        {
+            cds::gc::he::smr::destruct( true );
+        }
+    };
+
+    class batch_disposer_test: public ::testing::Test
+    {
+    protected:
+        void SetUp()
+        {
+            s_stat.clear();
+        }
+    };
+
+    template <class GC>
+    class batch_disposer_gc: public ::testing::Test
+    {
+    protected:
+        void SetUp()
+        {
+            GC::construct();
+            cds::threading::Manager::attachThread();
+            s_stat.clear();
+        }
+
+        void TearDown()
+        {
+            cds::threading::Manager::detachThread();
+            GC::destruct();
+        }
+    };
+
+    typedef ::testing::Types< hp_gc, dhp_gc, he_gc > gc_types;
+    TYPED_TEST_CASE( batch_disposer_gc, gc_types );
+
+    TEST_F( batch_disposer_test, registry )
+    {
+        using cds::gc::details::batch_disposer_registry;
+
+        cds::gc::details::free_retired_ptr_func fBatch = cds::gc::details::retired_functor< batch_disposer, item >::get();
+        cds::gc::details::free_retired_ptr_func fPlain = cds::gc::details::retired_functor< plain_disposer, item >::get();
+
+        EXPECT_FALSE( batch_disposer_registry::empty());
+        EXPECT_TRUE( batch_disposer_registry::find( fBatch ) != nullptr );
+        EXPECT_TRUE( batch_disposer_registry::find( fPlain ) == nullptr );
+
+        // Registering is done once per disposer type
+        cds::gc::details::free_retired_ptr_func fAgain = cds::gc::details::retired_functor< batch_disposer, item >::get();
+        EXPECT_TRUE( fAgain == fBatch );
+    }
+
+    TEST_F( batch_disposer_test, free_retired )
+    {
+        using cds::gc::details::retired_ptr;
+
+        static size_t const c_nItemCount = 300; // more than the batch size of free_retired()
+        std::vector< item > items( c_nItemCount );
+        std::vector< retired_ptr > retired;
+
+        cds::gc::details::free_retired_ptr_func fBatch = cds::gc::details::retired_functor< batch_disposer, item >::get();
+        cds::gc::details::free_retired_ptr_func fPlain = cds::gc::details::retired_functor< plain_disposer, item >::get();
+
+        // The retired pointers of batch and per-pointer disposers are interleaved
+        size_t nPlain = 0;
+        for ( size_t i = 0; i < c_nItemCount; ++i ) {
+            if ( i % 3 == 0 ) {
+                retired.push_back( retired_ptr( &items[i], fPlain ));
+                ++nPlain;
+            }
+            else
+                retired.push_back( retired_ptr( &items[i], fBatch ));
+        }
+
+        cds::gc::details::free_retired( retired.data(), retired.data() + retired.size());
+
+        for ( auto const& i : items )
+            EXPECT_EQ( i.nDisposed, 1u );
+        EXPECT_EQ( s_stat.nCall, nPlain );
+        EXPECT_EQ( s_stat.nBatchItem, c_nItemCount - nPlain );
+
+        // The batch items are grouped: 200 items are disposed by two calls of 128 and 72 items
+        EXPECT_EQ( s_stat.nBatchCall, 2u );
+    }
+
+    TYPED_TEST( batch_disposer_gc, retire )
+    {
+        typedef typename TypeParam::gc gc;
+
+        size_t const nItemCount = 1000;
+        std::vector< item > items( nItemCount );
+
+        size_t nPlain = 0;
+        for ( size_t i = 0; i < nItemCount; ++i ) {
+            if ( i % 4 == 0 ) {
+                gc::template retire< plain_disposer >( &items[i] );
+                ++nPlain;
+            }
+            else
+                gc::template retire< batch_disposer >( &items[i] );
+        }
+        gc::force_dispose();
+
+        for ( auto const& i : items )
+            EXPECT_EQ( i.nDisposed, 1u );
+        EXPECT_EQ( s_stat.nCall, nPlain );
+        EXPECT_EQ( s_stat.nBatchItem, nItemCount - nPlain );
+        EXPECT_GT( s_stat.nBatchCall, 0u );
+
+        // Each scan disposes the batch items of a full retired array by few calls
+        EXPECT_LT( s_stat.nBatchCall, s_stat.nBatchItem );
+    }
+
+    TEST_F( batch_disposer_test, container )
+    {
+        typedef cds::intrusive::MichaelList< cds::gc::HP, item,
+            typename cds::intrusive::michael_list::make_traits<
+                cds::intrusive::opt::hook< cds::intrusive::michael_list::base_hook< cds::opt::gc< cds::gc::HP >>>
+                , cds::intrusive::opt::disposer< batch_disposer >
+                , cds::opt::less< less >
+            >::type
+        > list_type;
+
+        cds::gc::hp::GarbageCollector::Construct( list_type::c_nHazardPtrCount, 1, 16 );
+        cds::threading::Manager::attachThread();
+        {
+            size_t const nItemCount = 100;
+            std::vector< item > items( nItemCount );
+            {
+                list_type l;
+                for ( size_t i = 0; i < nItemCount; ++i ) {
+                    items[i].nKey = static_cast<int>( i );
+                    EXPECT_TRUE( l.insert( items[i] ));
+                }
+                for ( size_t i = 0; i < nItemCount; ++i )
+                    EXPECT_TRUE( l.erase( items[i] ));
+                EXPECT_TRUE( l.empty());
+            }
+            cds::gc::HP::force_dispose();
+
+            for ( auto const& i : items )
+                EXPECT_EQ( i.nDisposed, 1u );
+
+            // The list disposer wrapper forwards the batch call to the disposer
+            EXPECT_EQ( s_stat.nCall, 0u );
+            EXPECT_EQ( s_stat.nBatchItem, nItemCount );
+        }
+        cds::threading::Manager::detachThread();
+        cds::gc::hp::GarbageCollector::Destruct( true );
+    }
+
+} // namespace
@@ -0,0 +1,133 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cds_test/ext_gtest.h>
+
+#include <cds/intrusive/michael_list_he.h>
+
+namespace {
+
+    class he_birth_era: public ::testing::Test
+    {
+    protected:
+        struct item: public cds::intrusive::michael_list::node<cds::gc::HE>
+        {
+            static size_t s_nFreed;
+        };
+
+        struct disposer {
+            void operator()( item* p )
+            {
+                ++item::s_nFreed;
+                delete p;
+            }
+        };
+
+        void SetUp()
+        {
+            cds::gc::he::smr::construct( 2, 8, 16, 4 );
+            cds::threading::Manager::attachThread();
+            item::s_nFreed = 0;
+        }
+
+        void TearDown()
+        {
+            cds::threading::Manager::detachThread();
+            cds::gc::he::smr::destruct( true );
+        }
+    };
+
+    size_t he_birth_era::item::s_nFreed = 0;
+
+    TEST_F( he_birth_era, stalled_reader )
+    {
+        typedef cds::gc::HE gc;
+
+        item* pOld = new item;
+        item* pAlive = new item;
+        EXPECT_EQ( pOld->birth_era_, gc::current_era());
+
+        // The reader stalls holding the era when pOld and pAlive are alive
+        gc::Guard g;
+        g.assign( pOld );
+        gc::retire<disposer>( pOld );
+        gc::scan();
+        EXPECT_EQ( item::s_nFreed, 0u );
+
+        // The objects born after the stalled era are freed
+        size_t const nCount = 100;
+        for ( size_t i = 0; i < nCount; ++i ) {
+            item* p = new item;
+            EXPECT_GT( p->birth_era_, pOld->birth_era_ );
+            gc::retire<disposer>( p );
+        }
+        gc::scan();
+        EXPECT_EQ( item::s_nFreed, nCount );
+
+        // The object alive at the stalled era is kept even if it is retired later
+        gc::retire<disposer>( pAlive );
+        gc::scan();
+        EXPECT_EQ( item::s_nFreed, nCount );
+
+        g.clear();
+        gc::scan();
+        EXPECT_EQ( item::s_nFreed, nCount + 2 );
+    }
+
+    TEST_F( he_birth_era, assign_guarded )
+    {
+        typedef cds::gc::HE gc;
+
+        item* p = new item;
+        gc::Guard g1;
+        g1.assign( p );
+
+        // The objects born at the era of g1 are protected by g1 as well
+        size_t const nCount = 10;
+        size_t const nBornAtGuardEra = 4;   // era frequency
+        for ( size_t i = 0; i < nCount; ++i )
+            gc::retire<disposer>( new item );
+        gc::retire<disposer>( p );
+        gc::scan();
+        EXPECT_EQ( item::s_nFreed, nCount - nBornAtGuardEra );
+
+        // g2 gets the era of g1 that protects p, the current era is past the retire era of p
+        gc::Guard g2;
+        g2.assign( p );
+        g1.clear();
+        gc::scan();
+        EXPECT_EQ( item::s_nFreed, nCount - nBornAtGuardEra );
+
+        g2.clear();
+        gc::scan();
+        EXPECT_EQ( item::s_nFreed, nCount + 1 );
+    }
+
+} // namespace
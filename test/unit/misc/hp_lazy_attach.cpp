@@ -0,0 +1,104 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include <cds_test/ext_gtest.h>
+#include <thread>
+
+#include <cds/gc/hp.h>
+
+namespace {
+
+    class hp_lazy_attach: public ::testing::Test
+    {
+    protected:
+        void SetUp()
+        {
+            cds::gc::hp::GarbageCollector::Construct( 2, 8, 16 );
+        }
+
+        void TearDown()
+        {
+            cds::gc::hp::GarbageCollector::Destruct( true );
+        }
+
+        static size_t thread_list_count()
+        {
+            cds::gc::HP::stat st;
+            cds::gc::HP::statistics( st );
+            return st.thread_list_count;
+        }
+    };
+
+    TEST_F( hp_lazy_attach, attached_thread )
+    {
+        size_t const nInitCount = thread_list_count();
+
+        std::thread t( [nInitCount]() {
+            cds::threading::Manager::attachThread();
+
+            // The thread gets HP record on its first use of HP
+            EXPECT_EQ( thread_list_count(), nInitCount );
+            {
+                cds::gc::HP::Guard g;
+            }
+            EXPECT_EQ( thread_list_count(), nInitCount + 1 );
+
+            cds::threading::Manager::detachThread();
+        } );
+        t.join();
+    }
+
+    TEST_F( hp_lazy_attach, unattached_thread )
+    {
+        size_t const nInitCount = thread_list_count();
+
+        // A thread not attached to the Manager is never detached from HP, so it must not get HP record
+        ASSERT_FALSE( cds::threading::Manager::isThreadAttached());
+#ifdef NDEBUG
+        EXPECT_TRUE( cds::gc::hp::smr::tls() == nullptr );
+#else
+        EXPECT_DEATH( cds::gc::hp::smr::tls(), "" );
+#endif
+        EXPECT_EQ( thread_list_count(), nInitCount );
+
+        // A detached thread is not attached again
+        cds::threading::Manager::attachThread();
+        {
+            cds::gc::HP::Guard g;
+        }
+        EXPECT_EQ( thread_list_count(), nInitCount + 1 );
+        cds::threading::Manager::detachThread();
+#ifdef NDEBUG
+        EXPECT_TRUE( cds::gc::hp::smr::tls() == nullptr );
+#else
+        EXPECT_DEATH( cds::gc::hp::smr::tls(), "" );
+#endif
+    }
+
+} // namespace
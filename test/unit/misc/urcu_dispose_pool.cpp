@@ -0,0 +1,137 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include <cds_test/ext_gtest.h>
+#include <thread>
+#include <vector>
+
+#include <cds/urcu/general_threaded.h>
+#include <cds/urcu/dispose_thread_pool.h>
+
+namespace {
+
+    static cds::atomicity::event_counter s_nFreed;
+    static cds::atomicity::event_counter s_nInitCount;
+
+    struct item {
+        size_t  n;
+    };
+
+    struct item_disposer {
+        void operator()( item * p ) const
+        {
+            delete p;
+            ++s_nFreed;
+        }
+    };
+
+    struct counting_init {
+        void operator()( size_t nWorker, size_t nWorkerCount ) const
+        {
+            EXPECT_LT( nWorker, nWorkerCount );
+            ++s_nInitCount;
+        }
+    };
+
+    struct pool_traits: public cds::urcu::dispose_thread_pool_traits
+    {
+        static constexpr size_t const thread_count = 4;
+        static constexpr size_t const batch_size = 16;
+        typedef counting_init worker_init;
+    };
+
+    struct bounded_pool_traits: public pool_traits
+    {
+        static constexpr size_t const max_pending = 32;
+    };
+
+    typedef cds::container::VyukovMPSCCycleQueue< cds::urcu::epoch_retired_ptr > rcu_buffer;
+
+    template <class RCU>
+    class urcu_dispose_pool: public ::testing::Test
+    {
+    public:
+        typedef cds::urcu::gc<RCU> rcu_type;
+
+    protected:
+        void SetUp()
+        {
+            s_nFreed.reset();
+            s_nInitCount.reset();
+            RCU::Construct( 64 );
+            cds::threading::Manager::attachThread();
+        }
+
+        void TearDown()
+        {
+            cds::threading::Manager::detachThread();
+            RCU::Destruct();
+        }
+    };
+
+    typedef ::testing::Types<
+        cds::urcu::general_threaded< rcu_buffer, std::mutex, cds::urcu::dispose_thread_pool< rcu_buffer, pool_traits >>,
+        cds::urcu::general_threaded< rcu_buffer, std::mutex, cds::urcu::dispose_thread_pool< rcu_buffer, bounded_pool_traits >>
+    > rcu_implementations;
+
+    TYPED_TEST_CASE( urcu_dispose_pool, rcu_implementations );
+
+    TYPED_TEST( urcu_dispose_pool, retire )
+    {
+        typedef typename TestFixture::rcu_type rcu_type;
+
+        static const size_t c_nThreadCount = 4;
+        static const size_t c_nItemCount = 10000;
+        size_t const nWorkerCount = pool_traits::thread_count;
+
+        std::vector< std::thread > threads;
+        for ( size_t i = 0; i < c_nThreadCount; ++i ) {
+            threads.emplace_back( []() {
+                cds::threading::Manager::attachThread();
+                for ( size_t k = 0; k < c_nItemCount; ++k ) {
+                    {
+                        typename rcu_type::scoped_lock lock;
+                    }
+                    rcu_type::template retire_ptr<item_disposer>( new item{ k } );
+                }
+                cds::threading::Manager::detachThread();
+            } );
+        }
+        for ( auto& t : threads )
+            t.join();
+
+        // All retired objects are freed after the grace period
+        rcu_type::force_dispose();
+        EXPECT_EQ( s_nFreed.get(), c_nThreadCount * c_nItemCount );
+        EXPECT_EQ( TypeParam::instance()->disposer().pending(), 0u );
+        EXPECT_EQ( TypeParam::instance()->disposer().thread_count(), nWorkerCount );
+        EXPECT_EQ( s_nInitCount.get(), nWorkerCount );
+    }
+
+} // namespace
@@ -0,0 +1,155 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cds_test/ext_gtest.h>
+#include <thread>
+#include <vector>
+
+#include <cds/urcu/general_instant.h>
+#include <cds/urcu/general_buffered.h>
+#include <cds/urcu/general_local_buffered.h>
+
+namespace {
+
+    template <class RCU>
+    class urcu_gp_stat: public ::testing::Test
+    {
+    public:
+        typedef cds::urcu::gc<RCU> rcu_type;
+
+    protected:
+        void SetUp()
+        {
+            RCU::Construct();
+            cds::threading::Manager::attachThread();
+        }
+
+        void TearDown()
+        {
+            cds::threading::Manager::detachThread();
+            RCU::Destruct();
+        }
+    };
+
+    typedef ::testing::Types<
+        cds::urcu::general_instant<>,
+        cds::urcu::general_buffered<>,
+        cds::urcu::general_local_buffered<>
+    > rcu_implementations;
+
+    TYPED_TEST_CASE( urcu_gp_stat, rcu_implementations );
+
+    TYPED_TEST( urcu_gp_stat, synchronize )
+    {
+        typedef typename TestFixture::rcu_type rcu_type;
+
+        static const size_t c_nThreadCount = 8;
+        static const size_t c_nPassCount = 1000;
+
+        cds::urcu::gp_stat before;
+        rcu_type::statistics( before );
+
+        rcu_type::synchronize();
+
+        cds::urcu::gp_stat st;
+        rcu_type::statistics( st );
+        EXPECT_EQ( st.gp_count, before.gp_count + 1 );
+        EXPECT_EQ( st.gp_shared_count, before.gp_shared_count );
+
+        std::vector< std::thread > threads;
+        for ( size_t i = 0; i < c_nThreadCount; ++i ) {
+            threads.emplace_back( []() {
+                cds::threading::Manager::attachThread();
+                for ( size_t pass = 0; pass < c_nPassCount; ++pass ) {
+                    {
+                        typename rcu_type::scoped_lock lock;
+                    }
+                    rcu_type::synchronize();
+                }
+                cds::threading::Manager::detachThread();
+            } );
+        }
+        for ( auto& t : threads )
+            t.join();
+
+        cds::urcu::gp_stat after;
+        rcu_type::statistics( after );
+
+        // Each synchronize() call either passes its own grace period or uses the one passed by another caller
+        EXPECT_EQ( after.gp_count - st.gp_count + after.gp_shared_count - st.gp_shared_count, c_nThreadCount * c_nPassCount );
+        EXPECT_GT( after.gp_count, st.gp_count );
+    }
+
+    TYPED_TEST( urcu_gp_stat, synchronize_expedited )
+    {
+        typedef typename TestFixture::rcu_type rcu_type;
+
+        static const size_t c_nThreadCount = 4;
+        static const size_t c_nPassCount = 100;
+
+        cds::urcu::gp_stat before;
+        rcu_type::statistics( before );
+
+        rcu_type::synchronize_expedited();
+
+        cds::urcu::gp_stat st;
+        rcu_type::statistics( st );
+        EXPECT_EQ( st.gp_count, before.gp_count + 1 );
+        EXPECT_EQ( st.gp_shared_count, before.gp_shared_count );
+
+        // The readers keep entering critical sections while the main thread passes expedited grace periods
+        atomics::atomic<bool> bStop( false );
+        std::vector< std::thread > threads;
+        for ( size_t i = 0; i < c_nThreadCount; ++i ) {
+            threads.emplace_back( [&bStop]() {
+                cds::threading::Manager::attachThread();
+                while ( !bStop.load( atomics::memory_order_relaxed )) {
+                    typename rcu_type::scoped_lock lock;
+                }
+                cds::threading::Manager::detachThread();
+            } );
+        }
+
+        for ( size_t pass = 0; pass < c_nPassCount; ++pass )
+            rcu_type::synchronize_expedited();
+
+        bStop.store( true, atomics::memory_order_relaxed );
+        for ( auto& t : threads )
+            t.join();
+
+        cds::urcu::gp_stat after;
+        rcu_type::statistics( after );
+
+        // Only the main thread passes grace periods, so none of them is shared
+        EXPECT_EQ( after.gp_count - st.gp_count, c_nPassCount );
+        EXPECT_EQ( after.gp_shared_count, st.gp_shared_count );
+    }
+
+} // namespace
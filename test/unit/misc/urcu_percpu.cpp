@@ -0,0 +1,188 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include <cds_test/ext_gtest.h>
+#include <thread>
+#include <vector>
+#include <chrono>
+
+#include <cds/urcu/percpu_buffered.h>
+
+namespace {
+
+    typedef cds::urcu::gc< cds::urcu::percpu_buffered<>> rcu_type;
+
+    class urcu_percpu: public ::testing::Test
+    {
+    protected:
+        void SetUp()
+        {
+            rcu_type::rcu_implementation::Construct( 16 );
+            cds::threading::Manager::attachThread();
+        }
+
+        void TearDown()
+        {
+            cds::threading::Manager::detachThread();
+            rcu_type::rcu_implementation::Destruct();
+        }
+
+        struct item {
+            size_t  nValue;
+        };
+
+        struct item_disposer {
+            void operator()( item * p ) const
+            {
+                p->nValue = 0;
+                delete p;
+            }
+        };
+    };
+
+    TEST_F( urcu_percpu, access_lock )
+    {
+        EXPECT_GE( rcu_type::rcu_implementation::instance()->counter_count(), 1u );
+
+        EXPECT_FALSE( rcu_type::is_locked());
+        {
+            rcu_type::scoped_lock l1;
+            EXPECT_TRUE( rcu_type::is_locked());
+            {
+                rcu_type::scoped_lock l2;
+                EXPECT_TRUE( rcu_type::is_locked());
+            }
+            EXPECT_TRUE( rcu_type::is_locked());
+        }
+        EXPECT_FALSE( rcu_type::is_locked());
+
+        rcu_type::synchronize();
+        rcu_type::synchronize();
+    }
+
+    TEST_F( urcu_percpu, wait_reader )
+    {
+        std::atomic<bool> bLocked( false );
+        std::atomic<bool> bUnlock( false );
+        std::atomic<bool> bSynchronized( false );
+
+        // Idle attached threads do not delay grace periods
+        std::vector< std::thread > idle;
+        for ( size_t i = 0; i < 16; ++i ) {
+            idle.emplace_back( [&bUnlock]() {
+                cds::threading::Manager::attachThread();
+                while ( !bUnlock.load( std::memory_order_acquire ))
+                    std::this_thread::sleep_for( std::chrono::milliseconds( 1 ));
+                cds::threading::Manager::detachThread();
+            } );
+        }
+        rcu_type::synchronize();
+
+        std::thread reader( [&]() {
+            cds::threading::Manager::attachThread();
+            {
+                rcu_type::scoped_lock l;
+                bLocked.store( true, std::memory_order_release );
+                while ( !bUnlock.load( std::memory_order_acquire ))
+                    std::this_thread::yield();
+            }
+            cds::threading::Manager::detachThread();
+        } );
+
+        while ( !bLocked.load( std::memory_order_acquire ))
+            std::this_thread::yield();
+
+        std::thread updater( [&]() {
+            cds::threading::Manager::attachThread();
+            rcu_type::synchronize();
+            bSynchronized.store( true, std::memory_order_release );
+            cds::threading::Manager::detachThread();
+        } );
+
+        // The grace period cannot end while the reader is in its critical section
+        std::this_thread::sleep_for( std::chrono::milliseconds( 50 ));
+        EXPECT_FALSE( bSynchronized.load( std::memory_order_acquire ));
+
+        bUnlock.store( true, std::memory_order_release );
+        updater.join();
+        reader.join();
+        for ( auto& t : idle )
+            t.join();
+        EXPECT_TRUE( bSynchronized.load( std::memory_order_acquire ));
+    }
+
+    TEST_F( urcu_percpu, readers )
+    {
+        static const size_t c_nReaderCount = 4;
+        static const size_t c_nUpdateCount = 500;
+
+        cds::urcu::details::gc_common::atomic_marked_ptr< cds::details::marked_ptr< item, 0 >> pShared;
+        pShared.store( cds::details::marked_ptr< item, 0 >( new item{ 1 } ), std::memory_order_release );
+        std::atomic<bool> bStop( false );
+        std::atomic<size_t> nErrors( 0 );
+        std::atomic<size_t> nStarted( 0 );
+
+        std::vector< std::thread > readers;
+        for ( size_t i = 0; i < c_nReaderCount; ++i ) {
+            readers.emplace_back( [&]() {
+                cds::threading::Manager::attachThread();
+                nStarted.fetch_add( 1 );
+                while ( !bStop.load( std::memory_order_acquire )) {
+                    rcu_type::scoped_lock l;
+                    item * p = pShared.load( std::memory_order_acquire ).ptr();
+                    for ( int k = 0; k < 16; ++k ) {
+                        if ( p->nValue == 0 )
+                            nErrors.fetch_add( 1 );
+                        // let the thread migrate to another processor inside the critical section
+                        if ( k == 8 )
+                            std::this_thread::yield();
+                    }
+                }
+                cds::threading::Manager::detachThread();
+            } );
+        }
+
+        while ( nStarted.load() != c_nReaderCount )
+            std::this_thread::yield();
+
+        for ( size_t i = 0; i < c_nUpdateCount; ++i ) {
+            item * pOld = pShared.exchange( cds::details::marked_ptr< item, 0 >( new item{ i + 2 } ), std::memory_order_acq_rel ).ptr();
+            rcu_type::retire_ptr< item_disposer >( pOld );
+        }
+
+        bStop.store( true, std::memory_order_release );
+        for ( auto& t : readers )
+            t.join();
+
+        EXPECT_EQ( nErrors.load(), 0u );
+        rcu_type::synchronize();
+        delete pShared.load( std::memory_order_relaxed ).ptr();
+    }
+
+} // namespace
@@ -0,0 +1,201 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cds_test/ext_gtest.h>
+#include <thread>
+#include <vector>
+
+#include <cds/urcu/quiescent_buffered.h>
+
+namespace {
+
+    typedef cds::urcu::gc< cds::urcu::quiescent_buffered<>> rcu_type;
+
+    class urcu_qsbr: public ::testing::Test
+    {
+    protected:
+        void SetUp()
+        {
+            rcu_type::rcu_implementation::Construct( 16 );
+            cds::threading::Manager::attachThread();
+        }
+
+        void TearDown()
+        {
+            cds::threading::Manager::detachThread();
+            rcu_type::rcu_implementation::Destruct();
+        }
+
+        struct item {
+            size_t  nValue;
+        };
+
+        struct item_disposer {
+            void operator()( item * p ) const
+            {
+                p->nValue = 0;
+                delete p;
+            }
+        };
+    };
+
+    TEST_F( urcu_qsbr, access_lock )
+    {
+        EXPECT_FALSE( rcu_type::is_locked());
+        {
+            rcu_type::scoped_lock l1;
+            EXPECT_TRUE( rcu_type::is_locked());
+            {
+                rcu_type::scoped_lock l2;
+                EXPECT_TRUE( rcu_type::is_locked());
+            }
+            EXPECT_TRUE( rcu_type::is_locked());
+        }
+        EXPECT_FALSE( rcu_type::is_locked());
+
+        // The caller of synchronize() is not waited for
+        rcu_type::synchronize();
+        rcu_type::quiescent_state();
+    }
+
+    TEST_F( urcu_qsbr, readers )
+    {
+        static const size_t c_nReaderCount = 4;
+        static const size_t c_nUpdateCount = 500;
+
+        cds::urcu::details::gc_common::atomic_marked_ptr< cds::details::marked_ptr< item, 0 >> pShared;
+        pShared.store( cds::details::marked_ptr< item, 0 >( new item{ 1 } ), std::memory_order_release );
+        std::atomic<bool> bStop( false );
+        std::atomic<size_t> nErrors( 0 );
+        std::atomic<size_t> nStarted( 0 );
+
+        std::vector< std::thread > readers;
+        for ( size_t i = 0; i < c_nReaderCount; ++i ) {
+            readers.emplace_back( [&]() {
+                cds::threading::Manager::attachThread();
+                nStarted.fetch_add( 1 );
+                while ( !bStop.load( std::memory_order_acquire )) {
+                    {
+                        rcu_type::scoped_lock l;
+                        item * p = pShared.load( std::memory_order_acquire ).ptr();
+                        for ( int k = 0; k < 16; ++k ) {
+                            if ( p->nValue == 0 )
+                                nErrors.fetch_add( 1 );
+                        }
+                    }
+                    rcu_type::quiescent_state();
+                }
+                cds::threading::Manager::detachThread();
+            } );
+        }
+
+        while ( nStarted.load() != c_nReaderCount )
+            std::this_thread::yield();
+
+        for ( size_t i = 0; i < c_nUpdateCount; ++i ) {
+            item * pOld = pShared.exchange( cds::details::marked_ptr< item, 0 >( new item{ i + 2 } ), std::memory_order_acq_rel ).ptr();
+            rcu_type::retire_ptr< item_disposer >( pOld );
+        }
+
+        bStop.store( true, std::memory_order_release );
+        for ( auto& t : readers )
+            t.join();
+
+        EXPECT_EQ( nErrors.load(), 0u );
+        rcu_type::synchronize();
+        delete pShared.load( std::memory_order_relaxed ).ptr();
+    }
+
+    TEST_F( urcu_qsbr, idle_thread )
+    {
+        std::atomic<bool> bAttached( false );
+        std::atomic<bool> bStop( false );
+
+        // The thread is attached to the RCU but never enters read-side critical section
+        // and never calls quiescent_state(), it must not delay grace periods
+        std::thread idle( [&]() {
+            cds::threading::Manager::attachThread();
+            EXPECT_FALSE( rcu_type::is_locked());
+            bAttached.store( true, std::memory_order_release );
+            while ( !bStop.load( std::memory_order_acquire ))
+                std::this_thread::yield();
+            cds::threading::Manager::detachThread();
+        } );
+
+        while ( !bAttached.load( std::memory_order_acquire ))
+            std::this_thread::yield();
+
+        // Retire more than the buffer capacity
+        for ( size_t i = 0; i < 100; ++i )
+            rcu_type::retire_ptr< item_disposer >( new item{ i + 1 } );
+        rcu_type::synchronize();
+
+        bStop.store( true, std::memory_order_release );
+        idle.join();
+    }
+
+    TEST_F( urcu_qsbr, thread_offline )
+    {
+        std::atomic<bool> bOffline( false );
+        std::atomic<bool> bStop( false );
+
+        // The offline thread does not delay grace periods
+        std::thread blocked( [&]() {
+            cds::threading::Manager::attachThread();
+            rcu_type::thread_offline();
+            bOffline.store( true, std::memory_order_release );
+            while ( !bStop.load( std::memory_order_acquire ))
+                std::this_thread::yield();
+            rcu_type::thread_online();
+            cds::threading::Manager::detachThread();
+        } );
+
+        while ( !bOffline.load( std::memory_order_acquire ))
+            std::this_thread::yield();
+        rcu_type::synchronize();
+
+        // The deferred callback thread is offline while it is idle
+        std::atomic<size_t> nCalled( 0 );
+        for ( size_t i = 0; i < 10; ++i )
+            rcu_type::call_rcu( [&nCalled]() { nCalled.fetch_add( 1 ); } );
+
+        std::future<void> done = rcu_type::call_rcu_future( [&nCalled]() { nCalled.fetch_add( 1 ); } );
+        rcu_type::thread_offline();
+        done.get();
+        rcu_type::thread_online();
+        EXPECT_EQ( nCalled.load(), 11u );
+
+        rcu_type::synchronize();
+
+        bStop.store( true, std::memory_order_release );
+        blocked.join();
+    }
+
+} // namespace
@@ -0,0 +1,183 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+
+    (C) Copyright Maxim Khizhinsky (libcds.dev@gmail.com) 2006-2017
+
+    Source code repo: http://github.com/khizmax/libcds/
+    Download: http://sourceforge.net/projects/libcds/files/
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this
+      list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above copyright notice,
+      this list of conditions and the following disclaimer in the documentation
+      and/or other materials provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+    OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cds_test/ext_gtest.h>
+#include <chrono>
+#include <thread>
+
+#include <cds/urcu/general_instant.h>
+#include <cds/urcu/general_buffered.h>
+#include <cds/urcu/general_local_buffered.h>
+
+namespace {
+
+    struct item
+    {
+        static atomics::atomic<size_t> s_nDisposed;
+    };
+    atomics::atomic<size_t> item::s_nDisposed( 0 );
+
+    struct item_disposer
+    {
+        void operator()( item * p ) const
+        {
+            item::s_nDisposed.fetch_add( 1, atomics::memory_order_relaxed );
+            delete p;
+        }
+    };
+
+    template <class RCU>
+    class urcu_stat: public ::testing::Test
+    {
+    public:
+        typedef cds::urcu::gc<RCU> rcu_type;
+        typedef typename rcu_type::stat stat_type;
+
+    protected:
+        void SetUp()
+        {
+            RCU::Construct();
+            cds::threading::Manager::attachThread();
+        }
+
+        void TearDown()
+        {
+            cds::threading::Manager::detachThread();
+            RCU::Destruct();
+        }
+
+        static size_t histogram_sum( stat_type const& st )
+        {
+            size_t nSum = 0;
+            for ( size_t i = 0; i < stat_type::c_nLatencyBucketCount; ++i )
+                nSum += st.m_arrLatency[i].get();
+            return nSum;
+        }
+    };
+
+    typedef ::testing::Types<
+        cds::urcu::general_instant< std::mutex, cds::backoff::Default, cds::urcu::stat<>>,
+        cds::urcu::general_buffered< cds::container::VyukovMPMCCycleQueue< cds::urcu::epoch_retired_ptr >, std::mutex, cds::backoff::Default, cds::urcu::stat<>>,
+        cds::urcu::general_local_buffered< std::mutex, cds::backoff::Default, cds::urcu::stat<>>
+    > rcu_implementations;
+
+    TYPED_TEST_CASE( urcu_stat, rcu_implementations );
+
+    TYPED_TEST( urcu_stat, grace_period )
+    {
+        typedef typename TestFixture::rcu_type rcu_type;
+        typedef typename TestFixture::stat_type stat_type;
+
+        static const size_t c_nPassCount = 100;
+
+        stat_type const& st = rcu_type::internal_statistics();
+        size_t const nBefore = st.m_nGracePeriod.get();
+
+        for ( size_t i = 0; i < c_nPassCount; ++i )
+            rcu_type::synchronize();
+        rcu_type::synchronize_expedited();
+
+        EXPECT_EQ( st.m_nGracePeriod.get() - nBefore, c_nPassCount + 1 );
+        EXPECT_EQ( st.m_nExpeditedGracePeriod.get(), 1u );
+        EXPECT_EQ( TestFixture::histogram_sum( st ), st.m_nGracePeriod.get());
+
+        uint64_t const nTotal = st.m_nGPTotalNs.load( atomics::memory_order_relaxed );
+        uint64_t const nMax = st.m_nGPMaxNs.load( atomics::memory_order_relaxed );
+        uint64_t const nExpeditedTotal = st.m_nExpeditedTotalNs.load( atomics::memory_order_relaxed );
+        uint64_t const nExpeditedMax = st.m_nExpeditedMaxNs.load( atomics::memory_order_relaxed );
+        EXPECT_GT( nMax, 0u );
+        EXPECT_GE( nTotal, nMax );
+        EXPECT_EQ( nExpeditedTotal, nExpeditedMax );    // one expedited grace period
+        EXPECT_GE( nMax, nExpeditedMax );
+        EXPECT_GE( nTotal, nExpeditedTotal );
+
+        // The bucket bounds grow by power of 2 starting from 1 microsecond
+        EXPECT_EQ( stat_type::bucket_upper_ns( 0 ), 1024u );
+        EXPECT_EQ( stat_type::bucket_upper_ns( 1 ), 2048u );
+    }
+
+    TYPED_TEST( urcu_stat, reader_wait )
+    {
+        typedef typename TestFixture::rcu_type rcu_type;
+        typedef typename TestFixture::stat_type stat_type;
+
+        stat_type const& st = rcu_type::internal_statistics();
+        size_t const nWait = st.m_nReaderWait.get();
+
+        // The grace period has to wait for the reader that is inside its critical section
+        atomics::atomic<bool> bLocked( false );
+        std::thread reader( [&bLocked]() {
+            cds::threading::Manager::attachThread();
+            {
+                typename rcu_type::scoped_lock lock;
+                bLocked.store( true, atomics::memory_order_release );
+                std::this_thread::sleep_for( std::chrono::milliseconds( 20 ));
+            }
+            cds::threading::Manager::detachThread();
+        } );
+
+        while ( !bLocked.load( atomics::memory_order_acquire ))
+            std::this_thread::yield();
+        rcu_type::synchronize();
+        reader.join();
+
+        EXPECT_GT( st.m_nReaderWait.get(), nWait );
+        EXPECT_GT( st.m_nReaderWaitSpin.get(), 0u );
+    }
+
+    TYPED_TEST( urcu_stat, retire )
+    {
+        typedef typename TestFixture::rcu_type rcu_type;
+        typedef typename TestFixture::stat_type stat_type;
+
+        stat_type const& st = rcu_type::internal_statistics();
+        size_t const nCapacity = rcu_type::rcu_implementation::instance()->capacity();
+        size_t const nRetireCount = nCapacity * 4 + 1;
+
+        item::s_nDisposed.store( 0, atomics::memory_order_relaxed );
+        for ( size_t i = 0; i < nRetireCount; ++i )
+            rcu_type::template retire_ptr<item_disposer>( new item );
+        rcu_type::synchronize();
+
+        size_t const nHighWater = st.m_nBufferHighWater.load( atomics::memory_order_relaxed );
+        if ( rcu_type::rcu_implementation::c_bBuffered ) {
+            // A full buffer forces the grace period
+            EXPECT_GT( st.m_nForcedSynchronize.get(), 0u );
+            EXPECT_GT( nHighWater, 0u );
+            EXPECT_LE( nHighWater, nCapacity );
+        }
+        else {
+            EXPECT_EQ( st.m_nForcedSynchronize.get(), 0u );
+            EXPECT_EQ( nHighWater, 0u );
+        }
+        EXPECT_EQ( item::s_nDisposed.load( atomics::memory_order_relaxed ), nRetireCount );
+    }
+
+} // namespace
@@ -127,6 +127,56 @@ namespace cds_test {
         test( pq );
     }
 
+    TEST_F( FCPQueue, vector_elimination )
+    {
+        typedef cds::container::FCPriorityQueue<
+            value_type
+            ,std::priority_queue< value_type, std::vector<value_type>, less >
+            ,cds::container::fcpqueue::make_traits<
+                cds::opt::enable_elimination< true >
+                , cds::opt::stat< cds::container::fcpqueue::stat<>>
+            >::type
+        > pqueue_type;
+
+        pqueue_type pq;
+        test( pq );
+    }
+
+    TEST_F( FCPQueue, vector_parallel_elimination )
+    {
+        typedef cds::container::FCPriorityQueue<
+            value_type
+            ,std::priority_queue< value_type, std::vector<value_type>, less >
+            ,cds::container::fcpqueue::make_traits<
+                cds::opt::enable_elimination< true >
+                , cds::opt::fc_kernel< cds::algo::flat_combining::parallel_kernel<2>>
+                , cds::opt::wait_strategy< cds::algo::flat_combining::wait_strategy::multi_mutex_multi_condvar<>>
+            >::type
+        > pqueue_type;
+
+        pqueue_type pq;
+        test( pq );
+    }
+
+    TEST_F( FCPQueue, vector_parallel_elimination_concurrent )
+    {
+        typedef cds::container::FCPriorityQueue<
+            value_type
+            ,std::priority_queue< value_type, std::vector<value_type>, yield_less >
+            ,cds::container::fcpqueue::make_traits<
+                cds::opt::enable_elimination< true >
+                , cds::opt::fc_kernel< cds::algo::flat_combining::parallel_kernel<2>>
+                , cds::opt::wait_strategy< cds::algo::flat_combining::wait_strategy::multi_mutex_multi_condvar<>>
+                , cds::opt::stat< cds::container::fcpqueue::stat<>>
+            >::type
+        > pqueue_type;
+
+        pqueue_type pq;
+        test_concurrent( pq );
+        EXPECT_GT( pq.statistics().m_nCollided.get(), 0u );
+        EXPECT_GT( pq.statistics().m_nPushMove.get(), 0u );
+    }
+
     TEST_F( FCPQueue, vector_mutex )
     {
         typedef cds::container::FCPriorityQueue<
@@ -32,11 +32,27 @@
 #define CDSUNIT_PQUEUE_FCPQUEUE_H
 
 #include "test_data.h"
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <cds/algo/atomic.h>
 
 namespace cds_test {
 
     class FCPQueue : public PQueueTest
     {
+    public:
+        // The comparator yields the combiner, so the other threads publish their requests
+        // and the combiner gets a batch of them even on a single core
+        struct yield_less {
+            bool operator()( value_type const& v1, value_type const& v2 ) const
+            {
+                std::this_thread::yield();
+                return v1.k < v2.k;
+            }
+        };
+
     protected:
         template <class PQueue>
         void test( PQueue& pq )
@@ -104,6 +120,74 @@ namespace cds_test {
             ASSERT_TRUE( pq.empty());
             ASSERT_EQ( pq.size(), 0u );
         }
+
+        // Concurrent push/pop, then the rest of the queue is drained in priority order
+        template <class PQueue>
+        void test_concurrent( PQueue& pq )
+        {
+            static unsigned int const c_nPusherCount = 4;
+            static unsigned int const c_nPopperCount = 4;
+            static key_type const c_nPushCount = 2000;    // per pusher
+            static size_t const c_nTotal = size_t( c_nPusherCount ) * c_nPushCount;
+
+            ASSERT_TRUE( pq.empty());
+
+            atomics::atomic<size_t> nPopped( 0 );
+            std::vector< std::vector<key_type>> arrPopped( c_nPopperCount );
+            std::vector< std::thread > threads;
+
+            for ( unsigned int t = 0; t < c_nPusherCount; ++t ) {
+                threads.emplace_back( [&pq, t]() {
+                    // Each pusher pushes increasing keys, so a new value is often the highest
+                    // and can be given to a pending pop directly
+                    for ( key_type i = 0; i < c_nPushCount; ++i ) {
+                        value_type v( i * key_type( c_nPusherCount ) + key_type( t ));
+                        if ( i & 1 )
+                            pq.push( std::move( v ));
+                        else
+                            pq.push( v );
+                    }
+                });
+            }
+            for ( unsigned int t = 0; t < c_nPopperCount; ++t ) {
+                threads.emplace_back( [&pq, &nPopped, &arrPopped, t]() {
+                    // The poppers take a half of the values, the rest is left in the queue
+                    value_type v;
+                    while ( nPopped.load( atomics::memory_order_relaxed ) < c_nTotal / 2 ) {
+                        if ( pq.pop( v )) {
+                            arrPopped[t].push_back( v.k );
+                            nPopped.fetch_add( 1, atomics::memory_order_relaxed );
+                        }
+                        else
+                            std::this_thread::yield();
+                    }
+                });
+            }
+            for ( auto& thr : threads )
+                thr.join();
+
+            std::vector<key_type> arrAll;
+            arrAll.reserve( c_nTotal );
+            for ( auto const& vec : arrPopped )
+                arrAll.insert( arrAll.end(), vec.begin(), vec.end());
+            EXPECT_EQ( arrAll.size(), nPopped.load());
+
+            // The heap built by batch merges keeps the priority order
+            value_type v;
+            key_type nPrev = std::numeric_limits<key_type>::max();
+            while ( pq.pop( v )) {
+                EXPECT_LE( v.k, nPrev );
+                nPrev = v.k;
+                arrAll.push_back( v.k );
+            }
+            ASSERT_TRUE( pq.empty());
+
+            // No value is lost or duplicated
+            ASSERT_EQ( arrAll.size(), c_nTotal );
+            std::sort( arrAll.begin(), arrAll.end());
+            for ( size_t i = 0; i < arrAll.size(); ++i )
+                ASSERT_EQ( arrAll[i], static_cast<key_type>( i ));
+        }
     };
 } // namespace cds_test
 
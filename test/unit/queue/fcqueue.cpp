@@ -33,11 +33,36 @@
 #include <test/include/cds_test/fc_hevy_value.h>
 
 #include <list>
+#include <thread>
+#include <vector>
+#include <algorithm>
 
 namespace {
 
     class FCQueue: public ::testing::Test
     {
+    public:
+        // The queue yields the combiner, so the other threads publish their requests
+        // and the combiner gets a batch of them even on a single core
+        template <typename T>
+        struct yield_queue: public std::queue<T>
+        {
+            typedef std::queue<T> base_class;
+
+            template <typename Q>
+            void push( Q&& v )
+            {
+                std::this_thread::yield();
+                base_class::push( std::forward<Q>( v ));
+            }
+
+            void pop()
+            {
+                std::this_thread::yield();
+                base_class::pop();
+            }
+        };
+
     protected:
         template <class Queue>
         void test( Queue& q )
@@ -207,6 +232,58 @@ namespace {
             ASSERT_EQ( q.size(), 0u );
         }
 
+        // Each thread enqueues its values and dequeues in random order concurrently.
+        // The queue stays almost empty, so the combiner pairs enqueue and dequeue requests
+        template <class Queue>
+        void test_concurrent( Queue& q )
+        {
+            static unsigned int const c_nThreadCount = 4;
+            static int const c_nPassCount = 2000;  // per thread
+
+            ASSERT_TRUE( q.empty());
+
+            std::vector< std::vector<int>> arrDequeued( c_nThreadCount );
+            std::vector< std::thread > threads;
+            for ( unsigned int t = 0; t < c_nThreadCount; ++t ) {
+                threads.emplace_back( [&q, &arrDequeued, t]() {
+                    // The threads go almost in lockstep, so the order of enqueue and dequeue differs by the random choice
+                    unsigned int nRand = t + 1;
+                    int val;
+                    for ( int i = 0; i < c_nPassCount; ++i ) {
+                        int v = static_cast<int>( t ) * c_nPassCount + i;
+                        nRand = nRand * 1103515245 + 12345;
+                        unsigned int const nChoice = nRand >> 16;
+
+                        for ( unsigned int k = 0; k < 2; ++k ) {
+                            if ( ( k + nChoice ) & 1 ) {
+                                if ( q.dequeue( val ))
+                                    arrDequeued[t].push_back( val );
+                            }
+                            else if ( nChoice & 2 )
+                                q.enqueue( std::move( v ));
+                            else
+                                q.enqueue( v );
+                        }
+                    }
+                });
+            }
+            for ( auto& thr : threads )
+                thr.join();
+
+            std::vector<int> arrAll;
+            for ( auto const& vec : arrDequeued )
+                arrAll.insert( arrAll.end(), vec.begin(), vec.end());
+            int val;
+            while ( q.dequeue( val ))
+                arrAll.push_back( val );
+            EXPECT_TRUE( q.empty());
+
+            // Every value is received once
+            ASSERT_EQ( arrAll.size(), static_cast<size_t>( c_nThreadCount * c_nPassCount ));
+            std::sort( arrAll.begin(), arrAll.end());
+            for ( size_t i = 0; i < arrAll.size(); ++i )
+                ASSERT_EQ( arrAll[i], static_cast<int>( i ));
+        }
     };
 
     TEST_F( FCQueue, std_deque )
@@ -322,6 +399,22 @@ namespace {
         test( q );
     }
 
+    TEST_F( FCQueue, std_elimination_concurrent )
+    {
+        typedef cds::container::FCQueue<int, yield_queue<int>,
+            cds::container::fcqueue::make_traits<
+                cds::opt::enable_elimination< true >
+                , cds::opt::wait_strategy< cds::algo::flat_combining::wait_strategy::multi_mutex_multi_condvar<>>
+                , cds::opt::stat< cds::container::fcqueue::stat<>>
+            >::type
+        > queue_type;
+
+        queue_type q;
+        test_concurrent( q );
+        EXPECT_GT( q.statistics().m_nCollided.get(), 0u );
+        EXPECT_GT( q.statistics().m_nEliminationPass.get(), 0u );
+    }
+
     TEST_F( FCQueue, std_deque_elimination_single_mutex_multi_condvar )
     {
         typedef cds::container::FCQueue<int, std::queue< int, std::deque<int>>,
@@ -372,6 +465,84 @@ namespace {
         test( q );
     }
 
+    TEST_F( FCQueue, std_deque_numa )
+    {
+        typedef cds::container::FCQueue<int, std::queue< int, std::deque<int>>,
+            cds::container::fcqueue::make_traits<
+                cds::opt::fc_kernel< cds::algo::flat_combining::numa_kernel >
+            >::type
+        > queue_type;
+
+        queue_type q;
+        test( q );
+    }
+
+    TEST_F( FCQueue, std_deque_numa_round_robin_elimination )
+    {
+        typedef cds::container::FCQueue<int, std::queue< int, std::deque<int>>,
+            cds::container::fcqueue::make_traits<
+                cds::opt::fc_kernel< cds::algo::flat_combining::numa_kernel >
+                , cds::opt::numa_topology< cds::algo::flat_combining::numa::round_robin<2>>
+                , cds::opt::enable_elimination< true >
+                , cds::opt::wait_strategy< cds::algo::flat_combining::wait_strategy::single_mutex_multi_condvar<>>
+            >::type
+        > queue_type;
+
+        queue_type q;
+        test( q );
+    }
+
+    TEST_F( FCQueue, std_deque_slot )
+    {
+        typedef cds::container::FCQueue<int, std::queue< int, std::deque<int>>,
+            cds::container::fcqueue::make_traits<
+                cds::opt::fc_kernel< cds::algo::flat_combining::slot_kernel<>>
+            >::type
+        > queue_type;
+
+        queue_type q;
+        test( q );
+    }
+
+    TEST_F( FCQueue, std_deque_slot_elimination )
+    {
+        typedef cds::container::FCQueue<int, std::queue< int, std::deque<int>>,
+            cds::container::fcqueue::make_traits<
+                cds::opt::fc_kernel< cds::algo::flat_combining::slot_kernel<128>>
+                , cds::opt::enable_elimination< true >
+                , cds::opt::wait_strategy< cds::algo::flat_combining::wait_strategy::multi_mutex_multi_condvar<>>
+            >::type
+        > queue_type;
+
+        queue_type q;
+        test( q );
+    }
+
+    TEST_F( FCQueue, std_deque_futex )
+    {
+        typedef cds::container::FCQueue<int, std::queue< int, std::deque<int>>,
+            cds::container::fcqueue::make_traits<
+                cds::opt::wait_strategy< cds::algo::flat_combining::wait_strategy::futex<>>
+            >::type
+        > queue_type;
+
+        queue_type q;
+        test( q );
+    }
+
+    TEST_F( FCQueue, std_deque_futex_elimination )
+    {
+        typedef cds::container::FCQueue<int, std::queue< int, std::deque<int>>,
+            cds::container::fcqueue::make_traits<
+                cds::opt::enable_elimination< true >
+                , cds::opt::wait_strategy< cds::algo::flat_combining::wait_strategy::futex<5, 4>>
+            >::type
+        > queue_type;
+
+        queue_type q;
+        test( q );
+    }
+
     TEST_F( FCQueue, std_list )
     {
         typedef cds::container::FCQueue<int, std::queue< int, std::list<int>>> queue_type;
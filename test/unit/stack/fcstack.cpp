@@ -178,6 +178,17 @@ namespace {
         test<stack_type>();
     }
 
+    TEST_F( FCStack, deque_futex )
+    {
+        struct stack_traits : public
+            cds::container::fcstack::make_traits <
+            cds::opt::wait_strategy< cds::algo::flat_combining::wait_strategy::futex<>>
+            > ::type
+        {};
+        typedef cds::container::FCStack< unsigned int, std::stack<unsigned int, std::deque<unsigned int>>, stack_traits > stack_type;
+        test<stack_type>();
+    }
+
     TEST_F( FCStack, deque_elimination )
     {
         struct stack_traits : public
@@ -189,6 +200,18 @@ namespace {
         test<stack_type>();
     }
 
+    TEST_F( FCStack, deque_slot_elimination )
+    {
+        struct stack_traits : public
+            cds::container::fcstack::make_traits <
+            cds::opt::enable_elimination < true >
+            , cds::opt::fc_kernel< cds::algo::flat_combining::slot_kernel<8>>
+            > ::type
+        {};
+        typedef cds::container::FCStack< unsigned int, std::stack<unsigned int, std::deque<unsigned int>>, stack_traits > stack_type;
+        test<stack_type>();
+    }
+
     TEST_F( FCStack, vector_based )
     {
         typedef cds::container::FCStack< unsigned int, std::stack<unsigned int, std::vector<unsigned int>>> stack_type;